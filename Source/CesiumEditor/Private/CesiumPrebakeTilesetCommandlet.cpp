@@ -0,0 +1,90 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrebakeTilesetCommandlet.h"
+#include "CesiumEditor.h"
+#include "CesiumPrebakedTiles.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UCesiumPrebakeTilesetCommandlet::UCesiumPrebakeTilesetCommandlet() {
+  this->IsClient = false;
+  this->IsEditor = true;
+  this->IsServer = false;
+  this->LogToConsole = true;
+}
+
+int32 UCesiumPrebakeTilesetCommandlet::Main(const FString& Params) {
+  TArray<FString> tokens;
+  TArray<FString> switches;
+  TMap<FString, FString> values;
+  UCommandlet::ParseCommandLine(*Params, tokens, switches, values);
+
+  const FString* pSource = values.Find(TEXT("Source"));
+  const FString* pOutput = values.Find(TEXT("Output"));
+  if (!pSource || !pOutput) {
+    UE_LOG(
+        LogCesiumEditor,
+        Error,
+        TEXT(
+            "Usage: -run=CesiumPrebakeTileset -Source=<tileset directory> -Output=<pre-baked tiles directory> [-AlwaysIncludeTangents] [-IgnoreKhrMaterialsUnlit]"));
+    return 1;
+  }
+
+  const FString source = FPaths::ConvertRelativePathToFull(*pSource);
+  const FString output = FPaths::ConvertRelativePathToFull(*pOutput);
+
+  CesiumPrebakeOptions options;
+  options.alwaysIncludeTangents =
+      switches.Contains(TEXT("AlwaysIncludeTangents"));
+  options.ignoreKhrMaterialsUnlit =
+      switches.Contains(TEXT("IgnoreKhrMaterialsUnlit"));
+
+  TArray<FString> files;
+  IFileManager::Get().FindFilesRecursive(
+      files,
+      *source,
+      TEXT("*.glb"),
+      true,
+      false);
+
+  UE_LOG(
+      LogCesiumEditor,
+      Display,
+      TEXT("Pre-baking %d tiles from %s to %s"),
+      files.Num(),
+      *source,
+      *output);
+
+  int32 failures = 0;
+  for (const FString& file : files) {
+    TArray<uint8> content;
+    FString error;
+    if (!FFileHelper::LoadFileToArray(content, *file)) {
+      error = TEXT("Could not read the file");
+    } else if (CesiumPrebakedTiles::bakeTileContent(
+                   output,
+                   content,
+                   options,
+                   error)) {
+      continue;
+    }
+
+    ++failures;
+    UE_LOG(
+        LogCesiumEditor,
+        Warning,
+        TEXT("Could not pre-bake %s: %s"),
+        *file,
+        *error);
+  }
+
+  UE_LOG(
+      LogCesiumEditor,
+      Display,
+      TEXT("Pre-baked %d of %d tiles"),
+      files.Num() - failures,
+      files.Num());
+
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "CesiumPrebakeTilesetCommandlet.generated.h"
+
+/**
+ * Pre-bakes the tiles of a tileset on the local file system, so that a
+ * Cesium3DTileset whose PrebakedTilesDirectory points at the output directory
+ * doesn't need to compute the vertices, normals, and tangents of those tiles
+ * when they are loaded.
+ *
+ * Usage:
+ *
+ *   UnrealEditor-Cmd <Project> -run=CesiumPrebakeTileset
+ *     -Source=<tileset directory> -Output=<pre-baked tiles directory>
+ *     [-AlwaysIncludeTangents] [-IgnoreKhrMaterialsUnlit]
+ *
+ * The switches must match the corresponding properties of the tileset. Only
+ * binary glTF (.glb) tile content is baked.
+ */
+UCLASS()
+class UCesiumPrebakeTilesetCommandlet : public UCommandlet {
+  GENERATED_BODY()
+
+public:
+  UCesiumPrebakeTilesetCommandlet();
+
+  virtual int32 Main(const FString& Params) override;
+};
@@ -187,6 +187,7 @@ public class CesiumRuntime : ModuleRules
         );
 
         PrivateDependencyModuleNames.Add("Chaos");
+        PrivateDependencyModuleNames.Add("ImageWrapper");
 
         if (Target.bBuildEditor == true)
         {
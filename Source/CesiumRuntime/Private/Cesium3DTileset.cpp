@@ -10,23 +10,34 @@
 #include "Cesium3DTilesSelection/TilesetOptions.h"
 #include "Cesium3DTilesetLoadFailureDetails.h"
 #include "Cesium3DTilesetRoot.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
 #include "CesiumActors.h"
 #include "CesiumBoundingVolumeComponent.h"
 #include "CesiumCamera.h"
 #include "CesiumCameraManager.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumEncodedPropertyTableCache.h"
+#include "CesiumGeometricTileExcluder.h"
+#include "CesiumGeometricTileExcluderAdapter.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
 #include "CesiumGltf/ImageCesium.h"
 #include "CesiumGltf/Ktx2TranscodeTargets.h"
 #include "CesiumGltfComponent.h"
+#include "CesiumGltfComponentPool.h"
 #include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumIonClient/Connection.h"
 #include "CesiumLifetime.h"
+#include "CesiumMaterialInstanceCache.h"
+#include "CesiumPrebakedTile.h"
 #include "CesiumRasterOverlay.h"
+#include "CesiumRasterOverlayTexturePool.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumTextureStreaming.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTileExcluder.h"
 #include "CesiumViewExtension.h"
@@ -44,9 +55,12 @@
 #include "Kismet/GameplayStatics.h"
 #include "LevelSequenceActor.h"
 #include "LevelSequencePlayer.h"
+#include "Materials/MaterialInterface.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/Paths.h"
 #include "PixelFormat.h"
 #include "StereoRendering.h"
+#include "UnrealTaskProcessor.h"
 #include "VecMath.h"
 #include <glm/gtc/matrix_inverse.hpp>
 #include <memory>
@@ -233,6 +247,66 @@ void ACesium3DTileset::InvalidateResolvedCameraManager() {
 
 void ACesium3DTileset::RefreshTileset() { this->DestroyTileset(); }
 
+FCesiumComponentPoolStatistics
+ACesium3DTileset::GetComponentPoolStatistics() const {
+  if (!this->GltfComponentPool) {
+    return FCesiumComponentPoolStatistics();
+  }
+  return this->GltfComponentPool->GetStatistics();
+}
+
+FCesiumGltfMemoryStatistics ACesium3DTileset::GetGltfMemoryStatistics() const {
+  FCesiumGltfMemoryStatistics statistics;
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  for (const UCesiumGltfComponent* pGltf : gltfComponents) {
+    // Pooled components have released their tile's resources.
+    if (pGltf->ResidentGltfBytes == 0 && pGltf->ReleasedGltfBytes == 0) {
+      continue;
+    }
+
+    ++statistics.Tiles;
+    statistics.ResidentBytes += pGltf->ResidentGltfBytes;
+    statistics.ReleasedBytes += pGltf->ReleasedGltfBytes;
+    statistics.LargestTileResidentBytes = FMath::Max(
+        statistics.LargestTileResidentBytes,
+        pGltf->ResidentGltfBytes);
+  }
+
+  return statistics;
+}
+
+FCesiumPickingStatistics ACesium3DTileset::GetPickingStatistics() const {
+  FCesiumPickingStatistics statistics;
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  for (const UCesiumGltfComponent* pGltf : gltfComponents) {
+    for (const USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      const UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!pPrimitive || !pPrimitive->PickingBvh) {
+        continue;
+      }
+
+      const CesiumPrimitiveBvh& bvh = *pPrimitive->PickingBvh;
+      const int64 bytes = int64(bvh.getAllocatedSize());
+      ++statistics.Primitives;
+      statistics.Triangles += bvh.getTriangleCount();
+      statistics.Bytes += bytes;
+      statistics.LargestPrimitiveBytes =
+          FMath::Max(statistics.LargestPrimitiveBytes, bytes);
+      statistics.BuildSeconds += bvh.getBuildSeconds();
+      statistics.LongestPrimitiveBuildSeconds = FMath::Max(
+          statistics.LongestPrimitiveBuildSeconds,
+          bvh.getBuildSeconds());
+    }
+  }
+
+  return statistics;
+}
+
 void ACesium3DTileset::TroubleshootToken() {
   OnCesium3DTilesetIonTroubleshooting.Broadcast(this);
 }
@@ -401,6 +475,22 @@ void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
   }
 }
 
+void ACesium3DTileset::SetReleaseGltfDataAfterUpload(
+    bool bReleaseGltfDataAfterUpload) {
+  if (this->ReleaseGltfDataAfterUpload != bReleaseGltfDataAfterUpload) {
+    this->ReleaseGltfDataAfterUpload = bReleaseGltfDataAfterUpload;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetTextureCompression(
+    ECesiumTextureCompression NewTextureCompression) {
+  if (this->TextureCompression != NewTextureCompression) {
+    this->TextureCompression = NewTextureCompression;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial) {
   if (this->Material != InMaterial) {
     this->Material = InMaterial;
@@ -675,7 +765,14 @@ void ACesium3DTileset::NotifyHit(
 class UnrealResourcePreparer
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
-  UnrealResourcePreparer(ACesium3DTileset* pActor) : _pActor(pActor) {}
+  UnrealResourcePreparer(ACesium3DTileset* pActor)
+      : _pActor(pActor),
+        _prebakedTilesDirectory(getPrebakedTilesDirectory(*pActor)),
+        _pPropertyTableCache(MakeShared<CesiumEncodedPropertyTableCache>()),
+        _componentPoolGeneration(
+            pActor->GltfComponentPool
+                ? pActor->GltfComponentPool->GetGeneration()
+                : 0) {}
 
   virtual CesiumAsync::Future<
       Cesium3DTilesSelection::TileLoadResultAndRenderResources>
@@ -699,15 +796,33 @@ public:
 
     options.ignoreKhrMaterialsUnlit =
         this->_pActor->GetIgnoreKhrMaterialsUnlit();
+    options.textureCompression = this->_pActor->GetTextureCompression();
+    options.parallelMeshBuilding =
+        GetDefault<UCesiumRuntimeSettings>()->ParallelMeshBuilding;
+
+    // Texture streaming restores dropped mip levels from the glTF images, so
+    // they are only released if there is no texture memory budget.
+    options.releaseBuffers = this->_pActor->GetReleaseGltfDataAfterUpload();
+    options.releaseImages =
+        options.releaseBuffers &&
+        GetDefault<UCesiumRuntimeSettings>()->TextureMemoryBudgetInMegabytes ==
+            0;
 
     if (this->_pActor->_featuresMetadataDescription) {
       options.pFeaturesMetadataDescription =
           &(*this->_pActor->_featuresMetadataDescription);
+      options.pPropertyTableCache = this->_pPropertyTableCache;
     } else if (this->_pActor->_metadataDescription_DEPRECATED) {
       options.pEncodedMetadataDescription_DEPRECATED =
           &(*this->_pActor->_metadataDescription_DEPRECATED);
     }
 
+    std::optional<CesiumPrebakedTile> prebakedTile =
+        this->readPrebakedTile(tileLoadResult, options);
+    if (prebakedTile) {
+      options.pPrebakedTile = &*prebakedTile;
+    }
+
     TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf =
         UCesiumGltfComponent::CreateOffGameThread(transform, options);
     return asyncSystem.createResolvedFuture(
@@ -736,7 +851,10 @@ public:
           this->_pActor->GetWaterMaterial(),
           this->_pActor->GetCustomDepthParameters(),
           tile,
-          this->_pActor->GetCreateNavCollision());
+          this->_pActor->GetCreateNavCollision(),
+          this->_pActor->GltfComponentPool,
+          this->_pActor->MaterialInstanceCache,
+          this->shouldShareMaterialInstances());
     }
     // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
     return nullptr;
@@ -754,7 +872,18 @@ public:
     } else if (pMainThreadResult) {
       UCesiumGltfComponent* pGltf =
           reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
-      CesiumLifetime::destroyComponentRecursively(pGltf);
+      // Tiles of a destroyed tileset may be freed after the pool has been
+      // cleared for the next tileset, so they are destroyed instead.
+      UCesiumGltfComponentPool* pPool = this->_pActor->GltfComponentPool;
+      if (IsValid(pPool) &&
+          pPool->GetGeneration() == this->_componentPoolGeneration) {
+        pPool->Release(
+            pGltf,
+            this->_pActor->MaximumPooledTileComponents,
+            this->_pActor->MaximumPooledPrimitiveComponents);
+      } else {
+        CesiumLifetime::destroyComponentRecursively(pGltf);
+      }
     }
   }
 
@@ -770,30 +899,60 @@ public:
 
     auto pOptions = *ppOptions;
 
-    auto texture = CesiumTextureUtility::loadTextureAnyThreadPart(
-        CesiumTextureUtility::GltfImagePtr{&image},
-        TextureAddress::TA_Clamp,
-        TextureAddress::TA_Clamp,
-        pOptions->filter,
-        pOptions->group,
-        pOptions->useMipmaps,
-        true); // TODO: sRGB should probably be configurable on the raster
-               // overlay
-    return texture.Release();
+    TUniquePtr<CesiumRasterTileLoadResult> pResult =
+        MakeUnique<CesiumRasterTileLoadResult>();
+    if (pOptions->useTexturePool) {
+      pResult->pPooledImage = CesiumRasterOverlayTexturePool::prepareImage(
+          image,
+          pOptions->useMipmaps);
+    }
+
+    if (!pResult->pPooledImage) {
+      pResult->pTexture = CesiumTextureUtility::loadTextureAnyThreadPart(
+          CesiumTextureUtility::GltfImagePtr{&image},
+          TextureAddress::TA_Clamp,
+          TextureAddress::TA_Clamp,
+          pOptions->filter,
+          pOptions->group,
+          pOptions->useMipmaps,
+          true); // TODO: sRGB should probably be configurable on the raster
+                 // overlay
+      if (!pResult->pTexture) {
+        return nullptr;
+      }
+    }
+
+    return pResult.Release();
   }
 
   virtual void* prepareRasterInMainThread(
       CesiumRasterOverlays::RasterOverlayTile& rasterTile,
       void* pLoadThreadResult) override {
 
-    TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pLoadedTexture{
-        static_cast<CesiumTextureUtility::LoadedTextureResult*>(
-            pLoadThreadResult)};
+    TUniquePtr<CesiumRasterTileLoadResult> pLoadResult{
+        static_cast<CesiumRasterTileLoadResult*>(pLoadThreadResult)};
 
-    if (!pLoadedTexture) {
+    if (!pLoadResult) {
       return nullptr;
     }
 
+    if (pLoadResult->pPooledImage) {
+      auto ppOptions = std::any_cast<FRasterOverlayRendererOptions*>(
+          &rasterTile.getOverlay().getOptions().rendererOptions);
+      if (ppOptions == nullptr || *ppOptions == nullptr ||
+          !(*ppOptions)->pTexturePool) {
+        // The overlay was removed from the tileset while the tile loaded.
+        return nullptr;
+      }
+
+      return (*ppOptions)
+          ->pTexturePool->add(MoveTemp(*pLoadResult->pPooledImage))
+          .Release();
+    }
+
+    TUniquePtr<CesiumTextureUtility::LoadedTextureResult>& pLoadedTexture =
+        pLoadResult->pTexture;
+
     // The image source pointer during loading may have been invalidated,
     // so replace it.
     CesiumTextureUtility::GltfImagePtr* pImageSource =
@@ -810,7 +969,10 @@ public:
     }
 
     pTexture->AddToRoot();
-    return pTexture;
+
+    CesiumRasterTileTexture* pResult = new CesiumRasterTileTexture();
+    pResult->pTexture = pTexture;
+    return pResult;
   }
 
   virtual void freeRaster(
@@ -818,17 +980,24 @@ public:
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept override {
     if (pLoadThreadResult) {
-      CesiumTextureUtility::LoadedTextureResult* pLoadedTexture =
-          static_cast<CesiumTextureUtility::LoadedTextureResult*>(
-              pLoadThreadResult);
-      CesiumTextureUtility::destroyHalfLoadedTexture(*pLoadedTexture);
-      delete pLoadedTexture;
+      CesiumRasterTileLoadResult* pLoadResult =
+          static_cast<CesiumRasterTileLoadResult*>(pLoadThreadResult);
+      if (pLoadResult->pTexture) {
+        CesiumTextureUtility::destroyHalfLoadedTexture(*pLoadResult->pTexture);
+      }
+      delete pLoadResult;
     }
 
     if (pMainThreadResult) {
-      UTexture* pTexture = static_cast<UTexture*>(pMainThreadResult);
-      pTexture->RemoveFromRoot();
-      CesiumTextureUtility::destroyTexture(pTexture);
+      CesiumRasterTileTexture* pTexture =
+          static_cast<CesiumRasterTileTexture*>(pMainThreadResult);
+      if (pTexture->pPool) {
+        pTexture->pPool->free(*pTexture);
+      } else {
+        pTexture->pTexture->RemoveFromRoot();
+        CesiumTextureUtility::destroyTexture(pTexture->pTexture);
+      }
+      delete pTexture;
     }
   }
 
@@ -846,13 +1015,21 @@ public:
       UCesiumGltfComponent* pGltfContent =
           reinterpret_cast<UCesiumGltfComponent*>(
               pRenderContent->getRenderResources());
+      const CesiumRasterTileTexture* pTexture =
+          static_cast<const CesiumRasterTileTexture*>(
+              pMainThreadRendererResources);
       if (pGltfContent) {
+        // Map the texture coordinates of the tile to its slot in the texture,
+        // which is the whole texture unless it is pooled.
+        const CesiumRasterTileTexture noTexture{};
+        const CesiumRasterTileTexture& texture =
+            pTexture ? *pTexture : noTexture;
         pGltfContent->AttachRasterTile(
             tile,
             rasterTile,
-            static_cast<UTexture2D*>(pMainThreadRendererResources),
-            translation,
-            scale,
+            texture.pTexture,
+            translation * texture.scale + texture.translation,
+            scale * texture.scale,
             overlayTextureCoordinateID);
       }
     }
@@ -871,16 +1048,69 @@ public:
           reinterpret_cast<UCesiumGltfComponent*>(
               pRenderContent->getRenderResources());
       if (pGltfContent) {
+        const CesiumRasterTileTexture* pTexture =
+            static_cast<const CesiumRasterTileTexture*>(
+                pMainThreadRendererResources);
         pGltfContent->DetachRasterTile(
             tile,
             rasterTile,
-            static_cast<UTexture2D*>(pMainThreadRendererResources));
+            pTexture ? pTexture->pTexture : nullptr);
       }
     }
   }
 
 private:
+  bool shouldShareMaterialInstances() const {
+    // Raster overlay textures are specific to each tile, so primitives can't
+    // share material instances when there are overlays.
+    const Cesium3DTilesSelection::Tileset* pTileset =
+        this->_pActor->GetTileset();
+    return this->_pActor->ShareMaterialInstances && pTileset &&
+           pTileset->getOverlays().size() == 0;
+  }
+
+  static FString getPrebakedTilesDirectory(const ACesium3DTileset& actor) {
+    const FString& path = actor.PrebakedTilesDirectory.Path;
+    return path.IsEmpty()
+               ? FString()
+               : FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), path);
+  }
+
+  std::optional<CesiumPrebakedTile> readPrebakedTile(
+      const Cesium3DTilesSelection::TileLoadResult& tileLoadResult,
+      const CreateGltfOptions::CreateModelOptions& options) const {
+    // Smooth normals are generated before the model gets here, so they would
+    // not match the flat normals of the pre-baked tile.
+    if (this->_prebakedTilesDirectory.IsEmpty() ||
+        this->_pActor->GetGenerateSmoothNormals()) {
+      return std::nullopt;
+    }
+
+    const CesiumAsync::IAssetResponse* pResponse =
+        tileLoadResult.pCompletedRequest
+            ? tileLoadResult.pCompletedRequest->response()
+            : nullptr;
+    if (!pResponse) {
+      return std::nullopt;
+    }
+
+    CesiumPrebakeOptions prebakeOptions;
+    prebakeOptions.alwaysIncludeTangents = options.alwaysIncludeTangents;
+    prebakeOptions.ignoreKhrMaterialsUnlit = options.ignoreKhrMaterialsUnlit;
+
+    const gsl::span<const std::byte> content = pResponse->data();
+    const uint64 key = CesiumPrebakedTiles::computeKey(
+        TArrayView<const uint8>(
+            reinterpret_cast<const uint8*>(content.data()),
+            int32(content.size())),
+        prebakeOptions);
+    return CesiumPrebakedTiles::readTile(this->_prebakedTilesDirectory, key);
+  }
+
   ACesium3DTileset* _pActor;
+  FString _prebakedTilesDirectory;
+  TSharedPtr<CesiumEncodedPropertyTableCache> _pPropertyTableCache;
+  int32 _componentPoolGeneration;
 };
 
 void ACesium3DTileset::UpdateLoadStatus() {
@@ -934,6 +1164,33 @@ getCesiumViewExtension() {
   return cesiumViewExtension;
 }
 
+void addMaterialParameterNames(
+    const UMaterialInterface* pMaterial,
+    TSet<FString>& names) {
+  if (!pMaterial) {
+    return;
+  }
+
+  TArray<FMaterialParameterInfo> parameterInfos;
+  TArray<FGuid> parameterIds;
+
+  // This includes the parameters of the material's layers.
+  pMaterial->GetAllScalarParameterInfo(parameterInfos, parameterIds);
+  for (const FMaterialParameterInfo& parameterInfo : parameterInfos) {
+    names.Add(parameterInfo.Name.ToString());
+  }
+
+  pMaterial->GetAllVectorParameterInfo(parameterInfos, parameterIds);
+  for (const FMaterialParameterInfo& parameterInfo : parameterInfos) {
+    names.Add(parameterInfo.Name.ToString());
+  }
+
+  pMaterial->GetAllTextureParameterInfo(parameterInfos, parameterIds);
+  for (const FMaterialParameterInfo& parameterInfo : parameterInfos) {
+    names.Add(parameterInfo.Name.ToString());
+  }
+}
+
 } // namespace
 
 void ACesium3DTileset::LoadTileset() {
@@ -984,6 +1241,9 @@ void ACesium3DTileset::LoadTileset() {
   TArray<UCesiumTileExcluder*> tileExcluders;
   this->GetComponents<UCesiumTileExcluder>(tileExcluders);
 
+  TArray<UCesiumGeometricTileExcluder*> geometricTileExcluders;
+  this->GetComponents<UCesiumGeometricTileExcluder>(geometricTileExcluders);
+
   const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
       this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
 
@@ -1005,6 +1265,29 @@ void ACesium3DTileset::LoadTileset() {
     description.ModelMetadata = {
         pFeaturesMetadataComponent->PropertyTables,
         pFeaturesMetadataComponent->PropertyTextures};
+
+    if (pFeaturesMetadataComponent->EncodeOnlyReferencedProperties) {
+      // Tiles use the default materials when none are set on the tileset.
+      const UCesiumGltfComponent* pDefaults =
+          GetDefault<UCesiumGltfComponent>();
+      TSet<FString> materialParameterNames;
+      addMaterialParameterNames(
+          this->Material ? this->Material : pDefaults->BaseMaterial,
+          materialParameterNames);
+      addMaterialParameterNames(
+          this->TranslucentMaterial ? this->TranslucentMaterial
+                                    : pDefaults->BaseMaterialWithTranslucency,
+          materialParameterNames);
+      addMaterialParameterNames(
+          this->WaterMaterial ? this->WaterMaterial
+                              : pDefaults->BaseMaterialWithWater,
+          materialParameterNames);
+
+      description = CesiumEncodedFeaturesMetadata::
+          filterFeaturesMetadataDescription(
+              description,
+              materialParameterNames);
+    }
   } else if (pEncodedMetadataComponent) {
     UE_LOG(
         LogCesium,
@@ -1038,6 +1321,18 @@ void ACesium3DTileset::LoadTileset() {
     this->BoundingVolumePoolComponent->initPool(this->OcclusionPoolSize);
   }
 
+  if (!this->GltfComponentPool) {
+    this->GltfComponentPool = NewObject<UCesiumGltfComponentPool>(this);
+    this->GltfComponentPool->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  }
+
+  if (!this->MaterialInstanceCache) {
+    this->MaterialInstanceCache = NewObject<UCesiumMaterialInstanceCache>(this);
+    this->MaterialInstanceCache->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  }
+
   ACesiumCreditSystem* pCreditSystem = this->ResolvedCreditSystem;
 
   Cesium3DTilesSelection::TilesetExternals externals{
@@ -1134,6 +1429,11 @@ void ACesium3DTileset::LoadTileset() {
   options.contentOptions.ktx2TranscodeTargets =
       CesiumGltf::Ktx2TranscodeTargets(supportedFormats, false);
 
+  if (this->_taskOwner == UnrealTaskProcessor::UnownedTasks) {
+    this->_taskOwner = getTaskProcessor().createOwner(ECesiumTaskLane::InView);
+  }
+  CesiumTaskScope taskScope(this->_taskOwner);
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(LogCesium, Log, TEXT("Loading tileset from URL %s"), *this->Url);
@@ -1186,6 +1486,12 @@ void ACesium3DTileset::LoadTileset() {
     }
   }
 
+  for (UCesiumGeometricTileExcluder* pTileExcluder : geometricTileExcluders) {
+    if (pTileExcluder->IsActive()) {
+      pTileExcluder->AddToTileset();
+    }
+  }
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(
@@ -1261,6 +1567,13 @@ void ACesium3DTileset::DestroyTileset() {
     }
   }
 
+  TArray<UCesiumGeometricTileExcluder*> geometricTileExcluders;
+  this->GetComponents<UCesiumGeometricTileExcluder>(geometricTileExcluders);
+  for (UCesiumGeometricTileExcluder* pTileExcluder : geometricTileExcluders) {
+    pTileExcluder->RemoveFromTileset();
+  }
+  this->_pGeometricTileExcluder.reset();
+
   if (!this->_pTileset) {
     return;
   }
@@ -1274,6 +1587,22 @@ void ACesium3DTileset::DestroyTileset() {
       [this]() { --this->_tilesetsBeingDestroyed; });
   this->_pTileset.Reset();
 
+  // Work that is still queued for the destroyed tileset only needs to finish
+  // eventually, so it shouldn't hold up other tilesets.
+  getTaskProcessor().releaseOwner(this->_taskOwner);
+  this->_taskOwner = UnrealTaskProcessor::UnownedTasks;
+
+  // Pooled components may have been created for different materials or
+  // options, so don't carry them over to the next tileset. The destroyed
+  // tileset frees its tiles asynchronously, and clearing the pool starts a new
+  // generation so that those tiles are destroyed rather than pooled.
+  if (this->GltfComponentPool) {
+    this->GltfComponentPool->Clear();
+  }
+  if (this->MaterialInstanceCache) {
+    this->MaterialInstanceCache->Clear();
+  }
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(
@@ -2013,6 +2342,8 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  CesiumTextureStreaming::get().update(cameras);
+
   glm::dmat4 ueTilesetToUeWorld =
       VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale());
 
@@ -2034,6 +2365,23 @@ void ACesium3DTileset::Tick(float DeltaTime) {
         CreateViewStateFromViewParameters(camera, unrealWorldToCesiumTileset));
   }
 
+  // Tiles of a hidden tileset are loaded in advance, so they're less urgent
+  // than the tiles of tilesets that are visible right now.
+  const bool isRendered = !this->IsHidden() && this->RootComponent->IsVisible();
+  getTaskProcessor().setOwnerLane(
+      this->_taskOwner,
+      isRendered ? ECesiumTaskLane::InView : ECesiumTaskLane::Preload);
+
+  // updateView first runs the continuations that are waiting for the main
+  // thread, which are shared by all tilesets and raster overlays. Run them
+  // outside of this tileset's scope, so that the tasks they start aren't
+  // charged to this tileset, and only this tileset's own work is in its scope.
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DispatchMainThreadTasks)
+    getAsyncSystem().dispatchMainThreadTasks();
+  }
+  CesiumTaskScope taskScope(this->_taskOwner);
+
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
   if (this->_captureMovieMode) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
@@ -2156,6 +2504,11 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TextureCompression) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      ReleaseGltfDataAfterUpload) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
@@ -2165,6 +2518,10 @@ void ACesium3DTileset::PostEditChangeProperty(
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableOcclusionCulling) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseLodTransitions) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShareMaterialInstances) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PrebakedTilesDirectory) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShowCreditsOnScreen) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Root) ||
@@ -0,0 +1,427 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBlockCompression.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumUtility/Tracing.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+constexpr int32 BlockWidth = 4;
+constexpr int32 PixelsPerBlock = 16;
+constexpr int32 BytesPerPixel = 4;
+
+// The number of times the endpoints of a high quality BC1 block are refined
+// from the indices chosen for the previous endpoints.
+constexpr int32 RefinementIterations = 2;
+
+uint16 encode565(int32 red, int32 green, int32 blue) {
+  const int32 r = (FMath::Clamp(red, 0, 255) * 31 + 127) / 255;
+  const int32 g = (FMath::Clamp(green, 0, 255) * 63 + 127) / 255;
+  const int32 b = (FMath::Clamp(blue, 0, 255) * 31 + 127) / 255;
+  return uint16((r << 11) | (g << 5) | b);
+}
+
+void decode565(uint16 color, int32* pRgb) {
+  const int32 r = (color >> 11) & 31;
+  const int32 g = (color >> 5) & 63;
+  const int32 b = color & 31;
+  pRgb[0] = (r << 3) | (r >> 2);
+  pRgb[1] = (g << 2) | (g >> 4);
+  pRgb[2] = (b << 3) | (b >> 2);
+}
+
+struct BC1Candidate {
+  uint16 color0 = 0;
+  uint16 color1 = 0;
+  uint32 indices = 0;
+  int64 error = std::numeric_limits<int64>::max();
+};
+
+// Chooses the nearest color for each pixel from the palette that the given
+// endpoints define in four-color mode, and computes the total squared error.
+BC1Candidate evaluateEndpoints(
+    const uint8* pPixels,
+    uint16 color0,
+    uint16 color1) {
+  // Four-color mode requires the first endpoint to be the larger one. When
+  // they're equal the block is in three-color mode, but every pixel uses the
+  // first endpoint anyway.
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  int32 palette[4][3];
+  decode565(color0, palette[0]);
+  decode565(color1, palette[1]);
+  for (int32 channel = 0; channel < 3; ++channel) {
+    palette[2][channel] =
+        (2 * palette[0][channel] + palette[1][channel]) / 3;
+    palette[3][channel] =
+        (palette[0][channel] + 2 * palette[1][channel]) / 3;
+  }
+  const int32 paletteSize = color0 == color1 ? 1 : 4;
+
+  BC1Candidate candidate;
+  candidate.color0 = color0;
+  candidate.color1 = color1;
+  candidate.error = 0;
+
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    const uint8* pPixel = pPixels + i * BytesPerPixel;
+    int32 bestIndex = 0;
+    int32 bestError = std::numeric_limits<int32>::max();
+    for (int32 j = 0; j < paletteSize; ++j) {
+      const int32 dr = int32(pPixel[0]) - palette[j][0];
+      const int32 dg = int32(pPixel[1]) - palette[j][1];
+      const int32 db = int32(pPixel[2]) - palette[j][2];
+      const int32 error = dr * dr + dg * dg + db * db;
+      if (error < bestError) {
+        bestError = error;
+        bestIndex = j;
+      }
+    }
+    candidate.indices |= uint32(bestIndex) << (2 * i);
+    candidate.error += bestError;
+  }
+
+  return candidate;
+}
+
+BC1Candidate chooseBoundingBoxEndpoints(const uint8* pPixels) {
+  int32 minimum[3] = {255, 255, 255};
+  int32 maximum[3] = {0, 0, 0};
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    for (int32 channel = 0; channel < 3; ++channel) {
+      const int32 value = pPixels[i * BytesPerPixel + channel];
+      minimum[channel] = FMath::Min(minimum[channel], value);
+      maximum[channel] = FMath::Max(maximum[channel], value);
+    }
+  }
+
+  return evaluateEndpoints(
+      pPixels,
+      encode565(maximum[0], maximum[1], maximum[2]),
+      encode565(minimum[0], minimum[1], minimum[2]));
+}
+
+// Uses the colors at the ends of the principal axis of the block's colors as
+// the endpoints, which fits gradients that aren't aligned with the color axes
+// much better than the bounding box does.
+BC1Candidate choosePrincipalAxisEndpoints(const uint8* pPixels) {
+  float mean[3] = {0.0f, 0.0f, 0.0f};
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    for (int32 channel = 0; channel < 3; ++channel) {
+      mean[channel] += pPixels[i * BytesPerPixel + channel];
+    }
+  }
+  for (float& value : mean) {
+    value /= float(PixelsPerBlock);
+  }
+
+  float covariance[3][3] = {};
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    float offset[3];
+    for (int32 channel = 0; channel < 3; ++channel) {
+      offset[channel] = pPixels[i * BytesPerPixel + channel] - mean[channel];
+    }
+    for (int32 row = 0; row < 3; ++row) {
+      for (int32 column = 0; column < 3; ++column) {
+        covariance[row][column] += offset[row] * offset[column];
+      }
+    }
+  }
+
+  // Find the principal axis with a few iterations of the power method.
+  float axis[3] = {1.0f, 1.0f, 1.0f};
+  for (int32 iteration = 0; iteration < 8; ++iteration) {
+    float next[3];
+    for (int32 row = 0; row < 3; ++row) {
+      next[row] = covariance[row][0] * axis[0] +
+                  covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+    }
+    const float length = FMath::Max3(
+        FMath::Abs(next[0]),
+        FMath::Abs(next[1]),
+        FMath::Abs(next[2]));
+    if (length <= SMALL_NUMBER) {
+      // All of the pixels have the same color.
+      break;
+    }
+    for (int32 channel = 0; channel < 3; ++channel) {
+      axis[channel] = next[channel] / length;
+    }
+  }
+
+  int32 minimumPixel = 0;
+  int32 maximumPixel = 0;
+  float minimum = std::numeric_limits<float>::max();
+  float maximum = std::numeric_limits<float>::lowest();
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    const uint8* pPixel = pPixels + i * BytesPerPixel;
+    const float projection =
+        pPixel[0] * axis[0] + pPixel[1] * axis[1] + pPixel[2] * axis[2];
+    if (projection < minimum) {
+      minimum = projection;
+      minimumPixel = i;
+    }
+    if (projection > maximum) {
+      maximum = projection;
+      maximumPixel = i;
+    }
+  }
+
+  const uint8* pMaximum = pPixels + maximumPixel * BytesPerPixel;
+  const uint8* pMinimum = pPixels + minimumPixel * BytesPerPixel;
+  return evaluateEndpoints(
+      pPixels,
+      encode565(pMaximum[0], pMaximum[1], pMaximum[2]),
+      encode565(pMinimum[0], pMinimum[1], pMinimum[2]));
+}
+
+// Computes the endpoints that best fit the pixels, in the least squares sense,
+// given the palette index each pixel uses.
+BC1Candidate
+refineEndpoints(const uint8* pPixels, const BC1Candidate& candidate) {
+  // The weight of the first endpoint in each palette entry.
+  constexpr float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+  float aa = 0.0f;
+  float ab = 0.0f;
+  float bb = 0.0f;
+  float ax[3] = {0.0f, 0.0f, 0.0f};
+  float bx[3] = {0.0f, 0.0f, 0.0f};
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    const float a = weights[(candidate.indices >> (2 * i)) & 3];
+    const float b = 1.0f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (int32 channel = 0; channel < 3; ++channel) {
+      const float value = pPixels[i * BytesPerPixel + channel];
+      ax[channel] += a * value;
+      bx[channel] += b * value;
+    }
+  }
+
+  const float determinant = aa * bb - ab * ab;
+  if (FMath::Abs(determinant) <= SMALL_NUMBER) {
+    return candidate;
+  }
+
+  int32 endpoint0[3];
+  int32 endpoint1[3];
+  for (int32 channel = 0; channel < 3; ++channel) {
+    endpoint0[channel] = FMath::RoundToInt(
+        (bb * ax[channel] - ab * bx[channel]) / determinant);
+    endpoint1[channel] = FMath::RoundToInt(
+        (aa * bx[channel] - ab * ax[channel]) / determinant);
+  }
+
+  return evaluateEndpoints(
+      pPixels,
+      encode565(endpoint0[0], endpoint0[1], endpoint0[2]),
+      encode565(endpoint1[0], endpoint1[1], endpoint1[2]));
+}
+
+void compressAlphaBlock(const uint8* pPixels, uint8* pBlock) {
+  int32 minimum = 255;
+  int32 maximum = 0;
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    const int32 alpha = pPixels[i * BytesPerPixel + 3];
+    minimum = FMath::Min(minimum, alpha);
+    maximum = FMath::Max(maximum, alpha);
+  }
+
+  // With the first endpoint larger, the block uses eight interpolated alphas.
+  pBlock[0] = uint8(maximum);
+  pBlock[1] = uint8(minimum);
+  std::memset(pBlock + 2, 0, 6);
+  if (maximum == minimum) {
+    return;
+  }
+
+  int32 palette[8];
+  palette[0] = maximum;
+  palette[1] = minimum;
+  for (int32 j = 2; j < 8; ++j) {
+    palette[j] = ((8 - j) * maximum + (j - 1) * minimum) / 7;
+  }
+
+  uint64 indices = 0;
+  for (int32 i = 0; i < PixelsPerBlock; ++i) {
+    const int32 alpha = pPixels[i * BytesPerPixel + 3];
+    int32 bestIndex = 0;
+    int32 bestError = std::numeric_limits<int32>::max();
+    for (int32 j = 0; j < 8; ++j) {
+      const int32 error = FMath::Abs(alpha - palette[j]);
+      if (error < bestError) {
+        bestError = error;
+        bestIndex = j;
+      }
+    }
+    indices |= uint64(bestIndex) << (3 * i);
+  }
+
+  for (int32 byte = 0; byte < 6; ++byte) {
+    pBlock[2 + byte] = uint8(indices >> (8 * byte));
+  }
+}
+
+// Copies a block of pixels out of an image, repeating the last row and column
+// for blocks that extend past the edge of small mip levels.
+void readBlock(
+    const std::byte* pImage,
+    int32 width,
+    int32 height,
+    int32 blockX,
+    int32 blockY,
+    uint8* pPixels) {
+  for (int32 y = 0; y < BlockWidth; ++y) {
+    const int32 sourceY = FMath::Min(blockY * BlockWidth + y, height - 1);
+    for (int32 x = 0; x < BlockWidth; ++x) {
+      const int32 sourceX = FMath::Min(blockX * BlockWidth + x, width - 1);
+      std::memcpy(
+          pPixels + (y * BlockWidth + x) * BytesPerPixel,
+          pImage + (int64(sourceY) * width + sourceX) * BytesPerPixel,
+          BytesPerPixel);
+    }
+  }
+}
+
+bool isOpaque(const ImageCesium& image) {
+  for (size_t i = 3; i < image.pixelData.size(); i += BytesPerPixel) {
+    if (image.pixelData[i] != std::byte(255)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+namespace CesiumBlockCompression {
+
+void compressBC1Block(
+    const uint8* pPixels,
+    uint8* pBlock,
+    ECesiumTextureCompression compression) {
+  BC1Candidate best = chooseBoundingBoxEndpoints(pPixels);
+
+  if (compression == ECesiumTextureCompression::HighQuality && best.error > 0) {
+    const BC1Candidate principal = choosePrincipalAxisEndpoints(pPixels);
+    if (principal.error < best.error) {
+      best = principal;
+    }
+
+    for (int32 iteration = 0; iteration < RefinementIterations; ++iteration) {
+      const BC1Candidate refined = refineEndpoints(pPixels, best);
+      if (refined.error >= best.error) {
+        break;
+      }
+      best = refined;
+    }
+  }
+
+  pBlock[0] = uint8(best.color0);
+  pBlock[1] = uint8(best.color0 >> 8);
+  pBlock[2] = uint8(best.color1);
+  pBlock[3] = uint8(best.color1 >> 8);
+  pBlock[4] = uint8(best.indices);
+  pBlock[5] = uint8(best.indices >> 8);
+  pBlock[6] = uint8(best.indices >> 16);
+  pBlock[7] = uint8(best.indices >> 24);
+}
+
+void compressBC3Block(
+    const uint8* pPixels,
+    uint8* pBlock,
+    ECesiumTextureCompression compression) {
+  compressAlphaBlock(pPixels, pBlock);
+  compressBC1Block(pPixels, pBlock + 8, compression);
+}
+
+std::optional<ImageCesium> compressImage(
+    const ImageCesium& image,
+    ECesiumTextureCompression compression) {
+  if (compression == ECesiumTextureCompression::None ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.channels != 4 || image.bytesPerChannel != 1 || image.width <= 0 ||
+      image.height <= 0 || image.width % BlockWidth != 0 ||
+      image.height % BlockWidth != 0) {
+    return std::nullopt;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompressImage)
+
+  std::vector<ImageCesiumMipPosition> sourceMips = image.mipPositions;
+  if (sourceMips.empty()) {
+    sourceMips.push_back({0, image.pixelData.size()});
+  }
+
+  for (size_t mip = 0; mip < sourceMips.size(); ++mip) {
+    const size_t width = size_t(FMath::Max(image.width >> mip, 1));
+    const size_t height = size_t(FMath::Max(image.height >> mip, 1));
+    const ImageCesiumMipPosition& position = sourceMips[mip];
+    if (position.byteSize != width * height * BytesPerPixel ||
+        position.byteOffset + position.byteSize > image.pixelData.size()) {
+      return std::nullopt;
+    }
+  }
+
+  const bool opaque = isOpaque(image);
+  const int32 blockBytes = opaque ? BC1BlockBytes : BC3BlockBytes;
+
+  std::vector<std::byte> compressed;
+  std::vector<ImageCesiumMipPosition> compressedMips;
+  compressedMips.reserve(sourceMips.size());
+
+  uint8 pixels[PixelsPerBlock * BytesPerPixel];
+  for (size_t mip = 0; mip < sourceMips.size(); ++mip) {
+    const int32 width = FMath::Max(image.width >> mip, 1);
+    const int32 height = FMath::Max(image.height >> mip, 1);
+    const int32 blocksX = (width + BlockWidth - 1) / BlockWidth;
+    const int32 blocksY = (height + BlockWidth - 1) / BlockWidth;
+    const std::byte* pSource = &image.pixelData[sourceMips[mip].byteOffset];
+
+    const size_t offset = compressed.size();
+    const size_t size = size_t(blocksX) * size_t(blocksY) * blockBytes;
+    compressed.resize(offset + size);
+    uint8* pBlock = reinterpret_cast<uint8*>(compressed.data() + offset);
+
+    for (int32 blockY = 0; blockY < blocksY; ++blockY) {
+      for (int32 blockX = 0; blockX < blocksX; ++blockX) {
+        readBlock(pSource, width, height, blockX, blockY, pixels);
+        if (opaque) {
+          compressBC1Block(pixels, pBlock, compression);
+        } else {
+          compressBC3Block(pixels, pBlock, compression);
+        }
+        pBlock += blockBytes;
+      }
+    }
+
+    compressedMips.push_back({offset, size});
+  }
+
+  ImageCesium result;
+  result.width = image.width;
+  result.height = image.height;
+  result.channels = image.channels;
+  result.bytesPerChannel = image.bytesPerChannel;
+  result.compressedPixelFormat = opaque ? GpuCompressedPixelFormat::BC1_RGB
+                                        : GpuCompressedPixelFormat::BC3_RGBA;
+  result.pixelData = std::move(compressed);
+  if (!image.mipPositions.empty()) {
+    result.mipPositions = std::move(compressedMips);
+  }
+
+  return result;
+}
+
+} // namespace CesiumBlockCompression
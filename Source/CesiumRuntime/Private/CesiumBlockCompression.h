@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumTextureCompression.h"
+#include "HAL/Platform.h"
+#include <optional>
+
+/**
+ * Functions for compressing uncompressed images to the BC1 and BC3 texture
+ * formats on the CPU, so that they take less GPU memory.
+ */
+namespace CesiumBlockCompression {
+/**
+ * The size in bytes of a BC1 block.
+ */
+constexpr int32 BC1BlockBytes = 8;
+
+/**
+ * The size in bytes of a BC3 block.
+ */
+constexpr int32 BC3BlockBytes = 16;
+
+/**
+ * Compresses a 4x4 block of pixels to a BC1 block. The alpha of the pixels is
+ * ignored.
+ *
+ * @param pPixels The 16 RGBA pixels of the block, row by row.
+ * @param pBlock Receives the BC1BlockBytes bytes of the compressed block.
+ * @param compression How carefully to choose the colors of the block.
+ */
+void compressBC1Block(
+    const uint8* pPixels,
+    uint8* pBlock,
+    ECesiumTextureCompression compression);
+
+/**
+ * Compresses a 4x4 block of pixels to a BC3 block.
+ *
+ * @param pPixels The 16 RGBA pixels of the block, row by row.
+ * @param pBlock Receives the BC3BlockBytes bytes of the compressed block.
+ * @param compression How carefully to choose the colors of the block.
+ */
+void compressBC3Block(
+    const uint8* pPixels,
+    uint8* pBlock,
+    ECesiumTextureCompression compression);
+
+/**
+ * Compresses an uncompressed RGBA image and its mip levels into a new image.
+ * Opaque images are compressed to BC1 and translucent images to BC3. The
+ * given image is left unchanged, since a glTF image may be used by several
+ * textures that don't all want it compressed.
+ *
+ * @param image The image to compress.
+ * @param compression How to compress the image.
+ * @return The compressed image, or std::nullopt for images that are already
+ * compressed, that don't have four 8-bit channels, or whose size isn't a
+ * multiple of the block size.
+ */
+std::optional<CesiumGltf::ImageCesium> compressImage(
+    const CesiumGltf::ImageCesium& image,
+    ECesiumTextureCompression compression);
+} // namespace CesiumBlockCompression
@@ -0,0 +1,296 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBufferedCacheDatabase.h"
+#include "CesiumStats.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+
+using namespace CesiumAsync;
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Pending Cache Writes"),
+    STAT_CesiumPendingCacheWrites,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Cache Write Batches"),
+    STAT_CesiumCacheWriteBatches,
+    STATGROUP_Cesium);
+
+class CesiumBufferedCacheDatabase::Writer : public FRunnable {
+public:
+  explicit Writer(CesiumBufferedCacheDatabase& cache) : _cache(cache) {}
+
+  virtual uint32 Run() override {
+    this->_cache.runWriter();
+    return 0;
+  }
+
+private:
+  CesiumBufferedCacheDatabase& _cache;
+};
+
+CesiumBufferedCacheDatabase::CesiumBufferedCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDiskCache,
+    int64 maximumBufferedBytes)
+    : _pDiskCache(pDiskCache), _maximumBufferedBytes(maximumBufferedBytes) {
+  if (maximumBufferedBytes <= 0 ||
+      !FPlatformProcess::SupportsMultithreading()) {
+    return;
+  }
+
+  this->_pWriter = std::make_unique<Writer>(*this);
+  this->_pThread = FRunnableThread::Create(
+      this->_pWriter.get(),
+      TEXT("CesiumCacheWriter"),
+      0,
+      TPri_BelowNormal);
+  this->_running = this->_pThread != nullptr;
+}
+
+CesiumBufferedCacheDatabase::~CesiumBufferedCacheDatabase() {
+  this->shutdown();
+}
+
+std::optional<CacheItem>
+CesiumBufferedCacheDatabase::getEntry(const std::string& key) const {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+
+    // Check the writes that are still pending, and the batch that is being
+    // written right now, so that a response that was just stored isn't
+    // requested again.
+    for (const PendingWrites* pWrites :
+         {&this->_pendingWrites, &this->_writesInProgress}) {
+      auto it = pWrites->find(key);
+      if (it != pWrites->end()) {
+        const PendingWrite& write = it->second;
+        return CacheItem(
+            write.expiryTime,
+            CacheRequest(
+                HttpHeaders(write.requestHeaders),
+                write.requestMethod,
+                write.url),
+            CacheResponse(
+                write.statusCode,
+                HttpHeaders(write.responseHeaders),
+                std::vector<std::byte>(write.responseData)));
+      }
+    }
+  }
+
+  return this->_pDiskCache->getEntry(key);
+}
+
+bool CesiumBufferedCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  int32 pendingWrites = 0;
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (this->_running && !this->_stopping) {
+      const int64 bytes = int64(responseData.size());
+
+      auto it = this->_pendingWrites.find(key);
+      const int64 replacedBytes =
+          it != this->_pendingWrites.end()
+              ? int64(it->second.responseData.size())
+              : 0;
+
+      if (this->_pendingBytes + this->_inProgressBytes - replacedBytes +
+              bytes >
+          this->_maximumBufferedBytes) {
+        // Caching is best-effort, so it's better to skip this response than
+        // to stall the thread that loaded it.
+        ++this->_droppedWrites;
+        return false;
+      }
+
+      std::vector<std::byte> data(responseData.begin(), responseData.end());
+      this->_pendingWrites.insert_or_assign(
+          key,
+          PendingWrite{
+              expiryTime,
+              url,
+              requestMethod,
+              requestHeaders,
+              statusCode,
+              responseHeaders,
+              std::move(data)});
+      this->_pendingBytes += bytes - replacedBytes;
+      pendingWrites = int32(
+          this->_pendingWrites.size() + this->_writesInProgress.size());
+    } else {
+      pendingWrites = -1;
+    }
+  }
+
+  if (pendingWrites < 0) {
+    return this->_pDiskCache->storeEntry(
+        key,
+        expiryTime,
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        responseHeaders,
+        responseData);
+  }
+
+  this->_writesPending.notify_one();
+  SET_DWORD_STAT(STAT_CesiumPendingCacheWrites, pendingWrites);
+  return true;
+}
+
+bool CesiumBufferedCacheDatabase::prune() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (this->_running && !this->_stopping) {
+      this->_pruneRequested = true;
+      this->_writesPending.notify_one();
+      return true;
+    }
+  }
+
+  return this->_pDiskCache->prune();
+}
+
+bool CesiumBufferedCacheDatabase::clearAll() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_pendingWrites.clear();
+    this->_pendingBytes = 0;
+    this->_pruneRequested = false;
+
+    // A batch that has been taken but not yet written must not be written
+    // after the cache has been cleared.
+    ++this->_clearCount;
+  }
+
+  std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+  return this->_pDiskCache->clearAll();
+}
+
+void CesiumBufferedCacheDatabase::flush() {
+  std::unique_lock<std::mutex> lock(this->_mutex);
+  this->_writesPending.notify_one();
+  this->_batchWritten.wait(lock, [this]() {
+    return !this->_running || (this->_pendingWrites.empty() &&
+                               this->_writesInProgress.empty() &&
+                               !this->_pruneRequested);
+  });
+}
+
+void CesiumBufferedCacheDatabase::shutdown() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (!this->_running || this->_stopping) {
+      return;
+    }
+    this->_stopping = true;
+  }
+
+  // The writer commits everything that is pending before it exits, and new
+  // writes go directly to disk from now on.
+  this->_writesPending.notify_all();
+  this->_pThread->WaitForCompletion();
+  delete this->_pThread;
+  this->_pThread = nullptr;
+  this->_pWriter.reset();
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_running = false;
+  }
+  this->_batchWritten.notify_all();
+}
+
+void CesiumBufferedCacheDatabase::addStatistics(
+    CesiumCacheStatistics& statistics) const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  statistics.pendingWrites +=
+      int64(this->_pendingWrites.size() + this->_writesInProgress.size());
+  statistics.pendingWriteBytes += this->_pendingBytes + this->_inProgressBytes;
+  statistics.writeBatches += this->_batchesWritten;
+  statistics.droppedWrites += this->_droppedWrites;
+}
+
+void CesiumBufferedCacheDatabase::runWriter() {
+  for (;;) {
+    bool prune = false;
+    int64 clearCount = 0;
+
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_writesPending.wait(lock, [this]() {
+        return !this->_pendingWrites.empty() || this->_pruneRequested ||
+               this->_stopping;
+      });
+
+      if (this->_pendingWrites.empty() && !this->_pruneRequested) {
+        // Stopping, and everything has been written.
+        return;
+      }
+
+      // Everything that was stored while the previous batch was being
+      // written goes into this batch.
+      this->_writesInProgress.swap(this->_pendingWrites);
+      this->_inProgressBytes = this->_pendingBytes;
+      this->_pendingBytes = 0;
+      prune = this->_pruneRequested;
+      this->_pruneRequested = false;
+      clearCount = this->_clearCount;
+    }
+
+    this->writeBatch(clearCount, prune);
+
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      this->_writesInProgress.clear();
+      this->_inProgressBytes = 0;
+      ++this->_batchesWritten;
+    }
+
+    INC_DWORD_STAT(STAT_CesiumCacheWriteBatches);
+    this->_batchWritten.notify_all();
+  }
+}
+
+void CesiumBufferedCacheDatabase::writeBatch(int64 clearCount, bool prune) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WriteCacheBatch)
+
+  std::scoped_lock<std::mutex> diskLock(this->_diskMutex);
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (this->_clearCount != clearCount) {
+      return;
+    }
+  }
+
+  // The batch is only read here and in getEntry, and only modified by this
+  // thread, so it can be read without holding the mutex.
+  for (const auto& pair : this->_writesInProgress) {
+    const PendingWrite& write = pair.second;
+    this->_pDiskCache->storeEntry(
+        pair.first,
+        write.expiryTime,
+        write.url,
+        write.requestMethod,
+        write.requestHeaders,
+        write.statusCode,
+        write.responseHeaders,
+        write.responseData);
+  }
+
+  if (prune) {
+    this->_pDiskCache->prune();
+  }
+}
@@ -0,0 +1,123 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumCacheStatistics.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class FRunnableThread;
+
+/**
+ * A cache database that buffers the writes to another cache database, such as
+ * the SQLite cache on disk, and commits them in batches on a single
+ * background thread. The threads that store responses never wait for the
+ * disk. Buffered responses can be read back before they have been written.
+ *
+ * At most a fixed number of bytes is buffered. When the buffer is full,
+ * further responses are not cached until the writer catches up.
+ */
+class CesiumBufferedCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * Creates a buffered cache.
+   *
+   * @param pDiskCache The cache to write to in the background.
+   * @param maximumBufferedBytes The maximum number of response bytes waiting
+   * to be written. If this is zero, writes are not buffered at all.
+   */
+  CesiumBufferedCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDiskCache,
+      int64 maximumBufferedBytes);
+
+  virtual ~CesiumBufferedCacheDatabase();
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * Requests a prune of the underlying cache. The prune happens on the
+   * background thread after the buffered writes.
+   */
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * Blocks until every buffered write has been committed.
+   */
+  void flush();
+
+  /**
+   * Commits every buffered write and stops the background thread. Writes after
+   * this go directly to the underlying cache.
+   */
+  void shutdown();
+
+  /**
+   * Adds the statistics about buffered writes to the given statistics.
+   */
+  void addStatistics(CesiumCacheStatistics& statistics) const;
+
+private:
+  struct PendingWrite {
+    std::time_t expiryTime;
+    std::string url;
+    std::string requestMethod;
+    CesiumAsync::HttpHeaders requestHeaders;
+    uint16_t statusCode;
+    CesiumAsync::HttpHeaders responseHeaders;
+    std::vector<std::byte> responseData;
+  };
+
+  using PendingWrites = std::unordered_map<std::string, PendingWrite>;
+
+  class Writer;
+
+  void runWriter();
+
+  /**
+   * Writes the batch in progress to the underlying cache, unless the cache
+   * has been cleared since the batch was taken.
+   */
+  void writeBatch(int64 clearCount, bool prune);
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDiskCache;
+  int64 _maximumBufferedBytes;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _writesPending;
+  std::condition_variable _batchWritten;
+  PendingWrites _pendingWrites;
+  int64 _pendingBytes = 0;
+  PendingWrites _writesInProgress;
+  int64 _inProgressBytes = 0;
+  int64 _clearCount = 0;
+  bool _pruneRequested = false;
+  bool _stopping = false;
+  bool _running = false;
+  int64 _droppedWrites = 0;
+  int64 _batchesWritten = 0;
+
+  // Held while writing to the underlying cache, so that clearAll can't
+  // interleave with a batch.
+  std::mutex _diskMutex;
+
+  std::unique_ptr<Writer> _pWriter;
+  FRunnableThread* _pThread = nullptr;
+};
@@ -1,6 +1,7 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "CesiumCreditSystem.h"
+#include "CesiumAsync/AsyncSystem.h"
 #include "CesiumCreditSystemBPLoader.h"
 #include "CesiumRuntime.h"
 #include "CesiumUtility/CreditSystem.h"
@@ -335,50 +336,95 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
       _pCreditSystem->getCreditsToNoLongerShowThisFrame().size() > 0;
 
   if (CreditsUpdated) {
-    FString OnScreenCredits;
-    FString Credits;
-
     _lastCreditsCount = creditsToShowThisFrame.size();
+    _creditsChanged = true;
+  }
 
-    bool firstCreditOnScreen = true;
-    for (int i = 0; i < creditsToShowThisFrame.size(); i++) {
-      const CesiumUtility::Credit& credit = creditsToShowThisFrame[i];
+  if (_creditsChanged) {
+    _creditsChanged = false;
+    UpdateCredits();
+  }
+  _pCreditSystem->startNextFrame();
+}
 
-      FString CreditRtf;
-      const std::string& html = _pCreditSystem->getHtml(credit);
+void ACesiumCreditSystem::UpdateCredits() {
+  const std::vector<CesiumUtility::Credit>& creditsToShowThisFrame =
+      _pCreditSystem->getCreditsToShowThisFrame();
 
-      auto htmlFind = _htmlToRtf.find(html);
-      if (htmlFind != _htmlToRtf.end()) {
-        CreditRtf = htmlFind->second;
-      } else {
-        CreditRtf = ConvertHtmlToRtf(html);
-        _htmlToRtf.insert({html, CreditRtf});
-      }
+  FString OnScreenCredits;
+  FString Credits;
+  bool allCreditsConverted = true;
 
-      if (_pCreditSystem->shouldBeShownOnScreen(credit)) {
-        if (firstCreditOnScreen) {
-          firstCreditOnScreen = false;
-        } else {
-          OnScreenCredits += TEXT(" \u2022 ");
-        }
+  bool firstCreditOnScreen = true;
+  for (int i = 0; i < creditsToShowThisFrame.size(); i++) {
+    const CesiumUtility::Credit& credit = creditsToShowThisFrame[i];
+
+    const std::string& html = _pCreditSystem->getHtml(credit);
+
+    auto htmlFind = _htmlToRtf.find(html);
+    if (htmlFind == _htmlToRtf.end()) {
+      allCreditsConverted = false;
+      ConvertHtmlToRtfInBackground(html);
+      continue;
+    }
+
+    const ConvertedCredit& converted = htmlFind->second;
+    for (const std::string& imageUrl : converted.imageUrls) {
+      CreditsWidget->LoadImage(imageUrl);
+    }
 
-        OnScreenCredits += CreditRtf;
+    if (_pCreditSystem->shouldBeShownOnScreen(credit)) {
+      if (firstCreditOnScreen) {
+        firstCreditOnScreen = false;
       } else {
-        if (i != 0) {
-          Credits += "\n";
-        }
+        OnScreenCredits += TEXT(" \u2022 ");
+      }
 
-        Credits += CreditRtf;
+      OnScreenCredits += converted.rtf;
+    } else {
+      if (i != 0) {
+        Credits += "\n";
       }
-    }
 
-    if (!Credits.IsEmpty()) {
-      OnScreenCredits += "<credits url=\"popup\" text=\" Data attribution\"/>";
+      Credits += converted.rtf;
     }
+  }
+
+  // Keep showing the previous credits until every new credit has been
+  // converted. This is called again when each conversion finishes.
+  if (!allCreditsConverted) {
+    return;
+  }
 
-    CreditsWidget->SetCredits(Credits, OnScreenCredits);
+  if (!Credits.IsEmpty()) {
+    OnScreenCredits += "<credits url=\"popup\" text=\" Data attribution\"/>";
   }
-  _pCreditSystem->startNextFrame();
+
+  CreditsWidget->SetCredits(Credits, OnScreenCredits);
+}
+
+void ACesiumCreditSystem::ConvertHtmlToRtfInBackground(
+    const std::string& html) {
+  if (!_htmlBeingConverted.insert(html).second) {
+    return;
+  }
+
+  // Parsing the HTML with tidy takes long enough to cause hitches when
+  // credits change quickly, so it is done in a worker thread and the result
+  // is cached for as long as the credit system exists.
+  getAsyncSystem()
+      .runInWorkerThread([html]() { return ConvertHtmlToRtf(html); })
+      .thenInMainThread([pThis = TWeakObjectPtr<ACesiumCreditSystem>(this),
+                         html](ConvertedCredit&& converted) {
+        ACesiumCreditSystem* pCreditSystem = pThis.Get();
+        if (!pCreditSystem) {
+          return;
+        }
+
+        pCreditSystem->_htmlBeingConverted.erase(html);
+        pCreditSystem->_htmlToRtf.insert({html, std::move(converted)});
+        pCreditSystem->_creditsChanged = true;
+      });
 }
 
 namespace {
@@ -387,7 +433,7 @@ void convertHtmlToRtf(
     std::string& parentUrl,
     TidyDoc tdoc,
     TidyNode tnod,
-    UScreenCreditsWidget* CreditsWidget) {
+    std::vector<std::string>& imageUrls) {
   TidyNode child;
   TidyBuffer buf;
   tidyBufInit(&buf);
@@ -413,10 +459,10 @@ void convertHtmlToRtf(
       if (srcAttr) {
         auto srcValue = tidyAttrValue(srcAttr);
         if (srcValue) {
+          std::string imageUrl(reinterpret_cast<const char*>(srcValue));
           output += "<credits id=\"" +
-                    CreditsWidget->LoadImage(
-                        std::string(reinterpret_cast<const char*>(srcValue))) +
-                    "\"";
+                    UScreenCreditsWidget::GetImageKey(imageUrl) + "\"";
+          imageUrls.emplace_back(std::move(imageUrl));
           if (!parentUrl.empty()) {
             output += " url=\"" + parentUrl + "\"";
           }
@@ -429,13 +475,14 @@ void convertHtmlToRtf(
       auto hrefValue = tidyAttrValue(hrefAttr);
       parentUrl = std::string(reinterpret_cast<const char*>(hrefValue));
     }
-    convertHtmlToRtf(output, parentUrl, tdoc, child, CreditsWidget);
+    convertHtmlToRtf(output, parentUrl, tdoc, child, imageUrls);
   }
   tidyBufFree(&buf);
 }
 } // namespace
 
-FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
+/*static*/ ACesiumCreditSystem::ConvertedCredit
+ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
   TidyDoc tdoc;
   TidyBuffer tidy_errbuf = {0};
   int err;
@@ -449,12 +496,14 @@ FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
 
   html = "<!DOCTYPE html><html><body>" + html + "</body></html>";
 
+  ConvertedCredit result;
   std::string output, url;
   err = tidyParseString(tdoc, html.c_str());
   if (err < 2) {
-    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc), CreditsWidget);
+    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc), result.imageUrls);
   }
   tidyBufFree(&tidy_errbuf);
   tidyRelease(tdoc);
-  return UTF8_TO_TCHAR(output.c_str());
+  result.rtf = UTF8_TO_TCHAR(output.c_str());
+  return result;
 }
@@ -2,6 +2,7 @@
 
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataConversions.h"
+#include "CesiumEncodedPropertyTableCache.h"
 #include "CesiumFeatureIdSet.h"
 #include "CesiumFeaturesMetadataComponent.h"
 #include "CesiumLifetime.h"
@@ -16,9 +17,13 @@
 #include "Containers/Map.h"
 #include "PixelFormat.h"
 #include "TextureResource.h"
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltf/FeatureIdTextureView.h>
+#include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
+#include <algorithm>
 #include <glm/gtx/integer.hpp>
+#include <limits>
 #include <optional>
 #include <unordered_map>
 
@@ -343,7 +348,10 @@ getPixelFormat(FCesiumMetadataEncodingDetails encodingDetails) {
   case ECesiumEncodedMetadataComponentType::Uint8:
     switch (encodingDetails.Type) {
     case ECesiumEncodedMetadataType::Scalar:
-      return {EPixelFormat::PF_R8_UINT, 1};
+      // Packed properties share the channels of a texture.
+      return encodingDetails.IsPacked()
+                 ? EncodedPixelFormat{EPixelFormat::PF_R8G8B8A8_UINT, 4}
+                 : EncodedPixelFormat{EPixelFormat::PF_R8_UINT, 1};
     case ECesiumEncodedMetadataType::Vec2:
     case ECesiumEncodedMetadataType::Vec3:
     case ECesiumEncodedMetadataType::Vec4:
@@ -352,6 +360,18 @@ getPixelFormat(FCesiumMetadataEncodingDetails encodingDetails) {
       return {EPixelFormat::PF_Unknown, 0};
     }
   case ECesiumEncodedMetadataComponentType::Float:
+    if (encodingDetails.IsQuantized()) {
+      switch (encodingDetails.Type) {
+      case ECesiumEncodedMetadataType::Scalar:
+        return {EPixelFormat::PF_R16_UINT, 2};
+      case ECesiumEncodedMetadataType::Vec2:
+      case ECesiumEncodedMetadataType::Vec3:
+      case ECesiumEncodedMetadataType::Vec4:
+        return {EPixelFormat::PF_R16G16B16A16_UINT, 8};
+      default:
+        return {EPixelFormat::PF_Unknown, 0};
+      }
+    }
     switch (encodingDetails.Type) {
     case ECesiumEncodedMetadataType::Scalar:
       return {EPixelFormat::PF_R32_FLOAT, 4};
@@ -466,11 +486,230 @@ bool isValidPropertyTexturePropertyDescription(
   return true;
 }
 
+/**
+ * @brief Creates a square texture for the values of a property table
+ * property, whose texels are filled in by the given function.
+ */
+template <typename WriteTexels>
+TSharedPtr<LoadedTextureResult> createPropertyTableTexture(
+    int64 textureDimension,
+    const EncodedPixelFormat& encodedFormat,
+    WriteTexels&& writeTexels) {
+  TSharedPtr<LoadedTextureResult> pTexture = MakeShared<LoadedTextureResult>();
+  pTexture->sRGB = false;
+  // TODO: upgrade to new texture creation path.
+  pTexture->textureSource = LegacyTextureSource{};
+  pTexture->pTextureData = createTexturePlatformData(
+      textureDimension,
+      textureDimension,
+      encodedFormat.format);
+
+  pTexture->addressX = TextureAddress::TA_Clamp;
+  pTexture->addressY = TextureAddress::TA_Clamp;
+  pTexture->filter = TextureFilter::TF_Nearest;
+
+  if (!pTexture->pTextureData) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT(
+            "Error encoding a property table property. Most likely could not allocate enough texture memory."));
+    return nullptr;
+  }
+
+  FTexture2DMipMap* pMip = new FTexture2DMipMap();
+  pTexture->pTextureData->Mips.Add(pMip);
+  pMip->SizeX = textureDimension;
+  pMip->SizeY = textureDimension;
+
+  pMip->BulkData.Lock(LOCK_READ_WRITE);
+
+  void* pTextureData = pMip->BulkData.Realloc(
+      textureDimension * textureDimension * encodedFormat.pixelSize);
+
+  gsl::span<std::byte> textureData(
+      reinterpret_cast<std::byte*>(pTextureData),
+      static_cast<size_t>(pMip->BulkData.GetBulkDataSize()));
+  writeTexels(textureData);
+
+  pMip->BulkData.Unlock();
+
+  return pTexture;
+}
+
+/**
+ * @brief Encodes the values of a property table property into the given
+ * texels, as described by its encoding details. Quantized properties are
+ * first encoded as floats, which are then quantized.
+ */
+std::optional<QuantizationTransform> encodePropertyTableTexels(
+    const FCesiumPropertyTablePropertyDescription& description,
+    const FCesiumPropertyTableProperty& property,
+    gsl::span<std::byte> textureData,
+    size_t pixelSize) {
+  const FCesiumMetadataEncodingDetails& encodingDetails =
+      description.EncodingDetails;
+  if (encodingDetails.Conversion ==
+      ECesiumEncodedMetadataConversion::ParseColorFromString) {
+    CesiumEncodedMetadataParseColorFromString::encode(
+        description,
+        property,
+        textureData,
+        pixelSize);
+    return std::nullopt;
+  }
+
+  if (!encodingDetails.IsQuantized()) {
+    CesiumEncodedMetadataCoerce::encode(
+        description,
+        property,
+        textureData,
+        pixelSize);
+    return std::nullopt;
+  }
+
+  // Encode the values as floats with the layout of an unquantized texture,
+  // then quantize them in place of the floats.
+  const size_t componentCount =
+      CesiumGetEncodedMetadataTypeComponentCount(encodingDetails.Type);
+  const size_t stride = componentCount == 1 ? 1 : 4;
+  const size_t texelCount = textureData.size() / pixelSize;
+
+  TArray<float> floats;
+  floats.SetNumZeroed(static_cast<int32>(texelCount * stride));
+  gsl::span<std::byte> floatData(
+      reinterpret_cast<std::byte*>(floats.GetData()),
+      floats.Num() * sizeof(float));
+  CesiumEncodedMetadataCoerce::encode(
+      description,
+      property,
+      floatData,
+      stride * sizeof(float));
+
+  return quantizeTo16Bits(
+      gsl::span<const float>(floats.GetData(), floats.Num()),
+      gsl::span<uint16>(
+          reinterpret_cast<uint16*>(textureData.data()),
+          texelCount * stride),
+      componentCount,
+      stride);
+}
+
+/**
+ * @brief A texture of packed property table properties, which has one
+ * property in each channel.
+ */
+struct PackedPropertyTexture {
+  TArray<uint8> texels;
+  TArray<int32> propertyIndices;
+};
+
+constexpr int32 PackedPropertiesPerTexture = 4;
+
 } // namespace
 
+QuantizationTransform quantizeTo16Bits(
+    gsl::span<const float> values,
+    gsl::span<uint16> quantized,
+    size_t componentCount,
+    size_t stride) {
+  float minimum = std::numeric_limits<float>::max();
+  float maximum = std::numeric_limits<float>::lowest();
+  for (size_t i = 0; i < values.size(); i += stride) {
+    for (size_t j = 0; j < componentCount; ++j) {
+      const float value = values[i + j];
+      if (FMath::IsFinite(value)) {
+        minimum = FMath::Min(minimum, value);
+        maximum = FMath::Max(maximum, value);
+      }
+    }
+  }
+
+  if (minimum > maximum) {
+    // None of the values are finite.
+    minimum = maximum = 0.0f;
+  }
+
+  QuantizationTransform transform;
+  transform.offset = minimum;
+  transform.scale = (double(maximum) - double(minimum)) / MAX_uint16;
+
+  std::fill(quantized.begin(), quantized.end(), uint16(0));
+  if (transform.scale <= 0.0) {
+    return transform;
+  }
+
+  const double inverseScale = 1.0 / transform.scale;
+  for (size_t i = 0; i < values.size(); i += stride) {
+    for (size_t j = 0; j < componentCount; ++j) {
+      const float value = values[i + j];
+      if (FMath::IsFinite(value)) {
+        quantized[i + j] = uint16(FMath::Clamp(
+            FMath::RoundToInt64((double(value) - transform.offset) *
+                                inverseScale),
+            int64(0),
+            int64(MAX_uint16)));
+      }
+    }
+  }
+
+  return transform;
+}
+
+CesiumGltf::ImageCesium downsampleImage(
+    const CesiumGltf::ImageCesium& image,
+    int32 factor,
+    ECesiumEncodedMetadataDownsampleFilter filter) {
+  CesiumGltf::ImageCesium result;
+  result.channels = image.channels;
+  result.bytesPerChannel = image.bytesPerChannel;
+  result.width = FMath::DivideAndRoundUp(image.width, factor);
+  result.height = FMath::DivideAndRoundUp(image.height, factor);
+  result.pixelData.resize(
+      size_t(result.width) * result.height * result.channels);
+
+  const size_t channels = size_t(image.channels);
+  for (int32 y = 0; y < result.height; ++y) {
+    const int32 startY = y * factor;
+    const int32 endY = FMath::Min(startY + factor, image.height);
+    for (int32 x = 0; x < result.width; ++x) {
+      const int32 startX = x * factor;
+      const int32 endX = FMath::Min(startX + factor, image.width);
+      std::byte* pTexel =
+          &result.pixelData[(size_t(y) * result.width + x) * channels];
+
+      if (filter == ECesiumEncodedMetadataDownsampleFilter::Nearest) {
+        const int32 centerX = (startX + endX - 1) / 2;
+        const int32 centerY = (startY + endY - 1) / 2;
+        const std::byte* pSource =
+            &image.pixelData[(size_t(centerY) * image.width + centerX) *
+                             channels];
+        std::copy(pSource, pSource + channels, pTexel);
+        continue;
+      }
+
+      const uint32 count = uint32((endX - startX) * (endY - startY));
+      for (size_t c = 0; c < channels; ++c) {
+        uint32 sum = 0;
+        for (int32 sourceY = startY; sourceY < endY; ++sourceY) {
+          for (int32 sourceX = startX; sourceX < endX; ++sourceX) {
+            sum += uint32(
+                image.pixelData
+                    [(size_t(sourceY) * image.width + sourceX) * channels + c]);
+          }
+        }
+        pTexel[c] = std::byte((sum + count / 2) / count);
+      }
+    }
+  }
+
+  return result;
+}
+
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
     const FCesiumPropertyTableDescription& propertyTableDescription,
-    const FCesiumPropertyTable& propertyTable) {
+    const FCesiumPropertyTable& propertyTable,
+    bool encodeTextures) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTable)
 
@@ -483,6 +722,16 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
   const TMap<FString, FCesiumPropertyTableProperty>& properties =
       UCesiumPropertyTableBlueprintLibrary::GetProperties(propertyTable);
 
+  // All of the properties are encoded into square textures that are just
+  // large enough to hold the values of every feature.
+  int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
+  int64 textureDimension =
+      (floorSqrtFeatureCount * floorSqrtFeatureCount == propertyTableCount)
+          ? floorSqrtFeatureCount
+          : (floorSqrtFeatureCount + 1);
+
+  TArray<PackedPropertyTexture> packedTextures;
+
   encodedPropertyTable.properties.Reserve(properties.Num());
   for (const auto& pair : properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
@@ -548,67 +797,52 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     encodedProperty.name = createHlslSafeName(pDescription->Name);
     encodedProperty.type = pDescription->EncodingDetails.Type;
 
-    if (UCesiumPropertyTablePropertyBlueprintLibrary::
-            GetPropertyTablePropertyStatus(property) ==
-        ECesiumPropertyTablePropertyStatus::Valid) {
-
-      int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
-      int64 textureDimension =
-          (floorSqrtFeatureCount * floorSqrtFeatureCount == propertyTableCount)
-              ? floorSqrtFeatureCount
-              : (floorSqrtFeatureCount + 1);
-
-      encodedProperty.pTexture = MakeUnique<LoadedTextureResult>();
-      encodedProperty.pTexture->sRGB = false;
-      // TODO: upgrade to new texture creation path.
-      encodedProperty.pTexture->textureSource = LegacyTextureSource{};
-      encodedProperty.pTexture->pTextureData = createTexturePlatformData(
-          textureDimension,
-          textureDimension,
-          encodedFormat.format);
-
-      encodedProperty.pTexture->addressX = TextureAddress::TA_Clamp;
-      encodedProperty.pTexture->addressY = TextureAddress::TA_Clamp;
-      encodedProperty.pTexture->filter = TextureFilter::TF_Nearest;
-
-      if (!encodedProperty.pTexture->pTextureData) {
-        UE_LOG(
-            LogCesium,
-            Error,
-            TEXT(
-                "Error encoding a property table property. Most likely could not allocate enough texture memory."));
-        continue;
-      }
-
-      FTexture2DMipMap* pMip = new FTexture2DMipMap();
-      encodedProperty.pTexture->pTextureData->Mips.Add(pMip);
-      pMip->SizeX = textureDimension;
-      pMip->SizeY = textureDimension;
-
-      pMip->BulkData.Lock(LOCK_READ_WRITE);
-
-      void* pTextureData = pMip->BulkData.Realloc(
-          textureDimension * textureDimension * encodedFormat.pixelSize);
+    if (encodeTextures &&
+        UCesiumPropertyTablePropertyBlueprintLibrary::
+                GetPropertyTablePropertyStatus(property) ==
+            ECesiumPropertyTablePropertyStatus::Valid) {
+      if (encodingDetails.IsPacked()) {
+        // The texture is created once all of the properties that share it
+        // have been encoded.
+        if (packedTextures.Num() == 0 ||
+            packedTextures.Last().propertyIndices.Num() ==
+                PackedPropertiesPerTexture) {
+          packedTextures.Emplace_GetRef().texels.SetNumZeroed(
+              textureDimension * textureDimension * encodedFormat.pixelSize);
+        }
 
-      gsl::span<std::byte> textureData(
-          reinterpret_cast<std::byte*>(pTextureData),
-          static_cast<size_t>(pMip->BulkData.GetBulkDataSize()));
+        PackedPropertyTexture& packedTexture = packedTextures.Last();
+        const int32 channel = packedTexture.propertyIndices.Num();
+        packedTexture.propertyIndices.Add(
+            encodedPropertyTable.properties.Num() - 1);
+        encodedProperty.packedChannel = channel;
 
-      if (encodingDetails.Conversion ==
-          ECesiumEncodedMetadataConversion::ParseColorFromString) {
-        CesiumEncodedMetadataParseColorFromString::encode(
-            *pDescription,
-            property,
-            textureData,
-            encodedFormat.pixelSize);
-      } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
-        CesiumEncodedMetadataCoerce::encode(
+        TArray<uint8> values;
+        values.SetNumZeroed(textureDimension * textureDimension);
+        encodePropertyTableTexels(
             *pDescription,
             property,
-            textureData,
-            encodedFormat.pixelSize);
+            gsl::span<std::byte>(
+                reinterpret_cast<std::byte*>(values.GetData()),
+                values.Num()),
+            1);
+        for (int32 i = 0; i < values.Num(); ++i) {
+          packedTexture.texels[i * PackedPropertiesPerTexture + channel] =
+              values[i];
+        }
+      } else {
+        encodedProperty.pTexture = createPropertyTableTexture(
+            textureDimension,
+            encodedFormat,
+            [pDescription, &property, &encodedFormat, &encodedProperty](
+                gsl::span<std::byte> textureData) {
+              encodedProperty.quantization = encodePropertyTableTexels(
+                  *pDescription,
+                  property,
+                  textureData,
+                  encodedFormat.pixelSize);
+            });
       }
-      pMip->BulkData.Unlock();
     }
 
     if (pDescription->PropertyDetails.bHasOffset) {
@@ -652,13 +886,30 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     }
   }
 
+  for (const PackedPropertyTexture& packedTexture : packedTextures) {
+    TSharedPtr<LoadedTextureResult> pTexture = createPropertyTableTexture(
+        textureDimension,
+        {EPixelFormat::PF_R8G8B8A8_UINT, 4},
+        [&packedTexture](gsl::span<std::byte> textureData) {
+          FMemory::Memcpy(
+              textureData.data(),
+              packedTexture.texels.GetData(),
+              FMath::Min(
+                  textureData.size(),
+                  size_t(packedTexture.texels.Num())));
+        });
+    for (int32 index : packedTexture.propertyIndices) {
+      encodedPropertyTable.properties[index].pTexture = pTexture;
+    }
+  }
+
   return encodedPropertyTable;
 }
 
 EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     const FCesiumPropertyTextureDescription& propertyTextureDescription,
     const FCesiumPropertyTexture& propertyTexture,
-    TMap<const CesiumGltf::ImageCesium*, TWeakPtr<LoadedTextureResult>>&
+    TMap<PropertyTextureImageKey, TWeakPtr<LoadedTextureResult>>&
         propertyTexturePropertyMap) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTexture)
@@ -709,15 +960,39 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
 
       const CesiumGltf::ImageCesium* pImage = property.getImage();
 
+      const int32 downsampleFactor =
+          FMath::Max(pDescription->DownsampleFactor, 1);
+      ECesiumEncodedMetadataDownsampleFilter downsampleFilter =
+          pDescription->DownsampleFilter;
+      if (downsampleFactor == 1 ||
+          pDescription->PropertyDetails.ComponentType !=
+              ECesiumMetadataComponentType::Uint8) {
+        // Only properties with single-byte components can be averaged channel
+        // by channel.
+        downsampleFilter = ECesiumEncodedMetadataDownsampleFilter::Nearest;
+      }
+
+      const PropertyTextureImageKey imageKey(
+          pImage,
+          downsampleFactor,
+          downsampleFilter);
+
       TWeakPtr<LoadedTextureResult>* pMappedUnrealImageIt =
-          propertyTexturePropertyMap.Find(pImage);
+          propertyTexturePropertyMap.Find(imageKey);
       if (pMappedUnrealImageIt) {
         encodedProperty.pTexture = pMappedUnrealImageIt->Pin();
       } else {
+        std::optional<CesiumGltf::ImageCesium> downsampledImage;
+        if (downsampleFactor > 1) {
+          downsampledImage =
+              downsampleImage(*pImage, downsampleFactor, downsampleFilter);
+          pImage = &*downsampledImage;
+        }
+
         encodedProperty.pTexture = MakeShared<LoadedTextureResult>();
         // TODO: upgrade to new texture creation path.
         encodedProperty.pTexture->textureSource = LegacyTextureSource{};
-        propertyTexturePropertyMap.Emplace(pImage, encodedProperty.pTexture);
+        propertyTexturePropertyMap.Emplace(imageKey, encodedProperty.pTexture);
         // This assumes that the texture's image only contains one byte per
         // channel.
         encodedProperty.pTexture->pTextureData = createTexturePlatformData(
@@ -834,16 +1109,27 @@ EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
 
 EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
-    const FCesiumModelMetadata& metadata) {
+    const FCesiumModelMetadata& metadata,
+    const CesiumGltf::Model* pModel,
+    const TSharedPtr<CesiumEncodedPropertyTableCache>& pPropertyTableCache) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeModelMetadata)
 
   EncodedModelMetadata result;
 
+  // The property tables of the metadata are created from the property tables
+  // of the extension, in the same order.
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pMetadataExtension =
+      pModel && pPropertyTableCache
+          ? pModel->getExtension<
+                CesiumGltf::ExtensionModelExtStructuralMetadata>()
+          : nullptr;
+
   const TArray<FCesiumPropertyTable>& propertyTables =
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(metadata);
   result.propertyTables.Reserve(propertyTables.Num());
-  for (const auto& propertyTable : propertyTables) {
+  for (int32 i = 0; i < propertyTables.Num(); ++i) {
+    const FCesiumPropertyTable& propertyTable = propertyTables[i];
     const FString propertyTableName = getNameForPropertyTable(propertyTable);
 
     const FCesiumPropertyTableDescription* pExpectedPropertyTable =
@@ -856,11 +1142,32 @@ EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     if (pExpectedPropertyTable) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTable)
 
+      std::optional<uint64> key;
+      if (pMetadataExtension &&
+          size_t(i) < pMetadataExtension->propertyTables.size()) {
+        key = CesiumEncodedPropertyTableCache::computeKey(
+            *pExpectedPropertyTable,
+            *pModel,
+            *pMetadataExtension,
+            pMetadataExtension->propertyTables[size_t(i)]);
+      }
+
+      TSharedPtr<CesiumSharedPropertyTableTextures> pShared =
+          key ? pPropertyTableCache->find(*key) : nullptr;
+
       auto& encodedPropertyTable =
           result.propertyTables.Emplace_GetRef(encodePropertyTableAnyThreadPart(
               *pExpectedPropertyTable,
-              propertyTable));
+              propertyTable,
+              !pShared.IsValid()));
       encodedPropertyTable.name = propertyTableName;
+
+      if (key) {
+        if (!pShared) {
+          pShared = pPropertyTableCache->add(*key, encodedPropertyTable);
+        }
+        pPropertyTableCache->use(pShared, encodedPropertyTable);
+      }
     }
   }
 
@@ -868,7 +1175,7 @@ EncodedModelMetadata encodeModelMetadataAnyThreadPart(
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTextures(metadata);
   result.propertyTextures.Reserve(propertyTextures.Num());
 
-  TMap<const CesiumGltf::ImageCesium*, TWeakPtr<LoadedTextureResult>>
+  TMap<PropertyTextureImageKey, TWeakPtr<LoadedTextureResult>>
       propertyTexturePropertyMap;
   propertyTexturePropertyMap.Reserve(propertyTextures.Num());
 
@@ -955,6 +1262,13 @@ bool encodeModelMetadataGameThreadPart(EncodedModelMetadata& encodedMetadata) {
 
 void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata) {
   for (auto& propertyTable : encodedMetadata.propertyTables) {
+    if (propertyTable.pCache) {
+      // Shared textures are destroyed by the last tile that releases them.
+      TSharedPtr<CesiumEncodedPropertyTableCache> pCache = propertyTable.pCache;
+      pCache->release(propertyTable);
+      continue;
+    }
+
     for (EncodedPropertyTableProperty& encodedProperty :
          propertyTable.properties) {
       if (encodedProperty.pTexture &&
@@ -977,6 +1291,128 @@ void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata) {
   }
 }
 
+namespace {
+bool isAnyParameterReferenced(
+    const TSet<FString>& materialParameterNames,
+    const FString& name,
+    const TArray<FString>& suffixes) {
+  if (materialParameterNames.Contains(name)) {
+    return true;
+  }
+
+  for (const FString& suffix : suffixes) {
+    if (materialParameterNames.Contains(name + suffix)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Suffixes of the parameters that are set for every encoded property, on top
+// of the parameter with the property's own name.
+const TArray<FString>& getPropertyValueSuffixes() {
+  static const TArray<FString> suffixes{
+      MaterialPropertyOffsetSuffix,
+      MaterialPropertyScaleSuffix,
+      MaterialPropertyNoDataSuffix,
+      MaterialPropertyDefaultValueSuffix,
+      MaterialPropertyHasValueSuffix};
+  return suffixes;
+}
+} // namespace
+
+FCesiumFeaturesMetadataDescription filterFeaturesMetadataDescription(
+    const FCesiumFeaturesMetadataDescription& description,
+    const TSet<FString>& materialParameterNames) {
+  FCesiumFeaturesMetadataDescription result;
+
+  TArray<FString> propertyTableSuffixes = getPropertyValueSuffixes();
+  propertyTableSuffixes.Add(MaterialPropertyQuantizedScaleSuffix);
+  propertyTableSuffixes.Add(MaterialPropertyQuantizedOffsetSuffix);
+  propertyTableSuffixes.Add(MaterialPropertyChannelMaskSuffix);
+  TSet<FString> referencedPropertyTables;
+
+  for (const FCesiumPropertyTableDescription& propertyTable :
+       description.ModelMetadata.PropertyTables) {
+    FCesiumPropertyTableDescription filtered;
+    filtered.Name = propertyTable.Name;
+
+    for (const FCesiumPropertyTablePropertyDescription& property :
+         propertyTable.Properties) {
+      const FString fullPropertyName = getMaterialNameForPropertyTableProperty(
+          propertyTable.Name,
+          createHlslSafeName(property.Name));
+      if (isAnyParameterReferenced(
+              materialParameterNames,
+              fullPropertyName,
+              propertyTableSuffixes)) {
+        filtered.Properties.Add(property);
+      }
+    }
+
+    if (filtered.Properties.Num() > 0) {
+      referencedPropertyTables.Add(filtered.Name);
+      result.ModelMetadata.PropertyTables.Add(std::move(filtered));
+    }
+  }
+
+  TArray<FString> propertyTextureSuffixes = getPropertyValueSuffixes();
+  propertyTextureSuffixes.Add(MaterialChannelsSuffix);
+  propertyTextureSuffixes.Add(MaterialTexCoordIndexSuffix);
+
+  for (const FCesiumPropertyTextureDescription& propertyTexture :
+       description.ModelMetadata.PropertyTextures) {
+    FCesiumPropertyTextureDescription filtered;
+    filtered.Name = propertyTexture.Name;
+
+    for (const FCesiumPropertyTexturePropertyDescription& property :
+         propertyTexture.Properties) {
+      const FString fullPropertyName =
+          getMaterialNameForPropertyTextureProperty(
+              propertyTexture.Name,
+              createHlslSafeName(property.Name));
+      if (isAnyParameterReferenced(
+              materialParameterNames,
+              fullPropertyName,
+              propertyTextureSuffixes)) {
+        filtered.Properties.Add(property);
+      }
+    }
+
+    if (filtered.Properties.Num() > 0) {
+      if (description.PrimitiveMetadata.PropertyTextureNames.Contains(
+              filtered.Name)) {
+        result.PrimitiveMetadata.PropertyTextureNames.Add(filtered.Name);
+      }
+      result.ModelMetadata.PropertyTextures.Add(std::move(filtered));
+    }
+  }
+
+  static const TArray<FString> featureIdSetSuffixes{
+      MaterialTextureSuffix,
+      MaterialTexCoordIndexSuffix,
+      MaterialChannelsSuffix,
+      MaterialNumChannelsSuffix,
+      MaterialNullFeatureIdSuffix};
+
+  for (const FCesiumFeatureIdSetDescription& featureIdSet :
+       description.Features.FeatureIdSets) {
+    const bool isLinkedToReferencedTable =
+        !featureIdSet.PropertyTableName.IsEmpty() &&
+        referencedPropertyTables.Contains(featureIdSet.PropertyTableName);
+    if (isLinkedToReferencedTable ||
+        isAnyParameterReferenced(
+            materialParameterNames,
+            createHlslSafeName(featureIdSet.Name),
+            featureIdSetSuffixes)) {
+      result.Features.FeatureIdSets.Add(featureIdSet);
+    }
+  }
+
+  return result;
+}
+
 // The result should be a safe hlsl identifier, but any name clashes
 // after fixing safety will not be automatically handled.
 FString createHlslSafeName(const FString& rawName) {
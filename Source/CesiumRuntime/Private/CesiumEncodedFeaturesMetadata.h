@@ -7,9 +7,14 @@
 #include "CesiumTextureUtility.h"
 #include "Containers/Array.h"
 #include "Containers/Map.h"
+#include "Containers/Set.h"
 #include "Containers/UnrealString.h"
+#include "Templates/Tuple.h"
 #include "Templates/SharedPointer.h"
 #include "Templates/UniquePtr.h"
+#include <CesiumGltf/ImageCesium.h>
+#include <gsl/span>
+#include <optional>
 #include <variant>
 
 struct FCesiumFeatureIdSet;
@@ -25,6 +30,13 @@ struct FFeatureTextureDescription;
 struct FCesiumModelMetadataDescription;
 struct FCesiumPrimitiveFeaturesDescription;
 struct FCesiumPrimitiveMetadataDescription;
+struct FCesiumFeaturesMetadataDescription;
+class CesiumEncodedPropertyTableCache;
+struct CesiumSharedPropertyTableTextures;
+
+namespace CesiumGltf {
+struct Model;
+}
 
 /**
  * @brief Provides utility for encoding feature IDs from EXT_mesh_features and
@@ -91,6 +103,20 @@ static const FString MaterialPropertyNoDataSuffix = "_NO_DATA";
 static const FString MaterialPropertyDefaultValueSuffix = "_DEFAULT";
 static const FString MaterialPropertyHasValueSuffix = "_HAS_VALUE";
 
+/**
+ * Naming convention for the parameters of encoded property table properties:
+ * - Quantized Scale: "PTABLE_" + PropertyTableName + PropertyName +
+ * "_QUANTIZED_SCALE"
+ * - Quantized Offset: "PTABLE_" + PropertyTableName + PropertyName +
+ * "_QUANTIZED_OFFSET"
+ * - Channel Mask: "PTABLE_" + PropertyTableName + PropertyName +
+ * "_CHANNEL_MASK"
+ */
+static const FString MaterialPropertyQuantizedScaleSuffix = "_QUANTIZED_SCALE";
+static const FString MaterialPropertyQuantizedOffsetSuffix =
+    "_QUANTIZED_OFFSET";
+static const FString MaterialPropertyChannelMaskSuffix = "_CHANNEL_MASK";
+
 /**
  * Naming convention for material inputs (for use in custom functions):
  * - Property Data: PropertyName + "_DATA"
@@ -296,6 +322,47 @@ FString getMaterialNameForPropertyTextureProperty(
     const FString& propertyTableName,
     const FString& propertyName);
 
+/**
+ * @brief The transform that converts quantized integers back to the values
+ * they represent: value = quantized * scale + offset.
+ */
+struct QuantizationTransform {
+  double scale = 1.0;
+  double offset = 0.0;
+};
+
+/**
+ * @brief Quantizes floating-point values to 16-bit unsigned integers that are
+ * spread evenly between the smallest and largest finite value. Values that
+ * are not finite are quantized to the smallest value.
+ *
+ * The j-th component of the i-th value is read from values[i * stride + j]
+ * and written to quantized[i * stride + j], for j < componentCount. The other
+ * elements of quantized are set to zero.
+ *
+ * @returns The transform that converts the quantized integers back to values.
+ * The error of each value is at most half of its scale.
+ */
+QuantizationTransform quantizeTo16Bits(
+    gsl::span<const float> values,
+    gsl::span<uint16> quantized,
+    size_t componentCount,
+    size_t stride);
+
+/**
+ * @brief Downsamples an image with one byte per channel by dividing its width
+ * and height by the given factor, rounding up. Each texel of the result
+ * covers a block of factor x factor texels of the source image, or fewer at
+ * its right and bottom edges.
+ *
+ * Nearest keeps the texel at the center of each block. Average averages the
+ * bytes of each channel over the block, rounding to the nearest integer.
+ */
+CesiumGltf::ImageCesium downsampleImage(
+    const CesiumGltf::ImageCesium& image,
+    int32 factor,
+    ECesiumEncodedMetadataDownsampleFilter filter);
+
 /**
  * A property table property that has been encoded for access on the GPU.
  */
@@ -306,15 +373,28 @@ struct EncodedPropertyTableProperty {
   FString name;
 
   /**
-   * @brief The property table property values, encoded into a texture.
+   * @brief The property table property values, encoded into a texture. This
+   * is shared with other properties if the property is packed.
    */
-  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
+  TSharedPtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
 
   /**
    * @brief The type that the metadata will be encoded as.
    */
   ECesiumEncodedMetadataType type;
 
+  /**
+   * @brief The transform that converts the texels of a quantized property back
+   * to values. Only applicable if the property is quantized.
+   */
+  std::optional<QuantizationTransform> quantization;
+
+  /**
+   * @brief The channel of the shared texture that contains the values of the
+   * property. Only applicable if the property is packed.
+   */
+  std::optional<int32> packedChannel;
+
   /**
    * @brief The property table property's offset.
    */
@@ -350,6 +430,18 @@ struct EncodedPropertyTable {
    * @brief The encoded properties in this property table.
    */
   TArray<EncodedPropertyTableProperty> properties;
+
+  /**
+   * @brief The textures of this property table, if they are shared with the
+   * property tables of other tiles. Shared textures are released through
+   * pCache instead of being destroyed with the table.
+   */
+  TSharedPtr<CesiumSharedPropertyTableTextures> pSharedTextures;
+
+  /**
+   * @brief The cache that shares the textures of this property table, if any.
+   */
+  TSharedPtr<CesiumEncodedPropertyTableCache> pCache;
 };
 
 /**
@@ -445,15 +537,31 @@ struct EncodedModelMetadata {
   TArray<EncodedPropertyTexture> propertyTextures;
 };
 
+/**
+ * @brief Encodes the properties of a property table. If encodeTextures is
+ * false, the textures of the properties are left for the caller to set, e.g.
+ * from textures that are shared with other tiles.
+ */
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
     const FCesiumPropertyTableDescription& propertyTableDescription,
-    const FCesiumPropertyTable& propertyTable);
+    const FCesiumPropertyTable& propertyTable,
+    bool encodeTextures = true);
+
+/**
+ * @brief Identifies the texture of a property texture property by its image,
+ * downsample factor, and downsample filter. Properties with the same key share
+ * a texture.
+ */
+using PropertyTextureImageKey = TTuple<
+    const CesiumGltf::ImageCesium*,
+    int32,
+    ECesiumEncodedMetadataDownsampleFilter>;
 
 EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     const FCesiumPropertyTextureDescription& propertyTextureDescription,
     const FCesiumPropertyTexture& propertyTexture,
     TMap<
-        const CesiumGltf::ImageCesium*,
+        PropertyTextureImageKey,
         TWeakPtr<CesiumTextureUtility::LoadedTextureResult>>&
         propertyTexturePropertyMap);
 
@@ -462,9 +570,20 @@ EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
     const FCesiumPrimitiveMetadata& primitive,
     const FCesiumModelMetadata& modelMetadata);
 
+/**
+ * @brief Encodes the property tables and property textures of a model.
+ *
+ * @param pModel The glTF that the metadata was created from. Only needed to
+ * share property table textures.
+ * @param pPropertyTableCache If set, the textures of property tables are
+ * shared with the tiles whose property tables have the same contents.
+ */
 EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
-    const FCesiumModelMetadata& modelMetadata);
+    const FCesiumModelMetadata& modelMetadata,
+    const CesiumGltf::Model* pModel = nullptr,
+    const TSharedPtr<CesiumEncodedPropertyTableCache>& pPropertyTableCache =
+        nullptr);
 
 bool encodePropertyTableGameThreadPart(
     EncodedPropertyTable& encodedFeatureTable);
@@ -480,6 +599,29 @@ void destroyEncodedModelMetadata(EncodedModelMetadata& encodedMetadata);
 
 #pragma endregion
 
+#pragma region Material Parameters
+
+/**
+ * @brief Creates a copy of a features and metadata description that only
+ * contains the feature ID sets, property table properties, and property
+ * texture properties whose generated material parameters are referenced by a
+ * material. Property tables and property textures without any remaining
+ * properties are removed too.
+ *
+ * A feature ID set is also kept if it is linked to a property table that has
+ * referenced properties, because the feature IDs are needed to index into it.
+ *
+ * @param description The full description.
+ * @param materialParameterNames The names of all scalar, vector, and texture
+ * parameters of the materials and material layers that will be applied to the
+ * tiles.
+ */
+FCesiumFeaturesMetadataDescription filterFeaturesMetadataDescription(
+    const FCesiumFeaturesMetadataDescription& description,
+    const TSet<FString>& materialParameterNames);
+
+#pragma endregion
+
 FString createHlslSafeName(const FString& rawName);
 
 } // namespace CesiumEncodedFeaturesMetadata
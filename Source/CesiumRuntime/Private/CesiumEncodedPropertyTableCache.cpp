@@ -0,0 +1,295 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedPropertyTableCache.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "Hash/CityHash.h"
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <type_traits>
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Shared Property Tables Reused"),
+    STAT_CesiumSharedPropertyTablesReused,
+    STATGROUP_Cesium);
+
+using namespace CesiumEncodedFeaturesMetadata;
+using namespace CesiumGltf;
+
+namespace {
+
+uint64 hashBytes(uint64 hash, const void* pData, size_t size) {
+  return CityHash64WithSeed(
+      static_cast<const char*>(pData),
+      uint32(size),
+      hash);
+}
+
+template <typename T> uint64 hashValue(uint64 hash, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  return hashBytes(hash, &value, sizeof(T));
+}
+
+uint64 hashString(uint64 hash, const std::string& value) {
+  hash = hashValue(hash, value.size());
+  return hashBytes(hash, value.data(), value.size());
+}
+
+uint64 hashString(uint64 hash, const std::optional<std::string>& value) {
+  return value ? hashString(hashValue(hash, true), *value)
+               : hashValue(hash, false);
+}
+
+uint64 hashString(uint64 hash, const FString& value) {
+  hash = hashValue(hash, value.Len());
+  return hashBytes(hash, *value, value.Len() * sizeof(TCHAR));
+}
+
+// Hashes the bytes of a buffer view, or returns false if it's out of bounds.
+// A negative index hashes as a missing buffer view.
+bool hashBufferView(uint64& hash, const Model& model, int32 bufferViewIndex) {
+  if (bufferViewIndex < 0) {
+    hash = hashValue(hash, int64(-1));
+    return true;
+  }
+
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, bufferViewIndex);
+  if (!pBufferView) {
+    return false;
+  }
+
+  const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer || pBufferView->byteOffset < 0 ||
+      pBufferView->byteLength < 0 || pBufferView->byteLength > MAX_uint32 ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          int64(pBuffer->cesium.data.size())) {
+    return false;
+  }
+
+  hash = hashValue(hash, pBufferView->byteLength);
+  hash = hashBytes(
+      hash,
+      pBuffer->cesium.data.data() + pBufferView->byteOffset,
+      size_t(pBufferView->byteLength));
+  return true;
+}
+
+void destroyTextures(CesiumSharedPropertyTableTextures& shared) {
+  for (EncodedPropertyTableProperty& property : shared.properties) {
+    // Packed properties share a texture, which is destroyed once.
+    if (property.pTexture && property.pTexture->pTexture.IsValid()) {
+      CesiumLifetime::destroy(property.pTexture->pTexture.Get());
+      property.pTexture->pTexture.Reset();
+    }
+  }
+}
+
+} // namespace
+
+/*static*/ std::optional<uint64> CesiumEncodedPropertyTableCache::computeKey(
+    const FCesiumPropertyTableDescription& propertyTableDescription,
+    const Model& model,
+    const ExtensionModelExtStructuralMetadata& metadata,
+    const PropertyTable& propertyTable) {
+  if (!metadata.schema) {
+    return std::nullopt;
+  }
+
+  const auto classIt =
+      metadata.schema->classes.find(propertyTable.classProperty);
+  if (classIt == metadata.schema->classes.end()) {
+    return std::nullopt;
+  }
+
+  uint64 hash = hashString(0, propertyTable.classProperty);
+  hash = hashValue(hash, propertyTable.count);
+
+  // Only the properties that the description encodes are hashed, in the order
+  // of the description, because the order of the glTF properties isn't
+  // stable.
+  for (const FCesiumPropertyTablePropertyDescription& description :
+       propertyTableDescription.Properties) {
+    const FCesiumMetadataPropertyDetails& details = description.PropertyDetails;
+    const FCesiumMetadataEncodingDetails& encoding =
+        description.EncodingDetails;
+    if (encoding.Conversion == ECesiumEncodedMetadataConversion::None) {
+      continue;
+    }
+
+    hash = hashString(hash, description.Name);
+    hash = hashValue(hash, details.Type);
+    hash = hashValue(hash, details.ComponentType);
+    hash = hashValue(hash, details.bIsArray);
+    hash = hashValue(hash, details.ArraySize);
+    hash = hashValue(hash, details.bIsNormalized);
+    hash = hashValue(hash, encoding.Type);
+    hash = hashValue(hash, encoding.ComponentType);
+    hash = hashValue(hash, encoding.Conversion);
+    hash = hashValue(hash, encoding.bQuantize);
+    hash = hashValue(hash, encoding.bPack);
+
+    const std::string name = TCHAR_TO_UTF8(*description.Name);
+
+    const auto classPropertyIt = classIt->second.properties.find(name);
+    if (classPropertyIt == classIt->second.properties.end()) {
+      hash = hashValue(hash, false);
+    } else {
+      const ClassProperty& classProperty = classPropertyIt->second;
+      hash = hashValue(hash, true);
+      hash = hashString(hash, classProperty.type);
+      hash = hashString(hash, classProperty.componentType);
+      hash = hashString(hash, classProperty.enumType);
+      hash = hashValue(hash, classProperty.array);
+      hash = hashValue(hash, classProperty.count.value_or(-1));
+      hash = hashValue(hash, classProperty.normalized);
+    }
+
+    const auto propertyIt = propertyTable.properties.find(name);
+    if (propertyIt == propertyTable.properties.end()) {
+      hash = hashValue(hash, false);
+      continue;
+    }
+
+    const PropertyTableProperty& property = propertyIt->second;
+    hash = hashValue(hash, true);
+    hash = hashString(hash, property.arrayOffsetType);
+    hash = hashString(hash, property.stringOffsetType);
+    if (!hashBufferView(hash, model, property.values) ||
+        !hashBufferView(hash, model, property.arrayOffsets) ||
+        !hashBufferView(hash, model, property.stringOffsets)) {
+      return std::nullopt;
+    }
+  }
+
+  return hash;
+}
+
+TSharedPtr<CesiumSharedPropertyTableTextures>
+CesiumEncodedPropertyTableCache::find(uint64 key) {
+  std::scoped_lock lock(this->_mutex);
+
+  const TWeakPtr<CesiumSharedPropertyTableTextures>* ppShared =
+      this->_tables.Find(key);
+  if (!ppShared) {
+    return nullptr;
+  }
+
+  TSharedPtr<CesiumSharedPropertyTableTextures> pShared = ppShared->Pin();
+  if (!pShared) {
+    // The tiles that used the textures were freed before they were released
+    // through this cache, for example because their loads were canceled.
+    this->_tables.Remove(key);
+    return nullptr;
+  }
+
+  INC_DWORD_STAT(STAT_CesiumSharedPropertyTablesReused);
+  return pShared;
+}
+
+TSharedPtr<CesiumSharedPropertyTableTextures>
+CesiumEncodedPropertyTableCache::add(
+    uint64 key,
+    const EncodedPropertyTable& encodedPropertyTable) {
+  std::scoped_lock lock(this->_mutex);
+
+  TWeakPtr<CesiumSharedPropertyTableTextures>& pWeakShared =
+      this->_tables.FindOrAdd(key);
+  TSharedPtr<CesiumSharedPropertyTableTextures> pShared = pWeakShared.Pin();
+  if (pShared) {
+    return pShared;
+  }
+
+  pShared = MakeShared<CesiumSharedPropertyTableTextures>();
+  pShared->key = key;
+  pShared->properties.Reserve(encodedPropertyTable.properties.Num());
+  for (const EncodedPropertyTableProperty& property :
+       encodedPropertyTable.properties) {
+    EncodedPropertyTableProperty& sharedProperty =
+        pShared->properties.Emplace_GetRef();
+    sharedProperty.name = property.name;
+    sharedProperty.type = property.type;
+    sharedProperty.pTexture = property.pTexture;
+    sharedProperty.quantization = property.quantization;
+    sharedProperty.packedChannel = property.packedChannel;
+  }
+
+  pWeakShared = pShared;
+  return pShared;
+}
+
+void CesiumEncodedPropertyTableCache::use(
+    const TSharedPtr<CesiumSharedPropertyTableTextures>& pShared,
+    EncodedPropertyTable& encodedPropertyTable) {
+  if (!pShared) {
+    return;
+  }
+
+  for (EncodedPropertyTableProperty& property :
+       encodedPropertyTable.properties) {
+    const EncodedPropertyTableProperty* pSharedProperty =
+        pShared->properties.FindByPredicate(
+            [&name = property.name](
+                const EncodedPropertyTableProperty& sharedProperty) {
+              return sharedProperty.name == name;
+            });
+    if (pSharedProperty) {
+      property.pTexture = pSharedProperty->pTexture;
+      property.quantization = pSharedProperty->quantization;
+      property.packedChannel = pSharedProperty->packedChannel;
+    } else {
+      property.pTexture.Reset();
+      property.quantization.reset();
+      property.packedChannel.reset();
+    }
+  }
+
+  encodedPropertyTable.pSharedTextures = pShared;
+  encodedPropertyTable.pCache = this->AsShared();
+}
+
+void CesiumEncodedPropertyTableCache::release(
+    EncodedPropertyTable& encodedPropertyTable) {
+  check(IsInGameThread());
+
+  for (EncodedPropertyTableProperty& property :
+       encodedPropertyTable.properties) {
+    property.pTexture.Reset();
+  }
+
+  TSharedPtr<CesiumSharedPropertyTableTextures> pShared =
+      MoveTemp(encodedPropertyTable.pSharedTextures);
+  encodedPropertyTable.pCache.Reset();
+  if (!pShared) {
+    return;
+  }
+
+  // The last tile that uses the textures destroys them. The lock keeps load
+  // threads from finding the textures in the meantime.
+  std::scoped_lock lock(this->_mutex);
+  if (pShared.GetSharedReferenceCount() > 1) {
+    return;
+  }
+
+  const TWeakPtr<CesiumSharedPropertyTableTextures>* ppShared =
+      this->_tables.Find(pShared->key);
+  if (ppShared && ppShared->HasSameObject(pShared.Get())) {
+    this->_tables.Remove(pShared->key);
+  }
+
+  destroyTextures(*pShared);
+}
+
+int32 CesiumEncodedPropertyTableCache::getCount() {
+  std::scoped_lock lock(this->_mutex);
+
+  int32 count = 0;
+  for (const auto& pair : this->_tables) {
+    if (pair.Value.IsValid()) {
+      ++count;
+    }
+  }
+  return count;
+}
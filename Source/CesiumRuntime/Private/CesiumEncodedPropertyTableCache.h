@@ -0,0 +1,106 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "Containers/Map.h"
+#include "Templates/SharedPointer.h"
+#include <mutex>
+#include <optional>
+
+struct FCesiumPropertyTableDescription;
+
+namespace CesiumGltf {
+struct ExtensionModelExtStructuralMetadata;
+struct Model;
+struct PropertyTable;
+} // namespace CesiumGltf
+
+/**
+ * The textures of an encoded property table, which are shared by every tile
+ * whose property table has the same contents.
+ */
+struct CesiumSharedPropertyTableTextures {
+  /** The key of the property table in its cache. */
+  uint64 key = 0;
+
+  /**
+   * The encoded properties of the table. Only their names, types, textures,
+   * quantization, and packed channels are set, because the other values may
+   * refer to the glTF of the tile that encoded the table.
+   */
+  TArray<CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty>
+      properties;
+};
+
+/**
+ * Shares the encoded textures of property tables between the tiles of a
+ * tileset. Tiles of implicit tilesets and tilesets with external schemas often
+ * have property tables with the same class and contents, which then only need
+ * to be encoded and uploaded once.
+ *
+ * Property tables are identified by a hash of their contents and of how they
+ * are encoded. The cache only keeps weak pointers to the textures, so that
+ * they are released once no tile uses them anymore.
+ *
+ * All functions except release may be called from any thread.
+ */
+class CesiumEncodedPropertyTableCache
+    : public TSharedFromThis<CesiumEncodedPropertyTableCache> {
+public:
+  /**
+   * Computes the key of a property table, which is a hash of the class
+   * properties, buffer views, and encoding details of the properties that the
+   * description encodes.
+   *
+   * @return The key, or std::nullopt if the property table can't be shared
+   * because it has no class or refers to invalid buffer views.
+   */
+  static std::optional<uint64> computeKey(
+      const FCesiumPropertyTableDescription& propertyTableDescription,
+      const CesiumGltf::Model& model,
+      const CesiumGltf::ExtensionModelExtStructuralMetadata& metadata,
+      const CesiumGltf::PropertyTable& propertyTable);
+
+  /**
+   * Finds the textures of a property table with the given key that another
+   * tile has encoded and that are still in use.
+   */
+  TSharedPtr<CesiumSharedPropertyTableTextures> find(uint64 key);
+
+  /**
+   * Adds the textures of a newly encoded property table. If another thread
+   * added textures with the same key in the meantime, those are returned
+   * instead, and the table must use them.
+   */
+  TSharedPtr<CesiumSharedPropertyTableTextures> add(
+      uint64 key,
+      const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+          encodedPropertyTable);
+
+  /**
+   * Makes an encoded property table use shared textures, which replace the
+   * textures that it encoded itself, if any. The textures are then released
+   * through this cache.
+   */
+  void use(
+      const TSharedPtr<CesiumSharedPropertyTableTextures>& pShared,
+      CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+          encodedPropertyTable);
+
+  /**
+   * Releases the shared textures of an encoded property table, and destroys
+   * them if no other tile uses them. Must be called from the game thread.
+   */
+  void release(CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                   encodedPropertyTable);
+
+  /**
+   * Gets the number of property tables whose textures are in use.
+   */
+  int32 getCount();
+
+private:
+  std::mutex _mutex;
+  TMap<uint64, TWeakPtr<CesiumSharedPropertyTableTextures>> _tables;
+};
@@ -0,0 +1,113 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStyleBuffer.h"
+#include "Math/UnrealMathUtility.h"
+
+const FColor CesiumFeatureStyleBuffer::DefaultColor(255, 255, 255, 255);
+const FColor CesiumFeatureStyleBuffer::DefaultEmissive(0, 0, 0, 255);
+
+namespace {
+int32 computeHeight(int64 featureCount) {
+  const int64 rows = FMath::DivideAndRoundUp(
+      FMath::Max(featureCount, int64(1)),
+      int64(CesiumFeatureStyleBuffer::Width));
+  // Heights are rounded up to a power of two, so that styling features one at
+  // a time doesn't create the textures again for every new row.
+  return int32(FMath::RoundUpToPowerOfTwo64(
+      FMath::Min(rows, int64(CesiumFeatureStyleBuffer::MaxHeight))));
+}
+} // namespace
+
+CesiumFeatureStyleBuffer::CesiumFeatureStyleBuffer(int64 featureCount)
+    : _height(0),
+      _colors(),
+      _emissives(),
+      _resized(false),
+      _firstChangedRow(MAX_int32),
+      _lastChangedRow(-1) {
+  this->_resize(computeHeight(featureCount));
+}
+
+void CesiumFeatureStyleBuffer::setVisibility(int64 featureID, bool visible) {
+  const int32 texel = this->_prepareTexel(featureID);
+  if (texel != INDEX_NONE) {
+    this->_colors[texel].A = visible ? 255 : 0;
+  }
+}
+
+void CesiumFeatureStyleBuffer::setColor(
+    int64 featureID,
+    const FLinearColor& color) {
+  const int32 texel = this->_prepareTexel(featureID);
+  if (texel != INDEX_NONE) {
+    const uint8 alpha = this->_colors[texel].A;
+    this->_colors[texel] = color.ToFColor(true);
+    this->_colors[texel].A = alpha;
+  }
+}
+
+void CesiumFeatureStyleBuffer::setEmissive(
+    int64 featureID,
+    const FLinearColor& emissive) {
+  const int32 texel = this->_prepareTexel(featureID);
+  if (texel != INDEX_NONE) {
+    this->_emissives[texel] = emissive.ToFColor(true);
+    this->_emissives[texel].A = DefaultEmissive.A;
+  }
+}
+
+void CesiumFeatureStyleBuffer::resetFeature(int64 featureID) {
+  const int32 texel = this->_prepareTexel(featureID);
+  if (texel != INDEX_NONE) {
+    this->_colors[texel] = DefaultColor;
+    this->_emissives[texel] = DefaultEmissive;
+  }
+}
+
+void CesiumFeatureStyleBuffer::resetAll() {
+  for (FColor& color : this->_colors) {
+    color = DefaultColor;
+  }
+  for (FColor& emissive : this->_emissives) {
+    emissive = DefaultEmissive;
+  }
+  this->_firstChangedRow = 0;
+  this->_lastChangedRow = this->_height - 1;
+}
+
+void CesiumFeatureStyleBuffer::clearChanges() {
+  this->_resized = false;
+  this->_firstChangedRow = MAX_int32;
+  this->_lastChangedRow = -1;
+}
+
+int32 CesiumFeatureStyleBuffer::_prepareTexel(int64 featureID) {
+  if (featureID < 0 || featureID >= int64(Width) * MaxHeight) {
+    return INDEX_NONE;
+  }
+
+  const int32 row = int32(featureID / Width);
+  if (row >= this->_height) {
+    this->_resize(computeHeight(featureID + 1));
+  }
+
+  this->_firstChangedRow = FMath::Min(this->_firstChangedRow, row);
+  this->_lastChangedRow = FMath::Max(this->_lastChangedRow, row);
+  return int32(featureID);
+}
+
+void CesiumFeatureStyleBuffer::_resize(int32 height) {
+  const int32 previousCount = this->_colors.Num();
+  const int32 texelCount = Width * height;
+  this->_colors.SetNumUninitialized(texelCount);
+  this->_emissives.SetNumUninitialized(texelCount);
+  for (int32 i = previousCount; i < texelCount; ++i) {
+    this->_colors[i] = DefaultColor;
+    this->_emissives[i] = DefaultEmissive;
+  }
+
+  this->_height = height;
+  this->_resized = true;
+  this->_firstChangedRow = 0;
+  this->_lastChangedRow = height - 1;
+}
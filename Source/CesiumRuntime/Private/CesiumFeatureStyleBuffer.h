@@ -0,0 +1,106 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Color.h"
+
+/**
+ * The CPU side of the styles of the features of one property table, which
+ * are uploaded to two textures indexed by feature ID.
+ *
+ * The texel of feature ID N is at (N % Width, N / Width) in both textures. The
+ * color texture holds the sRGB color that the feature is tinted with, and its
+ * alpha is 255 if the feature is visible and 0 if it's hidden. The emissive
+ * texture holds the sRGB emissive color that is added to the feature, and its
+ * alpha is unused.
+ *
+ * Changes are tracked by row, so that only the rows that changed since the
+ * last upload need to be copied to the textures.
+ */
+class CesiumFeatureStyleBuffer {
+public:
+  /** The width of the textures, in texels. */
+  static constexpr int32 Width = 1024;
+
+  /**
+   * The largest height of the textures, in texels. Feature IDs that don't fit
+   * are ignored.
+   */
+  static constexpr int32 MaxHeight = 16384;
+
+  /** The style texel of a feature that hasn't been styled. */
+  static const FColor DefaultColor;
+
+  /** The emissive texel of a feature that hasn't been styled. */
+  static const FColor DefaultEmissive;
+
+  /**
+   * Creates a buffer with room for the given number of features. The buffer
+   * grows when a larger feature ID is styled.
+   */
+  explicit CesiumFeatureStyleBuffer(int64 featureCount = 0);
+
+  /** Gets the height of the textures, in texels. */
+  int32 getHeight() const { return this->_height; }
+
+  /** Gets the texels of the color texture, row by row. */
+  const TArray<FColor>& getColors() const { return this->_colors; }
+
+  /** Gets the texels of the emissive texture, row by row. */
+  const TArray<FColor>& getEmissives() const { return this->_emissives; }
+
+  /** Shows or hides a feature. */
+  void setVisibility(int64 featureID, bool visible);
+
+  /** Sets the color that a feature is tinted with. */
+  void setColor(int64 featureID, const FLinearColor& color);
+
+  /** Sets the emissive color that is added to a feature. */
+  void setEmissive(int64 featureID, const FLinearColor& emissive);
+
+  /** Resets the style of a feature to the default style. */
+  void resetFeature(int64 featureID);
+
+  /** Resets the style of every feature to the default style. */
+  void resetAll();
+
+  /**
+   * Whether the height of the buffer changed since the last call to
+   * clearChanges, in which case the textures must be created again.
+   */
+  bool wasResized() const { return this->_resized; }
+
+  /** Whether any texel changed since the last call to clearChanges. */
+  bool hasChanges() const {
+    return this->_firstChangedRow <= this->_lastChangedRow;
+  }
+
+  /** Gets the first row that changed since the last call to clearChanges. */
+  int32 getFirstChangedRow() const { return this->_firstChangedRow; }
+
+  /** Gets the last row that changed since the last call to clearChanges. */
+  int32 getLastChangedRow() const { return this->_lastChangedRow; }
+
+  /** Forgets the changes, once they have been uploaded. */
+  void clearChanges();
+
+private:
+  /**
+   * Grows the buffer so that it contains the given feature and marks its row
+   * as changed.
+   *
+   * @return The index of the feature's texel, or INDEX_NONE if the feature ID
+   * is negative or too large.
+   */
+  int32 _prepareTexel(int64 featureID);
+
+  void _resize(int32 height);
+
+  int32 _height;
+  TArray<FColor> _colors;
+  TArray<FColor> _emissives;
+  bool _resized;
+  int32 _firstChangedRow;
+  int32 _lastChangedRow;
+};
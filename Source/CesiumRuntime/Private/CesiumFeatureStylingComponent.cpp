@@ -0,0 +1,369 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStylingComponent.h"
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumFeatureIdSet.h"
+#include "CesiumFeatureStyleBuffer.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMaterialUserData.h"
+#include "CesiumModelMetadata.h"
+#include "CesiumPrimitiveFeatures.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumTextureUtility.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/Package.h"
+
+namespace {
+
+const FString StyleParameterPrefix = "FSTYLE_";
+const FString StyleColorSuffix = "_COLOR";
+const FString StyleEmissiveSuffix = "_EMISSIVE";
+const FString StyleWidthSuffix = "_WIDTH";
+const FString StyleHeightSuffix = "_HEIGHT";
+
+constexpr int32 BytesPerTexel = int32(sizeof(FColor));
+
+UTexture2D* createStyleTexture(
+    const TArray<FColor>& texels,
+    int32 height,
+    const TCHAR* name) {
+  const int32 width = CesiumFeatureStyleBuffer::Width;
+
+  TUniquePtr<FTexturePlatformData> pTextureData =
+      CesiumTextureUtility::createTexturePlatformData(
+          width,
+          height,
+          PF_B8G8R8A8);
+
+  FTexture2DMipMap* pMip = new FTexture2DMipMap();
+  pTextureData->Mips.Add(pMip);
+  pMip->SizeX = width;
+  pMip->SizeY = height;
+
+  const int64 bytes = int64(width) * height * BytesPerTexel;
+  pMip->BulkData.Lock(LOCK_READ_WRITE);
+  void* pDest = pMip->BulkData.Realloc(bytes);
+  FMemory::Memcpy(pDest, texels.GetData(), bytes);
+  pMip->BulkData.Unlock();
+
+  UTexture2D* pTexture = NewObject<UTexture2D>(
+      GetTransientPackage(),
+      MakeUniqueObjectName(
+          GetTransientPackage(),
+          UTexture2D::StaticClass(),
+          name),
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+
+  pTexture->SetPlatformData(pTextureData.Release());
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  // Neighboring texels belong to unrelated features, so they must never be
+  // blended.
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->LODGroup = TextureGroup::TEXTUREGROUP_Pixels2D;
+  pTexture->SRGB = true;
+  pTexture->NeverStream = true;
+  pTexture->UpdateResource();
+
+  return pTexture;
+}
+
+void updateStyleTextureRows(
+    UTexture2D* pTexture,
+    const TArray<FColor>& texels,
+    int32 firstRow,
+    int32 lastRow) {
+  const int32 width = CesiumFeatureStyleBuffer::Width;
+  const int32 rowCount = lastRow - firstRow + 1;
+
+  // The region and texels must live until the render thread has copied them.
+  FUpdateTextureRegion2D* pRegion = new FUpdateTextureRegion2D(
+      0,
+      uint32(firstRow),
+      0,
+      0,
+      uint32(width),
+      uint32(rowCount));
+  TArray<FColor>* pTexels =
+      new TArray<FColor>(texels.GetData() + firstRow * width, rowCount * width);
+
+  pTexture->UpdateTextureRegions(
+      0,
+      1,
+      pRegion,
+      uint32(width * BytesPerTexel),
+      uint32(BytesPerTexel),
+      reinterpret_cast<uint8*>(pTexels->GetData()),
+      [pTexels](uint8*, const FUpdateTextureRegion2D* pRegion) {
+        delete pTexels;
+        delete pRegion;
+      });
+}
+
+} // namespace
+
+UCesiumFeatureStylingComponent::UCesiumFeatureStylingComponent() {
+  this->PrimaryComponentTick.bCanEverTick = true;
+  this->bTickInEditor = true;
+}
+
+void UCesiumFeatureStylingComponent::SetFeatureVisibility(
+    const FString& PropertyTableName,
+    int64 FeatureID,
+    bool Visible) {
+  this->_getBuffer(PropertyTableName).setVisibility(FeatureID, Visible);
+}
+
+void UCesiumFeatureStylingComponent::SetFeaturesVisibility(
+    const FString& PropertyTableName,
+    const TArray<int64>& FeatureIDs,
+    bool Visible) {
+  CesiumFeatureStyleBuffer& buffer = this->_getBuffer(PropertyTableName);
+  for (int64 featureID : FeatureIDs) {
+    buffer.setVisibility(featureID, Visible);
+  }
+}
+
+void UCesiumFeatureStylingComponent::SetFeatureColor(
+    const FString& PropertyTableName,
+    int64 FeatureID,
+    const FLinearColor& Color) {
+  this->_getBuffer(PropertyTableName).setColor(FeatureID, Color);
+}
+
+void UCesiumFeatureStylingComponent::SetFeaturesColor(
+    const FString& PropertyTableName,
+    const TArray<int64>& FeatureIDs,
+    const FLinearColor& Color) {
+  CesiumFeatureStyleBuffer& buffer = this->_getBuffer(PropertyTableName);
+  for (int64 featureID : FeatureIDs) {
+    buffer.setColor(featureID, Color);
+  }
+}
+
+void UCesiumFeatureStylingComponent::SetFeatureEmissive(
+    const FString& PropertyTableName,
+    int64 FeatureID,
+    const FLinearColor& Emissive) {
+  this->_getBuffer(PropertyTableName).setEmissive(FeatureID, Emissive);
+}
+
+void UCesiumFeatureStylingComponent::SetFeaturesEmissive(
+    const FString& PropertyTableName,
+    const TArray<int64>& FeatureIDs,
+    const FLinearColor& Emissive) {
+  CesiumFeatureStyleBuffer& buffer = this->_getBuffer(PropertyTableName);
+  for (int64 featureID : FeatureIDs) {
+    buffer.setEmissive(featureID, Emissive);
+  }
+}
+
+void UCesiumFeatureStylingComponent::ResetFeatureStyle(
+    const FString& PropertyTableName,
+    int64 FeatureID) {
+  this->_getBuffer(PropertyTableName).resetFeature(FeatureID);
+}
+
+void UCesiumFeatureStylingComponent::ResetAllFeatureStyles(
+    const FString& PropertyTableName) {
+  TSharedPtr<CesiumFeatureStyleBuffer>* ppBuffer =
+      this->_buffers.Find(PropertyTableName);
+  if (ppBuffer) {
+    (*ppBuffer)->resetAll();
+  }
+}
+
+void UCesiumFeatureStylingComponent::UpdateStyleTextures() {
+  for (auto& bufferIt : this->_buffers) {
+    const FString& propertyTableName = bufferIt.Key;
+    CesiumFeatureStyleBuffer& buffer = *bufferIt.Value;
+    if (!buffer.hasChanges()) {
+      continue;
+    }
+
+    UTexture2D** ppColorTexture =
+        this->_colorTextures.Find(propertyTableName);
+    UTexture2D** ppEmissiveTexture =
+        this->_emissiveTextures.Find(propertyTableName);
+
+    if (ppColorTexture && ppEmissiveTexture && !buffer.wasResized()) {
+      updateStyleTextureRows(
+          *ppColorTexture,
+          buffer.getColors(),
+          buffer.getFirstChangedRow(),
+          buffer.getLastChangedRow());
+      updateStyleTextureRows(
+          *ppEmissiveTexture,
+          buffer.getEmissives(),
+          buffer.getFirstChangedRow(),
+          buffer.getLastChangedRow());
+      buffer.clearChanges();
+      continue;
+    }
+
+    // The textures are created for the first time or with a new size, so
+    // they must be bound to the materials of the tiles again. The previous
+    // textures are collected once no material refers to them.
+    this->_colorTextures.Add(
+        propertyTableName,
+        createStyleTexture(
+            buffer.getColors(),
+            buffer.getHeight(),
+            TEXT("CesiumFeatureStyleColor")));
+    this->_emissiveTextures.Add(
+        propertyTableName,
+        createStyleTexture(
+            buffer.getEmissives(),
+            buffer.getHeight(),
+            TEXT("CesiumFeatureStyleEmissive")));
+    buffer.clearChanges();
+
+    AActor* pOwner = this->GetOwner();
+    if (pOwner) {
+      TInlineComponentArray<UCesiumGltfPrimitiveComponent*> primitives(pOwner);
+      for (UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+        this->_bindStyleTextures(*pPrimitive, &propertyTableName);
+      }
+    }
+  }
+}
+
+void UCesiumFeatureStylingComponent::BindStyleTextures(
+    UCesiumGltfPrimitiveComponent& Primitive) {
+  if (this->_colorTextures.Num() > 0) {
+    this->_bindStyleTextures(Primitive, nullptr);
+  }
+}
+
+void UCesiumFeatureStylingComponent::TickComponent(
+    float DeltaTime,
+    ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+  this->UpdateStyleTextures();
+}
+
+void UCesiumFeatureStylingComponent::OnUnregister() {
+  Super::OnUnregister();
+
+  // Tiles that are loaded later must not sample the styles anymore, but the
+  // tiles that are already loaded keep them until they are unloaded.
+  this->_buffers.Empty();
+  this->_colorTextures.Empty();
+  this->_emissiveTextures.Empty();
+}
+
+CesiumFeatureStyleBuffer& UCesiumFeatureStylingComponent::_getBuffer(
+    const FString& propertyTableName) {
+  TSharedPtr<CesiumFeatureStyleBuffer>& pBuffer =
+      this->_buffers.FindOrAdd(propertyTableName);
+  if (!pBuffer) {
+    pBuffer = MakeShared<CesiumFeatureStyleBuffer>();
+  }
+  return *pBuffer;
+}
+
+void UCesiumFeatureStylingComponent::_bindStyleTextures(
+    UCesiumGltfPrimitiveComponent& primitive,
+    const FString* pOnlyPropertyTableName) {
+  UMaterialInstanceDynamic* pMaterial =
+      Cast<UMaterialInstanceDynamic>(primitive.GetMaterial(0));
+  if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
+    return;
+  }
+
+  const UCesiumGltfComponent* pGltf =
+      Cast<UCesiumGltfComponent>(primitive.GetOuter());
+  if (!IsValid(pGltf)) {
+    return;
+  }
+
+  UMaterialInstance* pBaseAsMaterialInstance =
+      Cast<UMaterialInstance>(pMaterial->Parent);
+  UCesiumMaterialUserData* pCesiumData =
+      pBaseAsMaterialInstance
+          ? pBaseAsMaterialInstance->GetAssetUserData<UCesiumMaterialUserData>()
+          : nullptr;
+  const int32 featuresMetadataIndex =
+      pCesiumData ? pCesiumData->LayerNames.Find("FeaturesMetadata")
+                  : INDEX_NONE;
+
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(pGltf->Metadata);
+  const TArray<FCesiumFeatureIdSet>& featureIDSets =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
+          primitive.Features);
+  for (const FCesiumFeatureIdSet& featureIDSet : featureIDSets) {
+    const int64 propertyTableIndex =
+        UCesiumFeatureIdSetBlueprintLibrary::GetPropertyTableIndex(
+            featureIDSet);
+    if (propertyTableIndex < 0 ||
+        propertyTableIndex >= propertyTables.Num()) {
+      continue;
+    }
+
+    const FString propertyTableName =
+        CesiumEncodedFeaturesMetadata::getNameForPropertyTable(
+            propertyTables[propertyTableIndex]);
+    if ((pOnlyPropertyTableName &&
+         propertyTableName != *pOnlyPropertyTableName) ||
+        !this->_colorTextures.Contains(propertyTableName)) {
+      continue;
+    }
+
+    this->_setStyleParameters(
+        *pMaterial,
+        featuresMetadataIndex,
+        propertyTableName);
+  }
+}
+
+void UCesiumFeatureStylingComponent::_setStyleParameters(
+    UMaterialInstanceDynamic& material,
+    int32 featuresMetadataLayerIndex,
+    const FString& propertyTableName) {
+  const FString prefix =
+      StyleParameterPrefix +
+      CesiumEncodedFeaturesMetadata::createHlslSafeName(propertyTableName);
+  UTexture2D* pColorTexture = this->_colorTextures[propertyTableName];
+  UTexture2D* pEmissiveTexture = this->_emissiveTextures[propertyTableName];
+  const float width = float(CesiumFeatureStyleBuffer::Width);
+  const float height = float(pColorTexture->GetSizeY());
+
+  auto setParameters = [&](EMaterialParameterAssociation association,
+                           int32 index) {
+    material.SetTextureParameterValueByInfo(
+        FMaterialParameterInfo(
+            FName(prefix + StyleColorSuffix),
+            association,
+            index),
+        pColorTexture);
+    material.SetTextureParameterValueByInfo(
+        FMaterialParameterInfo(
+            FName(prefix + StyleEmissiveSuffix),
+            association,
+            index),
+        pEmissiveTexture);
+    material.SetScalarParameterValueByInfo(
+        FMaterialParameterInfo(
+            FName(prefix + StyleWidthSuffix),
+            association,
+            index),
+        width);
+    material.SetScalarParameterValueByInfo(
+        FMaterialParameterInfo(
+            FName(prefix + StyleHeightSuffix),
+            association,
+            index),
+        height);
+  };
+
+  setParameters(EMaterialParameterAssociation::GlobalParameter, INDEX_NONE);
+  if (featuresMetadataLayerIndex != INDEX_NONE) {
+    setParameters(
+        EMaterialParameterAssociation::LayerParameter,
+        featuresMetadataLayerIndex);
+  }
+}
@@ -1761,6 +1761,65 @@ void GenerateNodesForPropertyTable(
     PropertyInput.InputName = FName(PropertyDataName);
     PropertyInput.Input.Expression = PropertyData;
 
+    // Quantized properties are converted back to floats with a scale and
+    // offset that are set for each tile.
+    FString QuantizedScaleName;
+    FString QuantizedOffsetName;
+    if (Property.EncodingDetails.IsQuantized()) {
+      QuantizedScaleName = PropertyName + MaterialPropertyQuantizedScaleSuffix;
+      QuantizedOffsetName =
+          PropertyName + MaterialPropertyQuantizedOffsetSuffix;
+
+      for (const FString& Suffix :
+           {MaterialPropertyQuantizedScaleSuffix,
+            MaterialPropertyQuantizedOffsetSuffix}) {
+        PropertyDataSectionY += Incr;
+
+        UMaterialExpressionScalarParameter* Parameter =
+            NewObject<UMaterialExpressionScalarParameter>(TargetMaterialLayer);
+        Parameter->ParameterName = FName(FullPropertyName + Suffix);
+        Parameter->DefaultValue =
+            Suffix == MaterialPropertyQuantizedScaleSuffix ? 1.0f : 0.0f;
+        Parameter->MaterialExpressionEditorX = BeginSectionX;
+        Parameter->MaterialExpressionEditorY = PropertyDataSectionY;
+        AutoGeneratedNodes.Add(Parameter);
+
+        MaximumPropertyDataSectionX = FMath::Max(
+            MaximumPropertyDataSectionX,
+            Incr * GetNameLengthScalar(Parameter->ParameterName));
+
+        FCustomInput& ParameterInput =
+            GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+        ParameterInput.InputName = FName(PropertyName + Suffix);
+        ParameterInput.Input.Expression = Parameter;
+      }
+    }
+
+    // Packed properties share a texture, and the mask selects their channel.
+    FString ChannelMaskName;
+    if (Property.EncodingDetails.IsPacked()) {
+      ChannelMaskName = PropertyName + MaterialPropertyChannelMaskSuffix;
+      PropertyDataSectionY += Incr;
+
+      UMaterialExpressionVectorParameter* ChannelMask =
+          NewObject<UMaterialExpressionVectorParameter>(TargetMaterialLayer);
+      ChannelMask->ParameterName =
+          FName(FullPropertyName + MaterialPropertyChannelMaskSuffix);
+      ChannelMask->DefaultValue = FLinearColor(1, 0, 0, 0);
+      ChannelMask->MaterialExpressionEditorX = BeginSectionX;
+      ChannelMask->MaterialExpressionEditorY = PropertyDataSectionY;
+      AutoGeneratedNodes.Add(ChannelMask);
+
+      MaximumPropertyDataSectionX = FMath::Max(
+          MaximumPropertyDataSectionX,
+          Incr * GetNameLengthScalar(ChannelMask->ParameterName));
+
+      FCustomInput& ChannelMaskInput =
+          GetPropertyValuesFunction->Inputs.Emplace_GetRef();
+      ChannelMaskInput.InputName = FName(ChannelMaskName);
+      ChannelMaskInput.Input.Expression = ChannelMask;
+    }
+
     FCustomOutput& PropertyOutput =
         GetPropertyValuesFunction->AdditionalOutputs.Emplace_GetRef();
 
@@ -1785,12 +1844,30 @@ void GenerateNodesForPropertyTable(
             ? "asfloat"
             : "asuint";
 
-    // Example:
-    // "color = asfloat(color_DATA.Load(int3(_czm_pixelX, _czm_pixelY,
-    // 0)).rgb);"
-    GetPropertyValuesFunction->Code +=
-        OutputName + " = " + asComponentString + "(" + PropertyDataName +
-        ".Load(int3(_czm_pixelX, _czm_pixelY, 0))" + swizzle + ");\n";
+    FString LoadCode =
+        PropertyDataName + ".Load(int3(_czm_pixelX, _czm_pixelY, 0))";
+    if (Property.EncodingDetails.IsQuantized()) {
+      // Example:
+      // "height = asuint(height_DATA.Load(int3(_czm_pixelX, _czm_pixelY,
+      // 0)).r) * height_QUANTIZED_SCALE + height_QUANTIZED_OFFSET;"
+      GetPropertyValuesFunction->Code +=
+          OutputName + " = asuint(" + LoadCode + swizzle + ") * " +
+          QuantizedScaleName + " + " + QuantizedOffsetName + ";\n";
+    } else if (Property.EncodingDetails.IsPacked()) {
+      // Example:
+      // "lanes = round(dot(float4(asuint(lanes_DATA.Load(int3(_czm_pixelX,
+      // _czm_pixelY, 0)))), lanes_CHANNEL_MASK));"
+      GetPropertyValuesFunction->Code += OutputName + " = round(dot(float4(" +
+                                         "asuint(" + LoadCode + ")), " +
+                                         ChannelMaskName + "));\n";
+    } else {
+      // Example:
+      // "color = asfloat(color_DATA.Load(int3(_czm_pixelX, _czm_pixelY,
+      // 0)).rgb);"
+      GetPropertyValuesFunction->Code += OutputName + " = " +
+                                         asComponentString + "(" + LoadCode +
+                                         swizzle + ");\n";
+    }
 
     if (Property.PropertyDetails.HasValueTransforms()) {
       int32 PropertyTransformsSectionX =
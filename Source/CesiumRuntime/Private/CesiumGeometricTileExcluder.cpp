@@ -0,0 +1,271 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGeometricTileExcluder.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumGeometricTileExcluderAdapter.h"
+#include "CesiumTileExclusionVolumes.h"
+#include "CesiumUtility/Math.h"
+#include "Misc/Crc.h"
+#include "VecMath.h"
+#include <glm/geometric.hpp>
+#include <glm/trigonometric.hpp>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+template <typename T> uint32 combineStamp(uint32 stamp, const T& value) {
+  return FCrc::MemCrc32(&value, sizeof(T), stamp);
+}
+} // namespace
+
+UCesiumGeometricTileExcluder::UCesiumGeometricTileExcluder()
+    : _isAdded(false) {
+  PrimaryComponentTick.bCanEverTick = false;
+  bAutoActivate = true;
+}
+
+void UCesiumGeometricTileExcluder::AddToTileset() {
+  if (this->_isAdded) {
+    return;
+  }
+
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  if (!pCesiumTileset) {
+    return;
+  }
+  Tileset* pTileset = pCesiumTileset->GetTileset();
+  if (!pTileset) {
+    return;
+  }
+
+  // All geometric excluders of a tileset share a single native excluder.
+  std::shared_ptr<CesiumGeometricTileExcluderAdapter>& pAdapter =
+      pCesiumTileset->_pGeometricTileExcluder;
+  if (!pAdapter) {
+    pAdapter =
+        std::make_shared<CesiumGeometricTileExcluderAdapter>(pCesiumTileset);
+    pTileset->getOptions().excluders.push_back(pAdapter);
+  }
+
+  pAdapter->addExcluder(this);
+  this->_isAdded = true;
+}
+
+void UCesiumGeometricTileExcluder::RemoveFromTileset() {
+  if (!this->_isAdded) {
+    return;
+  }
+
+  this->_isAdded = false;
+
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  if (!pCesiumTileset) {
+    return;
+  }
+
+  std::shared_ptr<CesiumGeometricTileExcluderAdapter>& pAdapter =
+      pCesiumTileset->_pGeometricTileExcluder;
+  if (!pAdapter) {
+    return;
+  }
+
+  pAdapter->removeExcluder(this);
+  if (pAdapter->hasExcluders()) {
+    return;
+  }
+
+  Tileset* pTileset = pCesiumTileset->GetTileset();
+  if (pTileset) {
+    std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+        pTileset->getOptions().excluders;
+    auto it = std::find(excluders.begin(), excluders.end(), pAdapter);
+    if (it != excluders.end()) {
+      excluders.erase(it);
+    }
+  }
+
+  pAdapter.reset();
+}
+
+void UCesiumGeometricTileExcluder::Refresh() {
+  this->RemoveFromTileset();
+  this->AddToTileset();
+}
+
+void UCesiumGeometricTileExcluder::Activate(bool bReset) {
+  Super::Activate(bReset);
+  this->AddToTileset();
+}
+
+void UCesiumGeometricTileExcluder::Deactivate() {
+  Super::Deactivate();
+  this->RemoveFromTileset();
+}
+
+void UCesiumGeometricTileExcluder::OnComponentDestroyed(
+    bool bDestroyingHierarchy) {
+  this->RemoveFromTileset();
+  Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+#if WITH_EDITOR
+// Called when properties are changed in the editor
+void UCesiumGeometricTileExcluder::PostEditChangeProperty(
+    FPropertyChangedEvent& PropertyChangedEvent) {
+  Super::PostEditChangeProperty(PropertyChangedEvent);
+
+  this->Refresh();
+}
+#endif
+
+uint32 UCesiumGeometricTileExcluder::ComputeExclusionStamp() const {
+  uint32 stamp = combineStamp(0, this->ExclusionMode);
+  return combineStamp(
+      stamp,
+      this->GetComponentTransform().ToMatrixWithScale());
+}
+
+void UCesiumBoxTileExcluder::AppendExclusionVolumes(
+    const ACesium3DTileset& Tileset,
+    const glm::dmat4& UnrealWorldToCesiumTileset,
+    std::vector<CesiumExclusionVolume>& Volumes) const {
+  glm::dmat4 boxToCesiumTileset =
+      UnrealWorldToCesiumTileset *
+      VecMath::createMatrix4D(
+          this->GetComponentTransform().ToMatrixWithScale());
+
+  glm::dmat3 halfAxes = glm::dmat3(boxToCesiumTileset);
+  halfAxes[0] *= this->BoxExtent.X;
+  halfAxes[1] *= this->BoxExtent.Y;
+  halfAxes[2] *= this->BoxExtent.Z;
+
+  CesiumExclusionVolume& volume = Volumes.emplace_back();
+  volume.shape =
+      CesiumExclusionBox{glm::dvec3(boxToCesiumTileset[3]), halfAxes};
+  volume.excludeOutside =
+      this->ExclusionMode == ECesiumTileExclusionMode::ExcludeTilesOutside;
+}
+
+uint32 UCesiumBoxTileExcluder::ComputeExclusionStamp() const {
+  return combineStamp(Super::ComputeExclusionStamp(), this->BoxExtent);
+}
+
+void UCesiumSphereTileExcluder::AppendExclusionVolumes(
+    const ACesium3DTileset& Tileset,
+    const glm::dmat4& UnrealWorldToCesiumTileset,
+    std::vector<CesiumExclusionVolume>& Volumes) const {
+  glm::dmat4 sphereToCesiumTileset =
+      UnrealWorldToCesiumTileset *
+      VecMath::createMatrix4D(
+          this->GetComponentTransform().ToMatrixWithScale());
+
+  double scale = glm::length(sphereToCesiumTileset[0]);
+  scale = glm::max(scale, glm::length(sphereToCesiumTileset[1]));
+  scale = glm::max(scale, glm::length(sphereToCesiumTileset[2]));
+
+  CesiumExclusionVolume& volume = Volumes.emplace_back();
+  volume.shape = CesiumExclusionSphere{
+      glm::dvec3(sphereToCesiumTileset[3]),
+      this->SphereRadius * scale};
+  volume.excludeOutside =
+      this->ExclusionMode == ECesiumTileExclusionMode::ExcludeTilesOutside;
+}
+
+uint32 UCesiumSphereTileExcluder::ComputeExclusionStamp() const {
+  return combineStamp(Super::ComputeExclusionStamp(), this->SphereRadius);
+}
+
+void UCesiumPolygonTileExcluder::AppendExclusionVolumes(
+    const ACesium3DTileset& Tileset,
+    const glm::dmat4& UnrealWorldToCesiumTileset,
+    std::vector<CesiumExclusionVolume>& Volumes) const {
+  // Polygons are interpreted the same way as in UCesiumPolygonRasterOverlay.
+  FTransform worldToTileset = Tileset.GetActorTransform().Inverse();
+
+  for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (!IsValid(pPolygon)) {
+      continue;
+    }
+
+    CesiumGeospatial::CartographicPolygon polygon =
+        pPolygon->CreateCartographicPolygon(worldToTileset);
+
+    CesiumExclusionVolume& volume = Volumes.emplace_back();
+    volume.shape = CesiumExclusionPrism{
+        polygon.getVertices(),
+        this->MinimumHeight,
+        this->MaximumHeight};
+    volume.excludeOutside =
+        this->ExclusionMode == ECesiumTileExclusionMode::ExcludeTilesOutside;
+  }
+}
+
+uint32 UCesiumPolygonTileExcluder::ComputeExclusionStamp() const {
+  uint32 stamp = Super::ComputeExclusionStamp();
+  stamp = combineStamp(stamp, this->MinimumHeight);
+  stamp = combineStamp(stamp, this->MaximumHeight);
+
+  for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (!IsValid(pPolygon)) {
+      continue;
+    }
+
+    const int32 pointCount = pPolygon->Polygon->GetNumberOfSplinePoints();
+    stamp = combineStamp(stamp, pointCount);
+    for (int32 i = 0; i < pointCount; ++i) {
+      stamp = combineStamp(
+          stamp,
+          pPolygon->Polygon->GetLocationAtSplinePoint(
+              i,
+              ESplineCoordinateSpace::World));
+    }
+  }
+
+  return stamp;
+}
+
+void UCesiumRectangleTileExcluder::AppendExclusionVolumes(
+    const ACesium3DTileset& Tileset,
+    const glm::dmat4& UnrealWorldToCesiumTileset,
+    std::vector<CesiumExclusionVolume>& Volumes) const {
+  const double west = glm::radians(this->West);
+  const double south = glm::radians(this->South);
+  const double east = glm::radians(this->East);
+  const double north = glm::radians(this->North);
+
+  const bool excludeOutside =
+      this->ExclusionMode == ECesiumTileExclusionMode::ExcludeTilesOutside;
+
+  auto addRectangle = [&](double w, double e) {
+    CesiumExclusionVolume& volume = Volumes.emplace_back();
+    volume.shape = CesiumExclusionPrism{
+        {glm::dvec2(w, south),
+         glm::dvec2(e, south),
+         glm::dvec2(e, north),
+         glm::dvec2(w, north)},
+        this->MinimumHeight,
+        this->MaximumHeight};
+    volume.excludeOutside = excludeOutside;
+  };
+
+  // Exclusion prisms can't cross the anti-meridian, so split the rectangle
+  // there if necessary.
+  if (west <= east) {
+    addRectangle(west, east);
+  } else {
+    addRectangle(west, CesiumUtility::Math::OnePi);
+    addRectangle(-CesiumUtility::Math::OnePi, east);
+  }
+}
+
+uint32 UCesiumRectangleTileExcluder::ComputeExclusionStamp() const {
+  uint32 stamp = Super::ComputeExclusionStamp();
+  stamp = combineStamp(stamp, this->West);
+  stamp = combineStamp(stamp, this->South);
+  stamp = combineStamp(stamp, this->East);
+  stamp = combineStamp(stamp, this->North);
+  stamp = combineStamp(stamp, this->MinimumHeight);
+  return combineStamp(stamp, this->MaximumHeight);
+}
@@ -0,0 +1,102 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGeometricTileExcluderAdapter.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGeometricTileExcluder.h"
+#include "VecMath.h"
+#include <glm/gtc/matrix_inverse.hpp>
+
+CesiumGeometricTileExcluderAdapter::CesiumGeometricTileExcluderAdapter(
+    ACesium3DTileset* pTileset)
+    : _pTileset(pTileset),
+      _excluders(),
+      _index(),
+      _cache(),
+      _lastUnrealWorldToCesiumTileset(0.0),
+      _lastStamps() {}
+
+bool CesiumGeometricTileExcluderAdapter::shouldExclude(
+    const Cesium3DTilesSelection::Tile& tile) const noexcept {
+  if (this->_index.isEmpty()) {
+    return false;
+  }
+
+  std::optional<bool> cached = this->_cache.find(tile);
+  if (cached) {
+    return *cached;
+  }
+
+  bool excluded = this->_index.shouldExclude(tile.getBoundingVolume());
+  this->_cache.store(tile, excluded);
+  return excluded;
+}
+
+void CesiumGeometricTileExcluderAdapter::startNewFrame() noexcept {
+  // Forget the tiles that weren't visited in the previous frame, which
+  // includes any that were freed since.
+  this->_cache.startNewFrame();
+
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  if (!IsValid(pTileset)) {
+    this->_index.build({});
+    this->_cache.invalidate();
+    this->_lastStamps.clear();
+    return;
+  }
+
+  glm::dmat4 ueTilesetToUeWorld = VecMath::createMatrix4D(
+      pTileset->GetActorTransform().ToMatrixWithScale());
+  glm::dmat4 unrealWorldToCesiumTileset = glm::affineInverse(
+      ueTilesetToUeWorld *
+      pTileset->GetCesiumTilesetToUnrealRelativeWorldTransform());
+
+  // A zero scale makes the transformation singular. Don't exclude anything
+  // in that case, rather than testing against NaN volumes.
+  if (glm::isnan(unrealWorldToCesiumTileset[3].x) ||
+      glm::isnan(unrealWorldToCesiumTileset[3].y) ||
+      glm::isnan(unrealWorldToCesiumTileset[3].z)) {
+    this->_index.build({});
+    this->_cache.invalidate();
+    this->_lastStamps.clear();
+    return;
+  }
+
+  std::vector<std::pair<const UCesiumGeometricTileExcluder*, uint32>> stamps;
+  stamps.reserve(this->_excluders.Num());
+  for (const TWeakObjectPtr<UCesiumGeometricTileExcluder>& pExcluder :
+       this->_excluders) {
+    if (pExcluder.IsValid() && pExcluder->IsActive()) {
+      stamps.emplace_back(pExcluder.Get(), pExcluder->ComputeExclusionStamp());
+    }
+  }
+
+  if (stamps == this->_lastStamps &&
+      unrealWorldToCesiumTileset == this->_lastUnrealWorldToCesiumTileset) {
+    // Nothing changed, so the index and the cached decisions are still valid.
+    return;
+  }
+
+  std::vector<CesiumExclusionVolume> volumes;
+  for (const auto& [pExcluder, stamp] : stamps) {
+    pExcluder->AppendExclusionVolumes(
+        *pTileset,
+        unrealWorldToCesiumTileset,
+        volumes);
+  }
+
+  this->_index.build(std::move(volumes));
+  this->_cache.invalidate();
+  this->_lastStamps = std::move(stamps);
+  this->_lastUnrealWorldToCesiumTileset = unrealWorldToCesiumTileset;
+}
+
+void CesiumGeometricTileExcluderAdapter::addExcluder(
+    UCesiumGeometricTileExcluder* pExcluder) {
+  this->_excluders.AddUnique(pExcluder);
+}
+
+void CesiumGeometricTileExcluderAdapter::removeExcluder(
+    UCesiumGeometricTileExcluder* pExcluder) {
+  this->_excluders.Remove(pExcluder);
+}
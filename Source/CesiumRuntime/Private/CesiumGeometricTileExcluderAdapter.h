@@ -0,0 +1,53 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTileExclusionCache.h"
+#include "CesiumTileExclusionVolumes.h"
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <Cesium3DTilesSelection/ITileExcluder.h>
+#include <glm/mat4x4.hpp>
+#include <utility>
+#include <vector>
+
+class ACesium3DTileset;
+class UCesiumGeometricTileExcluder;
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * A single native tile excluder that combines all of the
+ * UCesiumGeometricTileExcluder components of a tileset. Their volumes are
+ * tested against the tiles' native bounding volumes, without wrapping tiles in
+ * UObjects or calling into Blueprints.
+ *
+ * The volumes are only gathered again, and the per-tile decisions only
+ * recomputed, when an excluder's stamp or the tileset's transform changes.
+ */
+class CesiumGeometricTileExcluderAdapter
+    : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  CesiumGeometricTileExcluderAdapter(ACesium3DTileset* pTileset);
+
+  virtual bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+  virtual void startNewFrame() noexcept override;
+
+  void addExcluder(UCesiumGeometricTileExcluder* pExcluder);
+  void removeExcluder(UCesiumGeometricTileExcluder* pExcluder);
+  bool hasExcluders() const { return !this->_excluders.IsEmpty(); }
+
+private:
+  TWeakObjectPtr<ACesium3DTileset> _pTileset;
+  TArray<TWeakObjectPtr<UCesiumGeometricTileExcluder>> _excluders;
+  CesiumTileExclusionIndex _index;
+  mutable CesiumTileExclusionCache _cache;
+
+  // The state the index was built from.
+  glm::dmat4 _lastUnrealWorldToCesiumTileset;
+  std::vector<std::pair<const UCesiumGeometricTileExcluder*, uint32>>
+      _lastStamps;
+};
@@ -6,6 +6,7 @@
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
 #include "CesiumFeatureIdSet.h"
+#include "CesiumFeatureStylingComponent.h"
 #include "CesiumGeometry/Axis.h"
 #include "CesiumGeometry/Rectangle.h"
 #include "CesiumGeometry/Transforms.h"
@@ -17,18 +18,27 @@
 #include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
 #include "CesiumGltf/PropertyType.h"
 #include "CesiumGltf/TextureInfo.h"
+#include "CesiumGltfComponentPool.h"
 #include "CesiumGltfContent/GltfUtilities.h"
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumMaterialInstanceCache.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumMeshKernels.h"
+#include "CesiumModelTrimming.h"
+#include "CesiumPrebakedTile.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRasterOverlays/RasterOverlay.h"
 #include "CesiumRasterOverlays/RasterOverlayTile.h"
 #include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "CesiumTextureStreaming.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTransforms.h"
 #include "CesiumUtility/Tracing.h"
 #include "CesiumUtility/joinToString.h"
+#include "CesiumVertexWelding.h"
 #include "Chaos/AABBTree.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
@@ -66,6 +76,11 @@ using namespace CesiumTextureUtility;
 using namespace CreateGltfOptions;
 using namespace LoadGltfResult;
 
+DECLARE_MEMORY_STAT(
+    TEXT("glTF CPU Memory"),
+    STAT_CesiumGltfCpuMemory,
+    STATGROUP_Cesium);
+
 namespace {
 using TMeshVector2 = FVector2f;
 using TMeshVector3 = FVector3f;
@@ -411,7 +426,8 @@ template <class T>
 static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
     CesiumGltf::Model& model,
     const std::optional<T>& gltfTexture,
-    bool sRGB) {
+    bool sRGB,
+    ECesiumTextureCompression compression = ECesiumTextureCompression::None) {
   if (!gltfTexture || gltfTexture.value().index < 0 ||
       gltfTexture.value().index >= model.textures.size()) {
     if (gltfTexture && gltfTexture.value().index >= 0) {
@@ -428,7 +444,7 @@ static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
   const CesiumGltf::Texture& texture =
       model.textures[gltfTexture.value().index];
 
-  return loadTextureAnyThreadPart(model, texture, sRGB);
+  return loadTextureAnyThreadPart(model, texture, sRGB, compression);
 }
 
 static void applyWaterMask(
@@ -956,15 +972,17 @@ static void loadPrimitive(
     name = constrainLength(name, 256);
   }
 
+  int32 meshIndex = -1;
   auto meshIt = std::find_if(
       model.meshes.begin(),
       model.meshes.end(),
       [&mesh](const Mesh& candidate) { return &candidate == &mesh; });
   if (meshIt != model.meshes.end()) {
-    int64_t meshIndex = meshIt - model.meshes.begin();
+    meshIndex = int32(meshIt - model.meshes.begin());
     name += " mesh " + std::to_string(meshIndex);
   }
 
+  int32 primitiveIndex = -1;
   auto primitiveIt = std::find_if(
       mesh.primitives.begin(),
       mesh.primitives.end(),
@@ -972,7 +990,7 @@ static void loadPrimitive(
         return &candidate == &primitive;
       });
   if (primitiveIt != mesh.primitives.end()) {
-    int64_t primitiveIndex = primitiveIt - mesh.primitives.begin();
+    primitiveIndex = int32(primitiveIt - mesh.primitives.begin());
     name += " primitive " + std::to_string(primitiveIndex);
   }
 
@@ -1066,6 +1084,30 @@ static void loadPrimitive(
     needsTangents = true;
   }
 
+  const CreateModelOptions* pModelOptions =
+      options.pMeshOptions->pNodeOptions->pModelOptions;
+  const bool parallel = pModelOptions->parallelMeshBuilding;
+
+  // Unlit primitives without normals get normals that depend on where the
+  // tile is, and raster overlay texture coordinates and encoded metadata depend
+  // on the tileset, so none of these can be pre-baked.
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  const bool canPrebake =
+      meshIndex >= 0 && primitiveIndex >= 0 &&
+      !(primitiveResult.isUnlit && !hasNormals) &&
+      primitive.attributes.find("_CESIUMOVERLAY_0") ==
+          primitive.attributes.end() &&
+      !pModelOptions->pFeaturesMetadataDescription &&
+      !pModelOptions->pEncodedMetadataDescription_DEPRECATED;
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  const CesiumPrebakedPrimitive* pPrebaked =
+      canPrebake && pModelOptions->pPrebakedTile
+          ? pModelOptions->pPrebakedTile->findPrimitive(
+                meshIndex,
+                primitiveIndex)
+          : nullptr;
+
   TUniquePtr<FStaticMeshRenderData> RenderData =
       MakeUnique<FStaticMeshRenderData>();
   RenderData->AllocateLODResources(1);
@@ -1080,15 +1122,11 @@ static void loadPrimitive(
     glm::dvec3 minPosition{std::numeric_limits<double>::max()};
     glm::dvec3 maxPosition{std::numeric_limits<double>::lowest()};
     if (min.size() != 3 || max.size() != 3) {
-      for (int32_t i = 0; i < positionView.size(); ++i) {
-        minPosition.x = glm::min<double>(minPosition.x, positionView[i].X);
-        minPosition.y = glm::min<double>(minPosition.y, positionView[i].Y);
-        minPosition.z = glm::min<double>(minPosition.z, positionView[i].Z);
-
-        maxPosition.x = glm::max<double>(maxPosition.x, positionView[i].X);
-        maxPosition.y = glm::max<double>(maxPosition.y, positionView[i].Y);
-        maxPosition.z = glm::max<double>(maxPosition.z, positionView[i].Z);
-      }
+      CesiumMeshKernels::computeBounds(
+          positionView,
+          parallel,
+          minPosition,
+          maxPosition);
     } else {
       minPosition = glm::dvec3(min[0], min[1], min[2]);
       maxPosition = glm::dvec3(max[0], max[1], max[2]);
@@ -1108,30 +1146,17 @@ static void loadPrimitive(
   }
 
   TArray<uint32> indices;
-  if (primitive.mode == MeshPrimitive::Mode::TRIANGLES ||
-      primitive.mode == MeshPrimitive::Mode::POINTS) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
-
-    for (int32 i = 0; i < indicesView.size(); ++i) {
-      indices[i] = indicesView[i];
-    }
+  if (pPrebaked) {
+    indices = pPrebaked->indices;
   } else {
-    // assume TRIANGLE_STRIP because all others are rejected earlier.
+    // TRIANGLES and POINTS are copied as they are. Anything else is a
+    // TRIANGLE_STRIP because all other modes are rejected earlier.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(
-        static_cast<TArray<uint32>::SizeType>(3 * (indicesView.size() - 2)));
-    for (int32 i = 0; i < indicesView.size() - 2; ++i) {
-      if (i % 2) {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 2];
-        indices[3 * i + 2] = indicesView[i + 1];
-      } else {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 1];
-        indices[3 * i + 2] = indicesView[i + 2];
-      }
-    }
+    CesiumMeshKernels::copyIndices(
+        indicesView,
+        primitive.mode == MeshPrimitive::Mode::TRIANGLE_STRIP,
+        parallel,
+        indices);
   }
 
   // If we don't have normals, the gltf spec prescribes that the client
@@ -1144,47 +1169,42 @@ static void loadPrimitive(
       duplicateVertices && primitive.mode != MeshPrimitive::Mode::POINTS;
 
   TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
-  StaticMeshBuildVertices.SetNum(
-      duplicateVertices ? indices.Num()
-                        : static_cast<int>(positionView.size()));
 
-  {
+  if (pPrebaked) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPrebakedVertices)
+    StaticMeshBuildVertices = pPrebaked->vertices;
+    RenderData->Bounds.SphereRadius = CesiumMeshKernels::computeSphereRadius(
+        StaticMeshBuildVertices,
+        RenderData->Bounds.Origin,
+        parallel);
+  } else {
+    StaticMeshBuildVertices.SetNum(
+        duplicateVertices ? indices.Num()
+                          : static_cast<int>(positionView.size()));
+
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyDuplicatedPositions)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector3& pos = positionView[vertexIndex];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
+      RenderData->Bounds.SphereRadius = CesiumMeshKernels::copyPositions(
+          positionView,
+          &indices,
+          RenderData->Bounds.Origin,
+          parallel,
+          StaticMeshBuildVertices);
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector3& pos = positionView[i];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
+      RenderData->Bounds.SphereRadius = CesiumMeshKernels::copyPositions(
+          positionView,
+          nullptr,
+          RenderData->Bounds.Origin,
+          parallel,
+          StaticMeshBuildVertices);
     }
   }
 
-  bool hasVertexColors = false;
+  bool hasVertexColors = pPrebaked && pPrebaked->hasVertexColors;
 
   auto colorAccessorIt = primitive.attributes.find("COLOR_0");
-  if (colorAccessorIt != primitive.attributes.end()) {
+  if (!pPrebaked && colorAccessorIt != primitive.attributes.end()) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyVertexColors)
     int colorAccessorID = colorAccessorIt->second;
     hasVertexColors = createAccessorView(
@@ -1203,21 +1223,38 @@ static void loadPrimitive(
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
-    primitiveResult.baseColorTexture =
-        loadTexture(model, pbrMetallicRoughness.baseColorTexture, true);
+    // Normal maps aren't compressed, because BC1 and BC3 distort normals too
+    // much.
+    const ECesiumTextureCompression compression =
+        pModelOptions->textureCompression;
+    primitiveResult.baseColorTexture = loadTexture(
+        model,
+        pbrMetallicRoughness.baseColorTexture,
+        true,
+        compression);
     primitiveResult.metallicRoughnessTexture = loadTexture(
         model,
         pbrMetallicRoughness.metallicRoughnessTexture,
-        false);
+        false,
+        compression);
     primitiveResult.normalTexture =
         loadTexture(model, material.normalTexture, false);
-    primitiveResult.occlusionTexture =
-        loadTexture(model, material.occlusionTexture, false);
+    primitiveResult.occlusionTexture = loadTexture(
+        model,
+        material.occlusionTexture,
+        false,
+        compression);
     primitiveResult.emissiveTexture =
-        loadTexture(model, material.emissiveTexture, true);
+        loadTexture(model, material.emissiveTexture, true, compression);
   }
 
-  {
+  if (pPrebaked) {
+    primitiveResult.textureCoordinateParameters =
+        pPrebaked->textureCoordinateParameters;
+    primitiveResult.overlayTextureCoordinateIDToUVIndex =
+        pPrebaked->overlayTextureCoordinateIDToUVIndex;
+    gltfToUnrealTexCoordMap = pPrebaked->gltfToUnrealTexCoordMap;
+  } else {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureCoordinates)
 
     primitiveResult
@@ -1291,7 +1328,6 @@ static void loadPrimitive(
     }
   }
 
-  auto pModelOptions = options.pMeshOptions->pNodeOptions->pModelOptions;
   auto pModelResult =
       options.pMeshOptions->pNodeOptions->pHalfConstructedModelResult;
 
@@ -1368,7 +1404,9 @@ static void loadPrimitive(
   // TangentY: Bi-tangent
   // TangentZ: Normal
 
-  if (hasNormals) {
+  if (pPrebaked) {
+    // The pre-baked vertices already have their normals and tangents.
+  } else if (hasNormals) {
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormalsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
@@ -1412,7 +1450,7 @@ static void loadPrimitive(
     }
   }
 
-  if (hasTangents) {
+  if (!pPrebaked && hasTangents) {
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangentsForDuplicatedVertices)
       for (int i = 0; i < indices.Num(); ++i) {
@@ -1442,13 +1480,32 @@ static void loadPrimitive(
     }
   }
 
-  if (needsTangents && !hasTangents) {
+  if (!pPrebaked && needsTangents && !hasTangents) {
     // Use mikktspace to calculate the tangents.
     // Note that this assumes normals and UVs are already populated.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
     computeTangentSpace(StaticMeshBuildVertices);
   }
 
+  if (duplicateVertices && !pPrebaked) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
+    for (int32 i = 0; i < indices.Num(); i++) {
+      indices[i] = i;
+    }
+  }
+
+  if (duplicateVertices && !pPrebaked) {
+    // Now that the normals and tangents are computed, corners of triangles
+    // that ended up identical can share a vertex again. This often brings the
+    // vertex count back down enough to use 16-bit indices.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WeldVertices)
+    CesiumVertexWelding::weldVertices(
+        StaticMeshBuildVertices,
+        indices,
+        FMath::Max(int32(gltfToUnrealTexCoordMap.size()), 1),
+        hasVertexColors);
+  }
+
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
 
@@ -1486,11 +1543,19 @@ static void loadPrimitive(
   section.bCastShadow = true;
   section.MaterialIndex = 0;
 
-  if (duplicateVertices) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
-    for (int32 i = 0; i < indices.Num(); i++) {
-      indices[i] = i;
-    }
+  if (canPrebake && pModelOptions->pPrebakeResult) {
+    CesiumPrebakedPrimitive& prebaked =
+        pModelOptions->pPrebakeResult->primitives.emplace_back();
+    prebaked.meshIndex = meshIndex;
+    prebaked.primitiveIndex = primitiveIndex;
+    prebaked.vertices = StaticMeshBuildVertices;
+    prebaked.indices = indices;
+    prebaked.hasVertexColors = hasVertexColors;
+    prebaked.textureCoordinateParameters =
+        primitiveResult.textureCoordinateParameters;
+    prebaked.overlayTextureCoordinateIDToUVIndex =
+        primitiveResult.overlayTextureCoordinateIDToUVIndex;
+    prebaked.gltfToUnrealTexCoordMap = gltfToUnrealTexCoordMap;
   }
 
   {
@@ -1823,6 +1888,95 @@ void applyGltfUpAxisTransform(const Model& model, glm::dmat4x4& rootTransform) {
 }
 } // namespace
 
+/**
+ * Creates the views of a primitive's accessors, features, and metadata again,
+ * after trimming the model has moved the data they point to.
+ */
+static void recreatePrimitiveViews(
+    const Model& model,
+    const FCesiumModelMetadata& modelMetadata,
+    LoadPrimitiveResult& result) {
+  if (!result.pMeshPrimitive) {
+    return;
+  }
+
+  const MeshPrimitive& primitive = *result.pMeshPrimitive;
+
+  result.Features = loadPrimitiveFeatures(model, primitive);
+  result.Metadata = loadPrimitiveMetadata(primitive);
+
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  result.Metadata_DEPRECATED = FCesiumMetadataPrimitive{
+      result.Features,
+      result.Metadata,
+      modelMetadata};
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  result.TexCoordAccessorMap.clear();
+  createTexCoordAccessorsForFeaturesMetadata(
+      model,
+      primitive,
+      result.Features,
+      result.Metadata,
+      modelMetadata,
+      result.TexCoordAccessorMap);
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt != primitive.attributes.end()) {
+    result.PositionAccessor =
+        AccessorView<TMeshVector3>(model, positionIt->second);
+  }
+
+  const Accessor* pIndexAccessor =
+      Model::getSafe(&model.accessors, primitive.indices);
+  if (!pIndexAccessor) {
+    return;
+  }
+
+  switch (pIndexAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    result.IndexAccessor = AccessorView<uint8_t>(model, *pIndexAccessor);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    result.IndexAccessor = AccessorView<uint16_t>(model, *pIndexAccessor);
+    break;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    result.IndexAccessor = AccessorView<uint32_t>(model, *pIndexAccessor);
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Releases the buffer data and images of the model that runtime queries don't
+ * need, now that its primitives and textures have been built.
+ */
+static void trimModelAnyThreadPart(
+    LoadModelResult& result,
+    const CreateModelOptions& options) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TrimModel)
+
+  Model& model = *options.pModel;
+  result.ReleasedCpuBytes =
+      CesiumModelTrimming::trimModel(model, options.releaseImages);
+
+  const ExtensionModelExtStructuralMetadata* pMetadataExtension =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (pMetadataExtension) {
+    result.Metadata = FCesiumModelMetadata(model, *pMetadataExtension);
+  }
+
+  for (LoadNodeResult& node : result.nodeResults) {
+    if (!node.meshResult) {
+      continue;
+    }
+    for (LoadPrimitiveResult& primitive : node.meshResult->primitiveResults) {
+      recreatePrimitiveViews(model, result.Metadata, primitive);
+    }
+  }
+}
+
 static void loadModelAnyThreadPart(
     LoadModelResult& result,
     const glm::dmat4x4& transform,
@@ -1847,7 +2001,9 @@ static void loadModelAnyThreadPart(
     result.EncodedMetadata =
         CesiumEncodedFeaturesMetadata::encodeModelMetadataAnyThreadPart(
             pFeaturesMetadataDescription->ModelMetadata,
-            result.Metadata);
+            result.Metadata,
+            &model,
+            options.pPropertyTableCache);
   } else if (pMetadataDescription_DEPRECATED) {
     result.EncodedMetadata_DEPRECATED =
         CesiumEncodedMetadataUtility::encodeMetadataAnyThreadPart(
@@ -2082,6 +2238,34 @@ static void SetPropertyTableParameterValues(
           encodedProperty.pTexture->pTexture.Get());
     }
 
+    if (encodedProperty.quantization) {
+      FString scaleName =
+          fullPropertyName +
+          CesiumEncodedFeaturesMetadata::MaterialPropertyQuantizedScaleSuffix;
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(FName(scaleName), association, index),
+          encodedProperty.quantization->scale);
+
+      FString offsetName =
+          fullPropertyName +
+          CesiumEncodedFeaturesMetadata::MaterialPropertyQuantizedOffsetSuffix;
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(FName(offsetName), association, index),
+          encodedProperty.quantization->offset);
+    }
+
+    if (encodedProperty.packedChannel) {
+      FLinearColor channelMask(0.0f, 0.0f, 0.0f, 0.0f);
+      channelMask.Component(*encodedProperty.packedChannel) = 1.0f;
+
+      FString channelMaskName =
+          fullPropertyName +
+          CesiumEncodedFeaturesMetadata::MaterialPropertyChannelMaskSuffix;
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(FName(channelMaskName), association, index),
+          channelMask);
+    }
+
     if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
             encodedProperty.offset)) {
       FString parameterName =
@@ -2505,104 +2689,103 @@ static void SetMetadataParameterValues_DEPRECATED(
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 #pragma endregion
 
-static void loadPrimitiveGameThreadPart(
-    const CesiumGltf::Model& model,
-    UCesiumGltfComponent* pGltf,
-    LoadPrimitiveResult& loadResult,
-    const glm::dmat4x4& cesiumToUnrealTransform,
-    const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision,
-    ACesium3DTileset* pTilesetActor) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
-
-  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
-      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
-
-  FName meshName = createSafeName(loadResult.name, "");
-  UCesiumGltfPrimitiveComponent* pMesh;
-  if (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS) {
-    UCesiumGltfPointsComponent* pPointMesh =
-        NewObject<UCesiumGltfPointsComponent>(pGltf, meshName);
-    pPointMesh->UsesAdditiveRefinement =
-        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
-    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
-    pPointMesh->Dimensions = loadResult.dimensions;
-    pMesh = pPointMesh;
-  } else {
-    pMesh = NewObject<UCesiumGltfPrimitiveComponent>(pGltf, meshName);
-  }
+static UCesiumMaterialUserData*
+getOrAddCesiumUserData(UMaterialInterface* pBaseMaterial) {
+  UMaterialInstance* pBaseAsMaterialInstance =
+      Cast<UMaterialInstance>(pBaseMaterial);
+  UCesiumMaterialUserData* pCesiumData =
+      pBaseAsMaterialInstance
+          ? pBaseAsMaterialInstance->GetAssetUserData<UCesiumMaterialUserData>()
+          : nullptr;
 
-  pMesh->pTilesetActor = pTilesetActor;
-  pMesh->overlayTextureCoordinateIDToUVIndex =
-      loadResult.overlayTextureCoordinateIDToUVIndex;
-  pMesh->GltfToUnrealTexCoordMap =
-      std::move(loadResult.GltfToUnrealTexCoordMap);
-  pMesh->TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
-  pMesh->PositionAccessor = std::move(loadResult.PositionAccessor);
-  pMesh->IndexAccessor = std::move(loadResult.IndexAccessor);
-  pMesh->HighPrecisionNodeTransform = loadResult.transform;
-  pMesh->UpdateTransformFromCesium(cesiumToUnrealTransform);
+  // If possible and necessary, attach the CesiumMaterialUserData now.
+#if WITH_EDITORONLY_DATA
+  if (pBaseAsMaterialInstance && !pCesiumData) {
+    const FStaticParameterSet& parameters =
+        pBaseAsMaterialInstance->GetStaticParameters();
 
-  pMesh->bUseDefaultCollision = false;
-  pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
-  pMesh->SetFlags(
-      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-  pMesh->pModel = loadResult.pModel;
-  pMesh->pMeshPrimitive = loadResult.pMeshPrimitive;
-  pMesh->boundingVolume = boundingVolume;
-  pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
-  pMesh->SetCustomDepthStencilWriteMask(
-      pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
-  pMesh->SetCustomDepthStencilValue(
-      pGltf->CustomDepthParameters.CustomDepthStencilValue);
-  if (loadResult.isUnlit) {
-    pMesh->bCastDynamicShadow = false;
+    bool hasLayers = parameters.bHasMaterialLayers;
+    if (hasLayers) {
+#if WITH_EDITOR
+      FScopedTransaction transaction(
+          FText::FromString("Add Cesium User Data to Material"));
+      pBaseAsMaterialInstance->Modify();
+#endif
+      pCesiumData = NewObject<UCesiumMaterialUserData>(
+          pBaseAsMaterialInstance,
+          NAME_None,
+          RF_Transactional);
+      pBaseAsMaterialInstance->AddAssetUserData(pCesiumData);
+      pCesiumData->PostEditChangeOwner();
+    }
   }
+#endif
 
-  UStaticMesh* pStaticMesh = NewObject<UStaticMesh>(pMesh, meshName);
-  pMesh->SetStaticMesh(pStaticMesh);
-
-  pStaticMesh->SetFlags(
-      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-  pStaticMesh->NeverStream = true;
+  return pCesiumData;
+}
 
-  pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+static bool hasPrimitiveTextures(const LoadPrimitiveResult& loadResult) {
+  return loadResult.baseColorTexture || loadResult.metallicRoughnessTexture ||
+         loadResult.normalTexture || loadResult.emissiveTexture ||
+         loadResult.occlusionTexture || loadResult.waterMaskTexture;
+}
 
-  const Material& material =
-      loadResult.pMaterial ? *loadResult.pMaterial : defaultMaterial;
+/**
+ * Computes the signature of the material parameters that
+ * SetMaterialParameterValues sets for a primitive without textures. The
+ * texture coordinate indices are left out, because they have no effect
+ * without textures.
+ */
+static CesiumMaterialSignature computeMaterialSignature(
+    const LoadPrimitiveResult& loadResult,
+    const Material& material,
+    const MaterialPBRMetallicRoughness& pbr,
+    const UMaterialInterface* pBaseMaterial) {
+  CesiumMaterialSignature signature;
+  signature.pBaseMaterial = pBaseMaterial;
 
-  const MaterialPBRMetallicRoughness& pbr =
-      material.pbrMetallicRoughness ? material.pbrMetallicRoughness.value()
-                                    : defaultPbrMetallicRoughness;
+  if (pbr.baseColorFactor.size() > 3) {
+    signature.baseColorFactor = FLinearColor(
+        pbr.baseColorFactor[0],
+        pbr.baseColorFactor[1],
+        pbr.baseColorFactor[2],
+        pbr.baseColorFactor[3]);
+  } else if (pbr.baseColorFactor.size() == 3) {
+    signature.baseColorFactor = FLinearColor(
+        pbr.baseColorFactor[0],
+        pbr.baseColorFactor[1],
+        pbr.baseColorFactor[2],
+        1.);
+  }
+
+  signature.metallicFactor =
+      static_cast<float>(loadResult.isUnlit ? 0.0f : pbr.metallicFactor);
+  signature.roughnessFactor =
+      static_cast<float>(loadResult.isUnlit ? 1.0f : pbr.roughnessFactor);
+
+  signature.hasEmissiveFactor = material.emissiveFactor.size() >= 3;
+  if (signature.hasEmissiveFactor) {
+    signature.emissiveFactor = FVector3f(
+        material.emissiveFactor[0],
+        material.emissiveFactor[1],
+        material.emissiveFactor[2]);
+  }
+
+  signature.onlyLand = loadResult.onlyLand;
+  signature.onlyWater = loadResult.onlyWater;
+  signature.waterMaskTranslationScale = FVector3f(
+      loadResult.waterMaskTranslationX,
+      loadResult.waterMaskTranslationY,
+      loadResult.waterMaskScale);
+
+  return signature;
+}
 
+static UMaterialInstanceDynamic*
+createMaterialInstance(UMaterialInterface* pBaseMaterial) {
   const FName ImportedSlotName(
       *(TEXT("CesiumMaterial") + FString::FromInt(nextMaterialId++)));
 
-  const auto is_in_blend_mode = [](auto& result) {
-    return !!result.pMaterial && result.pMaterial->alphaMode ==
-                                     CesiumGltf::Material::AlphaMode::BLEND;
-  };
-
-#if PLATFORM_MAC
-  // TODO: figure out why water material crashes mac
-  UMaterialInterface* pBaseMaterial =
-      (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
-       pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
-          ? pGltf->BaseMaterialWithTranslucency
-          : pGltf->BaseMaterial;
-#else
-  UMaterialInterface* pBaseMaterial;
-  if (loadResult.onlyWater || !loadResult.onlyLand) {
-    pBaseMaterial = pGltf->BaseMaterialWithWater;
-  } else {
-    pBaseMaterial =
-        (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
-         pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
-            ? pGltf->BaseMaterialWithTranslucency
-            : pGltf->BaseMaterial;
-  }
-#endif
-
   UMaterialInstanceDynamic* pMaterial = UMaterialInstanceDynamic::Create(
       pBaseMaterial,
       nullptr,
@@ -2610,6 +2793,19 @@ static void loadPrimitiveGameThreadPart(
 
   pMaterial->SetFlags(
       RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pMaterial->TwoSided = true;
+
+  return pMaterial;
+}
+
+static void SetMaterialParameterValues(
+    const CesiumGltf::Model& model,
+    UCesiumGltfComponent& gltfComponent,
+    LoadPrimitiveResult& loadResult,
+    const Material& material,
+    const MaterialPBRMetallicRoughness& pbr,
+    UMaterialInstanceDynamic* pMaterial,
+    UCesiumMaterialUserData* pCesiumData) {
   SetGltfParameterValues(
       model,
       loadResult,
@@ -2625,36 +2821,6 @@ static void loadPrimitiveGameThreadPart(
       EMaterialParameterAssociation::GlobalParameter,
       INDEX_NONE);
 
-  UMaterialInstance* pBaseAsMaterialInstance =
-      Cast<UMaterialInstance>(pBaseMaterial);
-  UCesiumMaterialUserData* pCesiumData =
-      pBaseAsMaterialInstance
-          ? pBaseAsMaterialInstance->GetAssetUserData<UCesiumMaterialUserData>()
-          : nullptr;
-
-  // If possible and necessary, attach the CesiumMaterialUserData now.
-#if WITH_EDITORONLY_DATA
-  if (pBaseAsMaterialInstance && !pCesiumData) {
-    const FStaticParameterSet& parameters =
-        pBaseAsMaterialInstance->GetStaticParameters();
-
-    bool hasLayers = parameters.bHasMaterialLayers;
-    if (hasLayers) {
-#if WITH_EDITOR
-      FScopedTransaction transaction(
-          FText::FromString("Add Cesium User Data to Material"));
-      pBaseAsMaterialInstance->Modify();
-#endif
-      pCesiumData = NewObject<UCesiumMaterialUserData>(
-          pBaseAsMaterialInstance,
-          NAME_None,
-          RF_Transactional);
-      pBaseAsMaterialInstance->AddAssetUserData(pCesiumData);
-      pCesiumData->PostEditChangeOwner();
-    }
-  }
-#endif
-
   if (pCesiumData) {
     SetGltfParameterValues(
         model,
@@ -2700,7 +2866,7 @@ static void loadPrimitiveGameThreadPart(
     if (featuresMetadataIndex >= 0) {
       SetFeaturesMetadataParameterValues(
           model,
-          *pGltf,
+          gltfComponent,
           loadResult,
           pMaterial,
           EMaterialParameterAssociation::LayerParameter,
@@ -2709,13 +2875,223 @@ static void loadPrimitiveGameThreadPart(
       // Set parameters for materials generated by the old implementation
       SetMetadataParameterValues_DEPRECATED(
           model,
-          *pGltf,
+          gltfComponent,
           loadResult,
           pMaterial,
           EMaterialParameterAssociation::LayerParameter,
           metadataIndex);
     }
   }
+}
+
+static void addStreamedTexture(
+    const TUniquePtr<LoadedTextureResult>& pLoadedTexture,
+    UCesiumGltfPrimitiveComponent* pMesh) {
+  if (pLoadedTexture) {
+    CesiumTextureStreaming::get().addTexture(
+        pLoadedTexture->pTexture.Get(),
+        *pLoadedTexture,
+        pMesh);
+  }
+}
+
+static void loadPrimitiveGameThreadPart(
+    const CesiumGltf::Model& model,
+    UCesiumGltfComponent* pGltf,
+    LoadPrimitiveResult& loadResult,
+    const glm::dmat4x4& cesiumToUnrealTransform,
+    const Cesium3DTilesSelection::Tile& tile,
+    bool createNavCollision,
+    ACesium3DTileset* pTilesetActor,
+    UCesiumGltfComponentPool* pComponentPool,
+    UCesiumMaterialInstanceCache* pMaterialCache,
+    bool shareMaterialInstances) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
+
+  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
+      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
+
+  const Material& material =
+      loadResult.pMaterial ? *loadResult.pMaterial : defaultMaterial;
+
+  const MaterialPBRMetallicRoughness& pbr =
+      material.pbrMetallicRoughness ? material.pbrMetallicRoughness.value()
+                                    : defaultPbrMetallicRoughness;
+
+  const auto is_in_blend_mode = [](auto& result) {
+    return !!result.pMaterial && result.pMaterial->alphaMode ==
+                                     CesiumGltf::Material::AlphaMode::BLEND;
+  };
+
+#if PLATFORM_MAC
+  // TODO: figure out why water material crashes mac
+  UMaterialInterface* pBaseMaterial =
+      (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
+       pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
+          ? pGltf->BaseMaterialWithTranslucency
+          : pGltf->BaseMaterial;
+#else
+  UMaterialInterface* pBaseMaterial;
+  if (loadResult.onlyWater || !loadResult.onlyLand) {
+    pBaseMaterial = pGltf->BaseMaterialWithWater;
+  } else {
+    pBaseMaterial =
+        (is_in_blend_mode(loadResult) && pbr.baseColorFactor.size() > 3 &&
+         pbr.baseColorFactor[3] < 0.996) // 1. - 1. / 256.
+            ? pGltf->BaseMaterialWithTranslucency
+            : pGltf->BaseMaterial;
+  }
+#endif
+
+  const bool isPoints =
+      loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS;
+  UClass* pComponentClass = isPoints
+                                ? UCesiumGltfPointsComponent::StaticClass()
+                                : UCesiumGltfPrimitiveComponent::StaticClass();
+
+  FName meshName = createSafeName(loadResult.name, "");
+
+  // A recycled component already has a static mesh and a material instance of
+  // the right base material, so only their contents need to be replaced.
+  UCesiumGltfPrimitiveComponent* pMesh =
+      pComponentPool ? pComponentPool->AcquirePrimitiveComponent(
+                           pGltf,
+                           meshName,
+                           pComponentClass,
+                           pBaseMaterial)
+                     : nullptr;
+  const bool isRecycled = pMesh != nullptr;
+  if (!isRecycled) {
+    pMesh = NewObject<UCesiumGltfPrimitiveComponent>(
+        pGltf,
+        pComponentClass,
+        meshName);
+  }
+
+  if (isPoints) {
+    UCesiumGltfPointsComponent* pPointMesh =
+        CastChecked<UCesiumGltfPointsComponent>(pMesh);
+    pPointMesh->UsesAdditiveRefinement =
+        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
+    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
+    pPointMesh->Dimensions = loadResult.dimensions;
+  }
+
+  pMesh->pTilesetActor = pTilesetActor;
+  pMesh->overlayTextureCoordinateIDToUVIndex =
+      loadResult.overlayTextureCoordinateIDToUVIndex;
+  pMesh->GltfToUnrealTexCoordMap =
+      std::move(loadResult.GltfToUnrealTexCoordMap);
+  pMesh->TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
+  pMesh->PositionAccessor = std::move(loadResult.PositionAccessor);
+  pMesh->IndexAccessor = std::move(loadResult.IndexAccessor);
+  pMesh->HighPrecisionNodeTransform = loadResult.transform;
+  pMesh->UpdateTransformFromCesium(cesiumToUnrealTransform);
+
+  pMesh->bUseDefaultCollision = false;
+  pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+  pMesh->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pMesh->pModel = loadResult.pModel;
+  pMesh->pMeshPrimitive = loadResult.pMeshPrimitive;
+  pMesh->boundingVolume = boundingVolume;
+  pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
+  pMesh->SetCustomDepthStencilWriteMask(
+      pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
+  pMesh->SetCustomDepthStencilValue(
+      pGltf->CustomDepthParameters.CustomDepthStencilValue);
+  pMesh->bCastDynamicShadow = !loadResult.isUnlit;
+
+  UStaticMesh* pStaticMesh;
+  UMaterialInstanceDynamic* pMaterial = nullptr;
+  if (isRecycled) {
+    pStaticMesh = pMesh->GetStaticMesh();
+    if (!pMesh->SharesMaterialInstance) {
+      pMaterial =
+          CastChecked<UMaterialInstanceDynamic>(pStaticMesh->GetMaterial(0));
+    }
+  } else {
+    pStaticMesh = NewObject<UStaticMesh>(pMesh, meshName);
+    pMesh->SetStaticMesh(pStaticMesh);
+
+    pStaticMesh->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pStaticMesh->NeverStream = true;
+  }
+
+  pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+
+  UCesiumMaterialUserData* pCesiumData = getOrAddCesiumUserData(pBaseMaterial);
+
+  // Primitives without textures of their own differ only in a few factors, so
+  // all primitives with the same factors can share one material instance.
+  const bool shareMaterial =
+      shareMaterialInstances && pMaterialCache &&
+      !hasPrimitiveTextures(loadResult) &&
+      pMaterialCache->CanShare(
+          pBaseMaterial,
+          pTilesetActor->GetUseLodTransitions());
+
+  bool initializeMaterial = true;
+  if (shareMaterial) {
+    const CesiumMaterialSignature signature =
+        computeMaterialSignature(loadResult, material, pbr, pBaseMaterial);
+    UMaterialInstanceDynamic* pSharedMaterial =
+        pMaterialCache->Find(signature);
+    if (pSharedMaterial) {
+      initializeMaterial = false;
+    } else {
+      pSharedMaterial = createMaterialInstance(pBaseMaterial);
+      pMaterialCache->Add(signature, pSharedMaterial);
+    }
+
+    if (pMaterial) {
+      // A recycled primitive's own material instance is no longer needed.
+      CesiumLifetime::destroy(pMaterial);
+    }
+    pMaterial = pSharedMaterial;
+  } else if (!pMaterial) {
+    pMaterial = createMaterialInstance(pBaseMaterial);
+  }
+
+  pMesh->SharesMaterialInstance = shareMaterial;
+  if (pStaticMesh->GetStaticMaterials().Num() > 0) {
+    pStaticMesh->GetStaticMaterials()[0].MaterialInterface = pMaterial;
+  } else {
+    pStaticMesh->AddMaterial(pMaterial);
+  }
+
+  if (initializeMaterial) {
+    SetMaterialParameterValues(
+        model,
+        *pGltf,
+        loadResult,
+        material,
+        pbr,
+        pMaterial,
+        pCesiumData);
+  }
+
+  addStreamedTexture(loadResult.baseColorTexture, pMesh);
+  addStreamedTexture(loadResult.metallicRoughnessTexture, pMesh);
+  addStreamedTexture(loadResult.normalTexture, pMesh);
+  addStreamedTexture(loadResult.emissiveTexture, pMesh);
+  addStreamedTexture(loadResult.occlusionTexture, pMesh);
+
+  // Materials that read their fade parameters from custom primitive data need
+  // them initialized on the primitive rather than on the material instance.
+  pMesh->FadePrimitiveDataIndices =
+      pMaterialCache
+          ? pMaterialCache->GetFadePrimitiveDataIndices(pBaseMaterial)
+          : CesiumFadePrimitiveDataIndices();
+  if (pMesh->FadePrimitiveDataIndices.usesCustomPrimitiveData()) {
+    pMesh->SetCustomPrimitiveDataFloat(
+        pMesh->FadePrimitiveDataIndices.fadePercentage,
+        1.0f);
+    pMesh->SetCustomPrimitiveDataFloat(
+        pMesh->FadePrimitiveDataIndices.fadingType,
+        0.0f);
+  }
 
   pMesh->Features = std::move(loadResult.Features);
   pMesh->Metadata = std::move(loadResult.Metadata);
@@ -2723,6 +3099,14 @@ static void loadPrimitiveGameThreadPart(
   pMesh->EncodedFeatures = std::move(loadResult.EncodedFeatures);
   pMesh->EncodedMetadata = std::move(loadResult.EncodedMetadata);
 
+  if (pTilesetActor) {
+    UCesiumFeatureStylingComponent* pStyling =
+        pTilesetActor->FindComponentByClass<UCesiumFeatureStylingComponent>();
+    if (pStyling) {
+      pStyling->BindStyleTextures(*pMesh);
+    }
+  }
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
   // Doing the above std::move operations invalidates the pointers in the
@@ -2740,10 +3124,6 @@ static void loadPrimitiveGameThreadPart(
 
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
-  pMaterial->TwoSided = true;
-
-  pStaticMesh->AddMaterial(pMaterial);
-
   pStaticMesh->SetLightingGuid();
   pStaticMesh->InitResources();
 
@@ -2786,6 +3166,12 @@ UCesiumGltfComponent::CreateOffGameThread(
   auto pResult = MakeUnique<HalfConstructedReal>();
   loadModelAnyThreadPart(pResult->loadModelResult, Transform, Options);
 
+  if (Options.releaseBuffers) {
+    trimModelAnyThreadPart(pResult->loadModelResult, Options);
+  }
+  pResult->loadModelResult.ResidentCpuBytes =
+      CesiumModelTrimming::computeCpuBytes(*Options.pModel);
+
   return pResult;
 }
 
@@ -2799,7 +3185,10 @@ UCesiumGltfComponent::CreateOffGameThread(
     UMaterialInterface* pBaseWaterMaterial,
     FCustomDepthParameters CustomDepthParameters,
     const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision) {
+    bool createNavCollision,
+    UCesiumGltfComponentPool* pComponentPool,
+    UCesiumMaterialInstanceCache* pMaterialCache,
+    bool shareMaterialInstances) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadModel)
 
@@ -2812,7 +3201,11 @@ UCesiumGltfComponent::CreateOffGameThread(
   //   return nullptr;
   // }
 
-  UCesiumGltfComponent* Gltf = NewObject<UCesiumGltfComponent>(pTilesetActor);
+  UCesiumGltfComponent* Gltf =
+      pComponentPool ? pComponentPool->AcquireGltfComponent() : nullptr;
+  if (!Gltf) {
+    Gltf = NewObject<UCesiumGltfComponent>(pTilesetActor);
+  }
   Gltf->SetMobility(pTilesetActor->GetRootComponent()->Mobility);
   Gltf->SetFlags(RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
 
@@ -2821,6 +3214,10 @@ UCesiumGltfComponent::CreateOffGameThread(
   Gltf->EncodedMetadata_DEPRECATED =
       std::move(pReal->loadModelResult.EncodedMetadata_DEPRECATED);
 
+  Gltf->ResidentGltfBytes = pReal->loadModelResult.ResidentCpuBytes;
+  Gltf->ReleasedGltfBytes = pReal->loadModelResult.ReleasedCpuBytes;
+  INC_MEMORY_STAT_BY(STAT_CesiumGltfCpuMemory, Gltf->ResidentGltfBytes);
+
   if (pBaseMaterial) {
     Gltf->BaseMaterial = pBaseMaterial;
   }
@@ -2851,7 +3248,10 @@ UCesiumGltfComponent::CreateOffGameThread(
             cesiumToUnrealTransform,
             tile,
             createNavCollision,
-            pTilesetActor);
+            pTilesetActor,
+            pComponentPool,
+            pMaterialCache,
+            shareMaterialInstances);
       }
     }
   }
@@ -2939,6 +3339,29 @@ void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
   }
 } // namespace
 
+void unshareMaterialInstance(UCesiumGltfPrimitiveComponent* pPrimitive) {
+  if (!pPrimitive->SharesMaterialInstance) {
+    return;
+  }
+
+  UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+  UMaterialInstanceDynamic* pSharedMaterial =
+      pStaticMesh
+          ? Cast<UMaterialInstanceDynamic>(pStaticMesh->GetMaterial(0))
+          : nullptr;
+  if (!IsValid(pSharedMaterial)) {
+    return;
+  }
+
+  UMaterialInstanceDynamic* pMaterial =
+      createMaterialInstance(pSharedMaterial->Parent);
+  pMaterial->CopyParameterOverrides(pSharedMaterial);
+
+  pStaticMesh->GetStaticMaterials()[0].MaterialInterface = pMaterial;
+  pPrimitive->SharesMaterialInstance = false;
+  pPrimitive->MarkRenderStateDirty();
+}
+
 } // namespace
 
 void UCesiumGltfComponent::AttachRasterTile(
@@ -2951,6 +3374,16 @@ void UCesiumGltfComponent::AttachRasterTile(
 
   FVector4 translationAndScale(translation.x, translation.y, scale.x, scale.y);
 
+  // Raster overlay textures are specific to this tile, so primitives can no
+  // longer share their material instances once one is attached.
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
+    if (pPrimitive) {
+      unshareMaterialInstance(pPrimitive);
+    }
+  }
+
   forEachPrimitiveComponent(
       this,
       [&rasterTile, pTexture, &translationAndScale, textureCoordinateID](
@@ -3020,6 +3453,11 @@ void UCesiumGltfComponent::DetachRasterTile(
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
+        if (pPrimitive->SharesMaterialInstance) {
+          // The raster tile was never attached to this primitive.
+          return;
+        }
+
         // If this material uses material layers and has the Cesium user data,
         // clear the parameters on each material layer that maps to this
         // overlay tile.
@@ -3057,9 +3495,11 @@ void UCesiumGltfComponent::SetCollisionEnabled(
   }
 }
 
-void UCesiumGltfComponent::BeginDestroy() {
+void UCesiumGltfComponent::ReleaseTileResources() {
   CesiumEncodedFeaturesMetadata::destroyEncodedModelMetadata(
       this->EncodedMetadata);
+  this->EncodedMetadata = {};
+  this->Metadata = FCesiumModelMetadata();
 
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   if (this->EncodedMetadata_DEPRECATED) {
@@ -3069,6 +3509,17 @@ void UCesiumGltfComponent::BeginDestroy() {
   }
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
+  DEC_MEMORY_STAT_BY(STAT_CesiumGltfCpuMemory, this->ResidentGltfBytes);
+  this->ResidentGltfBytes = 0;
+  this->ReleasedGltfBytes = 0;
+
+  this->_hasFadeState = false;
+  this->_fadeLayerIndex = FadeLayerIndexUnresolved;
+}
+
+void UCesiumGltfComponent::BeginDestroy() {
+  this->ReleaseTileResources();
+
   Super::BeginDestroy();
 }
 
@@ -3079,17 +3530,19 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
 
   fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
 
-  UCesiumMaterialUserData* pCesiumData =
-      BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>();
-
-  if (!pCesiumData) {
+  // Tiles stay in the fading lists for a frame after their transition is
+  // complete, so avoid dirtying anything when nothing has changed.
+  const bool fadingTypeChanged =
+      !this->_hasFadeState || this->_lastFadingIn != fadingIn;
+  if (!fadingTypeChanged && this->_lastFadePercentage == fadePercentage) {
     return;
   }
 
-  int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
-  if (fadeLayerIndex < 0) {
-    return;
-  }
+  this->_hasFadeState = true;
+  this->_lastFadePercentage = fadePercentage;
+  this->_lastFadingIn = fadingIn;
+
+  const float fadingType = fadingIn ? 0.0f : 1.0f;
 
   for (USceneComponent* pChild : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
@@ -3098,6 +3551,41 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
       continue;
     }
 
+    const CesiumFadePrimitiveDataIndices& indices =
+        pPrimitive->FadePrimitiveDataIndices;
+    if (indices.usesCustomPrimitiveData()) {
+      // Custom primitive data only updates the primitive's scene data, so the
+      // material instance and its uniform buffer are left untouched.
+      if (fadingTypeChanged &&
+          indices.fadingType == indices.fadePercentage + 1) {
+        pPrimitive->SetCustomPrimitiveDataVector2(
+            indices.fadePercentage,
+            FVector2D(fadePercentage, fadingType));
+        continue;
+      }
+
+      pPrimitive->SetCustomPrimitiveDataFloat(
+          indices.fadePercentage,
+          fadePercentage);
+      if (fadingTypeChanged) {
+        pPrimitive->SetCustomPrimitiveDataFloat(
+            indices.fadingType,
+            fadingType);
+      }
+      continue;
+    }
+
+    if (pPrimitive->SharesMaterialInstance) {
+      // Primitives only share a material instance that has a fade parameter
+      // if LOD transitions are disabled.
+      continue;
+    }
+
+    const int32 fadeLayerIndex = this->GetFadeLayerIndex();
+    if (fadeLayerIndex < 0) {
+      continue;
+    }
+
     UMaterialInstanceDynamic* pMaterial =
         Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterials()[0]);
     if (!pMaterial) {
@@ -3110,13 +3598,26 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
             EMaterialParameterAssociation::LayerParameter,
             fadeLayerIndex),
         fadePercentage);
-    pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            "FadingType",
-            EMaterialParameterAssociation::LayerParameter,
-            fadeLayerIndex),
-        fadingIn ? 0.0f : 1.0f);
+    if (fadingTypeChanged) {
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "FadingType",
+              EMaterialParameterAssociation::LayerParameter,
+              fadeLayerIndex),
+          fadingType);
+    }
+  }
+}
+
+int32 UCesiumGltfComponent::GetFadeLayerIndex() {
+  if (this->_fadeLayerIndex == FadeLayerIndexUnresolved) {
+    UCesiumMaterialUserData* pCesiumData =
+        BaseMaterial ? BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>()
+                     : nullptr;
+    this->_fadeLayerIndex =
+        pCesiumData ? pCesiumData->LayerNames.Find("DitherFade") : INDEX_NONE;
   }
+  return this->_fadeLayerIndex;
 }
 
 static bool isTriangleDegenerate(
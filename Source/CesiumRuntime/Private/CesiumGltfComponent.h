@@ -16,6 +16,8 @@
 #include <memory>
 #include "CesiumGltfComponent.generated.h"
 
+class UCesiumGltfComponentPool;
+class UCesiumMaterialInstanceCache;
 class UMaterialInterface;
 class UTexture2D;
 class UStaticMeshComponent;
@@ -78,7 +80,10 @@ public:
       UMaterialInterface* BaseWaterMaterial,
       FCustomDepthParameters CustomDepthParameters,
       const Cesium3DTilesSelection::Tile& tile,
-      bool createNavCollision);
+      bool createNavCollision,
+      UCesiumGltfComponentPool* ComponentPool,
+      UCesiumMaterialInstanceCache* MaterialCache,
+      bool ShareMaterialInstances);
 
   UCesiumGltfComponent();
   virtual ~UCesiumGltfComponent();
@@ -103,6 +108,18 @@ public:
       EncodedMetadata_DEPRECATED = std::nullopt;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
+  /**
+   * The number of bytes of the tile's glTF buffers and decoded images that
+   * remain in CPU memory while the tile is loaded.
+   */
+  int64 ResidentGltfBytes = 0;
+
+  /**
+   * The number of bytes of the tile's glTF buffers and decoded images that
+   * were released after its meshes and textures were uploaded.
+   */
+  int64 ReleasedGltfBytes = 0;
+
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
   void AttachRasterTile(
@@ -121,11 +138,37 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Collision")
   virtual void SetCollisionEnabled(ECollisionEnabled::Type NewType);
 
+  /**
+   * Destroys the encoded metadata that was created for the tile this component
+   * represents. This is done before the component is destroyed or recycled for
+   * another tile.
+   */
+  void ReleaseTileResources();
+
   virtual void BeginDestroy() override;
 
+  /**
+   * Updates the LOD transition state of this tile's primitives. Primitives
+   * whose material reads the DitherFade layer's parameters from custom
+   * primitive data are updated without touching their material instance.
+   * Calls that would not change the state are ignored.
+   */
   void UpdateFade(float fadePercentage, bool fadingIn);
 
 private:
+  static constexpr int32 FadeLayerIndexUnresolved = -2;
+
+  /**
+   * Gets the index of the DitherFade layer in the base material, or
+   * INDEX_NONE if there is none.
+   */
+  int32 GetFadeLayerIndex();
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  bool _hasFadeState = false;
+  bool _lastFadingIn = false;
+  float _lastFadePercentage = 0.0f;
+  int32 _fadeLayerIndex = FadeLayerIndexUnresolved;
 };
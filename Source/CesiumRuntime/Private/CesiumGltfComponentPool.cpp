@@ -0,0 +1,216 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfComponentPool.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumRuntime.h"
+#if WITH_EDITOR
+#include "Editor.h"
+#include "Editor/EditorEngine.h"
+#include "Engine/Selection.h"
+#endif
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace {
+constexpr ERenameFlags PoolRenameFlags =
+    REN_DontCreateRedirectors | REN_DoNotDirty | REN_NonTransactional |
+    REN_ForceNoResetLoaders;
+
+void deselectInEditor(USceneComponent* pComponent) {
+#if WITH_EDITOR
+  // If the editor is currently selecting this, remove the reference
+  if (GEditor) {
+    USelection* editorSelection = GEditor->GetSelectedComponents();
+    if (editorSelection && editorSelection->IsSelected(pComponent))
+      editorSelection->Deselect(pComponent);
+  }
+#endif
+}
+
+UMaterialInstanceDynamic*
+getPrimitiveMaterial(const UCesiumGltfPrimitiveComponent* pPrimitive) {
+  const UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+  return pStaticMesh
+             ? Cast<UMaterialInstanceDynamic>(pStaticMesh->GetMaterial(0))
+             : nullptr;
+}
+} // namespace
+
+UCesiumGltfComponent* UCesiumGltfComponentPool::AcquireGltfComponent() {
+  while (this->PooledTileComponents.Num() > 0) {
+    UCesiumGltfComponent* pGltf = this->PooledTileComponents.Pop(false);
+    if (IsValid(pGltf)) {
+      ++this->_tileComponentHits;
+      return pGltf;
+    }
+  }
+
+  ++this->_tileComponentMisses;
+  return nullptr;
+}
+
+UCesiumGltfPrimitiveComponent*
+UCesiumGltfComponentPool::AcquirePrimitiveComponent(
+    UCesiumGltfComponent* Gltf,
+    FName Name,
+    UClass* ComponentClass,
+    UMaterialInterface* BaseMaterial) {
+  // Prefer the most recently released components, but skip any whose render
+  // resources are still being released on the render thread.
+  for (int32 i = this->PooledPrimitiveComponents.Num() - 1; i >= 0; --i) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        this->PooledPrimitiveComponents[i];
+    if (!IsValid(pPrimitive)) {
+      this->PooledPrimitiveComponents.RemoveAt(i, 1, false);
+      continue;
+    }
+
+    if (pPrimitive->GetClass() != ComponentClass) {
+      continue;
+    }
+
+    UMaterialInstanceDynamic* pMaterial = getPrimitiveMaterial(pPrimitive);
+    if (!pMaterial || pMaterial->Parent != BaseMaterial) {
+      continue;
+    }
+
+    const UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+    if (!pStaticMesh->ReleaseResourcesFence.IsFenceComplete()) {
+      continue;
+    }
+
+    this->PooledPrimitiveComponents.RemoveAt(i, 1, false);
+
+    // Code elsewhere expects a primitive's outer to be its tile component.
+    pPrimitive->Rename(
+        *MakeUniqueObjectName(Gltf, ComponentClass, Name).ToString(),
+        Gltf,
+        PoolRenameFlags);
+
+    ++this->_primitiveComponentHits;
+    return pPrimitive;
+  }
+
+  ++this->_primitiveComponentMisses;
+  return nullptr;
+}
+
+void UCesiumGltfComponentPool::Release(
+    UCesiumGltfComponent* Gltf,
+    int32 MaximumTileComponents,
+    int32 MaximumPrimitiveComponents) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseComponentToPool)
+
+  if (!Gltf) {
+    return;
+  }
+
+  if (Gltf->IsRegistered()) {
+    Gltf->UnregisterComponent();
+  }
+
+  TArray<USceneComponent*> children = Gltf->GetAttachChildren();
+  for (USceneComponent* pChild : children) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (pPrimitive) {
+      this->ReleasePrimitive(pPrimitive, MaximumPrimitiveComponents);
+    } else {
+      CesiumLifetime::destroyComponentRecursively(pChild);
+    }
+  }
+
+  if (this->PooledTileComponents.Num() >= MaximumTileComponents) {
+    CesiumLifetime::destroyComponentRecursively(Gltf);
+    return;
+  }
+
+  deselectInEditor(Gltf);
+  Gltf->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+  Gltf->ReleaseTileResources();
+
+  // The next tile may be loaded with different materials, so restore the
+  // defaults that CreateOnGameThread expects.
+  const UCesiumGltfComponent* pDefaults = GetDefault<UCesiumGltfComponent>();
+  Gltf->BaseMaterial = pDefaults->BaseMaterial;
+  Gltf->BaseMaterialWithTranslucency = pDefaults->BaseMaterialWithTranslucency;
+  Gltf->BaseMaterialWithWater = pDefaults->BaseMaterialWithWater;
+
+  this->PooledTileComponents.Add(Gltf);
+}
+
+void UCesiumGltfComponentPool::ReleasePrimitive(
+    UCesiumGltfPrimitiveComponent* Primitive,
+    int32 MaximumPrimitiveComponents) {
+  UStaticMesh* pStaticMesh = Primitive->GetStaticMesh();
+  UMaterialInstanceDynamic* pMaterial = getPrimitiveMaterial(Primitive);
+  if (!pMaterial ||
+      this->PooledPrimitiveComponents.Num() >= MaximumPrimitiveComponents) {
+    CesiumLifetime::destroyComponentRecursively(Primitive);
+    return;
+  }
+
+  if (Primitive->IsRegistered()) {
+    Primitive->UnregisterComponent();
+  }
+
+  deselectInEditor(Primitive);
+  Primitive->DetachFromComponent(
+      FDetachmentTransformRules::KeepRelativeTransform);
+
+  // Destroy the tile-specific textures before their material parameters are
+  // cleared, and start releasing the render resources. The render data itself
+  // is replaced when the component is reused, once the release fence has
+  // completed.
+  Primitive->ReleaseTileResources();
+  if (!Primitive->SharesMaterialInstance) {
+    pMaterial->ClearParameterValues();
+  }
+  pStaticMesh->ReleaseResources();
+
+  UBodySetup* pBodySetup = pStaticMesh->GetBodySetup();
+  if (pBodySetup) {
+    pBodySetup->ClearPhysicsMeshes();
+  }
+
+  // Move the component out of its tile component, so that the tile component
+  // can be reused or destroyed independently.
+  const FName pooledName =
+      MakeUniqueObjectName(this, Primitive->GetClass(), Primitive->GetFName());
+  Primitive->Rename(*pooledName.ToString(), this, PoolRenameFlags);
+
+  this->PooledPrimitiveComponents.Add(Primitive);
+}
+
+void UCesiumGltfComponentPool::Clear() {
+  for (UCesiumGltfPrimitiveComponent* pPrimitive :
+       this->PooledPrimitiveComponents) {
+    if (IsValid(pPrimitive)) {
+      CesiumLifetime::destroyComponentRecursively(pPrimitive);
+    }
+  }
+  this->PooledPrimitiveComponents.Empty();
+
+  for (UCesiumGltfComponent* pGltf : this->PooledTileComponents) {
+    if (IsValid(pGltf)) {
+      CesiumLifetime::destroyComponentRecursively(pGltf);
+    }
+  }
+  this->PooledTileComponents.Empty();
+
+  ++this->_generation;
+}
+
+FCesiumComponentPoolStatistics UCesiumGltfComponentPool::GetStatistics() const {
+  FCesiumComponentPoolStatistics statistics;
+  statistics.PooledTileComponents = this->PooledTileComponents.Num();
+  statistics.PooledPrimitiveComponents = this->PooledPrimitiveComponents.Num();
+  statistics.TileComponentHits = this->_tileComponentHits;
+  statistics.TileComponentMisses = this->_tileComponentMisses;
+  statistics.PrimitiveComponentHits = this->_primitiveComponentHits;
+  statistics.PrimitiveComponentMisses = this->_primitiveComponentMisses;
+  return statistics;
+}
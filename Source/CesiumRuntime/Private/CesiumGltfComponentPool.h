@@ -0,0 +1,83 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumComponentPoolStatistics.h"
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "CesiumGltfComponentPool.generated.h"
+
+class UCesiumGltfComponent;
+class UCesiumGltfPrimitiveComponent;
+class UMaterialInterface;
+
+/**
+ * Recycles the components of unloaded tiles, so that later tile loads can
+ * reuse them instead of creating new UObjects. Each pooled primitive component
+ * keeps its UStaticMesh, UBodySetup, and UMaterialInstanceDynamic; only the
+ * render data, physics meshes, and material parameters are reset when it is
+ * released.
+ */
+UCLASS()
+class UCesiumGltfComponentPool : public UObject {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Takes a tile component from the pool, or returns nullptr if the pool is
+   * empty. The returned component is not registered or attached.
+   */
+  UCesiumGltfComponent* AcquireGltfComponent();
+
+  /**
+   * Takes a primitive component of the given class, whose material instance
+   * was created from the given base material, from the pool. Returns nullptr
+   * if the pool has no such component. The returned component is renamed into
+   * the given tile component, but is not registered or attached.
+   */
+  UCesiumGltfPrimitiveComponent* AcquirePrimitiveComponent(
+      UCesiumGltfComponent* Gltf,
+      FName Name,
+      UClass* ComponentClass,
+      UMaterialInterface* BaseMaterial);
+
+  /**
+   * Releases an unloaded tile component and all of its primitive components
+   * into the pool. Components that do not fit within the given limits are
+   * destroyed instead.
+   */
+  void Release(
+      UCesiumGltfComponent* Gltf,
+      int32 MaximumTileComponents,
+      int32 MaximumPrimitiveComponents);
+
+  /**
+   * Destroys all components in the pool and starts a new generation.
+   */
+  void Clear();
+
+  /**
+   * Gets the number of times the pool has been cleared. Components that were
+   * created before the pool was cleared should not be released into it.
+   */
+  int32 GetGeneration() const { return this->_generation; }
+
+  FCesiumComponentPoolStatistics GetStatistics() const;
+
+private:
+  void ReleasePrimitive(
+      UCesiumGltfPrimitiveComponent* Primitive,
+      int32 MaximumPrimitiveComponents);
+
+  UPROPERTY()
+  TArray<UCesiumGltfComponent*> PooledTileComponents;
+
+  UPROPERTY()
+  TArray<UCesiumGltfPrimitiveComponent*> PooledPrimitiveComponents;
+
+  int32 _generation = 0;
+  int64 _tileComponentHits = 0;
+  int64 _tileComponentMisses = 0;
+  int64 _primitiveComponentHits = 0;
+  int64 _primitiveComponentMisses = 0;
+};
@@ -6,6 +6,8 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumLifetime.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumRuntime.h"
+#include "CesiumStats.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture.h"
 #include "Materials/MaterialInstanceDynamic.h"
@@ -13,6 +15,11 @@
 #include "VecMath.h"
 #include <variant>
 
+DECLARE_MEMORY_STAT(
+    TEXT("Picking BVH Memory"),
+    STAT_CesiumPickingBvhBytes,
+    STATGROUP_Cesium);
+
 // Prevent deprecation warnings while initializing deprecated metadata structs.
 PRAGMA_DISABLE_DEPRECATION_WARNINGS
 
@@ -95,12 +102,47 @@ void destroyWaterParameterValues(
 }
 } // namespace
 
-void UCesiumGltfPrimitiveComponent::BeginDestroy() {
+const CesiumPrimitiveBvh* UCesiumGltfPrimitiveComponent::GetPickingBvh() {
+  if (this->PickingBvh) {
+    return this->PickingBvh.Get();
+  }
+
+  // Face indices only refer to the faces of a triangle list, as in
+  // GetFirstVertexFromFace.
+  using CesiumGltf::MeshPrimitive;
+  if (!this->pMeshPrimitive ||
+      this->pMeshPrimitive->mode != MeshPrimitive::Mode::TRIANGLES) {
+    return nullptr;
+  }
+
+  this->PickingBvh =
+      CesiumPrimitiveBvh::create(this->PositionAccessor, this->IndexAccessor);
+  if (!this->PickingBvh) {
+    return nullptr;
+  }
+
+  INC_MEMORY_STAT_BY(
+      STAT_CesiumPickingBvhBytes,
+      this->PickingBvh->getAllocatedSize());
+  UE_LOG(
+      LogCesium,
+      Verbose,
+      TEXT(
+          "Built the picking BVH of %s with %d triangles in %.3f ms, using %llu bytes"),
+      *this->GetName(),
+      this->PickingBvh->getTriangleCount(),
+      this->PickingBvh->getBuildSeconds() * 1000.0,
+      uint64(this->PickingBvh->getAllocatedSize()));
+
+  return this->PickingBvh.Get();
+}
+
+void UCesiumGltfPrimitiveComponent::ReleaseTileResources() {
   // This should mirror the logic in loadPrimitiveGameThreadPart in
   // CesiumGltfComponent.cpp
   UMaterialInstanceDynamic* pMaterial =
       Cast<UMaterialInstanceDynamic>(this->GetMaterial(0));
-  if (pMaterial) {
+  if (pMaterial && !this->SharesMaterialInstance) {
 
     destroyGltfParameterValues(
         pMaterial,
@@ -133,18 +175,49 @@ void UCesiumGltfPrimitiveComponent::BeginDestroy() {
             waterIndex);
       }
     }
+  }
 
-    CesiumEncodedFeaturesMetadata::destroyEncodedPrimitiveFeatures(
-        this->EncodedFeatures);
+  CesiumEncodedFeaturesMetadata::destroyEncodedPrimitiveFeatures(
+      this->EncodedFeatures);
 
-    PRAGMA_DISABLE_DEPRECATION_WARNINGS
-    if (this->EncodedMetadata_DEPRECATED) {
-      CesiumEncodedMetadataUtility::destroyEncodedMetadataPrimitive(
-          *this->EncodedMetadata_DEPRECATED);
-      this->EncodedMetadata_DEPRECATED = std::nullopt;
-    }
-    PRAGMA_ENABLE_DEPRECATION_WARNINGS
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  if (this->EncodedMetadata_DEPRECATED) {
+    CesiumEncodedMetadataUtility::destroyEncodedMetadataPrimitive(
+        *this->EncodedMetadata_DEPRECATED);
+    this->EncodedMetadata_DEPRECATED = std::nullopt;
+  }
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  this->Features = FCesiumPrimitiveFeatures();
+  this->Metadata = FCesiumPrimitiveMetadata();
+  this->EncodedFeatures = {};
+  this->EncodedMetadata = {};
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  this->Metadata_DEPRECATED = FCesiumMetadataPrimitive();
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  this->pModel = nullptr;
+  this->pMeshPrimitive = nullptr;
+  this->GltfToUnrealTexCoordMap.clear();
+  this->TexCoordAccessorMap.clear();
+  this->PositionAccessor = {};
+  this->IndexAccessor = {};
+  this->boundingVolume.reset();
+
+  if (this->PickingBvh) {
+    DEC_MEMORY_STAT_BY(
+        STAT_CesiumPickingBvhBytes,
+        this->PickingBvh->getAllocatedSize());
+    this->PickingBvh.Reset();
+  }
+}
 
+void UCesiumGltfPrimitiveComponent::BeginDestroy() {
+  this->ReleaseTileResources();
+
+  UMaterialInstanceDynamic* pMaterial =
+      Cast<UMaterialInstanceDynamic>(this->GetMaterial(0));
+  if (pMaterial && !this->SharesMaterialInstance) {
     CesiumLifetime::destroy(pMaterial);
   }
 
@@ -6,7 +6,9 @@
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
+#include "CesiumMaterialInstanceCache.h"
 #include "CesiumMetadataPrimitive.h"
+#include "CesiumPrimitiveBvh.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumRasterOverlays.h"
 #include "Components/StaticMeshComponent.h"
@@ -104,6 +106,25 @@ public:
 
   std::optional<Cesium3DTilesSelection::BoundingVolume> boundingVolume;
 
+  /**
+   * The bounding volume hierarchy of this primitive's triangles, if it has
+   * been built. See GetPickingBvh.
+   */
+  TUniquePtr<CesiumPrimitiveBvh> PickingBvh;
+
+  /**
+   * Whether this primitive's material instance is shared with other
+   * primitives that have identical material parameters. A shared material
+   * instance must not be modified or destroyed by this component.
+   */
+  bool SharesMaterialInstance = false;
+
+  /**
+   * The custom primitive data indices that this primitive's material reads
+   * its LOD transition parameters from, if any.
+   */
+  CesiumFadePrimitiveDataIndices FadePrimitiveDataIndices;
+
   /**
    * Updates this component's transform from a new double-precision
    * transformation from the Cesium world to the Unreal Engine world, as well as
@@ -113,6 +134,24 @@ public:
    */
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
+  /**
+   * Gets the bounding volume hierarchy that line traces use to pick this
+   * primitive without a physics mesh. It is built from PositionAccessor and
+   * IndexAccessor the first time it's needed, and released with the tile's
+   * resources.
+   *
+   * @return The hierarchy, or nullptr if the primitive isn't made of
+   * triangles or its positions are not available.
+   */
+  const CesiumPrimitiveBvh* GetPickingBvh();
+
+  /**
+   * Destroys the textures and encoded metadata that were created for the tile
+   * this component represents, and clears the references into its glTF. This
+   * is done before the component is destroyed or recycled for another tile.
+   */
+  void ReleaseTileResources();
+
   virtual void BeginDestroy() override;
 
   virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const;
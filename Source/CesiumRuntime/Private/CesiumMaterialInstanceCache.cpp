@@ -0,0 +1,139 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialInstanceCache.h"
+#include "CesiumMaterialUserData.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+bool CesiumMaterialSignature::operator==(
+    const CesiumMaterialSignature& rhs) const {
+  return this->pBaseMaterial == rhs.pBaseMaterial &&
+         this->baseColorFactor == rhs.baseColorFactor &&
+         this->metallicFactor == rhs.metallicFactor &&
+         this->roughnessFactor == rhs.roughnessFactor &&
+         this->hasEmissiveFactor == rhs.hasEmissiveFactor &&
+         this->emissiveFactor == rhs.emissiveFactor &&
+         this->onlyLand == rhs.onlyLand && this->onlyWater == rhs.onlyWater &&
+         this->waterMaskTranslationScale == rhs.waterMaskTranslationScale;
+}
+
+uint32 GetTypeHash(const CesiumMaterialSignature& signature) {
+  uint32 hash = PointerHash(signature.pBaseMaterial);
+  hash = HashCombine(hash, GetTypeHash(signature.baseColorFactor));
+  hash = HashCombine(hash, GetTypeHash(signature.metallicFactor));
+  hash = HashCombine(hash, GetTypeHash(signature.roughnessFactor));
+  hash = HashCombine(hash, GetTypeHash(signature.hasEmissiveFactor));
+  hash = HashCombine(hash, GetTypeHash(signature.emissiveFactor));
+  hash = HashCombine(hash, GetTypeHash(signature.onlyLand));
+  hash = HashCombine(hash, GetTypeHash(signature.onlyWater));
+  return HashCombine(hash, GetTypeHash(signature.waterMaskTranslationScale));
+}
+
+namespace {
+UCesiumMaterialUserData* getCesiumUserData(UMaterialInterface* pMaterial) {
+  UMaterialInstance* pMaterialInstance = Cast<UMaterialInstance>(pMaterial);
+  return pMaterialInstance
+             ? pMaterialInstance->GetAssetUserData<UCesiumMaterialUserData>()
+             : nullptr;
+}
+} // namespace
+
+bool UCesiumMaterialInstanceCache::CanShare(
+    UMaterialInterface* BaseMaterial,
+    bool UseLodTransitions) {
+  if (!BaseMaterial) {
+    return false;
+  }
+
+  // Metadata layers are parameterized with each primitive's feature IDs and
+  // property textures.
+  UCesiumMaterialUserData* pCesiumData = getCesiumUserData(BaseMaterial);
+  if (pCesiumData && (pCesiumData->LayerNames.Contains("FeaturesMetadata") ||
+                      pCesiumData->LayerNames.Contains("Metadata"))) {
+    return false;
+  }
+
+  if (UseLodTransitions) {
+    const CesiumFadePrimitiveDataIndices& fadeIndices =
+        this->GetFadePrimitiveDataIndices(BaseMaterial);
+    if (fadeIndices.hasFadeLayer && !fadeIndices.usesCustomPrimitiveData()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+UMaterialInstanceDynamic* UCesiumMaterialInstanceCache::Find(
+    const CesiumMaterialSignature& Signature) const {
+  UMaterialInstanceDynamic* const* ppMaterial =
+      this->_materialsBySignature.Find(Signature);
+  return ppMaterial && IsValid(*ppMaterial) ? *ppMaterial : nullptr;
+}
+
+void UCesiumMaterialInstanceCache::Add(
+    const CesiumMaterialSignature& Signature,
+    UMaterialInstanceDynamic* Material) {
+  this->_materialsBySignature.Add(Signature, Material);
+  this->SharedMaterials.Add(Material);
+}
+
+const CesiumFadePrimitiveDataIndices&
+UCesiumMaterialInstanceCache::GetFadePrimitiveDataIndices(
+    UMaterialInterface* BaseMaterial) {
+  const CesiumFadePrimitiveDataIndices* pExisting =
+      this->_fadeIndicesByMaterial.Find(BaseMaterial);
+  if (pExisting) {
+    return *pExisting;
+  }
+
+  CesiumFadePrimitiveDataIndices& indices =
+      this->_fadeIndicesByMaterial.Add(BaseMaterial);
+
+  UCesiumMaterialUserData* pCesiumData = getCesiumUserData(BaseMaterial);
+  if (!pCesiumData) {
+    return indices;
+  }
+
+  int32 fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
+  if (fadeLayerIndex < 0) {
+    return indices;
+  }
+
+  indices.hasFadeLayer = true;
+
+  // A scalar parameter that has "Use Custom Primitive Data" enabled in the
+  // material editor is read from the given primitive data slot instead of
+  // from the material instance.
+  TMap<FMaterialParameterInfo, FMaterialParameterMetadata> parameters;
+  BaseMaterial->GetAllParametersOfType(
+      EMaterialParameterType::Scalar,
+      parameters);
+
+  auto findPrimitiveDataIndex = [&parameters, fadeLayerIndex](FName name) {
+    const FMaterialParameterMetadata* pMetadata =
+        parameters.Find(FMaterialParameterInfo(
+            name,
+            EMaterialParameterAssociation::LayerParameter,
+            fadeLayerIndex));
+    if (!pMetadata) {
+      return int32(INDEX_NONE);
+    }
+
+    const int32 index = int32(pMetadata->PrimitiveDataIndex);
+    const int32 count = FCustomPrimitiveData::NumCustomPrimitiveDataFloats;
+    return index >= 0 && index < count ? index : int32(INDEX_NONE);
+  };
+
+  indices.fadePercentage = findPrimitiveDataIndex("FadePercentage");
+  indices.fadingType = findPrimitiveDataIndex("FadingType");
+
+  return indices;
+}
+
+void UCesiumMaterialInstanceCache::Clear() {
+  this->_materialsBySignature.Empty();
+  this->_fadeIndicesByMaterial.Empty();
+  this->SharedMaterials.Empty();
+}
@@ -0,0 +1,112 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "CesiumMaterialInstanceCache.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/**
+ * The values that fully determine the parameters of a glTF primitive's
+ * material instance, for primitives that have no textures of their own.
+ * Primitives with equal signatures can share a single material instance.
+ */
+struct CesiumMaterialSignature {
+  const UMaterialInterface* pBaseMaterial = nullptr;
+  FLinearColor baseColorFactor{1.0f, 1.0f, 1.0f, 1.0f};
+  float metallicFactor = 0.0f;
+  float roughnessFactor = 0.0f;
+  bool hasEmissiveFactor = false;
+  FVector3f emissiveFactor{0.0f, 0.0f, 0.0f};
+  bool onlyLand = false;
+  bool onlyWater = false;
+  FVector3f waterMaskTranslationScale{0.0f, 0.0f, 0.0f};
+
+  bool operator==(const CesiumMaterialSignature& rhs) const;
+};
+
+uint32 GetTypeHash(const CesiumMaterialSignature& signature);
+
+/**
+ * The custom primitive data indices that a material reads its LOD transition
+ * parameters from, or INDEX_NONE if the parameters are regular material
+ * parameters.
+ */
+struct CesiumFadePrimitiveDataIndices {
+  /**
+   * Whether the material has a DitherFade layer at all.
+   */
+  bool hasFadeLayer = false;
+  int32 fadePercentage = INDEX_NONE;
+  int32 fadingType = INDEX_NONE;
+
+  /**
+   * Whether both fade parameters are read from custom primitive data, so that
+   * fading a primitive does not require changing its material instance.
+   */
+  bool usesCustomPrimitiveData() const {
+    return this->fadePercentage != INDEX_NONE &&
+           this->fadingType != INDEX_NONE;
+  }
+};
+
+/**
+ * Shares material instances between the glTF primitives of a tileset that
+ * would otherwise get identical, separately created material instances. This
+ * lets Unreal batch their draw calls and avoids updating one uniform buffer
+ * per primitive.
+ */
+UCLASS()
+class UCesiumMaterialInstanceCache : public UObject {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Determines whether material instances of the given base material may be
+   * shared between primitives. This is not the case if the material has
+   * layers that take per-primitive parameters, such as feature metadata, or
+   * if LOD transitions are required but the material does not read its fade
+   * parameters from custom primitive data.
+   */
+  bool CanShare(UMaterialInterface* BaseMaterial, bool UseLodTransitions);
+
+  /**
+   * Finds the material instance shared by primitives with the given
+   * signature, or returns nullptr if there is none yet.
+   */
+  UMaterialInstanceDynamic*
+  Find(const CesiumMaterialSignature& Signature) const;
+
+  /**
+   * Registers a new material instance to be shared by all primitives with the
+   * given signature.
+   */
+  void Add(
+      const CesiumMaterialSignature& Signature,
+      UMaterialInstanceDynamic* Material);
+
+  /**
+   * Returns the custom primitive data indices of the given base material's
+   * LOD transition parameters.
+   */
+  const CesiumFadePrimitiveDataIndices&
+  GetFadePrimitiveDataIndices(UMaterialInterface* BaseMaterial);
+
+  /**
+   * Releases all shared material instances. Primitives that still use them
+   * keep them alive until they are destroyed.
+   */
+  void Clear();
+
+private:
+  UPROPERTY()
+  TArray<UMaterialInstanceDynamic*> SharedMaterials;
+
+  TMap<CesiumMaterialSignature, UMaterialInstanceDynamic*>
+      _materialsBySignature;
+  TMap<const UMaterialInterface*, CesiumFadePrimitiveDataIndices>
+      _fadeIndicesByMaterial;
+};
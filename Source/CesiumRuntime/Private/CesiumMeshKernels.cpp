@@ -0,0 +1,114 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshKernels.h"
+#include "Math/VectorRegister.h"
+#include <limits>
+
+using namespace CesiumGltf;
+
+namespace CesiumMeshKernels {
+
+void computeBounds(
+    const AccessorView<FVector3f>& positions,
+    bool parallel,
+    glm::dvec3& minPosition,
+    glm::dvec3& maxPosition) {
+  const int64 count = positions.size();
+  const int32 chunkCount = getChunkCount(count);
+
+  TArray<FVector3f> chunkMin;
+  TArray<FVector3f> chunkMax;
+  chunkMin.SetNumUninitialized(chunkCount);
+  chunkMax.SetNumUninitialized(chunkCount);
+
+  forEachChunk(count, parallel, [&](int32 chunk, int64 begin, int64 end) {
+    VectorRegister4Float minimum =
+        VectorSetFloat1(std::numeric_limits<float>::max());
+    VectorRegister4Float maximum =
+        VectorSetFloat1(std::numeric_limits<float>::lowest());
+    for (int64 i = begin; i < end; ++i) {
+      const VectorRegister4Float position = VectorLoadFloat3(&positions[i].X);
+      minimum = VectorMin(minimum, position);
+      maximum = VectorMax(maximum, position);
+    }
+    VectorStoreFloat3(minimum, &chunkMin[chunk].X);
+    VectorStoreFloat3(maximum, &chunkMax[chunk].X);
+  });
+
+  minPosition = glm::dvec3(std::numeric_limits<double>::max());
+  maxPosition = glm::dvec3(std::numeric_limits<double>::lowest());
+  for (int32 chunk = 0; chunk < chunkCount; ++chunk) {
+    const FVector3f& chunkMinimum = chunkMin[chunk];
+    const FVector3f& chunkMaximum = chunkMax[chunk];
+    minPosition = glm::min(
+        minPosition,
+        glm::dvec3(chunkMinimum.X, chunkMinimum.Y, chunkMinimum.Z));
+    maxPosition = glm::max(
+        maxPosition,
+        glm::dvec3(chunkMaximum.X, chunkMaximum.Y, chunkMaximum.Z));
+  }
+}
+
+double copyPositions(
+    const AccessorView<FVector3f>& positions,
+    const TArray<uint32>* pIndices,
+    const FVector& origin,
+    bool parallel,
+    TArray<FStaticMeshBuildVertex>& vertices) {
+  const int64 count = vertices.Num();
+  TArray<double> chunkRadiusSquared;
+  chunkRadiusSquared.SetNumZeroed(getChunkCount(count));
+
+  FStaticMeshBuildVertex* pVertices = vertices.GetData();
+  forEachChunk(count, parallel, [&](int32 chunk, int64 begin, int64 end) {
+    double radiusSquared = 0.0;
+    for (int64 i = begin; i < end; ++i) {
+      FStaticMeshBuildVertex& vertex = pVertices[i];
+      const FVector3f& position =
+          positions[pIndices ? int64((*pIndices)[int32(i)]) : i];
+      vertex.Position.X = position.X;
+      vertex.Position.Y = -position.Y;
+      vertex.Position.Z = position.Z;
+      vertex.UVs[0] = FVector2f(0.0f, 0.0f);
+      vertex.UVs[2] = FVector2f(0.0f, 0.0f);
+      radiusSquared = FMath::Max(
+          radiusSquared,
+          (FVector(vertex.Position) - origin).SizeSquared());
+    }
+    chunkRadiusSquared[chunk] = radiusSquared;
+  });
+
+  double radiusSquared = 0.0;
+  for (double chunkRadius : chunkRadiusSquared) {
+    radiusSquared = FMath::Max(radiusSquared, chunkRadius);
+  }
+  return FMath::Sqrt(radiusSquared);
+}
+
+double computeSphereRadius(
+    const TArray<FStaticMeshBuildVertex>& vertices,
+    const FVector& origin,
+    bool parallel) {
+  const int64 count = vertices.Num();
+  TArray<double> chunkRadiusSquared;
+  chunkRadiusSquared.SetNumZeroed(getChunkCount(count));
+
+  const FStaticMeshBuildVertex* pVertices = vertices.GetData();
+  forEachChunk(count, parallel, [&](int32 chunk, int64 begin, int64 end) {
+    double radiusSquared = 0.0;
+    for (int64 i = begin; i < end; ++i) {
+      radiusSquared = FMath::Max(
+          radiusSquared,
+          (FVector(pVertices[i].Position) - origin).SizeSquared());
+    }
+    chunkRadiusSquared[chunk] = radiusSquared;
+  });
+
+  double radiusSquared = 0.0;
+  for (double chunkRadius : chunkRadiusSquared) {
+    radiusSquared = FMath::Max(radiusSquared, chunkRadius);
+  }
+  return FMath::Sqrt(radiusSquared);
+}
+
+} // namespace CesiumMeshKernels
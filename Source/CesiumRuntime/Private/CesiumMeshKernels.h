@@ -0,0 +1,147 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Async/ParallelFor.h"
+#include "CesiumGltf/AccessorView.h"
+#include "Containers/Array.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+#include "StaticMeshResources.h"
+#include <glm/vec3.hpp>
+
+/**
+ * The loops of loadPrimitive that touch every vertex or index of a primitive.
+ *
+ * Each kernel splits its input into chunks of a fixed size and, if asked to,
+ * processes the chunks on the task graph. The chunks never depend on the
+ * number of worker threads and the results of the chunks are combined in
+ * chunk order, so a kernel returns exactly the same result whether it runs in
+ * parallel or not.
+ */
+namespace CesiumMeshKernels {
+
+/**
+ * The number of vertices or indices processed by a task. Primitives smaller
+ * than this are always processed on the calling thread, because scheduling a
+ * task costs more than the loop.
+ */
+constexpr int32 ChunkSize = 16384;
+
+/**
+ * Gets the number of chunks needed for the given number of elements.
+ */
+inline int32 getChunkCount(int64 count) {
+  return int32((count + ChunkSize - 1) / ChunkSize);
+}
+
+/**
+ * Calls func(chunk, begin, end) for each chunk of [0, count), in parallel if
+ * requested and there is more than one chunk.
+ */
+template <typename Func>
+void forEachChunk(int64 count, bool parallel, Func&& func) {
+  const int32 chunkCount = getChunkCount(count);
+  auto processChunk = [count, &func](int32 chunk) {
+    const int64 begin = int64(chunk) * ChunkSize;
+    func(chunk, begin, FMath::Min(begin + ChunkSize, count));
+  };
+
+  if (parallel && chunkCount > 1) {
+    ParallelFor(chunkCount, processChunk);
+  } else {
+    for (int32 chunk = 0; chunk < chunkCount; ++chunk) {
+      processChunk(chunk);
+    }
+  }
+}
+
+/**
+ * Computes the bounding box of the positions of a primitive.
+ *
+ * @param positions The positions.
+ * @param parallel Whether to process chunks of positions in parallel.
+ * @param minPosition Receives the minimum of the positions.
+ * @param maxPosition Receives the maximum of the positions.
+ */
+void computeBounds(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    bool parallel,
+    glm::dvec3& minPosition,
+    glm::dvec3& maxPosition);
+
+/**
+ * Copies the positions of a primitive to its vertices, converting them from
+ * glTF to Unreal coordinates, and clears the texture coordinates that are
+ * filled in later.
+ *
+ * @param positions The positions.
+ * @param pIndices If not nullptr, vertex i gets the position of index i, which
+ * duplicates the vertices shared by multiple triangles. Otherwise vertex i
+ * gets position i.
+ * @param origin The center of the bounds of the primitive.
+ * @param parallel Whether to process chunks of vertices in parallel.
+ * @param vertices The vertices, which must already have the right size.
+ * @return The radius of the sphere around the origin that contains every
+ * vertex.
+ */
+double copyPositions(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    const TArray<uint32>* pIndices,
+    const FVector& origin,
+    bool parallel,
+    TArray<FStaticMeshBuildVertex>& vertices);
+
+/**
+ * Computes the radius of the sphere around the origin that contains every
+ * vertex.
+ */
+double computeSphereRadius(
+    const TArray<FStaticMeshBuildVertex>& vertices,
+    const FVector& origin,
+    bool parallel);
+
+/**
+ * Copies the indices of a primitive, converting a triangle strip to a list of
+ * triangles.
+ *
+ * @param indicesView The glTF indices, which may be an AccessorView or a
+ * std::vector.
+ * @param isStrip Whether the indices are a triangle strip.
+ * @param parallel Whether to process chunks of indices in parallel.
+ * @param indices Receives the indices.
+ */
+template <typename TIndexAccessor>
+void copyIndices(
+    const TIndexAccessor& indicesView,
+    bool isStrip,
+    bool parallel,
+    TArray<uint32>& indices) {
+  const int64 count = int64(indicesView.size());
+  if (!isStrip) {
+    indices.SetNumUninitialized(int32(count));
+    uint32* pIndices = indices.GetData();
+    forEachChunk(count, parallel, [&](int32, int64 begin, int64 end) {
+      for (int64 i = begin; i < end; ++i) {
+        pIndices[i] = uint32(indicesView[i]);
+      }
+    });
+    return;
+  }
+
+  const int64 triangleCount = FMath::Max(count - 2, int64(0));
+  indices.SetNumUninitialized(int32(3 * triangleCount));
+  uint32* pIndices = indices.GetData();
+  forEachChunk(triangleCount, parallel, [&](int32, int64 begin, int64 end) {
+    for (int64 i = begin; i < end; ++i) {
+      // Every other triangle of a strip is wound the other way.
+      const int64 second = (i % 2) ? i + 2 : i + 1;
+      const int64 third = (i % 2) ? i + 1 : i + 2;
+      pIndices[3 * i] = uint32(indicesView[i]);
+      pIndices[3 * i + 1] = uint32(indicesView[second]);
+      pIndices[3 * i + 2] = uint32(indicesView[third]);
+    }
+  });
+}
+
+} // namespace CesiumMeshKernels
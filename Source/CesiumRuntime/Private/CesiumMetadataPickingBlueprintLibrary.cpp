@@ -1,12 +1,243 @@
 // Copyright 2020-2023 CesiumGS, Inc. and Contributors
 
 #include "CesiumMetadataPickingBlueprintLibrary.h"
+#include "Algo/Sort.h"
+#include "Cesium3DTileset.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumMetadataValue.h"
+#include "CesiumPrimitiveBvh.h"
+#include "CesiumPropertyTableProperty.h"
+#include <array>
 
 static TMap<FString, FCesiumMetadataValue> EmptyCesiumMetadataValueMap;
 
+namespace {
+/**
+ * The hits of a batch on one glTF primitive component. The indices of the
+ * hits are HitIndices[First] to HitIndices[First + Count - 1].
+ */
+struct PrimitiveHits {
+  const UCesiumGltfPrimitiveComponent* pComponent;
+  int32 First;
+  int32 Count;
+};
+
+/**
+ * Groups the hits of a batch by the glTF primitive component that they hit.
+ * Hits on anything else are left out. Within a group, the hits keep their
+ * order.
+ */
+void groupHitsByPrimitive(
+    const TArray<FHitResult>& hits,
+    TArray<int32>& hitIndices,
+    TArray<PrimitiveHits>& groups) {
+  TArray<TPair<const UCesiumGltfPrimitiveComponent*, int32>> componentHits;
+  componentHits.Reserve(hits.Num());
+
+  const UPrimitiveComponent* pLastComponent = nullptr;
+  const UCesiumGltfPrimitiveComponent* pLastGltfComponent = nullptr;
+  for (int32 i = 0; i < hits.Num(); ++i) {
+    // Consecutive hits are often on the same component, so avoid casting it
+    // again.
+    const UPrimitiveComponent* pComponent = hits[i].Component.Get();
+    if (pComponent != pLastComponent) {
+      pLastComponent = pComponent;
+      pLastGltfComponent = Cast<UCesiumGltfPrimitiveComponent>(pComponent);
+    }
+    if (pLastGltfComponent) {
+      componentHits.Emplace(pLastGltfComponent, i);
+    }
+  }
+
+  Algo::Sort(componentHits, [](const auto& lhs, const auto& rhs) {
+    return lhs.Key != rhs.Key ? lhs.Key < rhs.Key : lhs.Value < rhs.Value;
+  });
+
+  hitIndices.SetNumUninitialized(componentHits.Num());
+  groups.Reset();
+  for (int32 i = 0; i < componentHits.Num(); ++i) {
+    hitIndices[i] = componentHits[i].Value;
+    if (groups.IsEmpty() || groups.Last().pComponent != componentHits[i].Key) {
+      groups.Add(PrimitiveHits{componentHits[i].Key, i, 0});
+    }
+    ++groups.Last().Count;
+  }
+}
+
+/**
+ * Finds the vertex indices of the hit faces of one primitive. The type of the
+ * primitive's index accessor is only resolved once for all of the hits.
+ */
+void findFaceVertices(
+    const UCesiumGltfPrimitiveComponent& component,
+    const TArray<FHitResult>& hits,
+    TArrayView<const int32> hitIndices,
+    TArray<std::array<int64, 3>>& faceVertices) {
+  faceVertices.SetNumUninitialized(hitIndices.Num());
+  const int64 vertexCount = component.PositionAccessor.size();
+  std::visit(
+      [&hits, hitIndices, vertexCount, &faceVertices](
+          const auto& indexAccessor) {
+        for (int32 i = 0; i < hitIndices.Num(); ++i) {
+          CesiumFaceVertexIndicesFromAccessor visitor{
+              hits[hitIndices[i]].FaceIndex,
+              vertexCount};
+          faceVertices[i] = visitor(indexAccessor);
+        }
+      },
+      component.IndexAccessor);
+}
+
+/**
+ * Computes the UV coordinates of the hits on one primitive, in the same way as
+ * FindUVFromHit. UVs[i] and Found[i] receive the result of the hit at
+ * hitIndices[i].
+ */
+void findUVs(
+    const UCesiumGltfPrimitiveComponent& component,
+    const TArray<FHitResult>& hits,
+    TArrayView<const int32> hitIndices,
+    const TArray<std::array<int64, 3>>& faceVertices,
+    int64 gltfTexCoordSetIndex,
+    TArray<FVector2D>& UVs,
+    TArray<bool>& found) {
+  UVs.SetNumUninitialized(hitIndices.Num());
+  found.SetNumUninitialized(hitIndices.Num());
+  for (int32 i = 0; i < hitIndices.Num(); ++i) {
+    UVs[i] = FVector2D::Zero();
+    found[i] = false;
+  }
+
+  const CesiumGltf::AccessorView<FVector3f>& positions =
+      component.PositionAccessor;
+  if (positions.status() != CesiumGltf::AccessorViewStatus::Valid) {
+    return;
+  }
+
+  auto accessorIt = component.TexCoordAccessorMap.find(gltfTexCoordSetIndex);
+  if (accessorIt == component.TexCoordAccessorMap.end()) {
+    return;
+  }
+
+  const FTransform& componentToWorld = component.GetComponentToWorld();
+
+  std::visit(
+      [&](const auto& texCoordAccessor) {
+        for (int32 i = 0; i < hitIndices.Num(); ++i) {
+          const std::array<int64, 3>& vertices = faceVertices[i];
+
+          std::array<FVector2D, 3> vertexUVs;
+          std::array<FVector, 3> vertexPositions;
+          bool valid = true;
+          for (size_t j = 0; j < vertices.size(); ++j) {
+            const int64 vertex = vertices[j];
+            CesiumTexCoordFromAccessor visitor{vertex};
+            const std::optional<glm::dvec2> maybeTexCoord =
+                visitor(texCoordAccessor);
+            if (!maybeTexCoord || vertex < 0 || vertex >= positions.size()) {
+              valid = false;
+              break;
+            }
+
+            vertexUVs[j] = FVector2D((*maybeTexCoord)[0], (*maybeTexCoord)[1]);
+
+            // The Y-component of glTF positions must be inverted
+            const FVector3f& position = positions[vertex];
+            vertexPositions[j] =
+                FVector(position[0], -position[1], position[2]);
+          }
+
+          if (!valid) {
+            continue;
+          }
+
+          const FVector location = componentToWorld.InverseTransformPosition(
+              hits[hitIndices[i]].Location);
+          const FVector baryCoords = FMath::ComputeBaryCentric2D(
+              location,
+              vertexPositions[0],
+              vertexPositions[1],
+              vertexPositions[2]);
+
+          UVs[i] = (baryCoords.X * vertexUVs[0]) +
+                   (baryCoords.Y * vertexUVs[1]) +
+                   (baryCoords.Z * vertexUVs[2]);
+          found[i] = true;
+        }
+      },
+      accessorIt->second);
+}
+
+/**
+ * Reusable buffers for resolving the hits of one primitive.
+ */
+struct PrimitiveHitScratch {
+  TArray<std::array<int64, 3>> faceVertices;
+  TArray<FVector2D> UVs;
+  TArray<bool> found;
+};
+
+/**
+ * Gets the feature IDs of the hits on one primitive, in the same way as
+ * GetFeatureIDFromHit. featureIDs[i] receives the feature ID of the hit at
+ * hitIndices[i].
+ */
+void getFeatureIDs(
+    const UCesiumGltfPrimitiveComponent& component,
+    const TArray<FHitResult>& hits,
+    TArrayView<const int32> hitIndices,
+    int64 featureIDSetIndex,
+    PrimitiveHitScratch& scratch,
+    TArrayView<int64> featureIDs) {
+  const TArray<FCesiumFeatureIdSet>& featureIDSets =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
+          component.Features);
+  if (featureIDSetIndex < 0 || featureIDSetIndex >= featureIDSets.Num()) {
+    for (int64& featureID : featureIDs) {
+      featureID = -1;
+    }
+    return;
+  }
+
+  const FCesiumFeatureIdSet& featureIDSet = featureIDSets[featureIDSetIndex];
+  findFaceVertices(component, hits, hitIndices, scratch.faceVertices);
+
+  if (UCesiumFeatureIdSetBlueprintLibrary::GetFeatureIDSetType(
+          featureIDSet) == ECesiumFeatureIdSetType::Texture) {
+    const FCesiumFeatureIdTexture& texture =
+        UCesiumFeatureIdSetBlueprintLibrary::GetAsFeatureIDTexture(
+            featureIDSet);
+    findUVs(
+        component,
+        hits,
+        hitIndices,
+        scratch.faceVertices,
+        UCesiumFeatureIdTextureBlueprintLibrary::
+            GetGltfTextureCoordinateSetIndex(texture),
+        scratch.UVs,
+        scratch.found);
+    for (int32 i = 0; i < hitIndices.Num(); ++i) {
+      featureIDs[i] =
+          scratch.found[i]
+              ? UCesiumFeatureIdTextureBlueprintLibrary::GetFeatureIDForUV(
+                    texture,
+                    scratch.UVs[i])
+              : -1;
+    }
+    return;
+  }
+
+  // Feature ID attributes and implicit feature IDs use the first vertex of
+  // the face.
+  for (int32 i = 0; i < hitIndices.Num(); ++i) {
+    featureIDs[i] = UCesiumFeatureIdSetBlueprintLibrary::GetFeatureIDForVertex(
+        featureIDSet,
+        scratch.faceVertices[i][0]);
+  }
+}
+} // namespace
+
 TMap<FString, FCesiumMetadataValue>
 UCesiumMetadataPickingBlueprintLibrary::GetMetadataValuesForFace(
     const UPrimitiveComponent* Component,
@@ -143,20 +374,23 @@ bool UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
   return true;
 }
 
-TMap<FString, FCesiumMetadataValue>
-UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
+const FCesiumPropertyTable*
+UCesiumMetadataPickingBlueprintLibrary::FindPropertyTableFromHit(
     const FHitResult& Hit,
-    int64 FeatureIDSetIndex) {
+    int64 FeatureIDSetIndex,
+    int64& FeatureID) {
+  FeatureID = -1;
+
   const UCesiumGltfPrimitiveComponent* pGltfComponent =
       Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
   if (!IsValid(pGltfComponent)) {
-    return TMap<FString, FCesiumMetadataValue>();
+    return nullptr;
   }
 
   const UCesiumGltfComponent* pModel =
       Cast<UCesiumGltfComponent>(pGltfComponent->GetOuter());
   if (!IsValid(pModel)) {
-    return TMap<FString, FCesiumMetadataValue>();
+    return nullptr;
   }
 
   const FCesiumPrimitiveFeatures& features = pGltfComponent->Features;
@@ -164,7 +398,7 @@ UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(features);
 
   if (FeatureIDSetIndex < 0 || FeatureIDSetIndex >= featureIDSets.Num()) {
-    return TMap<FString, FCesiumMetadataValue>();
+    return nullptr;
   }
 
   const FCesiumFeatureIdSet& featureIDSet = featureIDSets[FeatureIDSetIndex];
@@ -174,23 +408,35 @@ UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
   const TArray<FCesiumPropertyTable>& propertyTables =
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(pModel->Metadata);
   if (propertyTableIndex < 0 || propertyTableIndex >= propertyTables.Num()) {
-    return TMap<FString, FCesiumMetadataValue>();
+    return nullptr;
   }
 
-  const FCesiumPropertyTable& propertyTable =
-      propertyTables[propertyTableIndex];
-
-  int64 featureID =
+  const int64 featureID =
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromHit(
           features,
           Hit,
           FeatureIDSetIndex);
   if (featureID < 0) {
+    return nullptr;
+  }
+
+  FeatureID = featureID;
+  return &propertyTables[propertyTableIndex];
+}
+
+TMap<FString, FCesiumMetadataValue>
+UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
+    const FHitResult& Hit,
+    int64 FeatureIDSetIndex) {
+  int64 featureID;
+  const FCesiumPropertyTable* pPropertyTable =
+      FindPropertyTableFromHit(Hit, FeatureIDSetIndex, featureID);
+  if (!pPropertyTable) {
     return TMap<FString, FCesiumMetadataValue>();
   }
 
   return UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeature(
-      propertyTable,
+      *pPropertyTable,
       featureID);
 }
 
@@ -226,3 +472,235 @@ UCesiumMetadataPickingBlueprintLibrary::GetPropertyTextureValuesFromHit(
       propertyTextures[PropertyTextureIndex],
       Hit);
 }
+
+void UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+    const TArray<FHitResult>& Hits,
+    int64 GltfTexCoordSetIndex,
+    TArray<FVector2D>& UVs,
+    TArray<bool>& Found) {
+  UVs.SetNumZeroed(Hits.Num());
+  Found.SetNumZeroed(Hits.Num());
+
+  TArray<int32> hitIndices;
+  TArray<PrimitiveHits> groups;
+  groupHitsByPrimitive(Hits, hitIndices, groups);
+
+  PrimitiveHitScratch scratch;
+  for (const PrimitiveHits& group : groups) {
+    TArrayView<const int32> groupHitIndices =
+        TArrayView<const int32>(hitIndices).Slice(group.First, group.Count);
+    findFaceVertices(
+        *group.pComponent,
+        Hits,
+        groupHitIndices,
+        scratch.faceVertices);
+    findUVs(
+        *group.pComponent,
+        Hits,
+        groupHitIndices,
+        scratch.faceVertices,
+        GltfTexCoordSetIndex,
+        scratch.UVs,
+        scratch.found);
+    for (int32 i = 0; i < groupHitIndices.Num(); ++i) {
+      UVs[groupHitIndices[i]] = scratch.UVs[i];
+      Found[groupHitIndices[i]] = scratch.found[i];
+    }
+  }
+}
+
+void UCesiumMetadataPickingBlueprintLibrary::GetFeatureIDsFromHits(
+    const TArray<FHitResult>& Hits,
+    TArray<int64>& FeatureIDs,
+    int64 FeatureIDSetIndex) {
+  FeatureIDs.SetNumUninitialized(Hits.Num());
+  for (int64& featureID : FeatureIDs) {
+    featureID = -1;
+  }
+
+  TArray<int32> hitIndices;
+  TArray<PrimitiveHits> groups;
+  groupHitsByPrimitive(Hits, hitIndices, groups);
+
+  PrimitiveHitScratch scratch;
+  TArray<int64> groupFeatureIDs;
+  for (const PrimitiveHits& group : groups) {
+    TArrayView<const int32> groupHitIndices =
+        TArrayView<const int32>(hitIndices).Slice(group.First, group.Count);
+    groupFeatureIDs.SetNumUninitialized(group.Count);
+    getFeatureIDs(
+        *group.pComponent,
+        Hits,
+        groupHitIndices,
+        FeatureIDSetIndex,
+        scratch,
+        groupFeatureIDs);
+    for (int32 i = 0; i < groupHitIndices.Num(); ++i) {
+      FeatureIDs[groupHitIndices[i]] = groupFeatureIDs[i];
+    }
+  }
+}
+
+void UCesiumMetadataPickingBlueprintLibrary::GetFloat64PropertyValuesFromHits(
+    const TArray<FHitResult>& Hits,
+    const FString& PropertyName,
+    TArray<int64>& FeatureIDs,
+    TArray<double>& Values,
+    int64 FeatureIDSetIndex,
+    double DefaultValue) {
+  FeatureIDs.SetNumUninitialized(Hits.Num());
+  Values.SetNumUninitialized(Hits.Num());
+  for (int32 i = 0; i < Hits.Num(); ++i) {
+    FeatureIDs[i] = -1;
+    Values[i] = DefaultValue;
+  }
+
+  TArray<int32> hitIndices;
+  TArray<PrimitiveHits> groups;
+  groupHitsByPrimitive(Hits, hitIndices, groups);
+
+  PrimitiveHitScratch scratch;
+  TArray<int64> groupFeatureIDs;
+  for (const PrimitiveHits& group : groups) {
+    const UCesiumGltfPrimitiveComponent& component = *group.pComponent;
+    const UCesiumGltfComponent* pModel =
+        Cast<UCesiumGltfComponent>(component.GetOuter());
+    if (!IsValid(pModel)) {
+      continue;
+    }
+
+    TArrayView<const int32> groupHitIndices =
+        TArrayView<const int32>(hitIndices).Slice(group.First, group.Count);
+    groupFeatureIDs.SetNumUninitialized(group.Count);
+    getFeatureIDs(
+        component,
+        Hits,
+        groupHitIndices,
+        FeatureIDSetIndex,
+        scratch,
+        groupFeatureIDs);
+    for (int32 i = 0; i < groupHitIndices.Num(); ++i) {
+      FeatureIDs[groupHitIndices[i]] = groupFeatureIDs[i];
+    }
+
+    const TArray<FCesiumFeatureIdSet>& featureIDSets =
+        UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
+            component.Features);
+    if (FeatureIDSetIndex < 0 || FeatureIDSetIndex >= featureIDSets.Num()) {
+      continue;
+    }
+
+    const int64 propertyTableIndex =
+        UCesiumFeatureIdSetBlueprintLibrary::GetPropertyTableIndex(
+            featureIDSets[FeatureIDSetIndex]);
+    const TArray<FCesiumPropertyTable>& propertyTables =
+        UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(
+            pModel->Metadata);
+    if (propertyTableIndex < 0 || propertyTableIndex >= propertyTables.Num()) {
+      continue;
+    }
+
+    const FCesiumPropertyTablePropertyHandle property(
+        UCesiumPropertyTableBlueprintLibrary::FindProperty(
+            propertyTables[propertyTableIndex],
+            PropertyName));
+    for (int32 i = 0; i < groupHitIndices.Num(); ++i) {
+      Values[groupHitIndices[i]] =
+          property.getFloat64(groupFeatureIDs[i], DefaultValue);
+    }
+  }
+}
+
+bool UCesiumMetadataPickingBlueprintLibrary::LineTraceGltfPrimitive(
+    UPrimitiveComponent* Component,
+    const FVector& Start,
+    const FVector& End,
+    FHitResult& Hit) {
+  UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Component);
+  if (!IsValid(pGltfComponent)) {
+    return false;
+  }
+
+  const CesiumPrimitiveBvh* pBvh = pGltfComponent->GetPickingBvh();
+  if (!pBvh) {
+    return false;
+  }
+
+  // The hierarchy is in the local coordinates of the component, which keeps
+  // them small enough for single precision.
+  const FTransform& componentToWorld = pGltfComponent->GetComponentToWorld();
+  const FVector localStart = componentToWorld.InverseTransformPosition(Start);
+  const FVector localEnd = componentToWorld.InverseTransformPosition(End);
+
+  CesiumPrimitiveBvh::RayHit rayHit;
+  if (!pBvh->raycast(
+          FVector3f(localStart),
+          FVector3f(localEnd - localStart),
+          1.0f,
+          rayHit)) {
+    return false;
+  }
+
+  const FVector location = componentToWorld.TransformPosition(
+      FMath::Lerp(localStart, localEnd, double(rayHit.time)));
+  // Normals are transformed by the inverse transpose, in case of non-uniform
+  // scale.
+  const FVector normal = componentToWorld.ToInverseMatrixWithScale()
+                             .GetTransposed()
+                             .TransformVector(FVector(rayHit.normal))
+                             .GetSafeNormal();
+
+  Hit =
+      FHitResult(pGltfComponent->GetOwner(), pGltfComponent, location, normal);
+  Hit.bBlockingHit = true;
+  Hit.FaceIndex = rayHit.faceIndex;
+  Hit.Time = rayHit.time;
+  Hit.Distance = FVector::Distance(Start, location);
+  Hit.TraceStart = Start;
+  Hit.TraceEnd = End;
+  return true;
+}
+
+bool UCesiumMetadataPickingBlueprintLibrary::LineTraceTileset(
+    const ACesium3DTileset* Tileset,
+    const FVector& Start,
+    const FVector& End,
+    FHitResult& Hit) {
+  if (!IsValid(Tileset)) {
+    return false;
+  }
+
+  const FVector direction = End - Start;
+
+  bool found = false;
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  Tileset->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    if (!pGltf->IsVisible()) {
+      continue;
+    }
+
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (!IsValid(pPrimitive) || !pPrimitive->IsVisible() ||
+          !FMath::LineBoxIntersection(
+              pPrimitive->Bounds.GetBox(),
+              Start,
+              End,
+              direction)) {
+        continue;
+      }
+
+      FHitResult primitiveHit;
+      if (LineTraceGltfPrimitive(pPrimitive, Start, End, primitiveHit) &&
+          (!found || primitiveHit.Time < Hit.Time)) {
+        Hit = primitiveHit;
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
@@ -0,0 +1,224 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumModelTrimming.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltf/ExtensionKhrTextureBasisu.h"
+#include "CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/ExtensionTextureWebp.h"
+#include "CesiumGltf/Model.h"
+#include "Templates/AlignmentTemplates.h"
+#include <cstring>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Buffer views are packed at this alignment so that accessors of any
+// component type stay aligned.
+constexpr int64 BufferViewAlignment = 8;
+
+void keep(std::vector<bool>& kept, int32_t index) {
+  if (index >= 0 && size_t(index) < kept.size()) {
+    kept[size_t(index)] = true;
+  }
+}
+
+void keepAccessor(
+    const Model& model,
+    int32_t accessorIndex,
+    std::vector<bool>& keptBufferViews) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor) {
+    return;
+  }
+
+  keep(keptBufferViews, pAccessor->bufferView);
+  if (pAccessor->sparse) {
+    keep(keptBufferViews, pAccessor->sparse->indices.bufferView);
+    keep(keptBufferViews, pAccessor->sparse->values.bufferView);
+  }
+}
+
+void keepTexture(
+    const Model& model,
+    int32_t textureIndex,
+    std::vector<bool>& keptImages) {
+  const Texture* pTexture = Model::getSafe(&model.textures, textureIndex);
+  if (!pTexture) {
+    return;
+  }
+
+  keep(keptImages, pTexture->source);
+
+  const ExtensionKhrTextureBasisu* pKtxExtension =
+      pTexture->getExtension<ExtensionKhrTextureBasisu>();
+  if (pKtxExtension) {
+    keep(keptImages, pKtxExtension->source);
+  }
+
+  const ExtensionTextureWebp* pWebpExtension =
+      pTexture->getExtension<ExtensionTextureWebp>();
+  if (pWebpExtension) {
+    keep(keptImages, pWebpExtension->source);
+  }
+}
+
+bool isQueryable(const MeshPrimitive& primitive) {
+  return primitive.getExtension<ExtensionExtMeshFeatures>() ||
+         primitive
+             .getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>() ||
+         primitive.attributes.find("_CESIUMOVERLAY_0") !=
+             primitive.attributes.end();
+}
+
+void findKeptData(
+    const Model& model,
+    std::vector<bool>& keptBufferViews,
+    std::vector<bool>& keptImages) {
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (pMetadata) {
+    for (const PropertyTable& propertyTable : pMetadata->propertyTables) {
+      for (const auto& propertyIt : propertyTable.properties) {
+        const PropertyTableProperty& property = propertyIt.second;
+        keep(keptBufferViews, property.values);
+        keep(keptBufferViews, property.arrayOffsets);
+        keep(keptBufferViews, property.stringOffsets);
+      }
+    }
+
+    for (const PropertyTexture& propertyTexture :
+         pMetadata->propertyTextures) {
+      for (const auto& propertyIt : propertyTexture.properties) {
+        keepTexture(model, propertyIt.second.index, keptImages);
+      }
+    }
+  }
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      if (!isQueryable(primitive)) {
+        continue;
+      }
+
+      keepAccessor(model, primitive.indices, keptBufferViews);
+      for (const auto& attributeIt : primitive.attributes) {
+        keepAccessor(model, attributeIt.second, keptBufferViews);
+      }
+
+      const ExtensionExtMeshFeatures* pFeatures =
+          primitive.getExtension<ExtensionExtMeshFeatures>();
+      if (pFeatures) {
+        for (const FeatureId& featureId : pFeatures->featureIds) {
+          if (featureId.texture) {
+            keepTexture(model, featureId.texture->index, keptImages);
+          }
+        }
+      }
+    }
+  }
+}
+
+int64 trimBuffers(Model& model, const std::vector<bool>& keptBufferViews) {
+  int64 releasedBytes = 0;
+
+  for (size_t bufferIndex = 0; bufferIndex < model.buffers.size();
+       ++bufferIndex) {
+    Buffer& buffer = model.buffers[bufferIndex];
+    const std::vector<std::byte>& data = buffer.cesium.data;
+    if (data.empty()) {
+      continue;
+    }
+
+    int64 packedSize = 0;
+    for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+      const BufferView& bufferView = model.bufferViews[i];
+      if (keptBufferViews[i] && bufferView.buffer == int32_t(bufferIndex) &&
+          bufferView.byteOffset + bufferView.byteLength <= int64(data.size())) {
+        packedSize = Align(packedSize, BufferViewAlignment);
+        packedSize += bufferView.byteLength;
+      }
+    }
+
+    std::vector<std::byte> packed(size_t(packedSize));
+    int64 offset = 0;
+    for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+      BufferView& bufferView = model.bufferViews[i];
+      if (bufferView.buffer != int32_t(bufferIndex)) {
+        continue;
+      }
+
+      if (!keptBufferViews[i] ||
+          bufferView.byteOffset + bufferView.byteLength > int64(data.size())) {
+        // Accessors of a dropped buffer view are reported as invalid by
+        // AccessorView instead of reading the wrong bytes.
+        bufferView.byteOffset = 0;
+        bufferView.byteLength = 0;
+        continue;
+      }
+
+      offset = Align(offset, BufferViewAlignment);
+      std::memcpy(
+          packed.data() + offset,
+          data.data() + bufferView.byteOffset,
+          size_t(bufferView.byteLength));
+      bufferView.byteOffset = offset;
+      offset += bufferView.byteLength;
+    }
+
+    releasedBytes += int64(data.size()) - packedSize;
+    buffer.cesium.data = std::move(packed);
+    buffer.byteLength = packedSize;
+  }
+
+  return releasedBytes;
+}
+
+int64 trimImages(Model& model, const std::vector<bool>& keptImages) {
+  int64 releasedBytes = 0;
+
+  for (size_t i = 0; i < model.images.size(); ++i) {
+    if (keptImages[i]) {
+      continue;
+    }
+
+    ImageCesium& image = model.images[i].cesium;
+    releasedBytes += int64(image.pixelData.size());
+    image.pixelData = std::vector<std::byte>();
+    image.mipPositions = std::vector<ImageCesiumMipPosition>();
+  }
+
+  return releasedBytes;
+}
+
+} // namespace
+
+namespace CesiumModelTrimming {
+
+int64 computeCpuBytes(const Model& model) {
+  int64 bytes = 0;
+  for (const Buffer& buffer : model.buffers) {
+    bytes += int64(buffer.cesium.data.size());
+  }
+  for (const Image& image : model.images) {
+    bytes += int64(image.cesium.pixelData.size());
+  }
+  return bytes;
+}
+
+int64 trimModel(Model& model, bool releaseImages) {
+  std::vector<bool> keptBufferViews(model.bufferViews.size(), false);
+  std::vector<bool> keptImages(model.images.size(), false);
+  findKeptData(model, keptBufferViews, keptImages);
+
+  int64 releasedBytes = trimBuffers(model, keptBufferViews);
+  if (releaseImages) {
+    releasedBytes += trimImages(model, keptImages);
+  }
+
+  return releasedBytes;
+}
+
+} // namespace CesiumModelTrimming
@@ -0,0 +1,47 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * Releases the CPU copies of glTF data that are no longer needed once a tile
+ * has been uploaded to the GPU.
+ *
+ * A trimmed model keeps everything that runtime queries read from it:
+ *  - the buffer views of the property tables of EXT_structural_metadata,
+ *  - every accessor of primitives with EXT_mesh_features or
+ *    EXT_structural_metadata, which picking reads to find the feature and the
+ *    texture coordinates of a hit,
+ *  - every accessor of primitives with raster overlay texture coordinates,
+ *    because cesium-native subdivides them to create upsampled tiles,
+ *  - the images of feature ID textures and property textures.
+ *
+ * The bytes of all other buffer views are dropped, and the remaining ones are
+ * packed into smaller buffers. Views created before trimming point to the old
+ * buffers and must be created again.
+ */
+namespace CesiumModelTrimming {
+
+/**
+ * Gets the number of bytes of CPU memory used by the buffers and decoded
+ * images of a model.
+ */
+int64 computeCpuBytes(const CesiumGltf::Model& model);
+
+/**
+ * Releases the buffer data and, optionally, the images of a model that
+ * runtime queries don't need.
+ *
+ * @param model The model to trim.
+ * @param releaseImages Whether to release the pixels of images that aren't
+ * used by feature ID textures or property textures.
+ * @return The number of bytes released.
+ */
+int64 trimModel(CesiumGltf::Model& model, bool releaseImages);
+
+} // namespace CesiumModelTrimming
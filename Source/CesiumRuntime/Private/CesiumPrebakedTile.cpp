@@ -0,0 +1,290 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrebakedTile.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "CesiumUtility/joinToString.h"
+#include "CreateGltfOptions.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include <glm/mat4x4.hpp>
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Prebaked Tiles Loaded"),
+    STAT_CesiumPrebakedTilesLoaded,
+    STATGROUP_Cesium);
+
+namespace {
+
+constexpr uint32 PrebakedTileMagic = 0x4B425043; // "CPBK"
+
+// Increment this whenever the file format changes, or the way that the
+// vertices and indices of a primitive are computed changes.
+constexpr uint32 PrebakedTileVersion = 1;
+
+// The vertices are stored exactly as they are laid out in memory, so tiles
+// baked by an engine with a different vertex layout can't be used.
+constexpr uint32 VertexSize = uint32(sizeof(FStaticMeshBuildVertex));
+
+bool hasRemaining(FArchive& archive, int64 bytes) {
+  return bytes >= 0 && archive.Tell() + bytes <= archive.TotalSize();
+}
+
+void serializeTexCoordParameters(
+    FArchive& archive,
+    std::unordered_map<std::string, uint32_t>& parameters) {
+  int32 count = int32(parameters.size());
+  archive << count;
+
+  if (archive.IsLoading()) {
+    parameters.clear();
+    for (int32 i = 0; i < count && !archive.IsError(); ++i) {
+      FString name;
+      uint32 value = 0;
+      archive << name;
+      archive << value;
+      parameters[TCHAR_TO_UTF8(*name)] = value;
+    }
+  } else {
+    for (auto& pair : parameters) {
+      FString name(UTF8_TO_TCHAR(pair.first.c_str()));
+      uint32 value = pair.second;
+      archive << name;
+      archive << value;
+    }
+  }
+}
+
+void serializeTexCoordMap(
+    FArchive& archive,
+    std::unordered_map<int32_t, uint32_t>& map) {
+  int32 count = int32(map.size());
+  archive << count;
+
+  if (archive.IsLoading()) {
+    map.clear();
+    for (int32 i = 0; i < count && !archive.IsError(); ++i) {
+      int32 gltfIndex = 0;
+      uint32 unrealIndex = 0;
+      archive << gltfIndex;
+      archive << unrealIndex;
+      map[gltfIndex] = unrealIndex;
+    }
+  } else {
+    for (auto& pair : map) {
+      int32 gltfIndex = pair.first;
+      uint32 unrealIndex = pair.second;
+      archive << gltfIndex;
+      archive << unrealIndex;
+    }
+  }
+}
+
+void serializePrimitive(FArchive& archive, CesiumPrebakedPrimitive& primitive) {
+  archive << primitive.meshIndex;
+  archive << primitive.primitiveIndex;
+
+  int32 vertexCount = primitive.vertices.Num();
+  archive << vertexCount;
+  if (archive.IsLoading()) {
+    if (!hasRemaining(archive, int64(vertexCount) * VertexSize)) {
+      archive.SetError();
+      return;
+    }
+    primitive.vertices.SetNumUninitialized(vertexCount);
+  }
+  archive.Serialize(
+      primitive.vertices.GetData(),
+      int64(vertexCount) * VertexSize);
+
+  int32 indexCount = primitive.indices.Num();
+  archive << indexCount;
+  if (archive.IsLoading()) {
+    if (!hasRemaining(archive, int64(indexCount) * sizeof(uint32))) {
+      archive.SetError();
+      return;
+    }
+    primitive.indices.SetNumUninitialized(indexCount);
+  }
+  archive.Serialize(
+      primitive.indices.GetData(),
+      int64(indexCount) * sizeof(uint32));
+
+  archive << primitive.hasVertexColors;
+  serializeTexCoordParameters(archive, primitive.textureCoordinateParameters);
+  for (int32_t& uvIndex : primitive.overlayTextureCoordinateIDToUVIndex) {
+    archive << uvIndex;
+  }
+  serializeTexCoordMap(archive, primitive.gltfToUnrealTexCoordMap);
+}
+
+} // namespace
+
+const CesiumPrebakedPrimitive* CesiumPrebakedTile::findPrimitive(
+    int32 meshIndex,
+    int32 primitiveIndex) const {
+  for (const CesiumPrebakedPrimitive& primitive : this->primitives) {
+    if (primitive.meshIndex == meshIndex &&
+        primitive.primitiveIndex == primitiveIndex) {
+      return &primitive;
+    }
+  }
+  return nullptr;
+}
+
+namespace CesiumPrebakedTiles {
+
+uint64 computeKey(
+    const TArrayView<const uint8>& content,
+    const CesiumPrebakeOptions& options) {
+  const uint64 seed = (uint64(PrebakedTileVersion) << 32) |
+                      (options.alwaysIncludeTangents ? 1 : 0) |
+                      (options.ignoreKhrMaterialsUnlit ? 2 : 0);
+  return CityHash64WithSeed(
+      reinterpret_cast<const char*>(content.GetData()),
+      uint32(content.Num()),
+      seed);
+}
+
+FString getPath(const FString& directory, uint64 key) {
+  // Spread the tiles over subdirectories so that no single directory gets too
+  // large.
+  const FString name =
+      FString::Printf(TEXT("%016llx"), static_cast<unsigned long long>(key));
+  return FPaths::Combine(directory, name.Left(2), name + TEXT(".cesiumtile"));
+}
+
+bool bakeTileContent(
+    const FString& directory,
+    const TArrayView<const uint8>& content,
+    const CesiumPrebakeOptions& options,
+    FString& error) {
+  CesiumGltfReader::GltfReader reader;
+  CesiumGltfReader::GltfReaderResult result =
+      reader.readGltf(gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(content.GetData()),
+          size_t(content.Num())));
+  if (!result.model) {
+    error = UTF8_TO_TCHAR(
+        CesiumUtility::joinToString(result.errors, "\n").c_str());
+    return false;
+  }
+
+  const CesiumPrebakedTile tile = bakeModel(*result.model, options);
+  const uint64 key = computeKey(content, options);
+  if (!writeTile(directory, key, tile)) {
+    error = FString::Printf(
+        TEXT("Could not write %s"),
+        *getPath(directory, key));
+    return false;
+  }
+
+  return true;
+}
+
+std::optional<CesiumPrebakedTile>
+readTile(const FString& directory, uint64 key) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadPrebakedTile)
+
+  TArray<uint8> data;
+  if (!FFileHelper::LoadFileToArray(
+          data,
+          *getPath(directory, key),
+          FILEREAD_Silent)) {
+    return std::nullopt;
+  }
+
+  FMemoryReader reader(data);
+  uint32 magic = 0;
+  uint32 version = 0;
+  uint32 vertexSize = 0;
+  reader << magic;
+  reader << version;
+  reader << vertexSize;
+  if (magic != PrebakedTileMagic || version != PrebakedTileVersion ||
+      vertexSize != VertexSize) {
+    return std::nullopt;
+  }
+
+  CesiumPrebakedTile tile;
+  serialize(reader, tile);
+  if (reader.IsError()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Ignoring corrupt pre-baked tile %s"),
+        *getPath(directory, key));
+    return std::nullopt;
+  }
+
+  INC_DWORD_STAT(STAT_CesiumPrebakedTilesLoaded);
+  return tile;
+}
+
+bool writeTile(
+    const FString& directory,
+    uint64 key,
+    const CesiumPrebakedTile& tile) {
+  TArray<uint8> data;
+  FMemoryWriter writer(data);
+  uint32 magic = PrebakedTileMagic;
+  uint32 version = PrebakedTileVersion;
+  uint32 vertexSize = VertexSize;
+  writer << magic;
+  writer << version;
+  writer << vertexSize;
+
+  // Saving doesn't modify the tile.
+  serialize(writer, const_cast<CesiumPrebakedTile&>(tile));
+
+  return FFileHelper::SaveArrayToFile(data, *getPath(directory, key));
+}
+
+void serialize(FArchive& archive, CesiumPrebakedTile& tile) {
+  int32 primitiveCount = int32(tile.primitives.size());
+  archive << primitiveCount;
+  if (archive.IsLoading()) {
+    if (primitiveCount < 0 || !hasRemaining(archive, primitiveCount)) {
+      archive.SetError();
+      return;
+    }
+    tile.primitives.clear();
+    tile.primitives.resize(size_t(primitiveCount));
+  }
+
+  for (CesiumPrebakedPrimitive& primitive : tile.primitives) {
+    serializePrimitive(archive, primitive);
+    if (archive.IsError()) {
+      return;
+    }
+  }
+}
+
+CesiumPrebakedTile bakeModel(
+    CesiumGltf::Model& model,
+    const CesiumPrebakeOptions& options,
+    const CesiumPrebakedTile* pPrebakedTile) {
+  CesiumPrebakedTile result;
+
+  CreateGltfOptions::CreateModelOptions modelOptions;
+  modelOptions.pModel = &model;
+  modelOptions.alwaysIncludeTangents = options.alwaysIncludeTangents;
+  modelOptions.ignoreKhrMaterialsUnlit = options.ignoreKhrMaterialsUnlit;
+  // Collision meshes are cooked from the pre-baked vertices when the tile is
+  // loaded, so they don't need to be cooked here.
+  modelOptions.createPhysicsMeshes = false;
+  modelOptions.pPrebakedTile = pPrebakedTile;
+  modelOptions.pPrebakeResult = &result;
+
+  UCesiumGltfComponent::CreateOffGameThread(glm::dmat4(1.0), modelOptions);
+
+  return result;
+}
+
+} // namespace CesiumPrebakedTiles
@@ -0,0 +1,88 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPrebakedTiles.h"
+#include "CesiumRasterOverlays.h"
+#include "StaticMeshResources.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * The vertices and indices computed for a single glTF primitive, ready to be
+ * copied into the vertex and index buffers of a static mesh.
+ */
+struct CesiumPrebakedPrimitive {
+  /** The index of the primitive's mesh in the glTF. */
+  int32 meshIndex = -1;
+
+  /** The index of the primitive in its mesh. */
+  int32 primitiveIndex = -1;
+
+  TArray<FStaticMeshBuildVertex> vertices;
+  TArray<uint32> indices;
+  bool hasVertexColors = false;
+
+  std::unordered_map<std::string, uint32_t> textureCoordinateParameters;
+  OverlayTextureCoordinateIDMap overlayTextureCoordinateIDToUVIndex{};
+  std::unordered_map<int32_t, uint32_t> gltfToUnrealTexCoordMap;
+};
+
+/**
+ * The pre-baked primitives of a single tile.
+ */
+struct CesiumPrebakedTile {
+  std::vector<CesiumPrebakedPrimitive> primitives;
+
+  /**
+   * Finds the pre-baked version of a primitive, or returns nullptr if the
+   * primitive wasn't baked.
+   */
+  const CesiumPrebakedPrimitive*
+  findPrimitive(int32 meshIndex, int32 primitiveIndex) const;
+};
+
+namespace CesiumPrebakedTiles {
+/**
+ * Reads the pre-baked tile with the given key from the given directory.
+ * Returns std::nullopt if the tile hasn't been baked, or if it was baked by an
+ * incompatible version of Cesium for Unreal.
+ */
+std::optional<CesiumPrebakedTile>
+readTile(const FString& directory, uint64 key);
+
+/**
+ * Writes a pre-baked tile with the given key to the given directory.
+ */
+bool writeTile(
+    const FString& directory,
+    uint64 key,
+    const CesiumPrebakedTile& tile);
+
+/**
+ * Serializes a pre-baked tile to or from an archive.
+ */
+void serialize(FArchive& archive, CesiumPrebakedTile& tile);
+
+/**
+ * Computes the pre-baked primitives of a glTF model the same way they are
+ * computed when the model is loaded as a tile.
+ *
+ * @param model The model to bake.
+ * @param options The options to bake the model with.
+ * @param pPrebakedTile A previously baked version of the model to load the
+ * model from, or nullptr to compute every primitive. This is useful to check
+ * that loading from a pre-baked tile gives the same result.
+ */
+CesiumPrebakedTile bakeModel(
+    CesiumGltf::Model& model,
+    const CesiumPrebakeOptions& options,
+    const CesiumPrebakedTile* pPrebakedTile = nullptr);
+} // namespace CesiumPrebakedTiles
@@ -0,0 +1,350 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveBvh.h"
+#include "HAL/PlatformTime.h"
+#include <CesiumUtility/Tracing.h>
+#include <algorithm>
+#include <type_traits>
+#include <variant>
+
+namespace {
+
+// The hierarchy is balanced, so its depth is at most 32 for any number of
+// triangles that fits in an int32.
+constexpr int32 MaxStackSize = 64;
+
+// Intersects a ray with a box, returning the distance at which it enters the
+// box, or a negative number if it misses it.
+float intersectBox(
+    const FVector3f& min,
+    const FVector3f& max,
+    const FVector3f& origin,
+    const FVector3f& inverseDirection,
+    float maxTime) {
+  float entry = 0.0f;
+  float exit = maxTime;
+  for (int32 axis = 0; axis < 3; ++axis) {
+    const float first = (min[axis] - origin[axis]) * inverseDirection[axis];
+    const float second = (max[axis] - origin[axis]) * inverseDirection[axis];
+    entry = FMath::Max(entry, FMath::Min(first, second));
+    exit = FMath::Min(exit, FMath::Max(first, second));
+  }
+  return entry <= exit ? entry : -1.0f;
+}
+
+// Intersects a ray with both sides of a triangle, with the Möller-Trumbore
+// algorithm.
+bool intersectTriangle(
+    const FVector3f* pVertices,
+    const FVector3f& origin,
+    const FVector3f& direction,
+    float maxTime,
+    float& time) {
+  const FVector3f edge1 = pVertices[1] - pVertices[0];
+  const FVector3f edge2 = pVertices[2] - pVertices[0];
+  const FVector3f p = FVector3f::CrossProduct(direction, edge2);
+  const float determinant = FVector3f::DotProduct(edge1, p);
+  if (determinant == 0.0f) {
+    return false;
+  }
+
+  const float inverseDeterminant = 1.0f / determinant;
+  const FVector3f s = origin - pVertices[0];
+  const float u = FVector3f::DotProduct(s, p) * inverseDeterminant;
+  if (u < 0.0f || u > 1.0f) {
+    return false;
+  }
+
+  const FVector3f q = FVector3f::CrossProduct(s, edge1);
+  const float v = FVector3f::DotProduct(direction, q) * inverseDeterminant;
+  if (v < 0.0f || u + v > 1.0f) {
+    return false;
+  }
+
+  const float t = FVector3f::DotProduct(edge2, q) * inverseDeterminant;
+  if (t < 0.0f || t > maxTime) {
+    return false;
+  }
+
+  time = t;
+  return true;
+}
+
+} // namespace
+
+/*static*/ TUniquePtr<CesiumPrimitiveBvh> CesiumPrimitiveBvh::create(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    const CesiumIndexAccessorType& indices) {
+  if (positions.status() != CesiumGltf::AccessorViewStatus::Valid) {
+    return nullptr;
+  }
+
+  TArray<FVector3f> vertices;
+  TArray<int32> faceIndices;
+
+  std::visit(
+      [&positions, &vertices, &faceIndices](const auto& indexAccessor) {
+        using TIndexAccessor = std::decay_t<decltype(indexAccessor)>;
+
+        const int64 vertexCount = positions.size();
+        int64 faceCount;
+        if constexpr (std::is_same_v<TIndexAccessor, std::monostate>) {
+          faceCount = vertexCount / 3;
+        } else {
+          if (indexAccessor.status() !=
+              CesiumGltf::AccessorViewStatus::Valid) {
+            return;
+          }
+          faceCount = indexAccessor.size() / 3;
+        }
+        faceCount = FMath::Min(faceCount, int64(MAX_int32 / 3));
+
+        vertices.Reserve(int32(faceCount * 3));
+        faceIndices.Reserve(int32(faceCount));
+        for (int64 face = 0; face < faceCount; ++face) {
+          int64 triangle[3];
+          bool valid = true;
+          for (int64 i = 0; i < 3; ++i) {
+            if constexpr (std::is_same_v<TIndexAccessor, std::monostate>) {
+              triangle[i] = face * 3 + i;
+            } else {
+              triangle[i] = int64(indexAccessor[face * 3 + i]);
+            }
+            valid &= triangle[i] < vertexCount;
+          }
+
+          if (!valid) {
+            continue;
+          }
+
+          for (int64 vertex : triangle) {
+            // The Y-component of glTF positions must be inverted
+            const FVector3f& position = positions[vertex];
+            vertices.Emplace(position.X, -position.Y, position.Z);
+          }
+          faceIndices.Add(int32(face));
+        }
+      },
+      indices);
+
+  if (faceIndices.Num() == 0) {
+    return nullptr;
+  }
+
+  return MakeUnique<CesiumPrimitiveBvh>(
+      MoveTemp(vertices),
+      MoveTemp(faceIndices));
+}
+
+CesiumPrimitiveBvh::CesiumPrimitiveBvh(
+    TArray<FVector3f>&& vertices,
+    TArray<int32>&& faceIndices)
+    : _nodes(),
+      _vertices(MoveTemp(vertices)),
+      _faceIndices(MoveTemp(faceIndices)),
+      _buildSeconds(0.0) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildPrimitiveBvh)
+
+  const double start = FPlatformTime::Seconds();
+
+  const int32 triangleCount = this->_faceIndices.Num();
+  check(this->_vertices.Num() == triangleCount * 3);
+
+  TArray<FVector3f> centroids;
+  centroids.SetNumUninitialized(triangleCount);
+  TArray<int32> order;
+  order.SetNumUninitialized(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    centroids[i] = (this->_vertices[3 * i] + this->_vertices[3 * i + 1] +
+                    this->_vertices[3 * i + 2]) /
+                   3.0f;
+    order[i] = i;
+  }
+
+  if (triangleCount > 0) {
+    this->_nodes.Reserve(
+        2 * FMath::DivideAndRoundUp(triangleCount, MaxTrianglesPerLeaf));
+    this->_build(order, centroids, 0, triangleCount);
+  }
+  this->_nodes.Shrink();
+
+  // Store the triangles in the order of the leaves.
+  TArray<FVector3f> sortedVertices;
+  sortedVertices.SetNumUninitialized(this->_vertices.Num());
+  TArray<int32> sortedFaceIndices;
+  sortedFaceIndices.SetNumUninitialized(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 triangle = order[i];
+    sortedVertices[3 * i] = this->_vertices[3 * triangle];
+    sortedVertices[3 * i + 1] = this->_vertices[3 * triangle + 1];
+    sortedVertices[3 * i + 2] = this->_vertices[3 * triangle + 2];
+    sortedFaceIndices[i] = this->_faceIndices[triangle];
+  }
+  this->_vertices = MoveTemp(sortedVertices);
+  this->_faceIndices = MoveTemp(sortedFaceIndices);
+
+  this->_buildSeconds = FPlatformTime::Seconds() - start;
+}
+
+bool CesiumPrimitiveBvh::raycast(
+    const FVector3f& origin,
+    const FVector3f& direction,
+    float maxTime,
+    RayHit& hit) const {
+  if (this->_nodes.Num() == 0) {
+    return false;
+  }
+
+  FVector3f inverseDirection;
+  for (int32 axis = 0; axis < 3; ++axis) {
+    // A large finite number avoids multiplying zero by infinity when the ray
+    // starts on a face of a box.
+    inverseDirection[axis] =
+        direction[axis] != 0.0f ? 1.0f / direction[axis] : MAX_flt;
+  }
+
+  float nearestTime = maxTime;
+  int32 nearestTriangle = INDEX_NONE;
+
+  int32 stack[MaxStackSize];
+  int32 stackSize = 0;
+
+  const Node& root = this->_nodes[0];
+  if (intersectBox(root.min, root.max, origin, inverseDirection, maxTime) >=
+      0.0f) {
+    stack[stackSize++] = 0;
+  }
+
+  while (stackSize > 0) {
+    const int32 nodeIndex = stack[--stackSize];
+    const Node& node = this->_nodes[nodeIndex];
+
+    if (node.count > 0) {
+      for (int32 i = node.firstOrSecond; i < node.firstOrSecond + node.count;
+           ++i) {
+        float time;
+        if (intersectTriangle(
+                &this->_vertices[3 * i],
+                origin,
+                direction,
+                nearestTime,
+                time)) {
+          nearestTime = time;
+          nearestTriangle = i;
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearer child first, so that its hits cull the farther one.
+    const int32 first = nodeIndex + 1;
+    const int32 second = node.firstOrSecond;
+    const float firstEntry = intersectBox(
+        this->_nodes[first].min,
+        this->_nodes[first].max,
+        origin,
+        inverseDirection,
+        nearestTime);
+    const float secondEntry = intersectBox(
+        this->_nodes[second].min,
+        this->_nodes[second].max,
+        origin,
+        inverseDirection,
+        nearestTime);
+
+    const bool firstIsNearer =
+        secondEntry < 0.0f || (firstEntry >= 0.0f && firstEntry <= secondEntry);
+    const int32 nearer = firstIsNearer ? first : second;
+    const int32 farther = firstIsNearer ? second : first;
+    const float fartherEntry = firstIsNearer ? secondEntry : firstEntry;
+    const float nearerEntry = firstIsNearer ? firstEntry : secondEntry;
+
+    if (fartherEntry >= 0.0f && stackSize < MaxStackSize) {
+      stack[stackSize++] = farther;
+    }
+    if (nearerEntry >= 0.0f && stackSize < MaxStackSize) {
+      stack[stackSize++] = nearer;
+    }
+  }
+
+  if (nearestTriangle == INDEX_NONE) {
+    return false;
+  }
+
+  const FVector3f* pVertices = &this->_vertices[3 * nearestTriangle];
+  FVector3f normal = FVector3f::CrossProduct(
+                         pVertices[1] - pVertices[0],
+                         pVertices[2] - pVertices[0])
+                         .GetSafeNormal();
+  if (FVector3f::DotProduct(normal, direction) > 0.0f) {
+    normal = -normal;
+  }
+
+  hit.faceIndex = this->_faceIndices[nearestTriangle];
+  hit.time = nearestTime;
+  hit.normal = normal;
+  return true;
+}
+
+SIZE_T CesiumPrimitiveBvh::getAllocatedSize() const {
+  return this->_nodes.GetAllocatedSize() +
+         this->_vertices.GetAllocatedSize() +
+         this->_faceIndices.GetAllocatedSize();
+}
+
+int32 CesiumPrimitiveBvh::_build(
+    TArray<int32>& order,
+    const TArray<FVector3f>& centroids,
+    int32 begin,
+    int32 end) {
+  const int32 nodeIndex = this->_nodes.Num();
+  Node& node = this->_nodes.Emplace_GetRef();
+
+  FVector3f min(MAX_flt);
+  FVector3f max(-MAX_flt);
+  FVector3f centroidMin(MAX_flt);
+  FVector3f centroidMax(-MAX_flt);
+  for (int32 i = begin; i < end; ++i) {
+    const int32 triangle = order[i];
+    for (int32 j = 0; j < 3; ++j) {
+      min = min.ComponentMin(this->_vertices[3 * triangle + j]);
+      max = max.ComponentMax(this->_vertices[3 * triangle + j]);
+    }
+    centroidMin = centroidMin.ComponentMin(centroids[triangle]);
+    centroidMax = centroidMax.ComponentMax(centroids[triangle]);
+  }
+  node.min = min;
+  node.max = max;
+
+  if (end - begin <= MaxTrianglesPerLeaf) {
+    node.firstOrSecond = begin;
+    node.count = end - begin;
+    return nodeIndex;
+  }
+
+  // Split the triangles in half at the median of their centroids along the
+  // longest axis of the centroids' bounds, which keeps the hierarchy balanced.
+  const FVector3f extent = centroidMax - centroidMin;
+  int32 axis = 0;
+  if (extent.Y > extent[axis]) {
+    axis = 1;
+  }
+  if (extent.Z > extent[axis]) {
+    axis = 2;
+  }
+  const int32 middle = begin + (end - begin) / 2;
+  std::nth_element(
+      order.GetData() + begin,
+      order.GetData() + middle,
+      order.GetData() + end,
+      [&centroids, axis](int32 a, int32 b) {
+        return centroids[a][axis] < centroids[b][axis];
+      });
+
+  // Building the children adds nodes, which may move this one.
+  this->_nodes[nodeIndex].count = 0;
+  this->_build(order, centroids, begin, middle);
+  const int32 second = this->_build(order, centroids, middle, end);
+  this->_nodes[nodeIndex].firstOrSecond = second;
+  return nodeIndex;
+}
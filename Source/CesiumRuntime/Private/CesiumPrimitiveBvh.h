@@ -0,0 +1,122 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltf/AccessorView.h"
+#include "Containers/Array.h"
+#include "GltfAccessors.h"
+#include "Math/Vector.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * A bounding volume hierarchy over the triangles of a glTF primitive, which
+ * finds the triangle that a ray hits without a physics mesh.
+ *
+ * The triangles are in the local coordinates of the primitive's component,
+ * i.e. glTF coordinates with the Y axis inverted. Each node of the hierarchy
+ * holds the bounding box of its triangles. Leaves hold up to
+ * MaxTrianglesPerLeaf triangles, whose vertices are copied next to each other
+ * so that a ray only reads the triangles of the leaves it enters.
+ */
+class CesiumPrimitiveBvh {
+public:
+  /** The largest number of triangles in a leaf. */
+  static constexpr int32 MaxTrianglesPerLeaf = 4;
+
+  /**
+   * The triangle that a ray hit.
+   */
+  struct RayHit {
+    /** The index of the face of the primitive that was hit. */
+    int32 faceIndex = -1;
+
+    /**
+     * The distance to the hit along the ray, as a multiple of the length of
+     * the ray's direction.
+     */
+    float time = 0.0f;
+
+    /**
+     * The unit normal of the triangle that was hit, facing against the
+     * direction of the ray.
+     */
+    FVector3f normal = FVector3f::ZeroVector;
+  };
+
+  /**
+   * Builds the hierarchy of the triangles of a glTF primitive whose mode is
+   * TRIANGLES.
+   *
+   * @param positions The positions of the primitive.
+   * @param indices The indices of the primitive, if any.
+   * @return The hierarchy, or nullptr if the positions are invalid or the
+   * primitive has no triangles. Faces with out-of-bounds indices are left out.
+   */
+  static TUniquePtr<CesiumPrimitiveBvh> create(
+      const CesiumGltf::AccessorView<FVector3f>& positions,
+      const CesiumIndexAccessorType& indices);
+
+  /**
+   * Builds the hierarchy of the given triangles.
+   *
+   * @param vertices The three vertices of each triangle.
+   * @param faceIndices The face index of each triangle.
+   */
+  CesiumPrimitiveBvh(
+      TArray<FVector3f>&& vertices,
+      TArray<int32>&& faceIndices);
+
+  /**
+   * Finds the nearest triangle hit by a ray. Triangles are hit from both
+   * sides.
+   *
+   * @param origin The origin of the ray.
+   * @param direction The direction of the ray, which doesn't need to be
+   * normalized.
+   * @param maxTime The largest distance along the ray, as a multiple of the
+   * length of direction.
+   * @param hit Receives the nearest hit, if any.
+   * @return Whether the ray hit a triangle.
+   */
+  bool raycast(
+      const FVector3f& origin,
+      const FVector3f& direction,
+      float maxTime,
+      RayHit& hit) const;
+
+  /** Gets the number of triangles. */
+  int32 getTriangleCount() const { return this->_faceIndices.Num(); }
+
+  /** Gets the number of nodes. */
+  int32 getNodeCount() const { return this->_nodes.Num(); }
+
+  /** Gets the number of bytes allocated by the hierarchy. */
+  SIZE_T getAllocatedSize() const;
+
+  /** Gets the time it took to build the hierarchy, in seconds. */
+  double getBuildSeconds() const { return this->_buildSeconds; }
+
+private:
+  /**
+   * A node of the hierarchy. The first child of an inner node follows it, and
+   * the index of its second child is in firstOrSecond. A leaf's triangles are
+   * [firstOrSecond, firstOrSecond + count).
+   */
+  struct Node {
+    FVector3f min;
+    int32 firstOrSecond;
+    FVector3f max;
+    int32 count;
+  };
+
+  int32 _build(
+      TArray<int32>& order,
+      const TArray<FVector3f>& centroids,
+      int32 begin,
+      int32 end);
+
+  TArray<Node> _nodes;
+  TArray<FVector3f> _vertices;
+  TArray<int32> _faceIndices;
+  double _buildSeconds;
+};
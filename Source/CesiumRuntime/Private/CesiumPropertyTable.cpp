@@ -1,7 +1,14 @@
 // Copyright 2020-2023 CesiumGS, Inc. and Contributors
 
 #include "CesiumPropertyTable.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
 #include "CesiumGltf/PropertyTableView.h"
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
 
 using namespace CesiumGltf;
 
@@ -86,6 +93,8 @@ UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeature(
     return values;
   }
 
+  values.Reserve(PropertyTable._properties.Num());
+
   for (const auto& pair : PropertyTable._properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
     ECesiumPropertyTablePropertyStatus status =
@@ -119,6 +128,8 @@ UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatureAsStrings(
     return values;
   }
 
+  values.Reserve(PropertyTable._properties.Num());
+
   for (const auto& pair : PropertyTable._properties) {
     const FCesiumPropertyTableProperty& property = pair.Value;
     ECesiumPropertyTablePropertyStatus status =
@@ -135,3 +146,387 @@ UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatureAsStrings(
 
   return values;
 }
+
+namespace {
+// The number of features whose values a query reads at once.
+constexpr int32 QueryBlockSize = 1024;
+
+using StringPropertyView = PropertyTablePropertyView<std::string_view>;
+
+template <typename T>
+bool compareValue(
+    ECesiumPropertyTableQueryOperator op,
+    const T& lhs,
+    const T& rhs) {
+  switch (op) {
+  case ECesiumPropertyTableQueryOperator::Equal:
+    return lhs == rhs;
+  case ECesiumPropertyTableQueryOperator::NotEqual:
+    // Unlike !=, this is false for NaN.
+    return lhs < rhs || rhs < lhs;
+  case ECesiumPropertyTableQueryOperator::Less:
+    return lhs < rhs;
+  case ECesiumPropertyTableQueryOperator::LessOrEqual:
+    return lhs <= rhs;
+  case ECesiumPropertyTableQueryOperator::Greater:
+    return lhs > rhs;
+  case ECesiumPropertyTableQueryOperator::GreaterOrEqual:
+    return lhs >= rhs;
+  default:
+    return false;
+  }
+}
+
+template <typename T, typename Compare>
+void compareValues(
+    TArrayView<const T> values,
+    const T& value,
+    Compare&& compare,
+    TArrayView<bool> keep) {
+  for (int32 i = 0; i < values.Num(); ++i) {
+    keep[i] = compare(values[i], value);
+  }
+}
+
+/**
+ * Compares a block of values with the given operator. The operator is only
+ * resolved once for the whole block, so that the loop can be vectorized.
+ */
+template <typename T>
+void compareValues(
+    ECesiumPropertyTableQueryOperator op,
+    TArrayView<const T> values,
+    const T& value,
+    TArrayView<bool> keep) {
+  switch (op) {
+  case ECesiumPropertyTableQueryOperator::Equal:
+    compareValues(values, value, std::equal_to<T>(), keep);
+    break;
+  case ECesiumPropertyTableQueryOperator::NotEqual:
+    compareValues(
+        values,
+        value,
+        [](const T& lhs, const T& rhs) { return lhs < rhs || rhs < lhs; },
+        keep);
+    break;
+  case ECesiumPropertyTableQueryOperator::Less:
+    compareValues(values, value, std::less<T>(), keep);
+    break;
+  case ECesiumPropertyTableQueryOperator::LessOrEqual:
+    compareValues(values, value, std::less_equal<T>(), keep);
+    break;
+  case ECesiumPropertyTableQueryOperator::Greater:
+    compareValues(values, value, std::greater<T>(), keep);
+    break;
+  case ECesiumPropertyTableQueryOperator::GreaterOrEqual:
+    compareValues(values, value, std::greater_equal<T>(), keep);
+    break;
+  default:
+    for (bool& keepValue : keep) {
+      keepValue = false;
+    }
+    break;
+  }
+}
+
+/**
+ * Calls filterBlock with blocks of the IDs of the matching features, and
+ * keeps only the features for which it sets keep to true.
+ */
+template <typename Func>
+void filterMatches(TBitArray<>& matches, Func&& filterBlock) {
+  TBitArray<> kept(false, matches.Num());
+  TArray<int64> featureIDs;
+  featureIDs.Reserve(QueryBlockSize);
+  TArray<bool> keep;
+  keep.Reserve(QueryBlockSize);
+
+  auto filter = [&]() {
+    keep.SetNumUninitialized(featureIDs.Num());
+    filterBlock(TArrayView<const int64>(featureIDs), TArrayView<bool>(keep));
+    for (int32 i = 0; i < featureIDs.Num(); ++i) {
+      if (keep[i]) {
+        kept[int32(featureIDs[i])] = true;
+      }
+    }
+    featureIDs.Reset();
+  };
+
+  for (TConstSetBitIterator<> it(matches); it; ++it) {
+    featureIDs.Add(it.GetIndex());
+    if (featureIDs.Num() == QueryBlockSize) {
+      filter();
+    }
+  }
+  if (featureIDs.Num() > 0) {
+    filter();
+  }
+
+  matches = MoveTemp(kept);
+}
+
+bool isStringProperty(const FCesiumPropertyTableProperty& Property) {
+  const FCesiumMetadataValueType valueType =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(Property);
+  return valueType.Type == ECesiumMetadataType::String && !valueType.bIsArray;
+}
+} // namespace
+
+FCesiumPropertyTableQuery::FCesiumPropertyTableQuery(
+    const FCesiumPropertyTable& PropertyTable)
+    : _pPropertyTable(&PropertyTable), _matches(), _indexes() {
+  this->reset();
+}
+
+void FCesiumPropertyTableQuery::reset() {
+  const int64 count =
+      UCesiumPropertyTableBlueprintLibrary::GetPropertyTableCount(
+          *this->_pPropertyTable);
+  // Feature IDs are limited to the range of int32 by TBitArray.
+  this->_matches.Init(
+      true,
+      int32(FMath::Min(count, int64(std::numeric_limits<int32>::max()))));
+}
+
+FCesiumPropertyTableQuery& FCesiumPropertyTableQuery::whereFloat64(
+    const FString& PropertyName,
+    ECesiumPropertyTableQueryOperator Operator,
+    double Value) {
+  const FCesiumPropertyTableProperty* pProperty =
+      this->_pPropertyTable->_properties.Find(PropertyName);
+  if (!pProperty || FMath::IsNaN(Value)) {
+    this->_matches.Init(false, this->_matches.Num());
+    return *this;
+  }
+
+  const PropertyIndex* pIndex = this->_indexes.Find(PropertyName);
+  if (pIndex && !isStringProperty(*pProperty)) {
+    const TArray<TPair<double, int32>>& numbers = pIndex->numbers;
+    auto getValue = [](const TPair<double, int32>& entry) {
+      return entry.Key;
+    };
+    const int32 lower = Algo::LowerBoundBy(numbers, Value, getValue);
+    const int32 upper = Algo::UpperBoundBy(numbers, Value, getValue);
+
+    TBitArray<> inRange(false, this->_matches.Num());
+    auto addRange = [&numbers, &inRange](int32 first, int32 last) {
+      for (int32 i = first; i < last; ++i) {
+        inRange[numbers[i].Value] = true;
+      }
+    };
+
+    switch (Operator) {
+    case ECesiumPropertyTableQueryOperator::Equal:
+      addRange(lower, upper);
+      break;
+    case ECesiumPropertyTableQueryOperator::NotEqual:
+      addRange(0, lower);
+      addRange(upper, numbers.Num());
+      break;
+    case ECesiumPropertyTableQueryOperator::Less:
+      addRange(0, lower);
+      break;
+    case ECesiumPropertyTableQueryOperator::LessOrEqual:
+      addRange(0, upper);
+      break;
+    case ECesiumPropertyTableQueryOperator::Greater:
+      addRange(upper, numbers.Num());
+      break;
+    case ECesiumPropertyTableQueryOperator::GreaterOrEqual:
+      addRange(lower, numbers.Num());
+      break;
+    }
+
+    this->_matches.CombineWithBitwiseAND(
+        inRange,
+        EBitwiseOperatorFlags::MaintainSize);
+    return *this;
+  }
+
+  // Features without a value read as NaN, which no comparison matches.
+  const FCesiumPropertyTablePropertyHandle property(*pProperty);
+  TArray<double> values;
+  filterMatches(
+      this->_matches,
+      [&property, &values, Operator, Value](
+          TArrayView<const int64> featureIDs,
+          TArrayView<bool> keep) {
+        values.SetNumUninitialized(featureIDs.Num());
+        property.getFloat64s(
+            featureIDs,
+            std::numeric_limits<double>::quiet_NaN(),
+            values);
+        compareValues<double>(Operator, values, Value, keep);
+      });
+
+  return *this;
+}
+
+FCesiumPropertyTableQuery& FCesiumPropertyTableQuery::whereString(
+    const FString& PropertyName,
+    ECesiumPropertyTableQueryOperator Operator,
+    const FString& Value) {
+  const FCesiumPropertyTableProperty* pProperty =
+      this->_pPropertyTable->_properties.Find(PropertyName);
+  const StringPropertyView* pView =
+      pProperty && isStringProperty(*pProperty)
+          ? std::any_cast<StringPropertyView>(&pProperty->_property)
+          : nullptr;
+  if (!pView) {
+    this->_matches.Init(false, this->_matches.Num());
+    return *this;
+  }
+
+  const std::string value = TCHAR_TO_UTF8(*Value);
+
+  const PropertyIndex* pIndex = this->_indexes.Find(PropertyName);
+  if (pIndex && Operator == ECesiumPropertyTableQueryOperator::Equal) {
+    TBitArray<> equal(false, this->_matches.Num());
+    auto it = pIndex->strings.find(value);
+    if (it != pIndex->strings.end()) {
+      for (int32 featureID : it->second) {
+        equal[featureID] = true;
+      }
+    }
+
+    this->_matches.CombineWithBitwiseAND(
+        equal,
+        EBitwiseOperatorFlags::MaintainSize);
+    return *this;
+  }
+
+  const std::string_view valueView(value);
+  filterMatches(
+      this->_matches,
+      [pView, Operator, valueView](
+          TArrayView<const int64> featureIDs,
+          TArrayView<bool> keep) {
+        const int64 size = pView->size();
+        for (int32 i = 0; i < featureIDs.Num(); ++i) {
+          const int64 featureID = featureIDs[i];
+          std::optional<std::string_view> maybeValue =
+              featureID < size ? pView->get(featureID) : std::nullopt;
+          keep[i] =
+              maybeValue && compareValue(Operator, *maybeValue, valueView);
+        }
+      });
+
+  return *this;
+}
+
+FCesiumPropertyTableQuery& FCesiumPropertyTableQuery::whereBoolean(
+    const FString& PropertyName,
+    bool Value) {
+  const FCesiumPropertyTableProperty* pProperty =
+      this->_pPropertyTable->_properties.Find(PropertyName);
+  if (!pProperty) {
+    this->_matches.Init(false, this->_matches.Num());
+    return *this;
+  }
+
+  const FCesiumPropertyTablePropertyHandle property(*pProperty);
+  TArray<bool> values;
+  filterMatches(
+      this->_matches,
+      [&property, &values, Value](
+          TArrayView<const int64> featureIDs,
+          TArrayView<bool> keep) {
+        values.SetNumUninitialized(featureIDs.Num());
+        property.getBooleans(featureIDs, false, values);
+        for (int32 i = 0; i < featureIDs.Num(); ++i) {
+          keep[i] = values[i] == Value;
+        }
+      });
+
+  return *this;
+}
+
+void FCesiumPropertyTableQuery::buildIndex(const FString& PropertyName) {
+  const FCesiumPropertyTableProperty* pProperty =
+      this->_pPropertyTable->_properties.Find(PropertyName);
+  if (!pProperty || this->_indexes.Contains(PropertyName)) {
+    return;
+  }
+
+  PropertyIndex& index = this->_indexes.Add(PropertyName);
+  const int32 count = this->_matches.Num();
+
+  if (isStringProperty(*pProperty)) {
+    const StringPropertyView* pView =
+        std::any_cast<StringPropertyView>(&pProperty->_property);
+    const int64 size = pView ? pView->size() : 0;
+    for (int32 featureID = 0; featureID < count && featureID < size;
+         ++featureID) {
+      std::optional<std::string_view> maybeValue = pView->get(featureID);
+      if (maybeValue) {
+        index.strings[std::string(*maybeValue)].Add(featureID);
+      }
+    }
+    return;
+  }
+
+  const FCesiumPropertyTablePropertyHandle property(*pProperty);
+  TArray<int64> featureIDs;
+  TArray<double> values;
+  index.numbers.Reserve(count);
+  for (int32 first = 0; first < count; first += QueryBlockSize) {
+    const int32 blockSize = FMath::Min(QueryBlockSize, count - first);
+    featureIDs.SetNumUninitialized(blockSize);
+    values.SetNumUninitialized(blockSize);
+    for (int32 i = 0; i < blockSize; ++i) {
+      featureIDs[i] = first + i;
+    }
+
+    property.getFloat64s(
+        featureIDs,
+        std::numeric_limits<double>::quiet_NaN(),
+        values);
+    for (int32 i = 0; i < blockSize; ++i) {
+      if (!FMath::IsNaN(values[i])) {
+        index.numbers.Emplace(values[i], first + i);
+      }
+    }
+  }
+
+  Algo::SortBy(index.numbers, [](const TPair<double, int32>& entry) {
+    return entry.Key;
+  });
+}
+
+int64 FCesiumPropertyTableQuery::countMatches() const {
+  return this->_matches.CountSetBits();
+}
+
+void FCesiumPropertyTableQuery::getMatchingFeatureIDs(
+    TArray<int64>& FeatureIDs) const {
+  FeatureIDs.Reset();
+  for (TConstSetBitIterator<> it(this->_matches); it; ++it) {
+    FeatureIDs.Add(it.GetIndex());
+  }
+}
+
+/*static*/ TArray<int64>
+UCesiumPropertyTableBlueprintLibrary::FindFeatureIDsByFloat64(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    ECesiumPropertyTableQueryOperator Operator,
+    double Value) {
+  TArray<int64> featureIDs;
+  FCesiumPropertyTableQuery(PropertyTable)
+      .whereFloat64(PropertyName, Operator, Value)
+      .getMatchingFeatureIDs(featureIDs);
+  return featureIDs;
+}
+
+/*static*/ TArray<int64>
+UCesiumPropertyTableBlueprintLibrary::FindFeatureIDsByString(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const FString& PropertyName,
+    ECesiumPropertyTableQueryOperator Operator,
+    const FString& Value) {
+  TArray<int64> featureIDs;
+  FCesiumPropertyTableQuery(PropertyTable)
+      .whereString(PropertyName, Operator, Value)
+      .getMatchingFeatureIDs(featureIDs);
+  return featureIDs;
+}
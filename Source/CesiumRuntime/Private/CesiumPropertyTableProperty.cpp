@@ -1402,3 +1402,254 @@ UCesiumPropertyTablePropertyBlueprintLibrary::GetGenericValue(
 }
 
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+namespace {
+template <typename TTo, typename TView>
+void getValuesFromView(
+    const void* pView,
+    TArrayView<const int64> featureIDs,
+    const TTo& defaultValue,
+    TArrayView<TTo> values) {
+  const TView& view = *static_cast<const TView*>(pView);
+  const int64 size = view.size();
+  for (int32 i = 0; i < featureIDs.Num(); ++i) {
+    const int64 featureID = featureIDs[i];
+    if (featureID < 0 || featureID >= size) {
+      values[i] = defaultValue;
+      continue;
+    }
+
+    auto maybeValue = view.get(featureID);
+    if (maybeValue) {
+      auto value = *maybeValue;
+      values[i] = CesiumMetadataConversions<TTo, decltype(value)>::convert(
+          value,
+          defaultValue);
+    } else {
+      values[i] = defaultValue;
+    }
+  }
+}
+
+template <typename T>
+void getValuesOrDefault(
+    const void* pView,
+    void (*pGetValues)(
+        const void*,
+        TArrayView<const int64>,
+        const T&,
+        TArrayView<T>),
+    TArrayView<const int64> featureIDs,
+    const T& defaultValue,
+    TArrayView<T> values) {
+  check(featureIDs.Num() == values.Num());
+  if (pGetValues) {
+    pGetValues(pView, featureIDs, defaultValue, values);
+    return;
+  }
+
+  for (T& value : values) {
+    value = defaultValue;
+  }
+}
+
+template <typename T>
+T getValueOrDefault(
+    const void* pView,
+    void (*pGetValues)(
+        const void*,
+        TArrayView<const int64>,
+        const T&,
+        TArrayView<T>),
+    int64 featureID,
+    const T& defaultValue) {
+  if (!pGetValues) {
+    return defaultValue;
+  }
+
+  T value;
+  pGetValues(
+      pView,
+      TArrayView<const int64>(&featureID, 1),
+      defaultValue,
+      TArrayView<T>(&value, 1));
+  return value;
+}
+} // namespace
+
+FCesiumPropertyTablePropertyHandle::FCesiumPropertyTablePropertyHandle(
+    const FCesiumPropertyTableProperty& Property) {
+  if (Property._status != ECesiumPropertyTablePropertyStatus::Valid &&
+      Property._status !=
+          ECesiumPropertyTablePropertyStatus::EmptyPropertyWithDefault) {
+    return;
+  }
+
+  propertyTablePropertyCallback<void>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      [this, &Property](const auto& view) {
+        using TView = std::decay_t<decltype(view)>;
+        // The callback receives a temporary invalid view if the type of the
+        // property could not be resolved. Only refer to the property's own
+        // view.
+        if (std::any_cast<TView>(&Property._property) != &view) {
+          return;
+        }
+
+        this->_pView = &view;
+        this->_size = view.size();
+        this->_getBooleans = &getValuesFromView<bool, TView>;
+        this->_getInteger64s = &getValuesFromView<int64, TView>;
+        this->_getFloat64s = &getValuesFromView<double, TView>;
+        this->_getVectors = &getValuesFromView<FVector, TView>;
+        this->_getVector4s = &getValuesFromView<FVector4, TView>;
+      });
+}
+
+bool FCesiumPropertyTablePropertyHandle::getBoolean(
+    int64 featureID,
+    bool defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getBooleans,
+      featureID,
+      defaultValue);
+}
+
+int64 FCesiumPropertyTablePropertyHandle::getInteger64(
+    int64 featureID,
+    int64 defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getInteger64s,
+      featureID,
+      defaultValue);
+}
+
+double FCesiumPropertyTablePropertyHandle::getFloat64(
+    int64 featureID,
+    double defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getFloat64s,
+      featureID,
+      defaultValue);
+}
+
+FVector FCesiumPropertyTablePropertyHandle::getVector(
+    int64 featureID,
+    const FVector& defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getVectors,
+      featureID,
+      defaultValue);
+}
+
+FVector4 FCesiumPropertyTablePropertyHandle::getVector4(
+    int64 featureID,
+    const FVector4& defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getVector4s,
+      featureID,
+      defaultValue);
+}
+
+void FCesiumPropertyTablePropertyHandle::getBooleans(
+    TArrayView<const int64> featureIDs,
+    bool defaultValue,
+    TArrayView<bool> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getBooleans,
+      featureIDs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTablePropertyHandle::getInteger64s(
+    TArrayView<const int64> featureIDs,
+    int64 defaultValue,
+    TArrayView<int64> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getInteger64s,
+      featureIDs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTablePropertyHandle::getFloat64s(
+    TArrayView<const int64> featureIDs,
+    double defaultValue,
+    TArrayView<double> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getFloat64s,
+      featureIDs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTablePropertyHandle::getVectors(
+    TArrayView<const int64> featureIDs,
+    const FVector& defaultValue,
+    TArrayView<FVector> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getVectors,
+      featureIDs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTablePropertyHandle::getVector4s(
+    TArrayView<const int64> featureIDs,
+    const FVector4& defaultValue,
+    TArrayView<FVector4> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getVector4s,
+      featureIDs,
+      defaultValue,
+      values);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::GetBooleanValues(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    const TArray<int64>& FeatureIDs,
+    TArray<bool>& Values,
+    bool DefaultValue) {
+  Values.SetNumUninitialized(FeatureIDs.Num());
+  FCesiumPropertyTablePropertyHandle(Property).getBooleans(
+      FeatureIDs,
+      DefaultValue,
+      Values);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger64Values(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    const TArray<int64>& FeatureIDs,
+    TArray<int64>& Values,
+    int64 DefaultValue) {
+  Values.SetNumUninitialized(FeatureIDs.Num());
+  FCesiumPropertyTablePropertyHandle(Property).getInteger64s(
+      FeatureIDs,
+      DefaultValue,
+      Values);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64Values(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    const TArray<int64>& FeatureIDs,
+    TArray<double>& Values,
+    double DefaultValue) {
+  Values.SetNumUninitialized(FeatureIDs.Num());
+  FCesiumPropertyTablePropertyHandle(Property).getFloat64s(
+      FeatureIDs,
+      DefaultValue,
+      Values);
+}
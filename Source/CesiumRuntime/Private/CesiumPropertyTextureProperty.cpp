@@ -796,3 +796,227 @@ UCesiumPropertyTexturePropertyBlueprintLibrary::GetDefaultValue(
         return FCesiumMetadataValue(view.defaultValue());
       });
 }
+
+namespace {
+template <typename TTo, typename TView>
+void getValuesFromView(
+    const void* pView,
+    TArrayView<const FVector2D> uvs,
+    const TTo& defaultValue,
+    TArrayView<TTo> values) {
+  const TView& view = *static_cast<const TView*>(pView);
+  for (int32 i = 0; i < uvs.Num(); ++i) {
+    auto maybeValue = view.get(uvs[i].X, uvs[i].Y);
+    if (maybeValue) {
+      auto value = *maybeValue;
+      values[i] = CesiumMetadataConversions<TTo, decltype(value)>::convert(
+          value,
+          defaultValue);
+    } else {
+      values[i] = defaultValue;
+    }
+  }
+}
+
+template <typename T>
+void getValuesOrDefault(
+    const void* pView,
+    void (*pGetValues)(
+        const void*,
+        TArrayView<const FVector2D>,
+        const T&,
+        TArrayView<T>),
+    TArrayView<const FVector2D> uvs,
+    const T& defaultValue,
+    TArrayView<T> values) {
+  check(uvs.Num() == values.Num());
+  if (pGetValues) {
+    pGetValues(pView, uvs, defaultValue, values);
+    return;
+  }
+
+  for (T& value : values) {
+    value = defaultValue;
+  }
+}
+
+template <typename T>
+T getValueOrDefault(
+    const void* pView,
+    void (*pGetValues)(
+        const void*,
+        TArrayView<const FVector2D>,
+        const T&,
+        TArrayView<T>),
+    const FVector2D& uv,
+    const T& defaultValue) {
+  if (!pGetValues) {
+    return defaultValue;
+  }
+
+  T value;
+  pGetValues(
+      pView,
+      TArrayView<const FVector2D>(&uv, 1),
+      defaultValue,
+      TArrayView<T>(&value, 1));
+  return value;
+}
+} // namespace
+
+FCesiumPropertyTexturePropertyHandle::FCesiumPropertyTexturePropertyHandle(
+    const FCesiumPropertyTextureProperty& Property) {
+  // Empty properties have no image to sample, and the Blueprint functions
+  // return the user-defined default value for them.
+  if (Property._status != ECesiumPropertyTexturePropertyStatus::Valid) {
+    return;
+  }
+
+  propertyTexturePropertyCallback<void>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      [this, &Property](const auto& view) {
+        using TView = std::decay_t<decltype(view)>;
+        // The callback receives a temporary invalid view if the type of the
+        // property could not be resolved. Only refer to the property's own
+        // view.
+        if (std::any_cast<TView>(&Property._property) != &view ||
+            view.status() != PropertyTexturePropertyViewStatus::Valid) {
+          return;
+        }
+
+        this->_pView = &view;
+        this->_getIntegers = &getValuesFromView<int32, TView>;
+        this->_getFloats = &getValuesFromView<float, TView>;
+        this->_getFloat64s = &getValuesFromView<double, TView>;
+        this->_getVectors = &getValuesFromView<FVector, TView>;
+        this->_getVector4s = &getValuesFromView<FVector4, TView>;
+      });
+}
+
+int32 FCesiumPropertyTexturePropertyHandle::getInteger(
+    const FVector2D& uv,
+    int32 defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getIntegers,
+      uv,
+      defaultValue);
+}
+
+float FCesiumPropertyTexturePropertyHandle::getFloat(
+    const FVector2D& uv,
+    float defaultValue) const {
+  return getValueOrDefault(this->_pView, this->_getFloats, uv, defaultValue);
+}
+
+double FCesiumPropertyTexturePropertyHandle::getFloat64(
+    const FVector2D& uv,
+    double defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getFloat64s,
+      uv,
+      defaultValue);
+}
+
+FVector FCesiumPropertyTexturePropertyHandle::getVector(
+    const FVector2D& uv,
+    const FVector& defaultValue) const {
+  return getValueOrDefault(this->_pView, this->_getVectors, uv, defaultValue);
+}
+
+FVector4 FCesiumPropertyTexturePropertyHandle::getVector4(
+    const FVector2D& uv,
+    const FVector4& defaultValue) const {
+  return getValueOrDefault(
+      this->_pView,
+      this->_getVector4s,
+      uv,
+      defaultValue);
+}
+
+void FCesiumPropertyTexturePropertyHandle::getIntegers(
+    TArrayView<const FVector2D> uvs,
+    int32 defaultValue,
+    TArrayView<int32> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getIntegers,
+      uvs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTexturePropertyHandle::getFloats(
+    TArrayView<const FVector2D> uvs,
+    float defaultValue,
+    TArrayView<float> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getFloats,
+      uvs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTexturePropertyHandle::getFloat64s(
+    TArrayView<const FVector2D> uvs,
+    double defaultValue,
+    TArrayView<double> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getFloat64s,
+      uvs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTexturePropertyHandle::getVectors(
+    TArrayView<const FVector2D> uvs,
+    const FVector& defaultValue,
+    TArrayView<FVector> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getVectors,
+      uvs,
+      defaultValue,
+      values);
+}
+
+void FCesiumPropertyTexturePropertyHandle::getVector4s(
+    TArrayView<const FVector2D> uvs,
+    const FVector4& defaultValue,
+    TArrayView<FVector4> values) const {
+  getValuesOrDefault(
+      this->_pView,
+      this->_getVector4s,
+      uvs,
+      defaultValue,
+      values);
+}
+
+void UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+    UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+    const TArray<FVector2D>& UVs,
+    TArray<double>& Values,
+    double DefaultValue) {
+  Values.SetNumUninitialized(UVs.Num());
+  FCesiumPropertyTexturePropertyHandle(Property).getFloat64s(
+      UVs,
+      DefaultValue,
+      Values);
+}
+
+void UCesiumPropertyTexturePropertyBlueprintLibrary::GetVector4Values(
+    UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+    const TArray<FVector2D>& UVs,
+    TArray<FVector4>& Values,
+    const FVector4& DefaultValue) {
+  Values.SetNumUninitialized(UVs.Num());
+  FCesiumPropertyTexturePropertyHandle(Property).getVector4s(
+      UVs,
+      DefaultValue,
+      Values);
+}
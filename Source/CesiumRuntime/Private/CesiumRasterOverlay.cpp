@@ -5,6 +5,7 @@
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTileset.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRasterOverlayTexturePool.h"
 #include "CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h"
 #include "CesiumRuntime.h"
 
@@ -50,6 +51,13 @@ void UCesiumRasterOverlay::AddToTileset() {
   options.subTileCacheBytes = this->SubTileCacheBytes;
   options.showCreditsOnScreen = this->ShowCreditsOnScreen;
   options.rendererOptions = &this->rendererOptions;
+  if (this->rendererOptions.useTexturePool) {
+    this->rendererOptions.pTexturePool =
+        MakeShared<CesiumRasterOverlayTexturePool>(
+            this->rendererOptions.filter,
+            this->rendererOptions.group,
+            this->rendererOptions.useMipmaps);
+  }
   options.loadErrorCallback =
       [this](const CesiumRasterOverlays::RasterOverlayLoadFailureDetails&
                  details) {
@@ -122,6 +130,9 @@ void UCesiumRasterOverlay::RemoveFromTileset() {
   this->OnRemove(pTileset, this->_pOverlay);
   pTileset->getOverlays().remove(this->_pOverlay);
   this->_pOverlay = nullptr;
+
+  // Tiles that still use the texture pool keep it alive until they're freed.
+  this->rendererOptions.pTexturePool = nullptr;
 }
 
 void UCesiumRasterOverlay::Refresh() {
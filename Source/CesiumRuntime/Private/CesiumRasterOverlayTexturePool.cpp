@@ -0,0 +1,279 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumRasterOverlayTexturePool.h"
+#include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumUtility/Tracing.h>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Raster Overlay Pool Pages"),
+    STAT_CesiumRasterOverlayPoolPages,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Raster Overlay Pool Slots"),
+    STAT_CesiumRasterOverlayPoolSlots,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Raster Overlay Pool Memory"),
+    STAT_CesiumRasterOverlayPoolBytes,
+    STATGROUP_Cesium);
+
+namespace {
+
+constexpr int32 BytesPerPixel = 4;
+
+int64 computePageBytes(int32 mipCount) {
+  int64 bytes = 0;
+  for (int32 mip = 0; mip < mipCount; ++mip) {
+    const int64 size = CesiumRasterOverlayTexturePool::PageSize >> mip;
+    bytes += size * size * BytesPerPixel;
+  }
+  return bytes;
+}
+
+// Copies a mip level into the middle of a larger buffer and repeats its edge
+// pixels into the gutter around it.
+TArray<uint8>
+addGutter(const std::byte* pPixels, int32 width, int32 height, int32 gutter) {
+  const int32 paddedWidth = width + 2 * gutter;
+  const int32 paddedHeight = height + 2 * gutter;
+
+  TArray<uint8> padded;
+  padded.SetNumUninitialized(paddedWidth * paddedHeight * BytesPerPixel);
+
+  for (int32 y = 0; y < paddedHeight; ++y) {
+    const int32 sourceY = FMath::Clamp(y - gutter, 0, height - 1);
+    const uint8* pSource = reinterpret_cast<const uint8*>(pPixels) +
+                           sourceY * width * BytesPerPixel;
+    uint8* pRow = padded.GetData() + y * paddedWidth * BytesPerPixel;
+
+    for (int32 x = 0; x < gutter; ++x) {
+      FMemory::Memcpy(pRow + x * BytesPerPixel, pSource, BytesPerPixel);
+    }
+
+    FMemory::Memcpy(
+        pRow + gutter * BytesPerPixel,
+        pSource,
+        width * BytesPerPixel);
+
+    const uint8* pLast = pSource + (width - 1) * BytesPerPixel;
+    for (int32 x = gutter + width; x < paddedWidth; ++x) {
+      FMemory::Memcpy(pRow + x * BytesPerPixel, pLast, BytesPerPixel);
+    }
+  }
+
+  return padded;
+}
+
+} // namespace
+
+CesiumRasterOverlayTexturePool::CesiumRasterOverlayTexturePool(
+    TextureFilter filter,
+    TextureGroup group,
+    bool useMipmaps)
+    : _filter(filter),
+      _group(group),
+      _mipCount(useMipmaps ? PageMipCount : 1),
+      _allocator(PageSize, Gutter, Gutter),
+      _pages() {}
+
+CesiumRasterOverlayTexturePool::~CesiumRasterOverlayTexturePool() {
+  const CesiumTextureAtlasAllocator::Statistics& statistics =
+      this->_allocator.getStatistics();
+  DEC_DWORD_STAT_BY(STAT_CesiumRasterOverlayPoolPages, statistics.pages);
+  DEC_DWORD_STAT_BY(
+      STAT_CesiumRasterOverlayPoolSlots,
+      statistics.allocatedSlots);
+  DEC_MEMORY_STAT_BY(
+      STAT_CesiumRasterOverlayPoolBytes,
+      statistics.pages * computePageBytes(this->_mipCount));
+
+  for (UTexture2D* pPage : this->_pages) {
+    pPage->RemoveFromRoot();
+    CesiumTextureUtility::destroyTexture(pPage);
+  }
+}
+
+/*static*/ TUniquePtr<CesiumPooledRasterImage>
+CesiumRasterOverlayTexturePool::prepareImage(
+    CesiumGltf::ImageCesium& image,
+    bool useMipmaps) {
+  using CesiumGltf::GpuCompressedPixelFormat;
+  if (image.channels != BytesPerPixel || image.bytesPerChannel != 1 ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.width <= 0 || image.height <= 0 ||
+      image.pixelData.size() <
+          size_t(image.width) * size_t(image.height) * BytesPerPixel ||
+      FMath::Max(image.width, image.height) + 2 * Gutter > PageSize) {
+    return nullptr;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PreparePooledRasterImage)
+
+  if (useMipmaps) {
+    std::optional<std::string> errorMessage =
+        CesiumGltfReader::GltfReader::generateMipMaps(image);
+    if (errorMessage) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("%s"),
+          UTF8_TO_TCHAR(errorMessage->c_str()));
+    }
+  }
+
+  TUniquePtr<CesiumPooledRasterImage> pResult =
+      MakeUnique<CesiumPooledRasterImage>();
+  pResult->width = image.width;
+  pResult->height = image.height;
+
+  const int32 mipCount =
+      useMipmaps && !image.mipPositions.empty()
+          ? FMath::Min(PageMipCount, int32(image.mipPositions.size()))
+          : 1;
+
+  for (int32 mip = 0; mip < mipCount; ++mip) {
+    const int32 width = FMath::Max(image.width >> mip, 1);
+    const int32 height = FMath::Max(image.height >> mip, 1);
+    size_t byteOffset = 0;
+    if (!image.mipPositions.empty()) {
+      const CesiumGltf::ImageCesiumMipPosition& position =
+          image.mipPositions[size_t(mip)];
+      if (position.byteSize != size_t(width * height * BytesPerPixel)) {
+        break;
+      }
+      byteOffset = position.byteOffset;
+    }
+
+    pResult->mips.Emplace(addGutter(
+        image.pixelData.data() + byteOffset,
+        width,
+        height,
+        Gutter >> mip));
+  }
+
+  return pResult;
+}
+
+TUniquePtr<CesiumRasterTileTexture>
+CesiumRasterOverlayTexturePool::add(CesiumPooledRasterImage&& image) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AddPooledRasterImage)
+
+  const CesiumTextureAtlasAllocator::Slot slot =
+      this->_allocator.allocate(image.width, image.height);
+  if (!slot.isValid()) {
+    return nullptr;
+  }
+
+  while (this->_pages.Num() < this->_allocator.getPageCount()) {
+    UTexture2D* pPage = this->_createPage();
+    pPage->AddToRoot();
+    this->_pages.Add(pPage);
+
+    INC_DWORD_STAT(STAT_CesiumRasterOverlayPoolPages);
+    INC_MEMORY_STAT_BY(
+        STAT_CesiumRasterOverlayPoolBytes,
+        computePageBytes(this->_mipCount));
+  }
+  INC_DWORD_STAT(STAT_CesiumRasterOverlayPoolSlots);
+
+  UTexture2D* pPage = this->_pages[slot.page];
+
+  // The slot and the gutter are aligned to the number of mip levels, so the
+  // image starts on a whole pixel in every level.
+  const int32 mipCount = FMath::Min(image.mips.Num(), this->_mipCount);
+  for (int32 mip = 0; mip < mipCount; ++mip) {
+    const int32 gutter = Gutter >> mip;
+    const int32 width = FMath::Max(image.width >> mip, 1) + 2 * gutter;
+    const int32 height = FMath::Max(image.height >> mip, 1) + 2 * gutter;
+
+    // The region and pixels must live until the render thread has copied
+    // them.
+    FUpdateTextureRegion2D* pRegion = new FUpdateTextureRegion2D(
+        uint32(slot.x >> mip),
+        uint32(slot.y >> mip),
+        0,
+        0,
+        uint32(width),
+        uint32(height));
+    TArray<uint8>* pPixels = new TArray<uint8>(MoveTemp(image.mips[mip]));
+
+    pPage->UpdateTextureRegions(
+        mip,
+        1,
+        pRegion,
+        uint32(width * BytesPerPixel),
+        uint32(BytesPerPixel),
+        pPixels->GetData(),
+        [pPixels](uint8*, const FUpdateTextureRegion2D* pRegion) {
+          delete pPixels;
+          delete pRegion;
+        });
+  }
+
+  TUniquePtr<CesiumRasterTileTexture> pResult =
+      MakeUnique<CesiumRasterTileTexture>();
+  pResult->pTexture = pPage;
+  pResult->translation = glm::dvec2(slot.x + Gutter, slot.y + Gutter) /
+                         double(PageSize);
+  pResult->scale = glm::dvec2(image.width, image.height) / double(PageSize);
+  pResult->pPool = this->AsShared();
+  pResult->slot = slot;
+  return pResult;
+}
+
+void CesiumRasterOverlayTexturePool::free(
+    const CesiumRasterTileTexture& texture) {
+  if (!texture.slot.isValid()) {
+    return;
+  }
+
+  // The pixels are left in the page; they are overwritten when the slot is
+  // allocated again.
+  this->_allocator.free(texture.slot);
+  DEC_DWORD_STAT(STAT_CesiumRasterOverlayPoolSlots);
+}
+
+UTexture2D* CesiumRasterOverlayTexturePool::_createPage() const {
+  TUniquePtr<FTexturePlatformData> pTextureData =
+      CesiumTextureUtility::createTexturePlatformData(
+          PageSize,
+          PageSize,
+          PF_R8G8B8A8);
+
+  for (int32 mip = 0; mip < this->_mipCount; ++mip) {
+    FTexture2DMipMap* pMip = new FTexture2DMipMap();
+    pTextureData->Mips.Add(pMip);
+    pMip->SizeX = PageSize >> mip;
+    pMip->SizeY = PageSize >> mip;
+
+    const int64 bytes = int64(pMip->SizeX) * pMip->SizeY * BytesPerPixel;
+    pMip->BulkData.Lock(LOCK_READ_WRITE);
+    void* pDest = pMip->BulkData.Realloc(bytes);
+    FMemory::Memzero(pDest, bytes);
+    pMip->BulkData.Unlock();
+  }
+
+  UTexture2D* pPage = NewObject<UTexture2D>(
+      GetTransientPackage(),
+      MakeUniqueObjectName(
+          GetTransientPackage(),
+          UTexture2D::StaticClass(),
+          "CesiumRasterOverlayPage"),
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+
+  pPage->SetPlatformData(pTextureData.Release());
+  pPage->AddressX = TextureAddress::TA_Clamp;
+  pPage->AddressY = TextureAddress::TA_Clamp;
+  pPage->Filter = this->_filter;
+  pPage->LODGroup = this->_group;
+  pPage->SRGB = true;
+  pPage->NeverStream = true;
+  pPage->UpdateResource();
+
+  return pPage;
+}
@@ -0,0 +1,152 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTextureAtlasAllocator.h"
+#include "CesiumTextureUtility.h"
+#include "Engine/TextureDefines.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/UniquePtr.h"
+#include <glm/vec2.hpp>
+
+class CesiumRasterOverlayTexturePool;
+class UTexture2D;
+
+namespace CesiumGltf {
+struct ImageCesium;
+}
+
+/**
+ * The mip levels of a raster overlay tile image, prepared in a load thread to
+ * be copied into a slot of a CesiumRasterOverlayTexturePool page.
+ */
+struct CesiumPooledRasterImage {
+  /** The width of the image, in pixels. */
+  int32 width = 0;
+
+  /** The height of the image, in pixels. */
+  int32 height = 0;
+
+  /**
+   * The RGBA pixels of each mip level, surrounded by a gutter that repeats the
+   * edge pixels of the level.
+   */
+  TArray<TArray<uint8>> mips;
+};
+
+/**
+ * The result of preparing a raster overlay tile image in a load thread. Only
+ * one of the two is set.
+ */
+struct CesiumRasterTileLoadResult {
+  /** The image to copy into a texture pool page. */
+  TUniquePtr<CesiumPooledRasterImage> pPooledImage;
+
+  /** The half-loaded texture of a raster tile that isn't pooled. */
+  TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pTexture;
+};
+
+/**
+ * The texture of a raster overlay tile, which is either a texture of its own or
+ * a slot in a page of a texture pool.
+ */
+struct CesiumRasterTileTexture {
+  /** The texture, which is a pool page if pPool is set. */
+  UTexture2D* pTexture = nullptr;
+
+  /**
+   * The translation that maps the texture coordinates of the tile to its
+   * slot in the page.
+   */
+  glm::dvec2 translation{0.0};
+
+  /**
+   * The scale that maps the texture coordinates of the tile to its slot in the
+   * page.
+   */
+  glm::dvec2 scale{1.0};
+
+  /** The pool that the slot was allocated from, if any. */
+  TSharedPtr<CesiumRasterOverlayTexturePool> pPool;
+
+  /** The slot of the tile in the pool. */
+  CesiumTextureAtlasAllocator::Slot slot;
+};
+
+/**
+ * Allocates the textures of the tiles of a raster overlay from a few large
+ * atlas pages instead of creating a texture for each tile. Attaching a tile
+ * copies its image into a free slot of a page, and freeing the tile returns
+ * the slot, so tiles don't create or destroy textures and every tile of the
+ * overlay uses one of the same few textures. Materials address the slot by
+ * the overlay's existing TranslationScale parameter.
+ *
+ * All functions except prepareImage must be called from the game thread.
+ */
+class CesiumRasterOverlayTexturePool
+    : public TSharedFromThis<CesiumRasterOverlayTexturePool> {
+public:
+  /** The width and height of each page, in pixels. */
+  static constexpr int32 PageSize = 2048;
+
+  /**
+   * The number of mip levels of each page. Slots are aligned so that they
+   * stay on whole pixels in every level.
+   */
+  static constexpr int32 PageMipCount = 5;
+
+  /**
+   * The number of pixels around each image in its slot that repeat its edge
+   * pixels, so that filtering clamps to the edge of the image like it would
+   * for a texture of its own.
+   */
+  static constexpr int32 Gutter = 1 << (PageMipCount - 1);
+
+  /**
+   * Creates a pool whose pages are sampled with the given options.
+   */
+  CesiumRasterOverlayTexturePool(
+      TextureFilter filter,
+      TextureGroup group,
+      bool useMipmaps);
+  ~CesiumRasterOverlayTexturePool();
+
+  /**
+   * Prepares an image to be added to a pool. May be called from any thread.
+   *
+   * @param image The image, to which mip levels are added if needed.
+   * @param useMipmaps Whether the pool uses mip levels.
+   * @return The prepared image, or nullptr if the image can't be pooled
+   * because it isn't 8-bit RGBA or is too large for a page.
+   */
+  static TUniquePtr<CesiumPooledRasterImage>
+  prepareImage(CesiumGltf::ImageCesium& image, bool useMipmaps);
+
+  /**
+   * Copies an image into a free slot, adding a page if necessary.
+   *
+   * @return The texture of the tile, or nullptr if it couldn't be added.
+   */
+  TUniquePtr<CesiumRasterTileTexture> add(CesiumPooledRasterImage&& image);
+
+  /**
+   * Frees the slot of a tile texture that was returned by add.
+   */
+  void free(const CesiumRasterTileTexture& texture);
+
+  /**
+   * Gets statistics about the pages and slots of this pool.
+   */
+  const CesiumTextureAtlasAllocator::Statistics& getStatistics() const {
+    return this->_allocator.getStatistics();
+  }
+
+private:
+  UTexture2D* _createPage() const;
+
+  TextureFilter _filter;
+  TextureGroup _group;
+  int32 _mipCount;
+  CesiumTextureAtlasAllocator _allocator;
+  TArray<UTexture2D*> _pages;
+};
@@ -5,7 +5,10 @@
 #include "CesiumAsync/CachingAssetAccessor.h"
 #include "CesiumAsync/GunzipAssetAccessor.h"
 #include "CesiumAsync/SqliteCache.h"
+#include "CesiumBufferedCacheDatabase.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumTextureStreaming.h"
+#include "CesiumTieredCacheDatabase.h"
 #include "CesiumUtility/Tracing.h"
 #include "HAL/FileManager.h"
 #include "HttpModule.h"
@@ -18,6 +21,7 @@
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <Modules/ModuleManager.h>
+#include <atomic>
 #include <spdlog/spdlog.h>
 
 #if CESIUM_TRACING_ENABLED
@@ -28,6 +32,11 @@
 
 DEFINE_LOG_CATEGORY(LogCesium);
 
+namespace {
+void shutdownTaskProcessor();
+void shutdownCacheDatabase();
+} // namespace
+
 void FCesiumRuntimeModule::StartupModule() {
   Cesium3DTilesContent::registerAllTileContentTypes();
 
@@ -52,7 +61,11 @@ void FCesiumRuntimeModule::StartupModule() {
       PluginShaderDir);
 }
 
-void FCesiumRuntimeModule::ShutdownModule() { CESIUM_TRACE_SHUTDOWN(); }
+void FCesiumRuntimeModule::ShutdownModule() {
+  shutdownTaskProcessor();
+  shutdownCacheDatabase();
+  CESIUM_TRACE_SHUTDOWN();
+}
 
 #undef LOCTEXT_NAMESPACE
 
@@ -62,9 +75,35 @@ FCesium3DTilesetIonTroubleshooting OnCesium3DTilesetIonTroubleshooting{};
 FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting{};
 
+namespace {
+
+// The task processor, once getTaskProcessorPointer has created it.
+std::atomic<UnrealTaskProcessor*> pCreatedTaskProcessor = nullptr;
+
+std::shared_ptr<UnrealTaskProcessor>& getTaskProcessorPointer() {
+  static std::shared_ptr<UnrealTaskProcessor> pTaskProcessor = []() {
+    auto pProcessor = std::make_shared<UnrealTaskProcessor>(
+        GetDefault<UCesiumRuntimeSettings>()->TaskProcessorThreadCount);
+    pCreatedTaskProcessor = pProcessor.get();
+    return pProcessor;
+  }();
+  return pTaskProcessor;
+}
+
+void shutdownTaskProcessor() {
+  // Don't start the worker threads just to stop them if nothing used them.
+  UnrealTaskProcessor* pTaskProcessor = pCreatedTaskProcessor.load();
+  if (pTaskProcessor) {
+    pTaskProcessor->shutdown();
+  }
+}
+
+} // namespace
+
+UnrealTaskProcessor& getTaskProcessor() { return *getTaskProcessorPointer(); }
+
 CesiumAsync::AsyncSystem& getAsyncSystem() noexcept {
-  static CesiumAsync::AsyncSystem asyncSystem(
-      std::make_shared<UnrealTaskProcessor>());
+  static CesiumAsync::AsyncSystem asyncSystem(getTaskProcessorPointer());
   return asyncSystem;
 }
 
@@ -100,19 +139,79 @@ std::string getCacheDatabaseName() {
 
 } // namespace
 
-std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
+namespace {
+
+// Set once the cache has been created, so that it can be flushed on shutdown.
+std::weak_ptr<CesiumBufferedCacheDatabase> pCreatedBufferedCacheDatabase;
+
+const std::shared_ptr<CesiumBufferedCacheDatabase>&
+getBufferedCacheDatabase() {
   static int MaxCacheItems =
       GetDefault<UCesiumRuntimeSettings>()->MaxCacheItems;
+  static int64 WriteBufferBytes =
+      int64(GetDefault<UCesiumRuntimeSettings>()
+                ->CacheWriteBufferSizeInMegabytes) *
+      1024 * 1024;
+
+  static std::shared_ptr<CesiumBufferedCacheDatabase> pCacheDatabase = [&]() {
+    auto pBuffered = std::make_shared<CesiumBufferedCacheDatabase>(
+        std::make_shared<CesiumAsync::SqliteCache>(
+            spdlog::default_logger(),
+            getCacheDatabaseName(),
+            MaxCacheItems),
+        WriteBufferBytes);
+    pCreatedBufferedCacheDatabase = pBuffered;
+    return pBuffered;
+  }();
 
-  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
-      std::make_shared<CesiumAsync::SqliteCache>(
-          spdlog::default_logger(),
-          getCacheDatabaseName(),
-          MaxCacheItems);
+  return pCacheDatabase;
+}
 
+const std::shared_ptr<CesiumTieredCacheDatabase>& getTieredCacheDatabase() {
+  static int64 MemoryCacheBytes =
+      int64(GetDefault<UCesiumRuntimeSettings>()->MemoryCacheSizeInMegabytes) *
+      1024 * 1024;
+
+  static std::shared_ptr<CesiumTieredCacheDatabase> pCacheDatabase =
+      std::make_shared<CesiumTieredCacheDatabase>(
+          getBufferedCacheDatabase(),
+          MemoryCacheBytes);
+
+  return pCacheDatabase;
+}
+
+} // namespace
+
+std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
+  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
+      getTieredCacheDatabase();
   return pCacheDatabase;
 }
 
+namespace {
+
+void shutdownCacheDatabase() {
+  // Commit the buffered cache writes, but don't open the database just to do
+  // so if nothing has used it.
+  std::shared_ptr<CesiumBufferedCacheDatabase> pBuffered =
+      pCreatedBufferedCacheDatabase.lock();
+  if (pBuffered) {
+    pBuffered->shutdown();
+  }
+}
+
+} // namespace
+
+CesiumCacheStatistics getCacheStatistics() {
+  CesiumCacheStatistics statistics = getTieredCacheDatabase()->getStatistics();
+  getBufferedCacheDatabase()->addStatistics(statistics);
+  return statistics;
+}
+
+CesiumTextureMemoryStatistics getTextureMemoryStatistics() {
+  return CesiumTextureStreaming::get().getStatistics();
+}
+
 const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
   static int RequestsPerCachePrune =
       GetDefault<UCesiumRuntimeSettings>()->RequestsPerCachePrune;
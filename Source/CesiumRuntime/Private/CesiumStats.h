@@ -0,0 +1,10 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/**
+ * The stat group shown by the "stat Cesium" console command.
+ */
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
@@ -0,0 +1,111 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureAtlasAllocator.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/AlignmentTemplates.h"
+
+CesiumTextureAtlasAllocator::CesiumTextureAtlasAllocator(
+    int32 pageSize,
+    int32 gutter,
+    int32 alignment)
+    : _pageSize(pageSize),
+      _gutter(gutter),
+      _alignment(alignment),
+      _pages(),
+      _statistics() {
+  check(FMath::IsPowerOfTwo(alignment));
+}
+
+int32 CesiumTextureAtlasAllocator::computeSlotSize(int32 width, int32 height)
+    const {
+  return Align(FMath::Max(width, height) + 2 * this->_gutter, this->_alignment);
+}
+
+CesiumTextureAtlasAllocator::Slot
+CesiumTextureAtlasAllocator::allocate(int32 width, int32 height) {
+  const int32 slotSize = this->computeSlotSize(width, height);
+  if (width <= 0 || height <= 0 || slotSize > this->_pageSize) {
+    ++this->_statistics.fallbacks;
+    return Slot();
+  }
+
+  // Prefer a page that is already divided into slots of this size, then an
+  // empty page, and only add a page if neither exists.
+  int32 pageIndex = INDEX_NONE;
+  for (int32 i = 0; i < this->_pages.Num(); ++i) {
+    const Page& page = this->_pages[i];
+    if (page.slotSize == slotSize && page.freeSlots.Num() > 0) {
+      pageIndex = i;
+      break;
+    }
+    if (page.slotSize == 0 && pageIndex == INDEX_NONE) {
+      pageIndex = i;
+    }
+  }
+
+  if (pageIndex == INDEX_NONE) {
+    pageIndex = this->_pages.AddDefaulted();
+    ++this->_statistics.pages;
+    this->_statistics.pagePixels += int64(this->_pageSize) * this->_pageSize;
+  }
+
+  Page& page = this->_pages[pageIndex];
+  if (page.slotSize == 0) {
+    this->_divide(page, slotSize);
+  }
+
+  const int32 slotIndex = page.freeSlots.Pop(false);
+  ++page.allocatedSlots;
+
+  const int32 slotsPerRow = this->_pageSize / slotSize;
+
+  Slot slot;
+  slot.page = pageIndex;
+  slot.x = (slotIndex % slotsPerRow) * slotSize;
+  slot.y = (slotIndex / slotsPerRow) * slotSize;
+  slot.size = slotSize;
+  slot.width = width;
+  slot.height = height;
+
+  ++this->_statistics.allocatedSlots;
+  ++this->_statistics.allocations;
+  this->_statistics.usedPixels += int64(width) * height;
+
+  return slot;
+}
+
+void CesiumTextureAtlasAllocator::free(const Slot& slot) {
+  if (!slot.isValid() || !this->_pages.IsValidIndex(slot.page)) {
+    return;
+  }
+
+  Page& page = this->_pages[slot.page];
+  check(page.slotSize == slot.size);
+
+  const int32 slotsPerRow = this->_pageSize / slot.size;
+  page.freeSlots.Add((slot.y / slot.size) * slotsPerRow + slot.x / slot.size);
+  --page.allocatedSlots;
+
+  if (page.allocatedSlots == 0) {
+    page.slotSize = 0;
+    page.freeSlots.Reset();
+  }
+
+  --this->_statistics.allocatedSlots;
+  ++this->_statistics.frees;
+  this->_statistics.usedPixels -= int64(slot.width) * slot.height;
+}
+
+void CesiumTextureAtlasAllocator::_divide(Page& page, int32 slotSize) {
+  const int32 slotsPerRow = this->_pageSize / slotSize;
+  const int32 slotCount = slotsPerRow * slotsPerRow;
+
+  page.slotSize = slotSize;
+  page.freeSlots.Reset(slotCount);
+
+  // Slots are popped from the end, so add them in reverse to fill the page
+  // from the top-left.
+  for (int32 i = slotCount - 1; i >= 0; --i) {
+    page.freeSlots.Add(i);
+  }
+}
@@ -0,0 +1,136 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "HAL/Platform.h"
+
+/**
+ * Allocates square slots for images from fixed-size atlas pages. Every page is
+ * divided into a grid of equally-sized slots, and images are given a slot from
+ * a page whose slots are the smallest that fit them, so images of the same size
+ * share pages without fragmenting them. A page whose slots have all been freed
+ * can be divided again for images of another size.
+ *
+ * The allocator only does the bookkeeping; the owner creates a texture for
+ * each page and copies images into their slots.
+ */
+class CesiumTextureAtlasAllocator {
+public:
+  /**
+   * A slot allocated for an image.
+   */
+  struct Slot {
+    /** The index of the page, or -1 if no slot was allocated. */
+    int32 page = -1;
+
+    /** The x coordinate of the top-left corner of the slot, in pixels. */
+    int32 x = 0;
+
+    /** The y coordinate of the top-left corner of the slot, in pixels. */
+    int32 y = 0;
+
+    /** The width and height of the slot, in pixels. */
+    int32 size = 0;
+
+    /** The width of the image in the slot, in pixels. */
+    int32 width = 0;
+
+    /** The height of the image in the slot, in pixels. */
+    int32 height = 0;
+
+    /** Whether a slot was allocated. */
+    bool isValid() const { return page >= 0; }
+  };
+
+  /**
+   * Statistics about the pages and slots of an allocator.
+   */
+  struct Statistics {
+    /** The number of pages. */
+    int32 pages = 0;
+
+    /** The number of slots that are currently allocated. */
+    int32 allocatedSlots = 0;
+
+    /** The number of pixels of the images in the allocated slots. */
+    int64 usedPixels = 0;
+
+    /** The total number of pixels of all pages. */
+    int64 pagePixels = 0;
+
+    /** The number of slots that have been allocated in total. */
+    int64 allocations = 0;
+
+    /** The number of slots that have been freed in total. */
+    int64 frees = 0;
+
+    /** The number of images that were too large for a page. */
+    int64 fallbacks = 0;
+  };
+
+  /**
+   * Creates an allocator.
+   *
+   * @param pageSize The width and height of each page, in pixels.
+   * @param gutter The number of pixels around each image that are reserved in
+   * its slot, so that filtering doesn't blend it with its neighbors.
+   * @param alignment The multiple of pixels that slot sizes and positions are
+   * rounded up to. Must be a power of two. Aligning slots to 2^n pixels keeps
+   * them on whole pixels in the first n mip levels of the pages.
+   */
+  CesiumTextureAtlasAllocator(int32 pageSize, int32 gutter, int32 alignment);
+
+  /** Gets the width and height of each page, in pixels. */
+  int32 getPageSize() const { return this->_pageSize; }
+
+  /** Gets the number of pixels reserved around each image in its slot. */
+  int32 getGutter() const { return this->_gutter; }
+
+  /**
+   * Gets the number of pages. Pages are never removed, so a page index stays
+   * valid for the lifetime of the allocator.
+   */
+  int32 getPageCount() const { return this->_pages.Num(); }
+
+  /**
+   * Computes the size of the slot that an image of the given size is given.
+   */
+  int32 computeSlotSize(int32 width, int32 height) const;
+
+  /**
+   * Allocates a slot for an image, adding a page if none has room for it.
+   *
+   * @param width The width of the image, in pixels.
+   * @param height The height of the image, in pixels.
+   * @return The slot, which is invalid if the image is too large for a page.
+   */
+  Slot allocate(int32 width, int32 height);
+
+  /**
+   * Frees a slot so that it can be allocated again.
+   */
+  void free(const Slot& slot);
+
+  /**
+   * Gets statistics about the pages and slots of this allocator.
+   */
+  const Statistics& getStatistics() const { return this->_statistics; }
+
+private:
+  struct Page {
+    // The size of the slots of this page, or 0 if all of its slots are free
+    // and it can be divided for any size.
+    int32 slotSize = 0;
+    int32 allocatedSlots = 0;
+    TArray<int32> freeSlots;
+  };
+
+  void _divide(Page& page, int32 slotSize);
+
+  int32 _pageSize;
+  int32 _gutter;
+  int32 _alignment;
+  TArray<Page> _pages;
+  Statistics _statistics;
+};
@@ -0,0 +1,377 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureStreaming.h"
+#include "CesiumCamera.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
+#include "CesiumTextureUtility.h"
+#include "CesiumUtility/Tracing.h"
+#include "Engine/Texture2D.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Streamed Textures"),
+    STAT_CesiumStreamedTextures,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Streamed Textures With Dropped Mips"),
+    STAT_CesiumReducedTextures,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Texture Memory Resident"),
+    STAT_CesiumTextureResidentBytes,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Texture Memory Budget"),
+    STAT_CesiumTextureBudgetBytes,
+    STATGROUP_Cesium);
+
+namespace {
+
+// Choosing the resident mip levels looks at every streamed texture, and the
+// sizes of tiles on screen change slowly, so it doesn't need to be done every
+// frame.
+constexpr double UpdateIntervalSeconds = 0.25;
+
+// Restoring mip levels uploads them to the GPU on the render thread, so only
+// this many bytes are restored in each update to avoid hitches. Dropping mip
+// levels is never limited, because it frees memory.
+constexpr int64 MaximumRestoredBytesPerUpdate = 32 * 1024 * 1024;
+
+double computeScreenPixels(
+    const UCesiumGltfPrimitiveComponent& primitive,
+    const std::vector<FCesiumCamera>& cameras) {
+  if (!primitive.IsVisible()) {
+    return 0.0;
+  }
+
+  const FBoxSphereBounds& bounds = primitive.Bounds;
+  double screenPixels = 0.0;
+  for (const FCesiumCamera& camera : cameras) {
+    // A camera inside the bounding sphere sees the texture across the whole
+    // viewport.
+    const double distance = FMath::Max(
+        FVector::Dist(camera.Location, bounds.Origin),
+        bounds.SphereRadius);
+    const double tanHalfFieldOfView =
+        FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees * 0.5));
+    if (distance <= 0.0 || tanHalfFieldOfView <= 0.0) {
+      continue;
+    }
+
+    screenPixels = FMath::Max(
+        screenPixels,
+        bounds.SphereRadius * camera.ViewportSize.X /
+            (distance * tanHalfFieldOfView));
+  }
+
+  return screenPixels;
+}
+
+// Computes the number of mip levels that are more detailed than the texture's
+// size on screen can show.
+uint32 computeInvisibleMips(const CesiumStreamedTextureLevels& levels) {
+  const double size = double(FMath::Max(levels.width, levels.height));
+  if (levels.screenPixels <= 0.0) {
+    return levels.mipCount;
+  }
+  if (levels.screenPixels >= size) {
+    return 0;
+  }
+  return uint32(FMath::FloorToInt(FMath::Log2(size / levels.screenPixels)));
+}
+
+bool copyMips(
+    const UCesiumGltfPrimitiveComponent& owner,
+    int32 imageIndex,
+    uint32 firstMip,
+    uint32 endMip,
+    TArray<TArray<uint8>>& mips) {
+  const CesiumGltf::Model* pModel = owner.pModel;
+  if (!pModel || imageIndex < 0 || imageIndex >= int32(pModel->images.size())) {
+    return false;
+  }
+
+  const CesiumGltf::ImageCesium& image = pModel->images[imageIndex].cesium;
+  if (image.mipPositions.size() < endMip) {
+    return false;
+  }
+
+  mips.Reserve(int32(endMip - firstMip));
+  for (uint32 mip = firstMip; mip < endMip; ++mip) {
+    const CesiumGltf::ImageCesiumMipPosition& position =
+        image.mipPositions[mip];
+    if (position.byteOffset + position.byteSize > image.pixelData.size()) {
+      return false;
+    }
+    mips.Emplace(
+        reinterpret_cast<const uint8*>(&image.pixelData[position.byteOffset]),
+        int32(position.byteSize));
+  }
+
+  return true;
+}
+
+} // namespace
+
+/*static*/ CesiumTextureStreaming& CesiumTextureStreaming::get() {
+  static CesiumTextureStreaming streaming;
+  return streaming;
+}
+
+void CesiumTextureStreaming::addTexture(
+    UTexture2D* pTexture,
+    const CesiumTextureUtility::LoadedTextureResult& loadedTexture,
+    UCesiumGltfPrimitiveComponent* pOwner) {
+  // The mips of compressed textures would be restored from the uncompressed
+  // pixels of their image, so they stay resident instead.
+  if (!pTexture || !pOwner || loadedTexture.streamableMipCount <= 1 ||
+      loadedTexture.imageIndex < 0 || loadedTexture.compressedOnLoad) {
+    return;
+  }
+
+  StreamedTexture texture;
+  texture.pTexture = pTexture;
+  texture.pOwner = pOwner;
+  texture.imageIndex = loadedTexture.imageIndex;
+  texture.levels.width = uint32(pTexture->GetSizeX());
+  texture.levels.height = uint32(pTexture->GetSizeY());
+  texture.levels.format = pTexture->GetPixelFormat();
+  texture.levels.mipCount = loadedTexture.streamableMipCount;
+
+  if (computeMaximumFirstMip(texture.levels) == 0) {
+    return;
+  }
+
+  this->_textures.Add(pTexture, texture);
+}
+
+void CesiumTextureStreaming::removeTexture(UTexture* pTexture) {
+  this->_textures.Remove(pTexture);
+}
+
+void CesiumTextureStreaming::update(const std::vector<FCesiumCamera>& cameras) {
+  if (this->_lastUpdateFrame == GFrameCounter) {
+    return;
+  }
+  this->_lastUpdateFrame = GFrameCounter;
+
+  const double now = FPlatformTime::Seconds();
+  if (now - this->_lastUpdateTime < UpdateIntervalSeconds) {
+    return;
+  }
+  this->_lastUpdateTime = now;
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureStreaming)
+
+  this->_budgetBytes =
+      int64(GetDefault<UCesiumRuntimeSettings>()
+                ->TextureMemoryBudgetInMegabytes) *
+      1024 * 1024;
+
+  TArray<StreamedTexture*> textures;
+  TArray<CesiumStreamedTextureLevels> levels;
+  textures.Reserve(this->_textures.Num());
+  levels.Reserve(this->_textures.Num());
+
+  for (auto it = this->_textures.CreateIterator(); it; ++it) {
+    StreamedTexture& texture = it.Value();
+    if (!texture.pTexture.IsValid()) {
+      // The texture was garbage collected without being destroyed by us.
+      it.RemoveCurrent();
+      continue;
+    }
+
+    const UCesiumGltfPrimitiveComponent* pOwner = texture.pOwner.Get();
+    texture.levels.screenPixels =
+        pOwner ? computeScreenPixels(*pOwner, cameras) : 0.0;
+
+    textures.Add(&texture);
+    levels.Add(texture.levels);
+  }
+
+  chooseFirstMips(levels, this->_budgetBytes);
+  this->_applyFirstMips(textures, levels);
+
+  const CesiumTextureMemoryStatistics statistics = this->getStatistics();
+  SET_DWORD_STAT(STAT_CesiumStreamedTextures, statistics.textures);
+  SET_DWORD_STAT(STAT_CesiumReducedTextures, statistics.reducedTextures);
+  SET_MEMORY_STAT(STAT_CesiumTextureResidentBytes, statistics.residentBytes);
+  SET_MEMORY_STAT(STAT_CesiumTextureBudgetBytes, statistics.budgetBytes);
+}
+
+void CesiumTextureStreaming::_applyFirstMips(
+    const TArray<StreamedTexture*>& textures,
+    const TArray<CesiumStreamedTextureLevels>& levels) {
+  TArray<int32> restored;
+
+  for (int32 i = 0; i < textures.Num(); ++i) {
+    StreamedTexture& texture = *textures[i];
+    const uint32 firstMip = levels[i].firstMip;
+    if (firstMip > texture.levels.firstMip) {
+      CesiumTextureUtility::setFirstResidentMip(
+          texture.pTexture.Get(),
+          firstMip,
+          TArray<TArray<uint8>>());
+      texture.levels.firstMip = firstMip;
+    } else if (firstMip < texture.levels.firstMip) {
+      restored.Add(i);
+    }
+  }
+
+  // Restore the textures that are largest on screen first.
+  restored.Sort([&levels](int32 a, int32 b) {
+    return levels[a].screenPixels > levels[b].screenPixels;
+  });
+
+  int64 restoredBytes = 0;
+  for (int32 i : restored) {
+    StreamedTexture& texture = *textures[i];
+    const uint32 firstMip = levels[i].firstMip;
+    const UCesiumGltfPrimitiveComponent* pOwner = texture.pOwner.Get();
+    if (!pOwner) {
+      continue;
+    }
+
+    const int64 bytes = computeBytes(texture.levels, firstMip) -
+                        computeBytes(texture.levels, texture.levels.firstMip);
+    if (restoredBytes > 0 &&
+        restoredBytes + bytes > MaximumRestoredBytesPerUpdate) {
+      // Keeping the rest of the textures at their current level uses less
+      // memory than the chosen level, so they stay within the budget until
+      // they're restored in a later update.
+      break;
+    }
+
+    TArray<TArray<uint8>> mips;
+    if (!copyMips(
+            *pOwner,
+            texture.imageIndex,
+            firstMip,
+            texture.levels.firstMip,
+            mips)) {
+      continue;
+    }
+
+    CesiumTextureUtility::setFirstResidentMip(
+        texture.pTexture.Get(),
+        firstMip,
+        MoveTemp(mips));
+    texture.levels.firstMip = firstMip;
+    restoredBytes += bytes;
+  }
+}
+
+CesiumTextureMemoryStatistics CesiumTextureStreaming::getStatistics() const {
+  CesiumTextureMemoryStatistics statistics;
+  statistics.budgetBytes = this->_budgetBytes;
+
+  for (const auto& pair : this->_textures) {
+    const CesiumStreamedTextureLevels& levels = pair.Value.levels;
+    ++statistics.textures;
+    statistics.residentBytes += computeBytes(levels, levels.firstMip);
+    statistics.fullResolutionBytes += computeBytes(levels, 0);
+    if (levels.firstMip > 0) {
+      ++statistics.reducedTextures;
+    }
+  }
+
+  return statistics;
+}
+
+/*static*/ int64 CesiumTextureStreaming::computeBytes(
+    const CesiumStreamedTextureLevels& levels,
+    uint32 firstMip) {
+  const FPixelFormatInfo& formatInfo = GPixelFormats[levels.format];
+  const uint32 blockSizeX = FMath::Max(formatInfo.BlockSizeX, 1);
+  const uint32 blockSizeY = FMath::Max(formatInfo.BlockSizeY, 1);
+
+  int64 bytes = 0;
+  for (uint32 mip = firstMip; mip < levels.mipCount; ++mip) {
+    const uint32 width = FMath::Max<uint32>(levels.width >> mip, 1);
+    const uint32 height = FMath::Max<uint32>(levels.height >> mip, 1);
+    const int64 columns = (width + blockSizeX - 1) / blockSizeX;
+    const int64 rows = (height + blockSizeY - 1) / blockSizeY;
+    bytes += columns * rows * formatInfo.BlockBytes;
+  }
+  return bytes;
+}
+
+/*static*/ uint32 CesiumTextureStreaming::computeMaximumFirstMip(
+    const CesiumStreamedTextureLevels& levels) {
+  const FPixelFormatInfo& formatInfo = GPixelFormats[levels.format];
+  const uint32 blockSizeX = FMath::Max(formatInfo.BlockSizeX, 1);
+  const uint32 blockSizeY = FMath::Max(formatInfo.BlockSizeY, 1);
+
+  uint32 maximumFirstMip = 0;
+  for (uint32 mip = 1; mip < levels.mipCount; ++mip) {
+    const uint32 width = levels.width >> mip;
+    const uint32 height = levels.height >> mip;
+    if (width == 0 || height == 0 || width % blockSizeX != 0 ||
+        height % blockSizeY != 0) {
+      break;
+    }
+    maximumFirstMip = mip;
+  }
+  return maximumFirstMip;
+}
+
+/*static*/ void CesiumTextureStreaming::chooseFirstMips(
+    const TArrayView<CesiumStreamedTextureLevels>& textures,
+    int64 budgetBytes) {
+  int64 totalBytes = 0;
+  for (CesiumStreamedTextureLevels& texture : textures) {
+    texture.firstMip = 0;
+    totalBytes += computeBytes(texture, 0);
+  }
+
+  if (budgetBytes <= 0 || totalBytes <= budgetBytes) {
+    return;
+  }
+
+  // The textures that are smallest on screen lose detail first.
+  TArray<int32> order;
+  order.Reserve(textures.Num());
+  for (int32 i = 0; i < textures.Num(); ++i) {
+    order.Add(i);
+  }
+  order.StableSort([&textures](int32 a, int32 b) {
+    return textures[a].screenPixels < textures[b].screenPixels;
+  });
+
+  // First drop the mip levels that are more detailed than the screen can show,
+  // which doesn't change what is rendered.
+  for (int32 i : order) {
+    if (totalBytes <= budgetBytes) {
+      return;
+    }
+
+    CesiumStreamedTextureLevels& texture = textures[i];
+    const uint32 firstMip = FMath::Min(
+        computeInvisibleMips(texture),
+        computeMaximumFirstMip(texture));
+    totalBytes -= computeBytes(texture, 0) - computeBytes(texture, firstMip);
+    texture.firstMip = firstMip;
+  }
+
+  // Then drop one more level at a time from every texture, until the
+  // textures fit or none of them has a level left to drop.
+  bool dropped = true;
+  while (totalBytes > budgetBytes && dropped) {
+    dropped = false;
+    for (int32 i : order) {
+      if (totalBytes <= budgetBytes) {
+        return;
+      }
+
+      CesiumStreamedTextureLevels& texture = textures[i];
+      if (texture.firstMip < computeMaximumFirstMip(texture)) {
+        totalBytes -= computeBytes(texture, texture.firstMip) -
+                      computeBytes(texture, texture.firstMip + 1);
+        ++texture.firstMip;
+        dropped = true;
+      }
+    }
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTextureMemoryStatistics.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "PixelFormat.h"
+#include "UObject/WeakObjectPtr.h"
+#include <vector>
+
+class UCesiumGltfPrimitiveComponent;
+class UTexture;
+class UTexture2D;
+struct FCesiumCamera;
+
+namespace CesiumTextureUtility {
+struct LoadedTextureResult;
+}
+
+/**
+ * The mip levels of a streamed texture, and how large it is on screen.
+ */
+struct CesiumStreamedTextureLevels {
+  /** The width of the most detailed mip level, in pixels. */
+  uint32 width = 0;
+
+  /** The height of the most detailed mip level, in pixels. */
+  uint32 height = 0;
+
+  /** The pixel format of the texture. */
+  EPixelFormat format = PF_Unknown;
+
+  /** The number of mip levels the texture has when it is fully resident. */
+  uint32 mipCount = 1;
+
+  /**
+   * The approximate size of the texture on screen, in pixels, in the view in
+   * which it is largest, or zero if it isn't visible.
+   */
+  double screenPixels = 0.0;
+
+  /**
+   * The most detailed mip level that is resident on the GPU. The mip levels
+   * above it have been dropped.
+   */
+  uint32 firstMip = 0;
+};
+
+/**
+ * Keeps the GPU memory used by the textures of tiles within the budget given
+ * by UCesiumRuntimeSettings::TextureMemoryBudgetInMegabytes. When the
+ * textures don't fit, the most detailed mip levels of the textures that are
+ * smallest on screen are dropped, first the levels that are more detailed
+ * than the screen can show, and then more if necessary. Dropped levels are
+ * restored from the glTF images when there is room for them again.
+ *
+ * Only the material textures of glTF primitives that were created
+ * asynchronously are streamed. All functions must be called from the game
+ * thread.
+ */
+class CesiumTextureStreaming {
+public:
+  /**
+   * Gets the texture streaming shared by all tilesets.
+   */
+  static CesiumTextureStreaming& get();
+
+  /**
+   * Starts streaming the mip levels of a texture, if it can be streamed.
+   *
+   * @param pTexture The texture that was created from the loaded texture.
+   * @param loadedTexture The loaded texture.
+   * @param pOwner The primitive that uses the texture, which holds the glTF
+   * image its mip levels are restored from.
+   */
+  void addTexture(
+      UTexture2D* pTexture,
+      const CesiumTextureUtility::LoadedTextureResult& loadedTexture,
+      UCesiumGltfPrimitiveComponent* pOwner);
+
+  /**
+   * Stops streaming the mip levels of a texture that is about to be
+   * destroyed. Does nothing if the texture isn't streamed.
+   */
+  void removeTexture(UTexture* pTexture);
+
+  /**
+   * Chooses the resident mip levels of every streamed texture from their size
+   * in the given views, and drops or restores mip levels to match. Each
+   * tileset calls this every frame with its cameras, but only the first call
+   * in a frame does anything, and the work is only done a few times a second.
+   */
+  void update(const std::vector<FCesiumCamera>& cameras);
+
+  /**
+   * Gets statistics about the GPU memory used by the streamed textures.
+   */
+  CesiumTextureMemoryStatistics getStatistics() const;
+
+  /**
+   * Computes the GPU memory used by a texture when the given mip level is the
+   * most detailed one that is resident.
+   */
+  static int64
+  computeBytes(const CesiumStreamedTextureLevels& levels, uint32 firstMip);
+
+  /**
+   * Computes the least detailed mip level that can be made the most detailed
+   * resident level of a texture. Block-compressed textures can only drop mip
+   * levels while the remaining levels are made of whole blocks, and at least
+   * one level is always kept.
+   */
+  static uint32
+  computeMaximumFirstMip(const CesiumStreamedTextureLevels& levels);
+
+  /**
+   * Chooses the most detailed resident mip level of each texture so that
+   * together they use no more than the given budget, if possible. Textures
+   * keep all of their mip levels if they fit, and the textures that are
+   * smallest on screen lose detail first.
+   *
+   * @param textures The textures, whose firstMip is set.
+   * @param budgetBytes The budget, or zero to keep every mip level.
+   */
+  static void chooseFirstMips(
+      const TArrayView<CesiumStreamedTextureLevels>& textures,
+      int64 budgetBytes);
+
+private:
+  struct StreamedTexture {
+    TWeakObjectPtr<UTexture2D> pTexture;
+    TWeakObjectPtr<UCesiumGltfPrimitiveComponent> pOwner;
+    int32 imageIndex = -1;
+    CesiumStreamedTextureLevels levels;
+  };
+
+  void _applyFirstMips(
+      const TArray<StreamedTexture*>& textures,
+      const TArray<CesiumStreamedTextureLevels>& levels);
+
+  TMap<UTexture*, StreamedTexture> _textures;
+  int64 _budgetBytes = 0;
+  uint64 _lastUpdateFrame = 0;
+  double _lastUpdateTime = 0.0;
+};
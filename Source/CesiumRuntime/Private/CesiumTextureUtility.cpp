@@ -4,9 +4,11 @@
 #include "Async/Async.h"
 #include "Async/Future.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "CesiumBlockCompression.h"
 #include "CesiumCommon.h"
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumTextureStreaming.h"
 #include "Containers/ResourceArray.h"
 #include "DynamicRHI.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
@@ -263,6 +265,8 @@ public:
       this->TextureRHI = pAsyncTexture->rhiTextureRef;
       pAsyncTexture->rhiTextureRef.SafeRelease();
     }
+
+    this->_mipCount = this->TextureRHI ? this->TextureRHI->GetNumMips() : 1;
   }
 
   virtual ~FCesiumTextureResource() {
@@ -391,6 +395,104 @@ public:
     FTextureResource::ReleaseRHI();
   }
 
+  /**
+   * @brief Replaces the RHI texture with one whose most detailed mip level is
+   * the given one. Mip levels that are resident in both textures are copied
+   * on the GPU, and the rest are uploaded from restoredMips.
+   */
+  void setFirstResidentMip(
+      FRHICommandListImmediate& RHICmdList,
+      uint32 firstMip,
+      const TArray<TArray<uint8>>& restoredMips) {
+    if (!this->TextureRHI || firstMip == this->_firstMip ||
+        firstMip >= this->_mipCount) {
+      return;
+    }
+
+    const uint32 oldFirstMip = this->_firstMip;
+    if (firstMip < oldFirstMip &&
+        restoredMips.Num() != int32(oldFirstMip - firstMip)) {
+      return;
+    }
+
+    const uint32 width = FMath::Max<uint32>(this->_width >> firstMip, 1);
+    const uint32 height = FMath::Max<uint32>(this->_height >> firstMip, 1);
+    const uint32 mipCount = this->_mipCount - firstMip;
+
+    ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
+    if (this->bSRGB) {
+      textureFlags |= TexCreate_SRGB;
+    }
+
+    FRHIResourceCreateInfo createInfo{TEXT("CesiumTextureUtility")};
+    createInfo.ExtData = this->_platformExtData;
+
+#if ENGINE_VERSION_5_2_OR_HIGHER
+    FTexture2DRHIRef rhiTexture = RHICreateTexture(
+        FRHITextureCreateDesc::Create2D(createInfo.DebugName)
+            .SetExtent(int32(width), int32(height))
+            .SetFormat(this->_format)
+            .SetNumMips(uint8(mipCount))
+            .SetNumSamples(1)
+            .SetFlags(textureFlags)
+            .SetInitialState(ERHIAccess::Unknown)
+            .SetExtData(createInfo.ExtData)
+            .SetGPUMask(createInfo.GPUMask)
+            .SetClearValue(createInfo.ClearValueBinding));
+#else
+    FTexture2DRHIRef rhiTexture = RHICreateTexture2D(
+        width,
+        height,
+        this->_format,
+        mipCount,
+        1,
+        textureFlags,
+        createInfo);
+#endif
+
+    RHICmdList.Transition(FRHITransitionInfo(
+        this->TextureRHI,
+        ERHIAccess::Unknown,
+        ERHIAccess::CopySrc));
+    RHICmdList.Transition(FRHITransitionInfo(
+        rhiTexture,
+        ERHIAccess::Unknown,
+        ERHIAccess::CopyDest));
+
+    // Copy the mip levels that both textures have.
+    const uint32 commonFirstMip = FMath::Max(firstMip, oldFirstMip);
+    FRHICopyTextureInfo copyInfo;
+    copyInfo.SourceMipIndex = commonFirstMip - oldFirstMip;
+    copyInfo.DestMipIndex = commonFirstMip - firstMip;
+    copyInfo.NumMips = this->_mipCount - commonFirstMip;
+    RHICmdList.CopyTexture(this->TextureRHI, rhiTexture, copyInfo);
+
+    // Upload the mip levels that weren't resident before.
+    const uint32 blockSizeX = GPixelFormats[this->_format].BlockSizeX;
+    const uint32 blockBytes = GPixelFormats[this->_format].BlockBytes;
+    for (int32 i = 0; i < restoredMips.Num(); ++i) {
+      const uint32 mipWidth = FMath::Max<uint32>(width >> i, 1);
+      const uint32 mipHeight = FMath::Max<uint32>(height >> i, 1);
+      const uint32 columns = (mipWidth + blockSizeX - 1) / blockSizeX;
+      FUpdateTextureRegion2D region(0, 0, 0, 0, mipWidth, mipHeight);
+      RHIUpdateTexture2D(
+          rhiTexture,
+          uint32(i),
+          region,
+          columns * blockBytes,
+          restoredMips[i].GetData());
+    }
+
+    RHICmdList.Transition(FRHITransitionInfo(
+        rhiTexture,
+        ERHIAccess::CopyDest,
+        ERHIAccess::SRVMask));
+
+    this->TextureRHI = std::move(rhiTexture);
+    this->_firstMip = firstMip;
+    RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
+  }
+
 private:
   UTexture* _pTexture;
   CesiumTextureUtility::CesiumTextureSource _textureSource;
@@ -403,6 +505,11 @@ private:
   ESamplerAddressMode _addressY;
 
   uint32 _platformExtData;
+
+  // The number of mip levels of the texture when all of them are resident,
+  // and the most detailed one that is resident now.
+  uint32 _mipCount;
+  uint32 _firstMip = 0;
 };
 
 namespace {
@@ -574,21 +681,21 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     const TextureFilter& filter,
     const TextureGroup& group,
     bool generateMipMaps,
-    bool sRGB) {
+    bool sRGB,
+    ECesiumTextureCompression compression) {
 
   CesiumGltf::ImageCesium* pImage =
       std::visit(GetImageFromSource{}, imageSource);
 
   assert(pImage != nullptr);
-  CesiumGltf::ImageCesium& image = *pImage;
 
-  if (image.pixelData.empty() || image.width == 0 || image.height == 0) {
+  if (pImage->pixelData.empty() || pImage->width == 0 || pImage->height == 0) {
     return nullptr;
   }
 
   if (generateMipMaps) {
     std::optional<std::string> errorMessage =
-        CesiumGltfReader::GltfReader::generateMipMaps(image);
+        CesiumGltfReader::GltfReader::generateMipMaps(*pImage);
     if (errorMessage) {
       UE_LOG(
           LogCesium,
@@ -598,6 +705,19 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     }
   }
 
+  // Mobile platforms generally support neither BC format, in which case the
+  // image is uploaded uncompressed. The compressed pixels are this texture's
+  // own, because other textures, such as normal maps and feature ID textures,
+  // may use the same glTF image and read its pixels on the CPU.
+  std::optional<CesiumGltf::ImageCesium> compressedImage;
+  if (compression != ECesiumTextureCompression::None &&
+      GPixelFormats[PF_DXT1].Supported && GPixelFormats[PF_DXT5].Supported) {
+    compressedImage =
+        CesiumBlockCompression::compressImage(*pImage, compression);
+  }
+  const CesiumGltf::ImageCesium& image =
+      compressedImage ? *compressedImage : *pImage;
+
   EPixelFormat pixelFormat;
   if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
     switch (image.compressedPixelFormat) {
@@ -667,13 +787,16 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
   pResult->group = group;
   pResult->sRGB = sRGB;
   pResult->generateMipMaps = generateMipMaps;
+  pResult->compressedOnLoad = compressedImage.has_value();
 
   if (GRHISupportsAsyncTextureCreation) {
     // Create RHI texture resource asynchronously.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRHITexture2D)
 
-    pResult->textureSource = AsyncCreatedTexture{
-        CreateRHITexture2D_Async(image, pixelFormat, generateMipMaps, sRGB)};
+    FTexture2DRHIRef rhiTexture =
+        CreateRHITexture2D_Async(image, pixelFormat, generateMipMaps, sRGB);
+    pResult->streamableMipCount = rhiTexture ? rhiTexture->GetNumMips() : 0;
+    pResult->textureSource = AsyncCreatedTexture{std::move(rhiTexture)};
   } else {
     // The RHI texture will be created later on the render thread, directly
     // from this texture source.
@@ -696,7 +819,8 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     CesiumGltf::Model& model,
     const CesiumGltf::Texture& texture,
-    bool sRGB) {
+    bool sRGB,
+    ECesiumTextureCompression compression) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTexture)
 
@@ -843,7 +967,8 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
       filter,
       TextureGroup::TEXTUREGROUP_World,
       useMipMaps,
-      sRGB);
+      sRGB,
+      compression);
 
   // Replace the image pointer with an index, in case the pointer gets
   // invalidated before the main thread loading continues.
@@ -851,6 +976,10 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     result->textureSource = GltfImageIndex{source};
   }
 
+  if (result) {
+    result->imageIndex = source;
+  }
+
   return result;
 }
 
@@ -934,6 +1063,30 @@ void destroyHalfLoadedTexture(LoadedTextureResult& halfLoaded) {
 
 void destroyTexture(UTexture* pTexture) {
   check(pTexture != nullptr);
+  CesiumTextureStreaming::get().removeTexture(pTexture);
   CesiumLifetime::destroy(pTexture);
 }
+
+void setFirstResidentMip(
+    UTexture2D* pTexture,
+    uint32 firstMip,
+    TArray<TArray<uint8>>&& restoredMips) {
+  if (!pTexture) {
+    return;
+  }
+
+  // Only textures created with an FCesiumTextureResource have a streamable mip
+  // count, so the cast is safe.
+  FCesiumTextureResource* pResource =
+      static_cast<FCesiumTextureResource*>(pTexture->GetResource());
+  if (!pResource) {
+    return;
+  }
+
+  ENQUEUE_RENDER_COMMAND(Cesium_SetFirstResidentMip)
+  ([pResource, firstMip, restoredMips = MoveTemp(restoredMips)](
+       FRHICommandListImmediate& RHICmdList) {
+    pResource->setFirstResidentMip(RHICmdList, firstMip, restoredMips);
+  });
+}
 } // namespace CesiumTextureUtility
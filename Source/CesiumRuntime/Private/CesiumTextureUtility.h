@@ -4,6 +4,7 @@
 
 #include "CesiumGltf/Model.h"
 #include "CesiumMetadataValueType.h"
+#include "CesiumTextureCompression.h"
 #include "Engine/Texture.h"
 #include "Engine/Texture2D.h"
 #include "Engine/TextureDefines.h"
@@ -89,6 +90,26 @@ struct LoadedTextureResult {
   bool sRGB{true};
   TWeakObjectPtr<UTexture2D> pTexture;
   CesiumTextureSource textureSource;
+
+  /**
+   * @brief The number of mip levels of the texture if it was created
+   * asynchronously, which allows its mip levels to be streamed with
+   * setFirstResidentMip, or 0 otherwise.
+   */
+  uint32 streamableMipCount{0};
+
+  /**
+   * @brief The index of the glTF image this texture was loaded from, or -1 if
+   * it wasn't loaded from a glTF image.
+   */
+  int32 imageIndex{-1};
+
+  /**
+   * @brief Whether the pixels of this texture were compressed when it was
+   * loaded. The pixels of its image are left uncompressed in that case, so
+   * its mip levels can't be restored from the image.
+   */
+  bool compressedOnLoad{false};
 };
 
 TUniquePtr<FTexturePlatformData>
@@ -107,6 +128,9 @@ createTexturePlatformData(int32 sizeX, int32 sizeY, EPixelFormat format);
  * @param group The texture group of this texture.
  * @param generateMipMaps Whether to generate a mipmap for this image.
  * @param sRGB Whether this texture uses a sRGB color space.
+ * @param compression How to compress this image if it is uncompressed. The
+ * texture receives its own compressed copy of the pixels, and the image is
+ * left uncompressed.
  * @return The loaded texture.
  */
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
@@ -116,7 +140,8 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     const TextureFilter& filter,
     const TextureGroup& group,
     bool generateMipMaps,
-    bool sRGB);
+    bool sRGB,
+    ECesiumTextureCompression compression = ECesiumTextureCompression::None);
 
 /**
  * @brief Does the asynchronous part of renderer resource preparation for this
@@ -126,12 +151,15 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
  * @param model The model.
  * @param texture The texture to load.
  * @param sRGB Whether this texture uses a sRGB color space.
+ * @param compression How to compress the texture's image if it is
+ * uncompressed.
  * @return The loaded texture.
  */
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     CesiumGltf::Model& model,
     const CesiumGltf::Texture& texture,
-    bool sRGB);
+    bool sRGB,
+    ECesiumTextureCompression compression = ECesiumTextureCompression::None);
 
 /**
  * @brief Does the main-thread part of render resource preparation for this
@@ -162,4 +190,19 @@ UTexture2D* loadTextureGameThreadPart(
 
 void destroyHalfLoadedTexture(LoadedTextureResult& halfLoaded);
 void destroyTexture(UTexture* pTexture);
+
+/**
+ * @brief Changes which mip levels of a texture are resident on the GPU, by
+ * dropping or restoring its most detailed mip levels. The texture must have
+ * been loaded with a non-zero LoadedTextureResult::streamableMipCount.
+ *
+ * @param pTexture The texture.
+ * @param firstMip The most detailed mip level to keep resident.
+ * @param restoredMips The pixel data of the mip levels that become resident,
+ * starting with firstMip. This is empty when mip levels are dropped.
+ */
+void setFirstResidentMip(
+    UTexture2D* pTexture,
+    uint32 firstMip,
+    TArray<TArray<uint8>>&& restoredMips);
 } // namespace CesiumTextureUtility
@@ -0,0 +1,205 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTieredCacheDatabase.h"
+#include "CesiumStats.h"
+
+using namespace CesiumAsync;
+
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Memory Cache Hits"),
+    STAT_CesiumMemoryCacheHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Disk Cache Hits"),
+    STAT_CesiumDiskCacheHits,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Cache Misses"),
+    STAT_CesiumCacheMisses,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Memory Cache Size"),
+    STAT_CesiumMemoryCacheBytes,
+    STATGROUP_Cesium);
+
+namespace {
+
+// Entries that would take up more than this fraction of the memory budget are
+// only kept on disk, so that one large response can't flush the whole tier.
+constexpr int64 MaximumEntryFraction = 8;
+
+// An estimate of the bookkeeping cost of each entry, in addition to its
+// strings and response data.
+constexpr int64 EntryOverheadBytes = 256;
+
+int64 computeHeadersBytes(const HttpHeaders& headers) {
+  int64 bytes = 0;
+  for (const auto& header : headers) {
+    bytes += int64(header.first.size() + header.second.size());
+  }
+  return bytes;
+}
+
+int64 computeEntryBytes(const std::string& key, const CacheItem& item) {
+  return EntryOverheadBytes + int64(key.size()) +
+         int64(item.cacheRequest.url.size()) +
+         int64(item.cacheRequest.method.size()) +
+         computeHeadersBytes(item.cacheRequest.headers) +
+         computeHeadersBytes(item.cacheResponse.headers) +
+         int64(item.cacheResponse.data.size());
+}
+
+} // namespace
+
+CesiumTieredCacheDatabase::CesiumTieredCacheDatabase(
+    const std::shared_ptr<ICacheDatabase>& pDiskCache,
+    int64 maximumMemoryBytes)
+    : _pDiskCache(pDiskCache),
+      _maximumMemoryBytes(FMath::Max(int64(0), maximumMemoryBytes)) {}
+
+std::optional<CacheItem>
+CesiumTieredCacheDatabase::getEntry(const std::string& key) const {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it != this->_entriesByKey.end()) {
+      // Move the entry to the front of the list, which is the most recently
+      // used end.
+      this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+      ++this->_statistics.memoryHits;
+      INC_DWORD_STAT(STAT_CesiumMemoryCacheHits);
+      return it->second->item;
+    }
+
+    ++this->_statistics.memoryMisses;
+  }
+
+  std::optional<CacheItem> result = this->_pDiskCache->getEntry(key);
+
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  if (!result) {
+    ++this->_statistics.diskMisses;
+    INC_DWORD_STAT(STAT_CesiumCacheMisses);
+    return result;
+  }
+
+  ++this->_statistics.diskHits;
+  this->_statistics.diskBytesRead += int64(result->cacheResponse.data.size());
+  INC_DWORD_STAT(STAT_CesiumDiskCacheHits);
+
+  // Another thread may have stored a newer response in the meantime.
+  if (this->_entriesByKey.find(key) == this->_entriesByKey.end()) {
+    this->addToMemory(key, CacheItem(*result));
+  }
+  return result;
+}
+
+bool CesiumTieredCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  const bool stored = this->_pDiskCache->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  if (stored) {
+    this->_statistics.diskBytesWritten += int64(responseData.size());
+  }
+
+  if (this->_maximumMemoryBytes == 0) {
+    return stored;
+  }
+
+  // Replace any older version of this response, even if the new one is too
+  // large to keep in memory.
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    this->removeFromMemory(it->second);
+  }
+
+  if (int64(responseData.size()) >
+      this->_maximumMemoryBytes / MaximumEntryFraction) {
+    return stored;
+  }
+
+  std::vector<std::byte> data(responseData.begin(), responseData.end());
+  this->addToMemory(
+      key,
+      CacheItem(
+          expiryTime,
+          CacheRequest(HttpHeaders(requestHeaders), requestMethod, url),
+          CacheResponse(
+              statusCode,
+              HttpHeaders(responseHeaders),
+              std::move(data))));
+
+  return stored;
+}
+
+bool CesiumTieredCacheDatabase::prune() {
+  // Entries in memory are revalidated by the caching asset accessor when they
+  // expire, just like the ones on disk, so only the disk needs pruning.
+  return this->_pDiskCache->prune();
+}
+
+bool CesiumTieredCacheDatabase::clearAll() {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_entries.clear();
+    this->_entriesByKey.clear();
+    this->_statistics.memoryEntries = 0;
+    this->_statistics.memoryBytes = 0;
+    SET_MEMORY_STAT(STAT_CesiumMemoryCacheBytes, 0);
+  }
+
+  return this->_pDiskCache->clearAll();
+}
+
+CesiumCacheStatistics CesiumTieredCacheDatabase::getStatistics() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_statistics;
+}
+
+void CesiumTieredCacheDatabase::addToMemory(
+    const std::string& key,
+    CacheItem&& item) const {
+  const int64 bytes = computeEntryBytes(key, item);
+  if (bytes > this->_maximumMemoryBytes / MaximumEntryFraction) {
+    return;
+  }
+
+  auto existing = this->_entriesByKey.find(key);
+  if (existing != this->_entriesByKey.end()) {
+    this->removeFromMemory(existing->second);
+  }
+
+  while (!this->_entries.empty() &&
+         this->_statistics.memoryBytes + bytes > this->_maximumMemoryBytes) {
+    this->removeFromMemory(std::prev(this->_entries.end()));
+  }
+
+  this->_entries.push_front(MemoryEntry{key, std::move(item), bytes});
+  this->_entriesByKey[key] = this->_entries.begin();
+  ++this->_statistics.memoryEntries;
+  this->_statistics.memoryBytes += bytes;
+  SET_MEMORY_STAT(STAT_CesiumMemoryCacheBytes, this->_statistics.memoryBytes);
+}
+
+void CesiumTieredCacheDatabase::removeFromMemory(EntryList::iterator it) const {
+  --this->_statistics.memoryEntries;
+  this->_statistics.memoryBytes -= it->bytes;
+  this->_entriesByKey.erase(it->key);
+  this->_entries.erase(it);
+}
@@ -0,0 +1,77 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumCacheStatistics.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * A cache database that keeps the most recently used responses in memory, up
+ * to a budget in bytes, in front of another cache database such as the
+ * SQLite cache on disk. Lookups of recently used responses don't touch the
+ * disk at all. Stores are written through to both tiers.
+ */
+class CesiumTieredCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * Creates a tiered cache.
+   *
+   * @param pDiskCache The cache to use as the second tier.
+   * @param maximumMemoryBytes The maximum number of bytes to keep in memory. If
+   * this is zero, all lookups go straight to the second tier.
+   */
+  CesiumTieredCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDiskCache,
+      int64 maximumMemoryBytes);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  CesiumCacheStatistics getStatistics() const;
+
+private:
+  struct MemoryEntry {
+    std::string key;
+    CesiumAsync::CacheItem item;
+    int64 bytes;
+  };
+
+  using EntryList = std::list<MemoryEntry>;
+
+  /**
+   * Adds an item to the memory tier, replacing any existing item with the
+   * same key, and evicts the least recently used items that no longer fit.
+   * Must be called with the mutex locked.
+   */
+  void addToMemory(const std::string& key, CesiumAsync::CacheItem&& item) const;
+
+  void removeFromMemory(EntryList::iterator it) const;
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDiskCache;
+  int64 _maximumMemoryBytes;
+
+  // The memory tier is updated by lookups, which are const.
+  mutable std::mutex _mutex;
+  mutable EntryList _entries;
+  mutable std::unordered_map<std::string, EntryList::iterator> _entriesByKey;
+  mutable CesiumCacheStatistics _statistics;
+};
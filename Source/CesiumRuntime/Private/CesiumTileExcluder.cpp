@@ -80,11 +80,48 @@ void UCesiumTileExcluder::Refresh() {
   this->AddToTileset();
 }
 
+void UCesiumTileExcluder::MarkExclusionChanged() {
+  ++this->_exclusionVersion;
+}
+
 bool UCesiumTileExcluder::ShouldExclude_Implementation(
     const UCesiumTile* TileObject) {
   return false;
 }
 
+void UCesiumTileExcluder::OnRegister() {
+  Super::OnRegister();
+
+  // The result of ShouldExclude usually depends on where the owner is, so
+  // cached results are discarded whenever it moves.
+  const AActor* pOwner = this->GetOwner();
+  USceneComponent* pOwnerRoot =
+      IsValid(pOwner) ? pOwner->GetRootComponent() : nullptr;
+  if (pOwnerRoot) {
+    pOwnerRoot->TransformUpdated.AddUObject(
+        this,
+        &UCesiumTileExcluder::_onOwnerTransformUpdated);
+  }
+}
+
+void UCesiumTileExcluder::OnUnregister() {
+  Super::OnUnregister();
+
+  const AActor* pOwner = this->GetOwner();
+  USceneComponent* pOwnerRoot =
+      IsValid(pOwner) ? pOwner->GetRootComponent() : nullptr;
+  if (pOwnerRoot) {
+    pOwnerRoot->TransformUpdated.RemoveAll(this);
+  }
+}
+
+void UCesiumTileExcluder::_onOwnerTransformUpdated(
+    USceneComponent* UpdatedComponent,
+    EUpdateTransformFlags UpdateTransformFlags,
+    ETeleportType Teleport) {
+  this->MarkExclusionChanged();
+}
+
 void UCesiumTileExcluder::Activate(bool bReset) {
   Super::Activate(bReset);
   this->AddToTileset();
@@ -106,6 +143,7 @@ void UCesiumTileExcluder::PostEditChangeProperty(
     FPropertyChangedEvent& PropertyChangedEvent) {
   Super::PostEditChangeProperty(PropertyChangedEvent);
 
+  this->MarkExclusionChanged();
   this->RemoveFromTileset();
   this->AddToTileset();
 }
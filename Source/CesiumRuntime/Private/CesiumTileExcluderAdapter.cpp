@@ -8,14 +8,33 @@ bool CesiumTileExcluderAdapter::shouldExclude(
   if (!this->IsExcluderValid) {
     return false;
   }
+
+  if (this->CacheResults) {
+    std::optional<bool> cached = this->Cache.find(tile);
+    if (cached) {
+      return *cached;
+    }
+  }
+
   Tile->_tileBounds = tile.getBoundingVolume();
   Tile->UpdateBounds();
-  return Excluder->ShouldExclude(Tile);
+  bool excluded = Excluder->ShouldExclude(Tile);
+
+  if (this->CacheResults) {
+    this->Cache.store(tile, excluded);
+  }
+
+  return excluded;
 }
 
 void CesiumTileExcluderAdapter::startNewFrame() noexcept {
+  // Forget the tiles that weren't visited in the previous frame, which
+  // includes any that were freed since.
+  this->Cache.startNewFrame();
+
   if (!Excluder.IsValid() || !IsValid(Tile) || !IsValid(Georeference)) {
     IsExcluderValid = false;
+    this->Cache.invalidate();
     return;
   }
 
@@ -23,6 +42,26 @@ void CesiumTileExcluderAdapter::startNewFrame() noexcept {
   Tile->_tileTransform =
       Georeference->GetGeoTransforms()
           .GetAbsoluteUnrealWorldToEllipsoidCenteredTransform();
+
+  this->CacheResults = Excluder->CacheExclusionResults;
+  if (!this->CacheResults) {
+    this->Cache.invalidate();
+    return;
+  }
+
+  // The tile's Unreal bounds depend on the georeference and on the transform of
+  // the tileset the tile component is attached to, so cached results are only
+  // valid while neither of them changes.
+  const int64 exclusionVersion = Excluder->GetExclusionVersion();
+  const FTransform& componentTransform = Tile->GetComponentTransform();
+  if (exclusionVersion != this->LastExclusionVersion ||
+      Tile->_tileTransform != this->LastTileTransform ||
+      !componentTransform.Equals(this->LastComponentTransform, 0.0)) {
+    this->Cache.invalidate();
+    this->LastExclusionVersion = exclusionVersion;
+    this->LastTileTransform = Tile->_tileTransform;
+    this->LastComponentTransform = componentTransform;
+  }
 }
 
 CesiumTileExcluderAdapter::CesiumTileExcluderAdapter(
@@ -32,4 +71,9 @@ CesiumTileExcluderAdapter::CesiumTileExcluderAdapter(
     : Excluder(pExcluder),
       Tile(pTile),
       Georeference(pGeoreference),
-      IsExcluderValid(true){};
+      IsExcluderValid(true),
+      Cache(),
+      CacheResults(false),
+      LastExclusionVersion(-1),
+      LastTileTransform(0.0),
+      LastComponentTransform(FTransform::Identity){};
@@ -1,6 +1,7 @@
 #pragma once
 #include "CesiumTile.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTileExclusionCache.h"
 #include <Cesium3DTilesSelection/ITileExcluder.h>
 
 class ACesiumGeoreference;
@@ -20,6 +21,14 @@ private:
   ACesiumGeoreference* Georeference;
   bool IsExcluderValid;
 
+  // The state that the cached exclusion results were computed with. The
+  // cache is invalidated whenever any of it changes.
+  mutable CesiumTileExclusionCache Cache;
+  bool CacheResults;
+  int64 LastExclusionVersion;
+  glm::dmat4 LastTileTransform;
+  FTransform LastComponentTransform;
+
 public:
   CesiumTileExcluderAdapter(
       TWeakObjectPtr<UCesiumTileExcluder> pExcluder,
@@ -0,0 +1,51 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileExclusionCache.h"
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/Tile.h"
+
+using namespace Cesium3DTilesSelection;
+
+std::optional<bool>
+CesiumTileExclusionCache::find(const Tile& tile) const noexcept {
+  auto it = this->_entries.find(&tile);
+  if (it == this->_entries.end()) {
+    return std::nullopt;
+  }
+
+  const Entry& entry = it->second;
+  if (entry.geometricError != tile.getGeometricError() ||
+      entry.boundingVolumeCenter !=
+          getBoundingVolumeCenter(tile.getBoundingVolume())) {
+    return std::nullopt;
+  }
+
+  entry.lastUsedFrame = this->_currentFrame;
+  return entry.excluded;
+}
+
+void CesiumTileExclusionCache::store(const Tile& tile, bool excluded) noexcept {
+  this->_entries.insert_or_assign(
+      &tile,
+      Entry{
+          getBoundingVolumeCenter(tile.getBoundingVolume()),
+          tile.getGeometricError(),
+          excluded,
+          this->_currentFrame});
+}
+
+void CesiumTileExclusionCache::startNewFrame() noexcept {
+  for (auto it = this->_entries.begin(); it != this->_entries.end();) {
+    if (it->second.lastUsedFrame != this->_currentFrame) {
+      it = this->_entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  ++this->_currentFrame;
+}
+
+void CesiumTileExclusionCache::invalidate() noexcept {
+  this->_entries.clear();
+}
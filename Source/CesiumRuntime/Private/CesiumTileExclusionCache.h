@@ -0,0 +1,66 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * Memoizes tile exclusion decisions until the excluder that made them
+ * changes.
+ *
+ * Entries are keyed by tile address and validated against a fingerprint of the
+ * tile's bounding volume and geometric error, so that a tile allocated at the
+ * address of a previously destroyed one does not inherit its decision. Entries
+ * that are not looked up for a whole frame are discarded by startNewFrame, so
+ * the cache only holds the tiles that are currently visited, and never keeps
+ * the addresses of tiles that were freed for long.
+ */
+class CesiumTileExclusionCache {
+public:
+  /**
+   * Returns the cached decision for the given tile, if there is one.
+   */
+  std::optional<bool>
+  find(const Cesium3DTilesSelection::Tile& tile) const noexcept;
+
+  /**
+   * Stores the decision for the given tile.
+   */
+  void store(const Cesium3DTilesSelection::Tile& tile, bool excluded) noexcept;
+
+  /**
+   * Discards the decisions that were not looked up or stored since the
+   * previous call, and starts tracking which decisions are used in the new
+   * frame. This should be called when the tile excluder starts a new frame.
+   */
+  void startNewFrame() noexcept;
+
+  /**
+   * Discards all cached decisions. This must be called whenever the excluder's
+   * version stamp changes.
+   */
+  void invalidate() noexcept;
+
+  /**
+   * Returns the number of cached decisions.
+   */
+  size_t size() const noexcept { return this->_entries.size(); }
+
+private:
+  struct Entry {
+    glm::dvec3 boundingVolumeCenter;
+    double geometricError;
+    bool excluded;
+    mutable uint64_t lastUsedFrame;
+  };
+
+  std::unordered_map<const Cesium3DTilesSelection::Tile*, Entry> _entries;
+  uint64_t _currentFrame = 0;
+};
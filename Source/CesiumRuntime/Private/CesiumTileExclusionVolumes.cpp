@@ -0,0 +1,617 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileExclusionVolumes.h"
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/S2CellBoundingVolume.h>
+#include <CesiumUtility/Math.h>
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+constexpr uint32_t MaxVolumesPerLeaf = 2;
+
+void computeAxisAlignedBounds(
+    const glm::dvec3& center,
+    const glm::dmat3& halfAxes,
+    glm::dvec3& aabbMin,
+    glm::dvec3& aabbMax) {
+  glm::dvec3 extent = glm::abs(halfAxes[0]) + glm::abs(halfAxes[1]) +
+                      glm::abs(halfAxes[2]);
+  aabbMin = center - extent;
+  aabbMax = center + extent;
+}
+
+bool overlaps(
+    const glm::dvec3& aMin,
+    const glm::dvec3& aMax,
+    const glm::dvec3& bMin,
+    const glm::dvec3& bMax) {
+  return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y &&
+         aMax.y >= bMin.y && aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
+
+std::array<glm::dvec3, 8> computeCorners(const OrientedBoundingBox& box) {
+  const glm::dvec3& c = box.getCenter();
+  const glm::dmat3& h = box.getHalfAxes();
+  return {
+      c - h[0] - h[1] - h[2],
+      c + h[0] - h[1] - h[2],
+      c - h[0] + h[1] - h[2],
+      c + h[0] + h[1] - h[2],
+      c - h[0] - h[1] + h[2],
+      c + h[0] - h[1] + h[2],
+      c - h[0] + h[1] + h[2],
+      c + h[0] + h[1] + h[2]};
+}
+
+/**
+ * Computes the bounds of a tile's bounding volume used by the broad-phase and
+ * narrow-phase tests. Regions keep their exact cartographic extents; for boxes
+ * and spheres, the extents are estimated conservatively.
+ */
+struct TileBoundsOperation {
+  struct Result {
+    OrientedBoundingBox box;
+    std::optional<GlobeRectangle> rectangle;
+    double minimumHeight;
+    double maximumHeight;
+  };
+
+  Result operator()(const BoundingSphere& sphere) const {
+    return fromBox(OrientedBoundingBox(
+        sphere.getCenter(),
+        glm::dmat3(sphere.getRadius())));
+  }
+
+  Result operator()(const OrientedBoundingBox& box) const {
+    return fromBox(box);
+  }
+
+  Result operator()(const BoundingRegion& region) const {
+    return Result{
+        region.getBoundingBox(),
+        region.getRectangle(),
+        region.getMinimumHeight(),
+        region.getMaximumHeight()};
+  }
+
+  Result
+  operator()(const BoundingRegionWithLooseFittingHeights& region) const {
+    return (*this)(region.getBoundingRegion());
+  }
+
+  Result operator()(const S2CellBoundingVolume& s2) const {
+    return (*this)(s2.computeBoundingRegion());
+  }
+
+  const BoundingVolume& boundingVolume;
+
+private:
+  Result fromBox(const OrientedBoundingBox& box) const {
+    // Height is 1-Lipschitz with respect to position, so the height of every
+    // point in the box is within the box's bounding radius of the height of
+    // its center.
+    const glm::dmat3& h = box.getHalfAxes();
+    double radius = glm::length(h[0] + h[1] + h[2]);
+    radius = glm::max(radius, glm::length(h[0] + h[1] - h[2]));
+    radius = glm::max(radius, glm::length(h[0] - h[1] + h[2]));
+    radius = glm::max(radius, glm::length(-h[0] + h[1] + h[2]));
+
+    std::optional<Cartographic> maybeCenter =
+        Ellipsoid::WGS84.cartesianToCartographic(box.getCenter());
+    if (!maybeCenter) {
+      return Result{box, std::nullopt, 0.0, 0.0};
+    }
+
+    return Result{
+        box,
+        estimateGlobeRectangle(this->boundingVolume),
+        maybeCenter->height - radius,
+        maybeCenter->height + radius};
+  }
+};
+
+struct Rectangle2D {
+  glm::dvec2 min;
+  glm::dvec2 max;
+};
+
+// Splits a globe rectangle into at most two planar longitude / latitude
+// rectangles that do not cross the anti-meridian.
+uint32_t splitRectangle(
+    const GlobeRectangle& rectangle,
+    std::array<Rectangle2D, 2>& result) {
+  if (rectangle.getWest() <= rectangle.getEast()) {
+    result[0] = Rectangle2D{
+        glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
+        glm::dvec2(rectangle.getEast(), rectangle.getNorth())};
+    return 1;
+  }
+
+  result[0] = Rectangle2D{
+      glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
+      glm::dvec2(Math::OnePi, rectangle.getNorth())};
+  result[1] = Rectangle2D{
+      glm::dvec2(-Math::OnePi, rectangle.getSouth()),
+      glm::dvec2(rectangle.getEast(), rectangle.getNorth())};
+  return 2;
+}
+
+bool isPointInRectangle(const glm::dvec2& point, const Rectangle2D& rectangle) {
+  return point.x >= rectangle.min.x && point.x <= rectangle.max.x &&
+         point.y >= rectangle.min.y && point.y <= rectangle.max.y;
+}
+
+bool isPointInPolygon(
+    const glm::dvec2& point,
+    const std::vector<glm::dvec2>& polygon) {
+  bool inside = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const glm::dvec2& a = polygon[i];
+    const glm::dvec2& b = polygon[j];
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+double cross2D(const glm::dvec2& a, const glm::dvec2& b, const glm::dvec2& c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Returns true if the segments intersect, including touching endpoints and
+// collinear overlaps. Both uses of this function treat touching as
+// intersecting, which keeps the exclusion tests conservative.
+bool segmentsIntersect(
+    const glm::dvec2& p1,
+    const glm::dvec2& p2,
+    const glm::dvec2& q1,
+    const glm::dvec2& q2) {
+  double d1 = cross2D(q1, q2, p1);
+  double d2 = cross2D(q1, q2, p2);
+  double d3 = cross2D(p1, p2, q1);
+  double d4 = cross2D(p1, p2, q2);
+
+  if (((d1 > 0.0 && d2 < 0.0) || (d1 < 0.0 && d2 > 0.0)) &&
+      ((d3 > 0.0 && d4 < 0.0) || (d3 < 0.0 && d4 > 0.0))) {
+    return true;
+  }
+
+  auto onSegment =
+      [](const glm::dvec2& a, const glm::dvec2& b, const glm::dvec2& p) {
+        return glm::min(a.x, b.x) <= p.x && p.x <= glm::max(a.x, b.x) &&
+               glm::min(a.y, b.y) <= p.y && p.y <= glm::max(a.y, b.y);
+      };
+
+  return (d1 == 0.0 && onSegment(q1, q2, p1)) ||
+         (d2 == 0.0 && onSegment(q1, q2, p2)) ||
+         (d3 == 0.0 && onSegment(p1, p2, q1)) ||
+         (d4 == 0.0 && onSegment(p1, p2, q2));
+}
+
+bool polygonBoundaryTouchesRectangle(
+    const std::vector<glm::dvec2>& polygon,
+    const Rectangle2D& rectangle) {
+  const std::array<glm::dvec2, 4> corners = {
+      rectangle.min,
+      glm::dvec2(rectangle.max.x, rectangle.min.y),
+      rectangle.max,
+      glm::dvec2(rectangle.min.x, rectangle.max.y)};
+
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const glm::dvec2& a = polygon[j];
+    const glm::dvec2& b = polygon[i];
+    for (size_t k = 0; k < corners.size(); ++k) {
+      if (segmentsIntersect(a, b, corners[k], corners[(k + 1) % 4])) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool isRectangleInsidePolygon(
+    const Rectangle2D& rectangle,
+    const std::vector<glm::dvec2>& polygon) {
+  // If all corners are inside and the polygon boundary never touches the
+  // rectangle boundary, the boundary cannot enter the rectangle either.
+  return isPointInPolygon(rectangle.min, polygon) &&
+         isPointInPolygon(rectangle.max, polygon) &&
+         isPointInPolygon(
+             glm::dvec2(rectangle.min.x, rectangle.max.y),
+             polygon) &&
+         isPointInPolygon(
+             glm::dvec2(rectangle.max.x, rectangle.min.y),
+             polygon) &&
+         !polygonBoundaryTouchesRectangle(polygon, rectangle);
+}
+
+bool isRectangleDisjointFromPolygon(
+    const Rectangle2D& rectangle,
+    const std::vector<glm::dvec2>& polygon,
+    const glm::dvec2& polygonMin,
+    const glm::dvec2& polygonMax) {
+  if (rectangle.max.x < polygonMin.x || rectangle.min.x > polygonMax.x ||
+      rectangle.max.y < polygonMin.y || rectangle.min.y > polygonMax.y) {
+    return true;
+  }
+
+  if (isPointInPolygon(rectangle.min, polygon) ||
+      isPointInRectangle(polygon[0], rectangle)) {
+    return false;
+  }
+
+  return !polygonBoundaryTouchesRectangle(polygon, rectangle);
+}
+
+// Projects a parallelepiped onto an axis and returns its half-length along
+// that axis, scaled by the length of the axis.
+double projectedRadius(const glm::dmat3& halfAxes, const glm::dvec3& axis) {
+  return glm::abs(glm::dot(halfAxes[0], axis)) +
+         glm::abs(glm::dot(halfAxes[1], axis)) +
+         glm::abs(glm::dot(halfAxes[2], axis));
+}
+
+bool areParallelepipedsSeparated(
+    const glm::dvec3& centerA,
+    const glm::dmat3& halfAxesA,
+    const glm::dvec3& centerB,
+    const glm::dmat3& halfAxesB) {
+  const glm::dvec3 offset = centerB - centerA;
+
+  auto isSeparatingAxis = [&](const glm::dvec3& axis) {
+    if (glm::dot(axis, axis) == 0.0) {
+      return false;
+    }
+    return glm::abs(glm::dot(offset, axis)) >
+           projectedRadius(halfAxesA, axis) + projectedRadius(halfAxesB, axis);
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    if (isSeparatingAxis(
+            glm::cross(halfAxesA[(i + 1) % 3], halfAxesA[(i + 2) % 3])) ||
+        isSeparatingAxis(
+            glm::cross(halfAxesB[(i + 1) % 3], halfAxesB[(i + 2) % 3]))) {
+      return true;
+    }
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (isSeparatingAxis(glm::cross(halfAxesA[i], halfAxesB[j]))) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+// Returns the squared distance from a point to a box with orthogonal
+// half-axes, such as the ones produced for tile bounding volumes.
+double squaredDistanceToBox(
+    const OrientedBoundingBox& box,
+    const glm::dvec3& point) {
+  const glm::dvec3 offset = point - box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  glm::dvec3 closest = box.getCenter();
+  for (int i = 0; i < 3; ++i) {
+    double length = glm::length(halfAxes[i]);
+    if (length == 0.0) {
+      continue;
+    }
+    glm::dvec3 axis = halfAxes[i] / length;
+    closest += glm::clamp(glm::dot(offset, axis), -length, length) * axis;
+  }
+
+  glm::dvec3 difference = point - closest;
+  return glm::dot(difference, difference);
+}
+
+struct VolumeBoundsOperation {
+  glm::dvec3& aabbMin;
+  glm::dvec3& aabbMax;
+
+  void operator()(const CesiumExclusionBox& box) {
+    computeAxisAlignedBounds(box.center, box.halfAxes, aabbMin, aabbMax);
+  }
+
+  void operator()(const CesiumExclusionSphere& sphere) {
+    aabbMin = sphere.center - glm::dvec3(sphere.radius);
+    aabbMax = sphere.center + glm::dvec3(sphere.radius);
+  }
+
+  void operator()(const CesiumExclusionPrism& prism) {
+    glm::dvec2 polygonMin(std::numeric_limits<double>::max());
+    glm::dvec2 polygonMax(std::numeric_limits<double>::lowest());
+    for (const glm::dvec2& vertex : prism.polygon) {
+      polygonMin = glm::min(polygonMin, vertex);
+      polygonMax = glm::max(polygonMax, vertex);
+    }
+
+    BoundingRegion region(
+        GlobeRectangle(polygonMin.x, polygonMin.y, polygonMax.x, polygonMax.y),
+        prism.minimumHeight,
+        prism.maximumHeight);
+    const OrientedBoundingBox& box = region.getBoundingBox();
+    computeAxisAlignedBounds(
+        box.getCenter(),
+        box.getHalfAxes(),
+        aabbMin,
+        aabbMax);
+  }
+};
+} // namespace
+
+void CesiumTileExclusionIndex::build(
+    std::vector<CesiumExclusionVolume>&& volumes) {
+  this->_volumes.clear();
+  this->_nodes.clear();
+  this->_hasExcludeOutside = false;
+
+  this->_volumes.reserve(volumes.size());
+  for (CesiumExclusionVolume& volume : volumes) {
+    if (const CesiumExclusionPrism* pPrism =
+            std::get_if<CesiumExclusionPrism>(&volume.shape)) {
+      if (pPrism->polygon.size() < 3 ||
+          pPrism->minimumHeight > pPrism->maximumHeight) {
+        continue;
+      }
+    }
+
+    PreparedVolume& prepared = this->_volumes.emplace_back();
+    prepared.volume = std::move(volume);
+    prepared.invertible = false;
+    prepared.inverseHalfAxes = glm::dmat3(0.0);
+    prepared.polygonMin = glm::dvec2(0.0);
+    prepared.polygonMax = glm::dvec2(0.0);
+
+    std::visit(
+        VolumeBoundsOperation{prepared.aabbMin, prepared.aabbMax},
+        prepared.volume.shape);
+
+    if (const CesiumExclusionBox* pBox =
+            std::get_if<CesiumExclusionBox>(&prepared.volume.shape)) {
+      prepared.invertible =
+          glm::abs(glm::determinant(pBox->halfAxes)) > Math::Epsilon14;
+      if (prepared.invertible) {
+        prepared.inverseHalfAxes = glm::inverse(pBox->halfAxes);
+      }
+    } else if (
+        const CesiumExclusionPrism* pPrism =
+            std::get_if<CesiumExclusionPrism>(&prepared.volume.shape)) {
+      prepared.polygonMin = glm::dvec2(std::numeric_limits<double>::max());
+      prepared.polygonMax = glm::dvec2(std::numeric_limits<double>::lowest());
+      for (const glm::dvec2& vertex : pPrism->polygon) {
+        prepared.polygonMin = glm::min(prepared.polygonMin, vertex);
+        prepared.polygonMax = glm::max(prepared.polygonMax, vertex);
+      }
+    }
+
+    this->_hasExcludeOutside |= prepared.volume.excludeOutside;
+  }
+
+  if (!this->_volumes.empty()) {
+    this->buildNode(0, uint32_t(this->_volumes.size()));
+  }
+}
+
+uint32_t CesiumTileExclusionIndex::buildNode(uint32_t begin, uint32_t end) {
+  const uint32_t nodeIndex = uint32_t(this->_nodes.size());
+  this->_nodes.emplace_back();
+
+  glm::dvec3 aabbMin(std::numeric_limits<double>::max());
+  glm::dvec3 aabbMax(std::numeric_limits<double>::lowest());
+  glm::dvec3 centroidMin = aabbMin;
+  glm::dvec3 centroidMax = aabbMax;
+  for (uint32_t i = begin; i < end; ++i) {
+    const PreparedVolume& volume = this->_volumes[i];
+    aabbMin = glm::min(aabbMin, volume.aabbMin);
+    aabbMax = glm::max(aabbMax, volume.aabbMax);
+    glm::dvec3 centroid = 0.5 * (volume.aabbMin + volume.aabbMax);
+    centroidMin = glm::min(centroidMin, centroid);
+    centroidMax = glm::max(centroidMax, centroid);
+  }
+
+  this->_nodes[nodeIndex].aabbMin = aabbMin;
+  this->_nodes[nodeIndex].aabbMax = aabbMax;
+
+  if (end - begin <= MaxVolumesPerLeaf) {
+    this->_nodes[nodeIndex].first = begin;
+    this->_nodes[nodeIndex].count = end - begin;
+    return nodeIndex;
+  }
+
+  glm::dvec3 spread = centroidMax - centroidMin;
+  int axis = 0;
+  if (spread.y > spread[axis])
+    axis = 1;
+  if (spread.z > spread[axis])
+    axis = 2;
+
+  const uint32_t middle = begin + (end - begin) / 2;
+  std::nth_element(
+      this->_volumes.begin() + begin,
+      this->_volumes.begin() + middle,
+      this->_volumes.begin() + end,
+      [axis](const PreparedVolume& a, const PreparedVolume& b) {
+        return a.aabbMin[axis] + a.aabbMax[axis] <
+               b.aabbMin[axis] + b.aabbMax[axis];
+      });
+
+  this->buildNode(begin, middle);
+  const uint32_t right = this->buildNode(middle, end);
+
+  this->_nodes[nodeIndex].first = right;
+  this->_nodes[nodeIndex].count = 0;
+  return nodeIndex;
+}
+
+bool CesiumTileExclusionIndex::shouldExclude(
+    const BoundingVolume& boundingVolume) const {
+  if (this->_volumes.empty()) {
+    return false;
+  }
+
+  TileBoundsOperation::Result bounds =
+      std::visit(TileBoundsOperation{boundingVolume}, boundingVolume);
+
+  TileBounds tile{
+      bounds.box,
+      glm::dvec3(0.0),
+      glm::dvec3(0.0),
+      bounds.rectangle.has_value(),
+      bounds.rectangle.value_or(GlobeRectangle(0.0, 0.0, 0.0, 0.0)),
+      bounds.minimumHeight,
+      bounds.maximumHeight};
+  computeAxisAlignedBounds(
+      tile.box.getCenter(),
+      tile.box.getHalfAxes(),
+      tile.aabbMin,
+      tile.aabbMax);
+
+  bool touchesKeepVolume = false;
+
+  // The hierarchy depth is logarithmic in the number of volumes, so a small
+  // fixed-size stack is plenty.
+  std::array<uint32_t, 64> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    const Node& node = this->_nodes[stack[--stackSize]];
+    if (!overlaps(node.aabbMin, node.aabbMax, tile.aabbMin, tile.aabbMax)) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      const uint32_t nodeIndex = uint32_t(&node - this->_nodes.data());
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = nodeIndex + 1;
+      continue;
+    }
+
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+      const PreparedVolume& volume = this->_volumes[i];
+      if (!overlaps(volume.aabbMin, volume.aabbMax, tile.aabbMin, tile.aabbMax))
+        continue;
+
+      if (!volume.volume.excludeOutside) {
+        if (this->isInside(volume, tile)) {
+          return true;
+        }
+      } else if (!touchesKeepVolume && !this->isDisjoint(volume, tile)) {
+        touchesKeepVolume = true;
+      }
+    }
+  }
+
+  return this->_hasExcludeOutside && !touchesKeepVolume;
+}
+
+bool CesiumTileExclusionIndex::isInside(
+    const PreparedVolume& volume,
+    const TileBounds& tile) const {
+  if (const CesiumExclusionBox* pBox =
+          std::get_if<CesiumExclusionBox>(&volume.volume.shape)) {
+    if (!volume.invertible) {
+      return false;
+    }
+    // Boxes are convex, so the tile is inside if all of its corners are.
+    for (const glm::dvec3& corner : computeCorners(tile.box)) {
+      glm::dvec3 local = volume.inverseHalfAxes * (corner - pBox->center);
+      if (glm::abs(local.x) > 1.0 || glm::abs(local.y) > 1.0 ||
+          glm::abs(local.z) > 1.0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  if (const CesiumExclusionSphere* pSphere =
+          std::get_if<CesiumExclusionSphere>(&volume.volume.shape)) {
+    const double radiusSquared = pSphere->radius * pSphere->radius;
+    for (const glm::dvec3& corner : computeCorners(tile.box)) {
+      glm::dvec3 offset = corner - pSphere->center;
+      if (glm::dot(offset, offset) > radiusSquared) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const CesiumExclusionPrism& prism =
+      std::get<CesiumExclusionPrism>(volume.volume.shape);
+  if (!tile.hasRegion || tile.minimumHeight < prism.minimumHeight ||
+      tile.maximumHeight > prism.maximumHeight) {
+    return false;
+  }
+
+  std::array<Rectangle2D, 2> parts;
+  uint32_t partCount = splitRectangle(tile.rectangle, parts);
+  for (uint32_t i = 0; i < partCount; ++i) {
+    if (!isRectangleInsidePolygon(parts[i], prism.polygon)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CesiumTileExclusionIndex::isDisjoint(
+    const PreparedVolume& volume,
+    const TileBounds& tile) const {
+  if (const CesiumExclusionBox* pBox =
+          std::get_if<CesiumExclusionBox>(&volume.volume.shape)) {
+    return areParallelepipedsSeparated(
+        tile.box.getCenter(),
+        tile.box.getHalfAxes(),
+        pBox->center,
+        pBox->halfAxes);
+  }
+
+  if (const CesiumExclusionSphere* pSphere =
+          std::get_if<CesiumExclusionSphere>(&volume.volume.shape)) {
+    return squaredDistanceToBox(tile.box, pSphere->center) >
+           pSphere->radius * pSphere->radius;
+  }
+
+  const CesiumExclusionPrism& prism =
+      std::get<CesiumExclusionPrism>(volume.volume.shape);
+  if (!tile.hasRegion) {
+    return false;
+  }
+
+  if (tile.maximumHeight < prism.minimumHeight ||
+      tile.minimumHeight > prism.maximumHeight) {
+    return true;
+  }
+
+  std::array<Rectangle2D, 2> parts;
+  uint32_t partCount = splitRectangle(tile.rectangle, parts);
+  for (uint32_t i = 0; i < partCount; ++i) {
+    if (!isRectangleDisjointFromPolygon(
+            parts[i],
+            prism.polygon,
+            volume.polygonMin,
+            volume.polygonMax)) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,133 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief A parallelepiped expressed in Cesium tileset coordinates (usually
+ * ECEF). The half-axes do not need to be orthogonal, so that arbitrary
+ * (sheared) Unreal component transforms can be represented exactly.
+ */
+struct CesiumExclusionBox {
+  glm::dvec3 center;
+  glm::dmat3 halfAxes;
+};
+
+/**
+ * @brief A sphere expressed in Cesium tileset coordinates.
+ */
+struct CesiumExclusionSphere {
+  glm::dvec3 center;
+  double radius;
+};
+
+/**
+ * @brief A polygon on the surface of the ellipsoid, extruded between a
+ * minimum and maximum height. Polygon vertices are longitude / latitude in
+ * radians. Polygons crossing the anti-meridian are not supported.
+ */
+struct CesiumExclusionPrism {
+  std::vector<glm::dvec2> polygon;
+  double minimumHeight;
+  double maximumHeight;
+};
+
+/**
+ * @brief A single volume contributed by a geometric tile excluder.
+ */
+struct CesiumExclusionVolume {
+  std::variant<CesiumExclusionBox, CesiumExclusionSphere, CesiumExclusionPrism>
+      shape;
+
+  /**
+   * @brief If false, tiles that lie entirely inside this volume are excluded.
+   * If true, the volume is a "keep" region: tiles that lie entirely outside of
+   * every such volume are excluded.
+   */
+  bool excludeOutside = false;
+};
+
+/**
+ * @brief Tests tile bounding volumes against a set of exclusion volumes.
+ *
+ * The volumes are organized into a static bounding volume hierarchy over their
+ * axis-aligned bounds, so that a tile is only tested in detail against the
+ * volumes that it could possibly touch. All tests are conservative: a tile is
+ * only excluded if it is known to be completely inside an exclusion volume, or
+ * completely outside of all "keep" volumes.
+ */
+class CesiumTileExclusionIndex {
+public:
+  /**
+   * @brief Rebuilds the index from the given volumes.
+   */
+  void build(std::vector<CesiumExclusionVolume>&& volumes);
+
+  /**
+   * @brief Returns true if there are no volumes in this index.
+   */
+  bool isEmpty() const noexcept { return this->_volumes.empty(); }
+
+  /**
+   * @brief Determines whether a tile with the given bounding volume, expressed
+   * in Cesium tileset coordinates, should be excluded.
+   */
+  bool shouldExclude(
+      const Cesium3DTilesSelection::BoundingVolume& boundingVolume) const;
+
+private:
+  struct TileBounds {
+    CesiumGeometry::OrientedBoundingBox box;
+    glm::dvec3 aabbMin;
+    glm::dvec3 aabbMax;
+
+    // The cartographic extent of the tile. The rectangle may cross the
+    // anti-meridian. hasRegion is false if it could not be estimated.
+    bool hasRegion;
+    CesiumGeospatial::GlobeRectangle rectangle;
+    double minimumHeight;
+    double maximumHeight;
+  };
+
+  struct PreparedVolume {
+    CesiumExclusionVolume volume;
+    glm::dvec3 aabbMin;
+    glm::dvec3 aabbMax;
+    // Only used for boxes: maps tileset coordinates relative to the box
+    // center into the box's unit cube. Invalid for degenerate boxes.
+    glm::dmat3 inverseHalfAxes;
+    bool invertible;
+    // Only used for prisms: the longitude / latitude bounds of the polygon.
+    glm::dvec2 polygonMin;
+    glm::dvec2 polygonMax;
+  };
+
+  struct Node {
+    glm::dvec3 aabbMin;
+    glm::dvec3 aabbMax;
+    // For leaves, the range [first, first + count) in _volumes. For interior
+    // nodes, count is zero and first is the index of the right child; the
+    // left child immediately follows this node.
+    uint32_t first;
+    uint32_t count;
+  };
+
+  uint32_t buildNode(uint32_t begin, uint32_t end);
+
+  bool isInside(const PreparedVolume& volume, const TileBounds& tile) const;
+  bool isDisjoint(const PreparedVolume& volume, const TileBounds& tile) const;
+
+  std::vector<PreparedVolume> _volumes;
+  std::vector<Node> _nodes;
+  bool _hasExcludeOutside = false;
+};
@@ -0,0 +1,97 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexWelding.h"
+#include "Misc/Crc.h"
+
+namespace {
+
+struct VertexComparer {
+  int32 numTexCoords;
+  bool hasVertexColors;
+
+  uint32 hash(const FStaticMeshBuildVertex& vertex) const {
+    uint32 hash = FCrc::MemCrc32(&vertex.Position, sizeof(vertex.Position));
+    hash = FCrc::MemCrc32(&vertex.TangentX, sizeof(vertex.TangentX), hash);
+    hash = FCrc::MemCrc32(&vertex.TangentY, sizeof(vertex.TangentY), hash);
+    hash = FCrc::MemCrc32(&vertex.TangentZ, sizeof(vertex.TangentZ), hash);
+    hash = FCrc::MemCrc32(
+        vertex.UVs,
+        numTexCoords * int32(sizeof(vertex.UVs[0])),
+        hash);
+    if (hasVertexColors) {
+      hash = FCrc::MemCrc32(&vertex.Color, sizeof(vertex.Color), hash);
+    }
+    return hash;
+  }
+
+  bool equal(const FStaticMeshBuildVertex& a, const FStaticMeshBuildVertex& b)
+      const {
+    return FMemory::Memcmp(&a.Position, &b.Position, sizeof(a.Position)) ==
+               0 &&
+           FMemory::Memcmp(&a.TangentX, &b.TangentX, sizeof(a.TangentX)) ==
+               0 &&
+           FMemory::Memcmp(&a.TangentY, &b.TangentY, sizeof(a.TangentY)) ==
+               0 &&
+           FMemory::Memcmp(&a.TangentZ, &b.TangentZ, sizeof(a.TangentZ)) ==
+               0 &&
+           FMemory::Memcmp(
+               a.UVs,
+               b.UVs,
+               numTexCoords * sizeof(a.UVs[0])) == 0 &&
+           (!hasVertexColors || a.Color == b.Color);
+  }
+};
+
+} // namespace
+
+namespace CesiumVertexWelding {
+
+void weldVertices(
+    TArray<FStaticMeshBuildVertex>& vertices,
+    TArray<uint32>& indices,
+    int32 numTexCoords,
+    bool hasVertexColors) {
+  const VertexComparer comparer{
+      FMath::Clamp(numTexCoords, 0, int32(MAX_STATIC_TEXCOORDS)),
+      hasVertexColors};
+
+  // An open-addressing hash table of indices into the merged vertices, with
+  // at least twice as many buckets as there are vertices.
+  const uint32 bucketCount =
+      FMath::RoundUpToPowerOfTwo(uint32(FMath::Max(vertices.Num(), 1)) * 2);
+  const uint32 bucketMask = bucketCount - 1;
+  TArray<int32> buckets;
+  buckets.Init(INDEX_NONE, int32(bucketCount));
+
+  TArray<FStaticMeshBuildVertex> merged;
+  merged.Reserve(vertices.Num());
+
+  // The index of each original vertex in the merged vertices, once it has
+  // been referenced.
+  TArray<int32> remap;
+  remap.Init(INDEX_NONE, vertices.Num());
+
+  for (uint32& index : indices) {
+    int32& mergedIndex = remap[int32(index)];
+    if (mergedIndex == INDEX_NONE) {
+      const FStaticMeshBuildVertex& vertex = vertices[int32(index)];
+      uint32 bucket = comparer.hash(vertex) & bucketMask;
+      while (buckets[bucket] != INDEX_NONE &&
+             !comparer.equal(merged[buckets[bucket]], vertex)) {
+        bucket = (bucket + 1) & bucketMask;
+      }
+
+      if (buckets[bucket] == INDEX_NONE) {
+        buckets[bucket] = merged.Add(vertex);
+      }
+      mergedIndex = buckets[bucket];
+    }
+
+    index = uint32(mergedIndex);
+  }
+
+  merged.Shrink();
+  vertices = MoveTemp(merged);
+}
+
+} // namespace CesiumVertexWelding
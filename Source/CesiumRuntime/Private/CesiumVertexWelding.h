@@ -0,0 +1,33 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "StaticMeshResources.h"
+
+/**
+ * Functions for turning the unindexed meshes that are created to compute flat
+ * normals and tangents back into indexed meshes.
+ */
+namespace CesiumVertexWelding {
+/**
+ * Merges vertices that are identical in every attribute that the mesh uses,
+ * and updates the indices to refer to the merged vertices. Vertices are kept
+ * in the order in which they are first referenced, so the result is
+ * deterministic.
+ *
+ * Attributes are compared bit for bit, so vertices are only merged when the
+ * merged mesh renders exactly like the original one.
+ *
+ * @param vertices The vertices, which are replaced by the merged vertices.
+ * @param indices The indices, which are replaced by indices of the merged
+ * vertices.
+ * @param numTexCoords The number of texture coordinate sets of the vertices
+ * that are used. The others are ignored.
+ * @param hasVertexColors Whether the vertex colors are used.
+ */
+void weldVertices(
+    TArray<FStaticMeshBuildVertex>& vertices,
+    TArray<uint32>& indices,
+    int32 numTexCoords,
+    bool hasVertexColors);
+} // namespace CesiumVertexWelding
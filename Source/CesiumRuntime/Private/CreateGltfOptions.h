@@ -7,7 +7,12 @@
 #include "CesiumGltf/MeshPrimitive.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/Node.h"
+#include "CesiumTextureCompression.h"
 #include "LoadGltfResult.h"
+#include "Templates/SharedPointer.h"
+
+class CesiumEncodedPropertyTableCache;
+struct CesiumPrebakedTile;
 
 // TODO: internal documentation
 namespace CreateGltfOptions {
@@ -24,6 +29,51 @@ struct CreateModelOptions {
   bool alwaysIncludeTangents = false;
   bool createPhysicsMeshes = true;
   bool ignoreKhrMaterialsUnlit = false;
+
+  /**
+   * How the uncompressed images of this model's materials are compressed
+   * before they are uploaded.
+   */
+  ECesiumTextureCompression textureCompression =
+      ECesiumTextureCompression::None;
+
+  /**
+   * Whether the loops over the vertices and indices of large primitives are
+   * split across worker threads.
+   */
+  bool parallelMeshBuilding = true;
+
+  /**
+   * Whether the buffer data that runtime queries don't need is released once
+   * this model's primitives have been built. See CesiumModelTrimming.
+   */
+  bool releaseBuffers = false;
+
+  /**
+   * Whether the pixels of images that runtime queries don't need are released
+   * once this model's textures have been created. Only used if releaseBuffers
+   * is true.
+   */
+  bool releaseImages = false;
+
+  /**
+   * The pre-baked vertices and indices of this model's primitives. Primitives
+   * found in it are not computed again.
+   */
+  const CesiumPrebakedTile* pPrebakedTile = nullptr;
+
+  /**
+   * If not nullptr, the vertices and indices of this model's primitives are
+   * recorded here so that they can be pre-baked.
+   */
+  CesiumPrebakedTile* pPrebakeResult = nullptr;
+
+  /**
+   * If set, the encoded textures of this model's property tables are shared
+   * with the other models of the tileset whose property tables have the same
+   * contents.
+   */
+  TSharedPtr<CesiumEncodedPropertyTableCache> pPropertyTableCache;
 };
 
 struct CreateNodeOptions {
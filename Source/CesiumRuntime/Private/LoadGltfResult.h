@@ -167,5 +167,13 @@ struct LoadModelResult {
   // For backwards compatibility with CesiumEncodedMetadataComponent.
   std::optional<CesiumEncodedMetadataUtility::EncodedMetadata>
       EncodedMetadata_DEPRECATED{};
+
+  // The number of bytes of glTF buffers and images that remain in CPU memory
+  // while the tile is loaded.
+  int64 ResidentCpuBytes = 0;
+
+  // The number of bytes of glTF buffers and images that were released after
+  // the primitives and textures were built.
+  int64 ReleasedCpuBytes = 0;
 };
 } // namespace LoadGltfResult
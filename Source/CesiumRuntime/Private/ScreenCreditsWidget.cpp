@@ -1,16 +1,21 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "ScreenCreditsWidget.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumRuntime.h"
 #include "Components/BackgroundBlur.h"
 #include "Components/RichTextBlock.h"
 #include "Engine/Font.h"
 #include "Engine/Texture2D.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Hash/CityHash.h"
 #include "HttpModule.h"
-#include "ImageUtils.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Math/UnrealMathUtility.h"
 #include "Misc/Base64.h"
+#include "Modules/ModuleManager.h"
 #include "Rendering/DrawElements.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Slate/SlateGameResources.h"
@@ -23,6 +28,43 @@
 #include <string>
 #include <vector>
 
+namespace {
+
+struct DecodedImage {
+  int32 width = 0;
+  int32 height = 0;
+  TArray64<uint8> pixels;
+};
+
+// Decodes a PNG or JPEG credit image to BGRA pixels. Called from a worker
+// thread.
+DecodedImage decodeImage(
+    IImageWrapperModule& imageWrapperModule,
+    const TArray<uint8>& data) {
+  DecodedImage result;
+
+  const EImageFormat format =
+      imageWrapperModule.DetectImageFormat(data.GetData(), data.Num());
+  if (format == EImageFormat::Invalid) {
+    return result;
+  }
+
+  TSharedPtr<IImageWrapper> pImageWrapper =
+      imageWrapperModule.CreateImageWrapper(format);
+  if (!pImageWrapper.IsValid() ||
+      !pImageWrapper->SetCompressed(data.GetData(), data.Num()) ||
+      !pImageWrapper->GetRaw(ERGBFormat::BGRA, 8, result.pixels)) {
+    result.pixels.Empty();
+    return result;
+  }
+
+  result.width = int32(pImageWrapper->GetWidth());
+  result.height = int32(pImageWrapper->GetHeight());
+  return result;
+}
+
+} // namespace
+
 class SCreditImage : public SCompoundWidget {
 public:
   SLATE_BEGIN_ARGS(SCreditImage) {}
@@ -124,8 +166,7 @@ protected:
       Text = *RunInfo.MetaData[TEXT("text")];
     }
     if (RunInfo.MetaData.Contains(TEXT("id"))) {
-      int32 id = FCString::Atoi(*RunInfo.MetaData[TEXT("id")]);
-      Brush = Decorator->FindImageBrush(id);
+      Brush = Decorator->FindImageBrush(RunInfo.MetaData[TEXT("id")]);
     }
     if (Brush) {
       if (Url.IsEmpty()) {
@@ -150,11 +191,9 @@ UCreditsDecorator::CreateDecorator(URichTextBlock* InOwner) {
   return MakeShareable(new FScreenCreditsDecorator(InOwner, this));
 }
 
-const FSlateBrush* UCreditsDecorator::FindImageBrush(int32 id) {
-  if (CreditsWidget->_creditImages.Num() > id) {
-    return CreditsWidget->_creditImages[id];
-  }
-  return nullptr;
+const FSlateBrush* UCreditsDecorator::FindImageBrush(const FString& id) {
+  FSlateBrush* const* ppBrush = CreditsWidget->_creditImages.Find(id);
+  return ppBrush ? *ppBrush : nullptr;
 }
 
 UScreenCreditsWidget::UScreenCreditsWidget(
@@ -166,9 +205,9 @@ UScreenCreditsWidget::UScreenCreditsWidget(
 }
 
 UScreenCreditsWidget::~UScreenCreditsWidget() {
-  for (int i = 0; i < _creditImages.Num(); i++) {
-    if (_creditImages[i]) {
-      delete _creditImages[i];
+  for (const TPair<FString, FSlateBrush*>& image : _creditImages) {
+    if (image.Value) {
+      delete image.Value;
     }
   }
 }
@@ -211,20 +250,64 @@ void UScreenCreditsWidget::HandleImageRequest(
     FHttpRequestPtr HttpRequest,
     FHttpResponsePtr HttpResponse,
     bool bSucceeded,
-    int32 id) {
-  UTexture2D* texture = nullptr;
+    FString Key) {
   if (bSucceeded && HttpResponse.IsValid() &&
-      HttpResponse->GetContentLength() > 0 &&
-      (texture = FImageUtils::ImportBufferAsTexture2D(
-           HttpResponse->GetContent())) != nullptr) {
-    texture->SRGB = true;
-    texture->UpdateResource();
-    _textures.Add(texture);
-    FTexturePlatformData* pPlatformData = texture->GetPlatformData();
-    int32 SizeX = pPlatformData->SizeX;
-    int32 SizeY = pPlatformData->SizeY;
-    _creditImages[id] = new FSlateImageBrush(texture, FVector2D(SizeX, SizeY));
+      HttpResponse->GetContentLength() > 0) {
+    DecodeImageInBackground(Key, FString(), HttpResponse->GetContent());
+  } else {
+    AddImage(Key, 0, 0, TArray64<uint8>());
+  }
+}
+
+void UScreenCreditsWidget::DecodeImageInBackground(
+    const FString& Key,
+    FString Base64,
+    TArray<uint8> Data) {
+  // Decoding can take a few milliseconds for large logos, so only the texture
+  // is created on the game thread.
+  IImageWrapperModule* pImageWrapperModule =
+      &FModuleManager::LoadModuleChecked<IImageWrapperModule>(
+          FName("ImageWrapper"));
+
+  getAsyncSystem()
+      .runInWorkerThread([pImageWrapperModule,
+                          Base64 = MoveTemp(Base64),
+                          Data = MoveTemp(Data)]() mutable {
+        if (!Base64.IsEmpty() && !FBase64::Decode(Base64, Data)) {
+          return DecodedImage();
+        }
+        return decodeImage(*pImageWrapperModule, Data);
+      })
+      .thenInMainThread([pThis = TWeakObjectPtr<UScreenCreditsWidget>(this),
+                         Key](DecodedImage&& image) {
+        if (pThis.IsValid()) {
+          pThis->AddImage(Key, image.width, image.height, image.pixels);
+        }
+      });
+}
+
+void UScreenCreditsWidget::AddImage(
+    const FString& Key,
+    int32 Width,
+    int32 Height,
+    const TArray64<uint8>& Pixels) {
+  if (Width > 0 && Height > 0 && Pixels.Num() == int64(Width) * Height * 4) {
+    UTexture2D* texture = UTexture2D::CreateTransient(Width, Height);
+    if (texture) {
+      FTexture2DMipMap& mip = texture->GetPlatformData()->Mips[0];
+      void* pData = mip.BulkData.Lock(LOCK_READ_WRITE);
+      FMemory::Memcpy(pData, Pixels.GetData(), Pixels.Num());
+      mip.BulkData.Unlock();
+
+      texture->SRGB = true;
+      texture->UpdateResource();
+      _textures.Add(texture);
+      _creditImages.Add(
+          Key,
+          new FSlateImageBrush(texture, FVector2D(Width, Height)));
+    }
   }
+
   // Only update credits after all of the images are done loading.
   --_numImagesLoading;
   if (_numImagesLoading == 0) {
@@ -232,37 +315,42 @@ void UScreenCreditsWidget::HandleImageRequest(
   }
 }
 
+/*static*/ std::string
+UScreenCreditsWidget::GetImageKey(const std::string& url) {
+  return std::to_string(CityHash64(url.data(), uint32(url.size())));
+}
+
 std::string UScreenCreditsWidget::LoadImage(const std::string& url) {
+  const std::string key = GetImageKey(url);
+  const FString Key = UTF8_TO_TCHAR(key.c_str());
+  if (_creditImages.Contains(Key)) {
+    // Already loaded or loading.
+    return key;
+  }
+
+  _creditImages.Add(Key, nullptr);
+  ++_numImagesLoading;
+
   const std::string base64Prefix = "data:image/png;base64,";
   if (url.rfind(base64Prefix, 0) == 0) {
-    TArray<uint8> dataBuffer;
-    FString base64 = UTF8_TO_TCHAR(url.c_str() + base64Prefix.length());
-    if (FBase64::Decode(base64, dataBuffer)) {
-      UTexture2D* texture = FImageUtils::ImportBufferAsTexture2D(dataBuffer);
-      texture->SRGB = true;
-      texture->UpdateResource();
-      _textures.Add(texture);
-      FTexturePlatformData* pPlatformData = texture->GetPlatformData();
-      int32 SizeX = pPlatformData->SizeX;
-      int32 SizeY = pPlatformData->SizeY;
-      _creditImages.Add(new FSlateImageBrush(texture, FVector2D(SizeX, SizeY)));
-    }
+    DecodeImageInBackground(
+        Key,
+        UTF8_TO_TCHAR(url.c_str() + base64Prefix.length()),
+        TArray<uint8>());
   } else {
-    ++_numImagesLoading;
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest =
         FHttpModule::Get().CreateRequest();
 
-    _creditImages.AddDefaulted();
     HttpRequest->OnProcessRequestComplete().BindUObject(
         this,
         &UScreenCreditsWidget::HandleImageRequest,
-        _creditImages.Num() - 1);
+        Key);
 
     HttpRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
     HttpRequest->SetVerb(TEXT("GET"));
     HttpRequest->ProcessRequest();
   }
-  return std::to_string(_creditImages.Num() - 1);
+  return key;
 }
 
 void UScreenCreditsWidget::SetCredits(
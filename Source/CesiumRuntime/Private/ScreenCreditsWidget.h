@@ -17,8 +17,16 @@ class UScreenCreditsWidget : public UUserWidget {
   GENERATED_BODY()
 public:
   /**
-   * Attempts to load an image from the given URL and returns the name of the
-   * image to be referenced in RTF.
+   * Gets the name by which an image with the given URL is referenced in RTF.
+   * May be called from any thread.
+   */
+  static std::string GetImageKey(const std::string& url);
+
+  /**
+   * Starts loading an image from the given URL, unless it is already loaded
+   * or loading, and returns the name of the image to be referenced in RTF.
+   * The image is downloaded and decoded in the background, and the credits
+   * aren't updated until it is ready.
    */
   std::string LoadImage(const std::string& url);
 
@@ -35,7 +43,18 @@ private:
       FHttpRequestPtr HttpRequest,
       FHttpResponsePtr HttpResponse,
       bool bSucceeded,
-      int32 id);
+      FString Key);
+
+  void DecodeImageInBackground(
+      const FString& Key,
+      FString Base64,
+      TArray<uint8> Data);
+
+  void AddImage(
+      const FString& Key,
+      int32 Width,
+      int32 Height,
+      const TArray64<uint8>& Pixels);
 
   UPROPERTY(meta = (BindWidget))
   class URichTextBlock* RichTextOnScreen;
@@ -56,7 +75,7 @@ private:
   class UCreditsDecorator* _decoratorPopup;
   int32 _numImagesLoading;
   FSlateFontInfo _font;
-  TArray<FSlateBrush*> _creditImages;
+  TMap<FString, FSlateBrush*> _creditImages;
   friend class UCreditsDecorator;
 };
 
@@ -70,7 +89,7 @@ public:
   virtual TSharedPtr<ITextDecorator>
   CreateDecorator(URichTextBlock* InOwner) override;
 
-  virtual const FSlateBrush* FindImageBrush(int32 id);
+  virtual const FSlateBrush* FindImageBrush(const FString& id);
 
   UScreenCreditsWidget* CreditsWidget;
   FOnPopupClicked PopupClicked;
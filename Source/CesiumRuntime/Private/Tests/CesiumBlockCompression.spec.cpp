@@ -0,0 +1,294 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumBlockCompression.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumTextureUtility.h"
+#include "Misc/AutomationTest.h"
+#include <array>
+
+using namespace CesiumBlockCompression;
+using namespace CesiumGltf;
+
+namespace {
+
+using Block = std::array<uint8, 64>;
+
+Block createBlock(const TFunction<FColor(int32 x, int32 y)>& color) {
+  Block pixels;
+  for (int32 y = 0; y < 4; ++y) {
+    for (int32 x = 0; x < 4; ++x) {
+      const FColor pixel = color(x, y);
+      uint8* pPixel = &pixels[(y * 4 + x) * 4];
+      pPixel[0] = pixel.R;
+      pPixel[1] = pixel.G;
+      pPixel[2] = pixel.B;
+      pPixel[3] = pixel.A;
+    }
+  }
+  return pixels;
+}
+
+void decode565(uint16 color, int32* pRgb) {
+  const int32 r = (color >> 11) & 31;
+  const int32 g = (color >> 5) & 63;
+  const int32 b = color & 31;
+  pRgb[0] = (r << 3) | (r >> 2);
+  pRgb[1] = (g << 2) | (g >> 4);
+  pRgb[2] = (b << 3) | (b >> 2);
+}
+
+// Decodes a BC1 block in four-color mode and computes its total squared error
+// against the original pixels.
+int64 computeBC1Error(const Block& pixels, const uint8* pBlock) {
+  const uint16 color0 = uint16(pBlock[0] | (pBlock[1] << 8));
+  const uint16 color1 = uint16(pBlock[2] | (pBlock[3] << 8));
+  const uint32 indices = uint32(pBlock[4]) | (uint32(pBlock[5]) << 8) |
+                         (uint32(pBlock[6]) << 16) |
+                         (uint32(pBlock[7]) << 24);
+
+  int32 palette[4][3];
+  decode565(color0, palette[0]);
+  decode565(color1, palette[1]);
+  for (int32 channel = 0; channel < 3; ++channel) {
+    palette[2][channel] =
+        (2 * palette[0][channel] + palette[1][channel]) / 3;
+    palette[3][channel] =
+        (palette[0][channel] + 2 * palette[1][channel]) / 3;
+  }
+
+  int64 error = 0;
+  for (int32 i = 0; i < 16; ++i) {
+    const int32* pColor = palette[(indices >> (2 * i)) & 3];
+    for (int32 channel = 0; channel < 3; ++channel) {
+      const int32 difference = int32(pixels[i * 4 + channel]) - pColor[channel];
+      error += difference * difference;
+    }
+  }
+  return error;
+}
+
+ImageCesium createImage(int32 size, uint8 alpha) {
+  ImageCesium image;
+  image.width = size;
+  image.height = size;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(size * size * 4));
+  for (int32 i = 0; i < size * size; ++i) {
+    image.pixelData[i * 4 + 0] = std::byte(i % 256);
+    image.pixelData[i * 4 + 1] = std::byte((i * 7) % 256);
+    image.pixelData[i * 4 + 2] = std::byte(255 - i % 256);
+    image.pixelData[i * 4 + 3] = std::byte(alpha);
+  }
+  return image;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumBlockCompressionSpec,
+    "Cesium.Unit.BlockCompression",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumBlockCompressionSpec)
+
+void FCesiumBlockCompressionSpec::Define() {
+  Describe("compressBC1Block", [this]() {
+    It("encodes a solid color exactly", [this]() {
+      const Block pixels =
+          createBlock([](int32, int32) { return FColor(255, 0, 0, 255); });
+      uint8 block[BC1BlockBytes];
+      compressBC1Block(pixels.data(), block, ECesiumTextureCompression::Fast);
+
+      const uint8 expected[BC1BlockBytes] =
+          {0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00};
+      TestTrue("block", FMemory::Memcmp(block, expected, BC1BlockBytes) == 0);
+    });
+
+    It("matches the reference block for two colors", [this]() {
+      const Block pixels = createBlock([](int32, int32 y) {
+        return y < 2 ? FColor::White : FColor::Black;
+      });
+      const uint8 expected[BC1BlockBytes] =
+          {0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x55, 0x55};
+
+      uint8 block[BC1BlockBytes];
+      compressBC1Block(pixels.data(), block, ECesiumTextureCompression::Fast);
+      TestTrue("fast", FMemory::Memcmp(block, expected, BC1BlockBytes) == 0);
+
+      compressBC1Block(
+          pixels.data(),
+          block,
+          ECesiumTextureCompression::HighQuality);
+      TestTrue(
+          "high quality",
+          FMemory::Memcmp(block, expected, BC1BlockBytes) == 0);
+    });
+
+    It("fits diagonal gradients better in high quality", [this]() {
+      // Green decreases while red and blue increase, so the corners of the
+      // bounding box aren't on the gradient.
+      const Block pixels = createBlock([](int32 x, int32 y) {
+        const int32 t = x + y;
+        return FColor(
+            uint8(40 + t * 25),
+            uint8(200 - t * 20),
+            uint8(60 + t * 15),
+            255);
+      });
+
+      uint8 fast[BC1BlockBytes];
+      compressBC1Block(pixels.data(), fast, ECesiumTextureCompression::Fast);
+      uint8 highQuality[BC1BlockBytes];
+      compressBC1Block(
+          pixels.data(),
+          highQuality,
+          ECesiumTextureCompression::HighQuality);
+
+      const int64 fastError = computeBC1Error(pixels, fast);
+      const int64 highQualityError = computeBC1Error(pixels, highQuality);
+      TestTrue("better", highQualityError < fastError);
+      // An average error of less than 16 per channel.
+      TestTrue("close", highQualityError < 16 * 16 * 16 * 3);
+    });
+  });
+
+  Describe("compressBC3Block", [this]() {
+    It("matches the reference alpha block", [this]() {
+      const Block pixels = createBlock([](int32, int32 y) {
+        return FColor(255, 255, 255, y < 2 ? 255 : 0);
+      });
+      uint8 block[BC3BlockBytes];
+      compressBC3Block(pixels.data(), block, ECesiumTextureCompression::Fast);
+
+      const uint8 expected[8] =
+          {0xFF, 0x00, 0x00, 0x00, 0x00, 0x49, 0x92, 0x24};
+      TestTrue("alpha", FMemory::Memcmp(block, expected, 8) == 0);
+
+      const uint8 expectedColor[BC1BlockBytes] =
+          {0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00};
+      TestTrue(
+          "color",
+          FMemory::Memcmp(block + 8, expectedColor, BC1BlockBytes) == 0);
+    });
+  });
+
+  Describe("compressImage", [this]() {
+    It("compresses opaque images and their mips to BC1", [this]() {
+      ImageCesium image = createImage(8, 255);
+      CesiumGltfReader::GltfReader::generateMipMaps(image);
+      TestEqual("mips", int32(image.mipPositions.size()), 4);
+
+      std::optional<ImageCesium> compressed =
+          compressImage(image, ECesiumTextureCompression::Fast);
+      if (!TestTrue("compressed", compressed.has_value())) {
+        return;
+      }
+      TestTrue(
+          "format",
+          compressed->compressedPixelFormat ==
+              GpuCompressedPixelFormat::BC1_RGB);
+      // 8x8 is four blocks, and every smaller mip is one block.
+      TestEqual(
+          "size",
+          int32(compressed->pixelData.size()),
+          (4 + 1 + 1 + 1) * 8);
+      TestEqual("mips", int32(compressed->mipPositions.size()), 4);
+      TestEqual(
+          "mip 1 offset",
+          int32(compressed->mipPositions[1].byteOffset),
+          32);
+      TestEqual("mip 3 size", int32(compressed->mipPositions[3].byteSize), 8);
+      TestEqual("width", compressed->width, 8);
+    });
+
+    It("compresses translucent images to BC3", [this]() {
+      ImageCesium image = createImage(8, 128);
+      std::optional<ImageCesium> compressed =
+          compressImage(image, ECesiumTextureCompression::HighQuality);
+      if (!TestTrue("compressed", compressed.has_value())) {
+        return;
+      }
+      TestTrue(
+          "format",
+          compressed->compressedPixelFormat ==
+              GpuCompressedPixelFormat::BC3_RGBA);
+      TestEqual("size", int32(compressed->pixelData.size()), 4 * 16);
+      TestTrue("no mips", compressed->mipPositions.empty());
+    });
+
+    It("leaves the source image unchanged", [this]() {
+      const ImageCesium image = createImage(8, 255);
+      const std::vector<std::byte> pixels = image.pixelData;
+
+      TestTrue(
+          "compressed",
+          compressImage(image, ECesiumTextureCompression::Fast).has_value());
+      TestTrue(
+          "format",
+          image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+      TestTrue("pixels", image.pixelData == pixels);
+    });
+
+    It("leaves images it can't compress unchanged", [this]() {
+      ImageCesium image = createImage(6, 255);
+      TestFalse(
+          "unaligned size",
+          compressImage(image, ECesiumTextureCompression::Fast).has_value());
+      TestEqual("size", int32(image.pixelData.size()), 6 * 6 * 4);
+
+      ImageCesium uncompressed = createImage(8, 255);
+      TestFalse(
+          "none",
+          compressImage(uncompressed, ECesiumTextureCompression::None)
+              .has_value());
+    });
+  });
+
+  Describe("loadTextureAnyThreadPart", [this]() {
+    It("doesn't compress an image shared with a normal map", [this]() {
+      Model model;
+      model.images.emplace_back().cesium = createImage(8, 255);
+      model.textures.emplace_back().source = 0;
+      model.textures.emplace_back().source = 0;
+
+      TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pBaseColor =
+          CesiumTextureUtility::loadTextureAnyThreadPart(
+              model,
+              model.textures[0],
+              true,
+              ECesiumTextureCompression::Fast);
+      TUniquePtr<CesiumTextureUtility::LoadedTextureResult> pNormal =
+          CesiumTextureUtility::loadTextureAnyThreadPart(
+              model,
+              model.textures[1],
+              false);
+      if (!TestNotNull("base color", pBaseColor.Get()) ||
+          !TestNotNull("normal", pNormal.Get())) {
+        return;
+      }
+
+      const ImageCesium& image = model.images[0].cesium;
+      TestTrue(
+          "image format",
+          image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+      TestEqual("image size", int32(image.pixelData.size()), 8 * 8 * 4);
+
+      TestFalse("normal compressed", pNormal->compressedOnLoad);
+      TestTrue(
+          "normal format",
+          pNormal->pTextureData->PixelFormat == PF_R8G8B8A8);
+
+      // Platforms without BC support upload every texture uncompressed.
+      if (GPixelFormats[PF_DXT1].Supported &&
+          GPixelFormats[PF_DXT5].Supported) {
+        TestTrue("base color compressed", pBaseColor->compressedOnLoad);
+        TestTrue(
+            "base color format",
+            pBaseColor->pTextureData->PixelFormat == PF_DXT1);
+      }
+    });
+  });
+}
@@ -0,0 +1,197 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "Async/ParallelFor.h"
+#include "CesiumBufferedCacheDatabase.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+
+using namespace CesiumAsync;
+
+namespace {
+
+// Stands in for the Sqlite cache, which serializes writes and takes a while
+// to commit each one.
+class SlowCacheDatabase : public ICacheDatabase {
+public:
+  explicit SlowCacheDatabase(float secondsPerWrite)
+      : _secondsPerWrite(secondsPerWrite) {}
+
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    if (this->_secondsPerWrite > 0.0f) {
+      FPlatformProcess::Sleep(this->_secondsPerWrite);
+    }
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(HttpHeaders(requestHeaders), requestMethod, url),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    this->items.clear();
+    return true;
+  }
+
+  size_t size() const {
+    std::scoped_lock<std::mutex> lock(this->mutex);
+    return this->items.size();
+  }
+
+  mutable std::mutex mutex;
+  std::map<std::string, CacheItem> items;
+
+private:
+  float _secondsPerWrite;
+};
+
+void store(ICacheDatabase& cache, const std::string& key, size_t size) {
+  std::vector<std::byte> data(size, std::byte(7));
+  cache.storeEntry(key, 0, key, "GET", {}, 200, {}, data);
+}
+
+// Stores responses from many threads at once and returns the total time the
+// threads spent waiting in storeEntry.
+double measureStoreStallSeconds(ICacheDatabase& cache, int32 count) {
+  std::atomic<int64> stallCycles{0};
+  ParallelFor(count, [&cache, &stallCycles](int32 i) {
+    const uint64 start = FPlatformTime::Cycles64();
+    store(cache, "tile" + std::to_string(i), 4096);
+    stallCycles += int64(FPlatformTime::Cycles64() - start);
+  });
+  return FPlatformTime::ToSeconds64(uint64(stallCycles.load()));
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumBufferedCacheDatabaseSpec,
+    "Cesium.Unit.BufferedCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumBufferedCacheDatabaseSpec)
+
+void FCesiumBufferedCacheDatabaseSpec::Define() {
+  It("writes buffered responses on flush", [this]() {
+    auto pDisk = std::make_shared<SlowCacheDatabase>(0.0f);
+    CesiumBufferedCacheDatabase cache(pDisk, 1024 * 1024);
+
+    for (int32 i = 0; i < 100; ++i) {
+      store(cache, "tile" + std::to_string(i), 1000);
+    }
+    cache.flush();
+
+    TestEqual("written", int32(pDisk->size()), 100);
+
+    CesiumCacheStatistics statistics;
+    cache.addStatistics(statistics);
+    TestEqual("pending", statistics.pendingWrites, int64(0));
+    TestEqual("pending bytes", statistics.pendingWriteBytes, int64(0));
+    TestTrue("batches", statistics.writeBatches >= 1);
+  });
+
+  It("reads responses that have not been written yet", [this]() {
+    auto pDisk = std::make_shared<SlowCacheDatabase>(0.05f);
+    CesiumBufferedCacheDatabase cache(pDisk, 1024 * 1024);
+
+    store(cache, "first", 10);
+    store(cache, "second", 20);
+
+    std::optional<CacheItem> item = cache.getEntry("second");
+    TestTrue("found", item.has_value());
+    TestEqual("size", int32(item->cacheResponse.data.size()), 20);
+  });
+
+  It("skips responses that don't fit in the buffer", [this]() {
+    auto pDisk = std::make_shared<SlowCacheDatabase>(0.05f);
+    CesiumBufferedCacheDatabase cache(pDisk, 1000);
+
+    store(cache, "fits", 600);
+    store(cache, "too large", 600);
+    cache.flush();
+
+    CesiumCacheStatistics statistics;
+    cache.addStatistics(statistics);
+    TestEqual("dropped", statistics.droppedWrites, int64(1));
+    TestTrue("fits", pDisk->items.count("fits") == 1);
+  });
+
+  It("doesn't write buffered responses after clearing", [this]() {
+    auto pDisk = std::make_shared<SlowCacheDatabase>(0.01f);
+    CesiumBufferedCacheDatabase cache(pDisk, 1024 * 1024);
+
+    for (int32 i = 0; i < 20; ++i) {
+      store(cache, "tile" + std::to_string(i), 100);
+    }
+    cache.clearAll();
+    cache.flush();
+
+    TestEqual("written", int32(pDisk->size()), 0);
+    TestFalse("found", cache.getEntry("tile19").has_value());
+  });
+
+  It("writes everything and then writes directly after shutdown", [this]() {
+    auto pDisk = std::make_shared<SlowCacheDatabase>(0.0f);
+    CesiumBufferedCacheDatabase cache(pDisk, 1024 * 1024);
+
+    store(cache, "before", 100);
+    cache.shutdown();
+    TestTrue("before", pDisk->items.count("before") == 1);
+
+    store(cache, "after", 100);
+    TestTrue("after", pDisk->items.count("after") == 1);
+  });
+
+  It("keeps worker threads from waiting for the disk", [this]() {
+    const int32 count = 200;
+
+    auto pDirectDisk = std::make_shared<SlowCacheDatabase>(0.002f);
+    const double directStall = measureStoreStallSeconds(*pDirectDisk, count);
+
+    auto pBufferedDisk = std::make_shared<SlowCacheDatabase>(0.002f);
+    CesiumBufferedCacheDatabase cache(pBufferedDisk, 64 * 1024 * 1024);
+    const double bufferedStall = measureStoreStallSeconds(cache, count);
+    cache.flush();
+
+    AddInfo(FString::Printf(
+        TEXT("Time spent storing %d responses: %.3fs direct, %.3fs buffered"),
+        count,
+        directStall,
+        bufferedStall));
+
+    TestEqual("written", int32(pBufferedDisk->size()), count);
+    TestTrue("less stall", bufferedStall < directStall * 0.25);
+  });
+}
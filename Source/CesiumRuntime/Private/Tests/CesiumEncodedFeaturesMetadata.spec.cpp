@@ -0,0 +1,373 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPropertyTable.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using namespace CesiumEncodedFeaturesMetadata;
+
+namespace {
+
+FCesiumFeaturesMetadataDescription createDescription() {
+  FCesiumFeaturesMetadataDescription description;
+
+  FCesiumFeatureIdSetDescription& buildings =
+      description.Features.FeatureIdSets.Emplace_GetRef();
+  buildings.Name = "buildings";
+  buildings.Type = ECesiumFeatureIdSetType::Attribute;
+  buildings.PropertyTableName = "houses";
+
+  FCesiumFeatureIdSetDescription& trees =
+      description.Features.FeatureIdSets.Emplace_GetRef();
+  trees.Name = "trees";
+  trees.Type = ECesiumFeatureIdSetType::Texture;
+
+  FCesiumPropertyTableDescription& houses =
+      description.ModelMetadata.PropertyTables.Emplace_GetRef();
+  houses.Name = "houses";
+  houses.Properties.Emplace_GetRef().Name = "roofColor";
+  houses.Properties.Emplace_GetRef().Name = "height";
+  houses.Properties.Emplace_GetRef().Name = "year built";
+
+  FCesiumPropertyTableDescription& roads =
+      description.ModelMetadata.PropertyTables.Emplace_GetRef();
+  roads.Name = "roads";
+  roads.Properties.Emplace_GetRef().Name = "lanes";
+
+  FCesiumPropertyTextureDescription& climate =
+      description.ModelMetadata.PropertyTextures.Emplace_GetRef();
+  climate.Name = "climate";
+  climate.Properties.Emplace_GetRef().Name = "temperature";
+  climate.Properties.Emplace_GetRef().Name = "humidity";
+  description.PrimitiveMetadata.PropertyTextureNames.Add("climate");
+
+  return description;
+}
+
+CesiumGltf::ImageCesium createGradientImage(int32 width, int32 height) {
+  CesiumGltf::ImageCesium image;
+  image.width = width;
+  image.height = height;
+  image.channels = 2;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height * 2));
+  for (int32 y = 0; y < height; ++y) {
+    for (int32 x = 0; x < width; ++x) {
+      const size_t texel = size_t(y * width + x) * 2;
+      image.pixelData[texel] = std::byte((x * 255) / (width - 1));
+      image.pixelData[texel + 1] = std::byte((y * 7) % 256);
+    }
+  }
+  return image;
+}
+
+int32 getByte(
+    const CesiumGltf::ImageCesium& image,
+    int32 x,
+    int32 y,
+    int32 channel) {
+  const size_t index = size_t((y * image.width + x) * image.channels + channel);
+  return int32(image.pixelData[index]);
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumEncodedFeaturesMetadataSpec,
+    "Cesium.Unit.EncodedFeaturesMetadata",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumEncodedFeaturesMetadataSpec)
+
+void FCesiumEncodedFeaturesMetadataSpec::Define() {
+  Describe("filterFeaturesMetadataDescription", [this]() {
+    It("removes everything when no parameters are referenced", [this]() {
+      FCesiumFeaturesMetadataDescription filtered =
+          filterFeaturesMetadataDescription(
+              createDescription(),
+              TSet<FString>{"BaseColorFactor", "Texture"});
+
+      TestEqual("feature ID sets", filtered.Features.FeatureIdSets.Num(), 0);
+      TestEqual(
+          "property tables",
+          filtered.ModelMetadata.PropertyTables.Num(),
+          0);
+      TestEqual(
+          "property textures",
+          filtered.ModelMetadata.PropertyTextures.Num(),
+          0);
+      TestEqual(
+          "property texture names",
+          filtered.PrimitiveMetadata.PropertyTextureNames.Num(),
+          0);
+    });
+
+    It("keeps only the referenced property table properties", [this]() {
+      FCesiumFeaturesMetadataDescription filtered =
+          filterFeaturesMetadataDescription(
+              createDescription(),
+              TSet<FString>{
+                  "PTABLE_houses_roofColor",
+                  "PTABLE_houses_year_built_SCALE"});
+
+      TestEqual(
+          "property tables",
+          filtered.ModelMetadata.PropertyTables.Num(),
+          1);
+      const FCesiumPropertyTableDescription& houses =
+          filtered.ModelMetadata.PropertyTables[0];
+      TestEqual("name", houses.Name, FString("houses"));
+      TestEqual("properties", houses.Properties.Num(), 2);
+      TestEqual("first", houses.Properties[0].Name, FString("roofColor"));
+      TestEqual("second", houses.Properties[1].Name, FString("year built"));
+    });
+
+    It("keeps feature ID sets that index referenced property tables",
+       [this]() {
+         FCesiumFeaturesMetadataDescription filtered =
+             filterFeaturesMetadataDescription(
+                 createDescription(),
+                 TSet<FString>{"PTABLE_houses_height"});
+
+         TestEqual(
+             "feature ID sets",
+             filtered.Features.FeatureIdSets.Num(),
+             1);
+         TestEqual(
+             "name",
+             filtered.Features.FeatureIdSets[0].Name,
+             FString("buildings"));
+       });
+
+    It("keeps feature ID sets with referenced parameters", [this]() {
+      FCesiumFeaturesMetadataDescription filtered =
+          filterFeaturesMetadataDescription(
+              createDescription(),
+              TSet<FString>{"trees_TX"});
+
+      TestEqual("feature ID sets", filtered.Features.FeatureIdSets.Num(), 1);
+      TestEqual(
+          "name",
+          filtered.Features.FeatureIdSets[0].Name,
+          FString("trees"));
+    });
+
+    It("keeps referenced property textures and their names", [this]() {
+      FCesiumFeaturesMetadataDescription filtered =
+          filterFeaturesMetadataDescription(
+              createDescription(),
+              TSet<FString>{"PTEXTURE_climate_humidity_CHANNELS"});
+
+      TestEqual(
+          "property textures",
+          filtered.ModelMetadata.PropertyTextures.Num(),
+          1);
+      const FCesiumPropertyTextureDescription& climate =
+          filtered.ModelMetadata.PropertyTextures[0];
+      TestEqual("properties", climate.Properties.Num(), 1);
+      TestEqual("property", climate.Properties[0].Name, FString("humidity"));
+      TestTrue(
+          "property texture name",
+          filtered.PrimitiveMetadata.PropertyTextureNames.Contains("climate"));
+    });
+  });
+
+  Describe("encodePropertyTableAnyThreadPart", [this]() {
+    It("doesn't quantize colors parsed from strings", [this]() {
+      CesiumGltf::Model model;
+      CesiumGltf::ExtensionModelExtStructuralMetadata& metadata =
+          model.addExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+      CesiumGltf::PropertyTable& propertyTable =
+          metadata.propertyTables.emplace_back();
+      propertyTable.classProperty = "houses";
+      propertyTable.count = 4;
+      AddStringPropertyTablePropertyToModel(
+          model,
+          propertyTable,
+          "roofColor",
+          {"#ff0000", "rgb(0, 255, 0)", "#0000ff", "#ffffff"});
+
+      FCesiumPropertyTableDescription description;
+      description.Name = "houses";
+      FCesiumPropertyTablePropertyDescription& property =
+          description.Properties.Emplace_GetRef();
+      property.Name = "roofColor";
+      property.PropertyDetails = FCesiumMetadataPropertyDetails(
+          ECesiumMetadataType::String,
+          ECesiumMetadataComponentType::None,
+          false);
+      property.EncodingDetails = FCesiumMetadataEncodingDetails(
+          ECesiumEncodedMetadataType::Vec3,
+          ECesiumEncodedMetadataComponentType::Float,
+          ECesiumEncodedMetadataConversion::ParseColorFromString);
+      property.EncodingDetails.bQuantize = true;
+      TestFalse("quantized", property.EncodingDetails.IsQuantized());
+
+      EncodedPropertyTable encoded = encodePropertyTableAnyThreadPart(
+          description,
+          FCesiumPropertyTable(model, propertyTable));
+      if (!TestEqual("properties", encoded.properties.Num(), 1) ||
+          !TestTrue(
+              "texture",
+              encoded.properties[0].pTexture &&
+                  encoded.properties[0].pTexture->pTextureData)) {
+        return;
+      }
+
+      const EncodedPropertyTableProperty& encodedProperty =
+          encoded.properties[0];
+      TestFalse("quantization", encodedProperty.quantization.has_value());
+
+      FTexturePlatformData& textureData =
+          *encodedProperty.pTexture->pTextureData;
+      TestTrue("format", textureData.PixelFormat == PF_A32B32G32R32F);
+
+      // Float colors are encoded backwards, as ABGR.
+      FByteBulkData& bulkData = textureData.Mips[0].BulkData;
+      if (!TestEqual("size", int32(bulkData.GetBulkDataSize()), 4 * 16)) {
+        return;
+      }
+      const float* pTexels =
+          static_cast<const float*>(bulkData.Lock(LOCK_READ_ONLY));
+      TestEqual("red", pTexels[3], 255.0f);
+      TestEqual("red green", pTexels[2], 0.0f);
+      TestEqual("green", pTexels[4 + 2], 255.0f);
+      TestEqual("blue", pTexels[8 + 1], 255.0f);
+      TestEqual("white", pTexels[12 + 3], 255.0f);
+      bulkData.Unlock();
+    });
+  });
+
+  Describe("quantizeTo16Bits", [this]() {
+    It("round-trips values within half a quantization step", [this]() {
+      FRandomStream random(7);
+      std::vector<float> values(4096);
+      for (float& value : values) {
+        value = random.FRandRange(-1000.0f, 2500.0f);
+      }
+
+      std::vector<uint16> quantized(values.size());
+      const QuantizationTransform transform =
+          quantizeTo16Bits(values, quantized, 1, 1);
+
+      const double range = 3500.0;
+      TestTrue("scale", transform.scale <= range / 65535.0);
+
+      double maximumError = 0.0;
+      for (size_t i = 0; i < values.size(); ++i) {
+        const double value = quantized[i] * transform.scale + transform.offset;
+        maximumError = FMath::Max(maximumError, FMath::Abs(value - values[i]));
+      }
+      TestTrue("error", maximumError <= 0.5 * transform.scale + 1e-3);
+    });
+
+    It("only quantizes the used components of each texel", [this]() {
+      // Two vec3 values with a stride of four, whose unused components would
+      // widen the range if they were quantized.
+      std::vector<float> values{10.0f, 11.0f, 12.0f, -500.0f,
+                                13.0f, 14.0f, 20.0f, 500.0f};
+      std::vector<uint16> quantized(values.size(), 1);
+      const QuantizationTransform transform =
+          quantizeTo16Bits(values, quantized, 3, 4);
+
+      TestEqual("offset", transform.offset, 10.0);
+      TestEqual("scale", transform.scale, 10.0 / 65535.0);
+      TestEqual("first", int32(quantized[0]), 0);
+      TestEqual("largest", int32(quantized[6]), 65535);
+      TestEqual("unused", int32(quantized[3]), 0);
+      TestEqual("unused", int32(quantized[7]), 0);
+    });
+
+    It("handles constant and non-finite values", [this]() {
+      std::vector<float> values{
+          3.0f,
+          std::numeric_limits<float>::quiet_NaN(),
+          3.0f,
+          std::numeric_limits<float>::infinity()};
+      std::vector<uint16> quantized(values.size(), 1);
+      const QuantizationTransform transform =
+          quantizeTo16Bits(values, quantized, 1, 1);
+
+      TestEqual("offset", transform.offset, 3.0);
+      TestEqual("scale", transform.scale, 0.0);
+      for (size_t i = 0; i < quantized.size(); ++i) {
+        TestEqual("quantized", int32(quantized[i]), 0);
+      }
+    });
+  });
+
+  Describe("downsampleImage", [this]() {
+    It("divides the size of the image, rounding up", [this]() {
+      const CesiumGltf::ImageCesium image = createGradientImage(17, 9);
+      const CesiumGltf::ImageCesium downsampled = downsampleImage(
+          image,
+          4,
+          ECesiumEncodedMetadataDownsampleFilter::Nearest);
+
+      TestEqual("width", downsampled.width, 5);
+      TestEqual("height", downsampled.height, 3);
+      TestEqual("channels", downsampled.channels, 2);
+      TestEqual("size", int32(downsampled.pixelData.size()), 5 * 3 * 2);
+    });
+
+    It("keeps source texels with Nearest", [this]() {
+      const CesiumGltf::ImageCesium image = createGradientImage(16, 16);
+      const CesiumGltf::ImageCesium downsampled = downsampleImage(
+          image,
+          4,
+          ECesiumEncodedMetadataDownsampleFilter::Nearest);
+
+      for (int32 y = 0; y < downsampled.height; ++y) {
+        for (int32 x = 0; x < downsampled.width; ++x) {
+          for (int32 c = 0; c < 2; ++c) {
+            TestEqual(
+                "texel",
+                getByte(downsampled, x, y, c),
+                getByte(image, x * 4 + 1, y * 4 + 1, c));
+          }
+        }
+      }
+    });
+
+    It("stays within the range of each block with Average", [this]() {
+      const int32 factor = 3;
+      const CesiumGltf::ImageCesium image = createGradientImage(20, 11);
+      const CesiumGltf::ImageCesium downsampled = downsampleImage(
+          image,
+          factor,
+          ECesiumEncodedMetadataDownsampleFilter::Average);
+
+      for (int32 y = 0; y < downsampled.height; ++y) {
+        for (int32 x = 0; x < downsampled.width; ++x) {
+          for (int32 c = 0; c < 2; ++c) {
+            int32 minimum = 255;
+            int32 maximum = 0;
+            int32 sum = 0;
+            int32 count = 0;
+            for (int32 sourceY = y * factor;
+                 sourceY < FMath::Min((y + 1) * factor, image.height);
+                 ++sourceY) {
+              for (int32 sourceX = x * factor;
+                   sourceX < FMath::Min((x + 1) * factor, image.width);
+                   ++sourceX) {
+                const int32 value = getByte(image, sourceX, sourceY, c);
+                minimum = FMath::Min(minimum, value);
+                maximum = FMath::Max(maximum, value);
+                sum += value;
+                ++count;
+              }
+            }
+
+            const int32 value = getByte(downsampled, x, y, c);
+            TestTrue("within block", value >= minimum && value <= maximum);
+            TestTrue("average", FMath::Abs(value - double(sum) / count) <= 0.5);
+          }
+        }
+      }
+    });
+  });
+}
@@ -0,0 +1,198 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedPropertyTableCache.h"
+#include "CesiumFeaturesMetadataComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumEncodedFeaturesMetadata;
+using namespace CesiumGltf;
+
+namespace {
+
+Model createModel(const std::vector<int32_t>& values) {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "buildings";
+  propertyTable.count = static_cast<int64_t>(values.size());
+  AddPropertyTablePropertyToModel(
+      model,
+      propertyTable,
+      "height",
+      ClassProperty::Type::SCALAR,
+      ClassProperty::ComponentType::INT32,
+      values);
+  return model;
+}
+
+FCesiumPropertyTableDescription createDescription() {
+  FCesiumPropertyTableDescription description;
+  description.Name = "buildings";
+
+  FCesiumPropertyTablePropertyDescription& property =
+      description.Properties.Emplace_GetRef();
+  property.Name = "height";
+  property.PropertyDetails = FCesiumMetadataPropertyDetails(
+      ECesiumMetadataType::Scalar,
+      ECesiumMetadataComponentType::Int32,
+      false);
+  property.EncodingDetails = FCesiumMetadataEncodingDetails(
+      ECesiumEncodedMetadataType::Scalar,
+      ECesiumEncodedMetadataComponentType::Float,
+      ECesiumEncodedMetadataConversion::Coerce);
+
+  return description;
+}
+
+std::optional<uint64> computeKey(
+    const Model& model,
+    const FCesiumPropertyTableDescription& description) {
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  return CesiumEncodedPropertyTableCache::computeKey(
+      description,
+      model,
+      *pMetadata,
+      pMetadata->propertyTables[0]);
+}
+
+EncodedPropertyTable createEncodedTable() {
+  EncodedPropertyTable table;
+  table.name = "buildings";
+  EncodedPropertyTableProperty& property = table.properties.Emplace_GetRef();
+  property.name = "height";
+  property.type = ECesiumEncodedMetadataType::Scalar;
+  property.pTexture = MakeShared<CesiumTextureUtility::LoadedTextureResult>();
+  return table;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumEncodedPropertyTableCacheSpec,
+    "Cesium.Unit.EncodedPropertyTableCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumEncodedPropertyTableCacheSpec)
+
+void FCesiumEncodedPropertyTableCacheSpec::Define() {
+  Describe("computeKey", [this]() {
+    It("is the same for property tables with the same contents", [this]() {
+      const Model first = createModel({1, 2, 3, 4});
+      const Model second = createModel({1, 2, 3, 4});
+
+      std::optional<uint64> firstKey = computeKey(first, createDescription());
+      std::optional<uint64> secondKey = computeKey(second, createDescription());
+      TestTrue("first key", firstKey.has_value());
+      TestTrue("second key", secondKey.has_value());
+      TestTrue("equal", firstKey == secondKey);
+    });
+
+    It("differs for property tables with different values", [this]() {
+      const Model first = createModel({1, 2, 3, 4});
+      const Model second = createModel({1, 2, 3, 5});
+
+      TestTrue(
+          "different",
+          computeKey(first, createDescription()) !=
+              computeKey(second, createDescription()));
+    });
+
+    It("differs for different encodings", [this]() {
+      const Model model = createModel({1, 2, 3, 4});
+
+      FCesiumPropertyTableDescription quantized = createDescription();
+      quantized.Properties[0].EncodingDetails.bQuantize = true;
+
+      TestTrue(
+          "different",
+          computeKey(model, createDescription()) !=
+              computeKey(model, quantized));
+    });
+
+    It("ignores properties that aren't encoded", [this]() {
+      const Model first = createModel({1, 2, 3, 4});
+      const Model second = createModel({5, 6, 7, 8});
+
+      FCesiumPropertyTableDescription description = createDescription();
+      description.Properties[0].EncodingDetails.Conversion =
+          ECesiumEncodedMetadataConversion::None;
+
+      TestTrue(
+          "equal",
+          computeKey(first, description) == computeKey(second, description));
+    });
+
+    It("is empty for property tables without a class", [this]() {
+      Model model = createModel({1, 2, 3, 4});
+      model.getExtension<ExtensionModelExtStructuralMetadata>()
+          ->propertyTables[0]
+          .classProperty = "nonexistent";
+
+      TestFalse("key", computeKey(model, createDescription()).has_value());
+    });
+
+    It("is empty for invalid buffer views", [this]() {
+      Model model = createModel({1, 2, 3, 4});
+      model.bufferViews[0].byteLength = 1024;
+
+      TestFalse("key", computeKey(model, createDescription()).has_value());
+    });
+  });
+
+  Describe("sharing", [this]() {
+    It("finds the textures of an added property table", [this]() {
+      TSharedPtr<CesiumEncodedPropertyTableCache> pCache =
+          MakeShared<CesiumEncodedPropertyTableCache>();
+      TestFalse("before add", pCache->find(1).IsValid());
+
+      EncodedPropertyTable first = createEncodedTable();
+      pCache->use(pCache->add(1, first), first);
+
+      EncodedPropertyTable second = createEncodedTable();
+      second.properties[0].pTexture.Reset();
+      pCache->use(pCache->find(1), second);
+
+      TestTrue(
+          "shared texture",
+          second.properties[0].pTexture == first.properties[0].pTexture);
+      TestTrue("cache", second.pCache == pCache);
+      TestEqual("count", pCache->getCount(), 1);
+    });
+
+    It("keeps the textures that were added first", [this]() {
+      TSharedPtr<CesiumEncodedPropertyTableCache> pCache =
+          MakeShared<CesiumEncodedPropertyTableCache>();
+
+      EncodedPropertyTable first = createEncodedTable();
+      pCache->use(pCache->add(1, first), first);
+
+      EncodedPropertyTable second = createEncodedTable();
+      pCache->use(pCache->add(1, second), second);
+
+      TestTrue(
+          "shared texture",
+          second.properties[0].pTexture == first.properties[0].pTexture);
+    });
+
+    It("forgets property tables once every tile released them", [this]() {
+      TSharedPtr<CesiumEncodedPropertyTableCache> pCache =
+          MakeShared<CesiumEncodedPropertyTableCache>();
+
+      EncodedPropertyTable first = createEncodedTable();
+      pCache->use(pCache->add(1, first), first);
+      EncodedPropertyTable second = createEncodedTable();
+      pCache->use(pCache->find(1), second);
+
+      pCache->release(first);
+      TestFalse("first texture", first.properties[0].pTexture.IsValid());
+      TestTrue("still shared", pCache->find(1).IsValid());
+
+      pCache->release(second);
+      TestFalse("released", pCache->find(1).IsValid());
+      TestEqual("count", pCache->getCount(), 0);
+    });
+  });
+}
@@ -0,0 +1,126 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStyleBuffer.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFeatureStyleBufferSpec,
+    "Cesium.Unit.FeatureStyleBuffer",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumFeatureStyleBufferSpec)
+
+void FCesiumFeatureStyleBufferSpec::Define() {
+  const int32 Width = CesiumFeatureStyleBuffer::Width;
+
+  It("starts with every feature visible and unstyled", [this, Width]() {
+    CesiumFeatureStyleBuffer buffer(Width * 3);
+    TestEqual("height", buffer.getHeight(), 4);
+    TestEqual("colors", buffer.getColors().Num(), Width * 4);
+    TestEqual("emissives", buffer.getEmissives().Num(), Width * 4);
+    TestTrue(
+        "color",
+        buffer.getColors()[Width * 3 + 5] ==
+            CesiumFeatureStyleBuffer::DefaultColor);
+    TestTrue(
+        "emissive",
+        buffer.getEmissives()[7] == CesiumFeatureStyleBuffer::DefaultEmissive);
+    TestTrue("resized", buffer.wasResized());
+    TestTrue("changes", buffer.hasChanges());
+  });
+
+  It("writes styles to the texel of the feature ID", [this, Width]() {
+    CesiumFeatureStyleBuffer buffer(Width * 2);
+    buffer.clearChanges();
+    TestFalse("no changes", buffer.hasChanges());
+
+    const int64 featureID = Width + 3;
+    buffer.setColor(featureID, FLinearColor::Red);
+    buffer.setVisibility(featureID, false);
+    buffer.setEmissive(2, FLinearColor::Green);
+
+    TestTrue(
+        "color",
+        buffer.getColors()[int32(featureID)] == FColor(255, 0, 0, 0));
+    TestTrue("emissive", buffer.getEmissives()[2] == FColor(0, 255, 0, 255));
+    TestTrue(
+        "neighbor",
+        buffer.getColors()[int32(featureID) + 1] ==
+            CesiumFeatureStyleBuffer::DefaultColor);
+
+    TestFalse("resized", buffer.wasResized());
+    TestEqual("first row", buffer.getFirstChangedRow(), 0);
+    TestEqual("last row", buffer.getLastChangedRow(), 1);
+
+    // Setting the color keeps the visibility.
+    buffer.setColor(featureID, FLinearColor::Blue);
+    TestEqual("hidden", buffer.getColors()[int32(featureID)].A, uint8(0));
+  });
+
+  It("tracks only the changed rows", [this, Width]() {
+    CesiumFeatureStyleBuffer buffer(Width * 8);
+    buffer.clearChanges();
+
+    buffer.setVisibility(Width * 5 + 1, false);
+    buffer.setVisibility(Width * 3, false);
+    TestEqual("first row", buffer.getFirstChangedRow(), 3);
+    TestEqual("last row", buffer.getLastChangedRow(), 5);
+
+    buffer.clearChanges();
+    buffer.resetFeature(Width * 3);
+    TestEqual("reset first row", buffer.getFirstChangedRow(), 3);
+    TestEqual("reset last row", buffer.getLastChangedRow(), 3);
+    TestTrue(
+        "reset",
+        buffer.getColors()[Width * 3] ==
+            CesiumFeatureStyleBuffer::DefaultColor);
+  });
+
+  It("grows to fit larger feature IDs", [this, Width]() {
+    CesiumFeatureStyleBuffer buffer;
+    TestEqual("height", buffer.getHeight(), 1);
+    buffer.clearChanges();
+
+    buffer.setVisibility(1, false);
+    buffer.setVisibility(Width * 2 + 1, false);
+    TestEqual("grown height", buffer.getHeight(), 4);
+    TestTrue("resized", buffer.wasResized());
+    TestEqual("hidden", buffer.getColors()[1].A, uint8(0));
+    TestEqual("grown hidden", buffer.getColors()[Width * 2 + 1].A, uint8(0));
+    TestTrue(
+        "grown default",
+        buffer.getColors()[Width * 3] ==
+            CesiumFeatureStyleBuffer::DefaultColor);
+  });
+
+  It("ignores invalid feature IDs", [this]() {
+    CesiumFeatureStyleBuffer buffer;
+    buffer.clearChanges();
+
+    buffer.setVisibility(-1, false);
+    buffer.setVisibility(
+        int64(CesiumFeatureStyleBuffer::Width) *
+            CesiumFeatureStyleBuffer::MaxHeight,
+        false);
+    TestFalse("changes", buffer.hasChanges());
+    TestEqual("height", buffer.getHeight(), 1);
+  });
+
+  It("resets every feature", [this, Width]() {
+    CesiumFeatureStyleBuffer buffer(Width * 2);
+    buffer.setColor(10, FLinearColor::Red);
+    buffer.setEmissive(Width + 10, FLinearColor::White);
+    buffer.clearChanges();
+
+    buffer.resetAll();
+    TestTrue(
+        "color",
+        buffer.getColors()[10] == CesiumFeatureStyleBuffer::DefaultColor);
+    TestTrue(
+        "emissive",
+        buffer.getEmissives()[Width + 10] ==
+            CesiumFeatureStyleBuffer::DefaultEmissive);
+    TestEqual("first row", buffer.getFirstChangedRow(), 0);
+    TestEqual("last row", buffer.getLastChangedRow(), 1);
+  });
+}
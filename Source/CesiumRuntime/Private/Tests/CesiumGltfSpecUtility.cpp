@@ -110,3 +110,39 @@ CesiumGltf::FeatureId& AddFeatureIDsAsTextureToModel(
 
   return featureID;
 }
+
+CesiumGltf::PropertyTableProperty& AddStringPropertyTablePropertyToModel(
+    CesiumGltf::Model& model,
+    CesiumGltf::PropertyTable& propertyTable,
+    const std::string& propertyName,
+    const std::vector<std::string>& values) {
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> offsets;
+  for (const std::string& value : values) {
+    offsets.push_back(static_cast<uint32_t>(data.size()));
+    data.insert(data.end(), value.begin(), value.end());
+  }
+  offsets.push_back(static_cast<uint32_t>(data.size()));
+
+  PropertyTableProperty& property = AddPropertyTablePropertyToModel(
+      model,
+      propertyTable,
+      propertyName,
+      ClassProperty::Type::STRING,
+      std::nullopt,
+      data);
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data = GetValuesAsBytes(offsets);
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+  bufferView.byteOffset = 0;
+
+  property.stringOffsets = static_cast<int32_t>(model.bufferViews.size() - 1);
+  property.stringOffsetType = PropertyTableProperty::StringOffsetType::UINT32;
+
+  return property;
+}
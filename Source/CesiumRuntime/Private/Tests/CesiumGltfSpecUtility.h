@@ -158,6 +158,19 @@ CesiumGltf::PropertyTableProperty& AddPropertyTablePropertyToModel(
   return property;
 }
 
+/**
+ * @brief Adds the given strings to the given model as a property table
+ * property in EXT_structural_metadata, with UINT32 string offsets. This also
+ * creates a class property definition for the new property in the schema.
+ *
+ * @returns The newly created property table property in the model extension.
+ */
+CesiumGltf::PropertyTableProperty& AddStringPropertyTablePropertyToModel(
+    CesiumGltf::Model& model,
+    CesiumGltf::PropertyTable& propertyTable,
+    const std::string& propertyName,
+    const std::vector<std::string>& values);
+
 /**
  * @brief Adds the given values to the given model as a property texture
  * property in EXT_structural_metadata. This also creates a class property
@@ -0,0 +1,208 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshKernels.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltfSpecUtility.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include <glm/vec3.hpp>
+#include <limits>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumMeshKernels;
+
+namespace {
+
+// Creates a glTF primitive that is a wavy grid of size x size vertices, with
+// the grid drawn both as a list of triangles and as one long triangle strip.
+struct SyntheticGrid {
+  Model model;
+  int32_t positionAccessor = -1;
+  std::vector<uint32_t> triangles;
+  std::vector<uint32_t> strip;
+};
+
+SyntheticGrid createGrid(int32 size) {
+  SyntheticGrid grid;
+
+  std::vector<glm::vec3> positions;
+  positions.reserve(size_t(size * size));
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      positions.emplace_back(
+          float(x) - 100.0f,
+          float(y) * 2.0f,
+          FMath::Sin(float(x * y)) * 10.0f);
+    }
+  }
+
+  for (int32 y = 0; y + 1 < size; ++y) {
+    for (int32 x = 0; x + 1 < size; ++x) {
+      const uint32_t corner = uint32_t(y * size + x);
+      grid.triangles.insert(
+          grid.triangles.end(),
+          {corner,
+           corner + 1,
+           corner + uint32_t(size),
+           corner + 1,
+           corner + uint32_t(size) + 1,
+           corner + uint32_t(size)});
+    }
+  }
+
+  for (int32 i = 0; i < size * size; ++i) {
+    grid.strip.push_back(uint32_t(i));
+  }
+
+  MeshPrimitive& primitive =
+      grid.model.meshes.emplace_back().primitives.emplace_back();
+  CreateAttributeForPrimitive(
+      grid.model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  grid.positionAccessor = primitive.attributes.at("POSITION");
+
+  return grid;
+}
+
+bool samePositions(
+    const TArray<FStaticMeshBuildVertex>& a,
+    const TArray<FStaticMeshBuildVertex>& b) {
+  if (a.Num() != b.Num()) {
+    return false;
+  }
+  for (int32 i = 0; i < a.Num(); ++i) {
+    if (a[i].Position != b[i].Position || a[i].UVs[0] != b[i].UVs[0]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Func> double measureSeconds(Func&& func) {
+  const int32 repetitions = 5;
+  double best = std::numeric_limits<double>::max();
+  for (int32 i = 0; i < repetitions; ++i) {
+    const double start = FPlatformTime::Seconds();
+    func();
+    best = FMath::Min(best, FPlatformTime::Seconds() - start);
+  }
+  return best;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMeshKernelsSpec,
+    "Cesium.Unit.MeshKernels",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumMeshKernelsSpec)
+
+void FCesiumMeshKernelsSpec::Define() {
+  It("returns the same results in parallel and sequentially", [this]() {
+    SyntheticGrid grid = createGrid(200);
+    AccessorView<FVector3f> positions(grid.model, grid.positionAccessor);
+    TestTrue("chunks", getChunkCount(positions.size()) > 1);
+
+    glm::dvec3 sequentialMin, sequentialMax, parallelMin, parallelMax;
+    computeBounds(positions, false, sequentialMin, sequentialMax);
+    computeBounds(positions, true, parallelMin, parallelMax);
+    TestTrue("min", sequentialMin == parallelMin);
+    TestTrue("max", sequentialMax == parallelMax);
+    TestTrue("min x", sequentialMin.x == -100.0);
+    TestTrue("max y", sequentialMax.y == 398.0);
+
+    TArray<uint32> sequentialIndices, parallelIndices;
+    copyIndices(grid.triangles, false, false, sequentialIndices);
+    copyIndices(grid.triangles, false, true, parallelIndices);
+    TestTrue("triangles", sequentialIndices == parallelIndices);
+    TestEqual(
+        "triangle count",
+        sequentialIndices.Num(),
+        int32(grid.triangles.size()));
+
+    copyIndices(grid.strip, true, false, sequentialIndices);
+    copyIndices(grid.strip, true, true, parallelIndices);
+    TestTrue("strip", sequentialIndices == parallelIndices);
+    TestEqual(
+        "strip count",
+        sequentialIndices.Num(),
+        int32(3 * (grid.strip.size() - 2)));
+    TestTrue(
+        "strip winding",
+        sequentialIndices[3] == 1 && sequentialIndices[4] == 3 &&
+            sequentialIndices[5] == 2);
+
+    const FVector origin(50.0, -300.0, 0.0);
+    TArray<uint32> triangles;
+    copyIndices(grid.triangles, false, false, triangles);
+
+    TArray<FStaticMeshBuildVertex> sequentialVertices, parallelVertices;
+    sequentialVertices.SetNumZeroed(triangles.Num());
+    parallelVertices.SetNumZeroed(triangles.Num());
+    const double sequentialRadius = copyPositions(
+        positions,
+        &triangles,
+        origin,
+        false,
+        sequentialVertices);
+    const double parallelRadius =
+        copyPositions(positions, &triangles, origin, true, parallelVertices);
+    TestTrue("radius", sequentialRadius == parallelRadius);
+    TestTrue("vertices", samePositions(sequentialVertices, parallelVertices));
+    TestTrue(
+        "flipped",
+        sequentialVertices[2].Position.Y == -positions[triangles[2]].Y);
+
+    TestTrue(
+        "prebaked radius",
+        computeSphereRadius(sequentialVertices, origin, true) ==
+            sequentialRadius);
+  });
+
+  It("reports the time of each stage", [this]() {
+    SyntheticGrid grid = createGrid(384);
+    AccessorView<FVector3f> positions(grid.model, grid.positionAccessor);
+    const FVector origin(0.0);
+
+    TArray<uint32> indices;
+    TArray<FStaticMeshBuildVertex> vertices;
+    vertices.SetNumZeroed(int32(grid.triangles.size()));
+
+    auto report = [this](const TCHAR* stage, auto&& run) {
+      const double sequential = measureSeconds([&run]() { run(false); });
+      const double parallel = measureSeconds([&run]() { run(true); });
+      AddInfo(FString::Printf(
+          TEXT("%s: %.3fms sequential, %.3fms parallel"),
+          stage,
+          sequential * 1000.0,
+          parallel * 1000.0));
+    };
+
+    report(TEXT("Bounds"), [&](bool parallel) {
+      glm::dvec3 min, max;
+      computeBounds(positions, parallel, min, max);
+    });
+    report(TEXT("Triangle indices"), [&](bool parallel) {
+      copyIndices(grid.triangles, false, parallel, indices);
+    });
+    report(TEXT("Strip indices"), [&](bool parallel) {
+      copyIndices(grid.strip, true, parallel, indices);
+    });
+
+    copyIndices(grid.triangles, false, false, indices);
+    report(TEXT("Duplicated positions"), [&](bool parallel) {
+      copyPositions(positions, &indices, origin, parallel, vertices);
+    });
+    report(TEXT("Sphere radius"), [&](bool parallel) {
+      computeSphereRadius(vertices, origin, parallel);
+    });
+
+    TestEqual("vertices", vertices.Num(), int32(grid.triangles.size()));
+  });
+}
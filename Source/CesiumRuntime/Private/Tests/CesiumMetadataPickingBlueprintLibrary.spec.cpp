@@ -6,10 +6,104 @@
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumGltfSpecUtility.h"
 #include "CesiumMetadataPickingBlueprintLibrary.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
 #include "Misc/AutomationTest.h"
+#include <array>
+#include <limits>
 
 using namespace CesiumGltf;
 
+namespace {
+
+const int32 GridSize = 40;
+const int64 GridFeatureCount = 200;
+
+// Adds a grid of GridSize x GridSize squares to the primitive, starting at the
+// given x coordinate. Each square is made of two triangles that don't share
+// vertices, and both triangles of square N have the feature ID N modulo
+// GridFeatureCount. The texture coordinates of the vertices are their
+// positions relative to the grid, divided by GridSize.
+void addFeatureGrid(Model& model, MeshPrimitive& primitive, float startX) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> texCoords;
+  std::vector<uint8_t> featureIDs;
+
+  const std::array<glm::vec2, 6> corners{
+      glm::vec2(0.0f, 0.0f),
+      glm::vec2(1.0f, 0.0f),
+      glm::vec2(1.0f, 1.0f),
+      glm::vec2(0.0f, 0.0f),
+      glm::vec2(1.0f, 1.0f),
+      glm::vec2(0.0f, 1.0f)};
+
+  for (int32 y = 0; y < GridSize; ++y) {
+    for (int32 x = 0; x < GridSize; ++x) {
+      const int32 square = y * GridSize + x;
+      for (const glm::vec2& corner : corners) {
+        const glm::vec2 position = glm::vec2(x, y) + corner;
+        positions.emplace_back(startX + position.x, position.y, 0.0f);
+        texCoords.emplace_back(position / float(GridSize));
+        featureIDs.push_back(uint8_t(square % GridFeatureCount));
+      }
+    }
+  }
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TEXCOORD_0",
+      AccessorSpec::Type::VEC2,
+      AccessorSpec::ComponentType::FLOAT,
+      texCoords);
+  FeatureId& featureId = AddFeatureIDsAsAttributeToModel(
+      model,
+      primitive,
+      featureIDs,
+      GridFeatureCount,
+      0);
+  featureId.propertyTable = 0;
+}
+
+// Creates a hit in the middle of the given triangle of a grid.
+FHitResult createGridHit(
+    UCesiumGltfPrimitiveComponent* pComponent,
+    float startX,
+    int32 faceIndex) {
+  const int32 square = faceIndex / 2;
+  const glm::vec2 squareCorner(square % GridSize, square / GridSize);
+  const glm::vec2 center =
+      squareCorner + (faceIndex % 2 == 0 ? glm::vec2(2.0f / 3.0f, 1.0f / 3.0f)
+                                         : glm::vec2(1.0f / 3.0f, 2.0f / 3.0f));
+
+  FHitResult hit;
+  hit.Component = pComponent;
+  hit.FaceIndex = faceIndex;
+  // The Y-component of glTF positions is inverted in Unreal.
+  hit.Location = FVector_NetQuantize(startX + center.x, -center.y, 0.0);
+  return hit;
+}
+
+template <typename Func> double measureSeconds(Func&& func) {
+  const int32 repetitions = 3;
+  double best = std::numeric_limits<double>::max();
+  for (int32 i = 0; i < repetitions; ++i) {
+    const double start = FPlatformTime::Seconds();
+    func();
+    best = FMath::Min(best, FPlatformTime::Seconds() - start);
+  }
+  return best;
+}
+
+} // namespace
+
 BEGIN_DEFINE_SPEC(
     FCesiumMetadataPickingSpec,
     "Cesium.Unit.MetadataPicking",
@@ -24,6 +118,8 @@ PropertyTable* pPropertyTable;
 PropertyTexture* pPropertyTexture;
 TObjectPtr<UCesiumGltfComponent> pModelComponent;
 TObjectPtr<UCesiumGltfPrimitiveComponent> pPrimitiveComponent;
+TArray<TObjectPtr<UCesiumGltfPrimitiveComponent>> gridComponents;
+TArray<float> gridStarts;
 END_DEFINE_SPEC(FCesiumMetadataPickingSpec)
 
 void FCesiumMetadataPickingSpec::Define() {
@@ -855,6 +951,212 @@ void FCesiumMetadataPickingSpec::Define() {
     });
   });
 
+  Describe("Batched hits", [this]() {
+    BeforeEach([this]() {
+      model = Model();
+      Mesh& mesh = model.meshes.emplace_back();
+      mesh.primitives.resize(2);
+      gridStarts = {0.0f, 100.0f};
+
+      pModelMetadata =
+          &model.addExtension<ExtensionModelExtStructuralMetadata>();
+      std::string className = "testClass";
+      pModelMetadata->schema.emplace();
+      pModelMetadata->schema->classes[className];
+
+      pPropertyTable = &pModelMetadata->propertyTables.emplace_back();
+      pPropertyTable->classProperty = className;
+      pPropertyTable->count = GridFeatureCount;
+
+      std::vector<double> heights;
+      for (int64 i = 0; i < GridFeatureCount; ++i) {
+        heights.push_back(double(i) * 0.5);
+      }
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          "height",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::FLOAT64,
+          heights);
+
+      for (size_t i = 0; i < mesh.primitives.size(); ++i) {
+        addFeatureGrid(model, mesh.primitives[i], gridStarts[int32(i)]);
+      }
+
+      pModelComponent = NewObject<UCesiumGltfComponent>();
+      pModelComponent->Metadata = FCesiumModelMetadata(model, *pModelMetadata);
+
+      gridComponents.Reset();
+      for (MeshPrimitive& primitive : mesh.primitives) {
+        UCesiumGltfPrimitiveComponent* pComponent =
+            NewObject<UCesiumGltfPrimitiveComponent>(pModelComponent);
+        pComponent->AttachToComponent(
+            pModelComponent,
+            FAttachmentTransformRules(EAttachmentRule::KeepRelative, false));
+        pComponent->PositionAccessor =
+            AccessorView<FVector3f>(model, primitive.attributes["POSITION"]);
+        pComponent->TexCoordAccessorMap.emplace(
+            0,
+            AccessorView<CesiumGltf::AccessorTypes::VEC2<float>>(
+                model,
+                primitive.attributes["TEXCOORD_0"]));
+        pComponent->Features = FCesiumPrimitiveFeatures(
+            model,
+            primitive,
+            *primitive.getExtension<ExtensionExtMeshFeatures>());
+        gridComponents.Add(pComponent);
+      }
+    });
+
+    It("returns the same results as single hits", [this]() {
+      TArray<FHitResult> hits;
+      const int32 faceCount = GridSize * GridSize * 2;
+      for (int32 faceIndex = 0; faceIndex < faceCount; faceIndex += 7) {
+        // Alternate between the grids so that hits aren't grouped already.
+        const int32 grid = (faceIndex / 7) % 2;
+        hits.Add(createGridHit(
+            gridComponents[grid],
+            gridStarts[grid],
+            faceIndex));
+      }
+
+      FHitResult noComponent = createGridHit(nullptr, 0.0f, 0);
+      hits.Add(noComponent);
+      FHitResult invalidFace =
+          createGridHit(gridComponents[0], gridStarts[0], 0);
+      invalidFace.FaceIndex = faceCount;
+      hits.Add(invalidFace);
+
+      TArray<FVector2D> UVs;
+      TArray<bool> found;
+      UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+          hits,
+          0,
+          UVs,
+          found);
+
+      TArray<int64> featureIDs;
+      UCesiumMetadataPickingBlueprintLibrary::GetFeatureIDsFromHits(
+          hits,
+          featureIDs);
+
+      TArray<int64> valueFeatureIDs;
+      TArray<double> heights;
+      UCesiumMetadataPickingBlueprintLibrary::GetFloat64PropertyValuesFromHits(
+          hits,
+          "height",
+          valueFeatureIDs,
+          heights,
+          0,
+          -1.0);
+
+      TestEqual("UV count", UVs.Num(), hits.Num());
+      TestEqual("found count", found.Num(), hits.Num());
+      TestEqual("feature ID count", featureIDs.Num(), hits.Num());
+      TestEqual("height count", heights.Num(), hits.Num());
+      TestTrue("feature IDs of values", featureIDs == valueFeatureIDs);
+
+      for (int32 i = 0; i < hits.Num(); ++i) {
+        const FHitResult& hit = hits[i];
+
+        FVector2D UV = FVector2D::Zero();
+        const bool expectedFound =
+            UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(hit, 0, UV);
+        TestEqual("found", found[i], expectedFound);
+        if (expectedFound) {
+          TestTrue("UV", UVs[i].Equals(UV));
+        }
+
+        const UCesiumGltfPrimitiveComponent* pComponent =
+            Cast<UCesiumGltfPrimitiveComponent>(hit.Component.Get());
+        const int64 expectedFeatureID =
+            pComponent
+                ? UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromHit(
+                      pComponent->Features,
+                      hit,
+                      0)
+                : -1;
+        TestEqual("feature ID", featureIDs[i], expectedFeatureID);
+
+        const TMap<FString, FCesiumMetadataValue> values =
+            UCesiumMetadataPickingBlueprintLibrary::
+                GetPropertyTableValuesFromHit(hit);
+        const FCesiumMetadataValue* pHeight = values.Find("height");
+        const double expectedHeight =
+            pHeight ? UCesiumMetadataValueBlueprintLibrary::GetFloat64(
+                          *pHeight,
+                          -1.0)
+                    : -1.0;
+        TestEqual("height", heights[i], expectedHeight);
+      }
+
+      TestEqual("no component", featureIDs[hits.Num() - 2], int64(-1));
+      TestFalse("invalid face", found[hits.Num() - 1]);
+    });
+
+    It("reports the time of single and batched hits", [this]() {
+      const int32 hitCount = 20000;
+      const int32 faceCount = GridSize * GridSize * 2;
+      FRandomStream random(42);
+
+      TArray<FHitResult> hits;
+      hits.Reserve(hitCount);
+      for (int32 i = 0; i < hitCount; ++i) {
+        const int32 grid = random.RandRange(0, gridComponents.Num() - 1);
+        hits.Add(createGridHit(
+            gridComponents[grid],
+            gridStarts[grid],
+            random.RandRange(0, faceCount - 1)));
+      }
+
+      TArray<FVector2D> UVs;
+      TArray<bool> found;
+      TArray<int64> featureIDs;
+      TArray<double> heights;
+
+      const double single = measureSeconds([&hits, &UVs, &heights]() {
+        UVs.SetNum(hits.Num());
+        heights.SetNum(hits.Num());
+        for (int32 i = 0; i < hits.Num(); ++i) {
+          UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
+              hits[i],
+              0,
+              UVs[i]);
+          const TMap<FString, FCesiumMetadataValue> values =
+              UCesiumMetadataPickingBlueprintLibrary::
+                  GetPropertyTableValuesFromHit(hits[i]);
+          const FCesiumMetadataValue* pHeight = values.Find("height");
+          heights[i] = pHeight ? UCesiumMetadataValueBlueprintLibrary::
+                                     GetFloat64(*pHeight, 0.0)
+                               : 0.0;
+        }
+      });
+
+      const double batched =
+          measureSeconds([&hits, &UVs, &found, &featureIDs, &heights]() {
+            UCesiumMetadataPickingBlueprintLibrary::FindUVsFromHits(
+                hits,
+                0,
+                UVs,
+                found);
+            UCesiumMetadataPickingBlueprintLibrary::
+                GetFloat64PropertyValuesFromHits(
+                    hits,
+                    "height",
+                    featureIDs,
+                    heights);
+          });
+
+      AddInfo(FString::Printf(
+          TEXT("UVs and heights of %d hits: %.3fms single, %.3fms batched"),
+          hitCount,
+          single * 1000.0,
+          batched * 1000.0));
+      TestEqual("heights", heights.Num(), hitCount);
+    });
+  });
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   Describe("Deprecated", [this]() {
     Describe("GetMetadataValuesForFace", [this]() {
@@ -0,0 +1,231 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumModelTrimming.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+#include <glm/vec3.hpp>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumModelTrimming;
+
+namespace {
+
+const std::vector<glm::vec3> positions{
+    glm::vec3(0.0f, 0.0f, 0.0f),
+    glm::vec3(1.0f, 0.0f, 0.0f),
+    glm::vec3(0.0f, 1.0f, 0.0f)};
+
+const std::vector<uint16_t> indices{0, 1, 2};
+
+MeshPrimitive& addTriangle(Model& model) {
+  Mesh& mesh = model.meshes.empty() ? model.meshes.emplace_back()
+                                    : model.meshes.front();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      indices);
+  return primitive;
+}
+
+// Adds a buffer view of the given bytes to the end of the model's first
+// buffer, and an accessor of single bytes that views it.
+int32_t addBytesToSharedBuffer(Model& model, const std::vector<uint8_t>& data) {
+  if (model.buffers.empty()) {
+    model.buffers.emplace_back();
+  }
+  Buffer& buffer = model.buffers.front();
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = int64_t(buffer.cesium.data.size());
+  bufferView.byteLength = int64_t(data.size());
+
+  for (uint8_t value : data) {
+    buffer.cesium.data.push_back(std::byte(value));
+  }
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+  accessor.type = AccessorSpec::Type::SCALAR;
+  accessor.componentType = AccessorSpec::ComponentType::UNSIGNED_BYTE;
+  accessor.count = int64_t(data.size());
+  return int32_t(model.accessors.size() - 1);
+}
+
+bool readsBytes(
+    const Model& model,
+    int32_t accessor,
+    const std::vector<uint8_t>& expected) {
+  AccessorView<uint8_t> view(model, accessor);
+  if (view.status() != AccessorViewStatus::Valid ||
+      view.size() != int64_t(expected.size())) {
+    return false;
+  }
+  for (int64_t i = 0; i < view.size(); ++i) {
+    if (view[i] != expected[size_t(i)]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumModelTrimmingSpec,
+    "Cesium.Unit.ModelTrimming",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumModelTrimmingSpec)
+
+void FCesiumModelTrimmingSpec::Define() {
+  Describe("trimModel", [this]() {
+    It("releases the geometry of primitives without features", [this]() {
+      Model model;
+      const MeshPrimitive& primitive = addTriangle(model);
+      const int64 bytes = computeCpuBytes(model);
+
+      TestEqual("released", trimModel(model, true), bytes);
+      TestEqual("resident", computeCpuBytes(model), int64(0));
+
+      AccessorView<glm::vec3> positionView(
+          model,
+          primitive.attributes.at("POSITION"));
+      TestTrue(
+          "invalid",
+          positionView.status() != AccessorViewStatus::Valid);
+    });
+
+    It("keeps the geometry and feature IDs of primitives with features",
+       [this]() {
+         Model model;
+         addTriangle(model);
+         addTriangle(model);
+         MeshPrimitive& withFeatures = model.meshes[0].primitives[1];
+         AddFeatureIDsAsAttributeToModel(model, withFeatures, {0, 1, 1}, 2, 0);
+
+         trimModel(model, true);
+
+         AccessorView<glm::vec3> positionView(
+             model,
+             withFeatures.attributes.at("POSITION"));
+         TestTrue("valid", positionView.status() == AccessorViewStatus::Valid);
+         TestTrue("position", positionView[1] == positions[1]);
+
+         AccessorView<uint16_t> indexView(model, withFeatures.indices);
+         TestTrue("index", indexView[2] == 2);
+
+         AccessorView<uint8_t> featureIdView(
+             model,
+             withFeatures.attributes.at("_FEATURE_ID_0"));
+         TestTrue("feature ID", featureIdView[1] == 1);
+
+         const MeshPrimitive& plain = model.meshes[0].primitives[0];
+         AccessorView<glm::vec3> plainView(
+             model,
+             plain.attributes.at("POSITION"));
+         TestTrue(
+             "plain released",
+             plainView.status() != AccessorViewStatus::Valid);
+       });
+
+    It("keeps the values of property tables", [this]() {
+      Model model;
+      addTriangle(model);
+
+      ExtensionModelExtStructuralMetadata& metadata =
+          model.addExtension<ExtensionModelExtStructuralMetadata>();
+      PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+      propertyTable.classProperty = "testClass";
+      propertyTable.count = 3;
+      const PropertyTableProperty& property = AddPropertyTablePropertyToModel(
+          model,
+          propertyTable,
+          "height",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          std::vector<int32_t>{10, 20, 30});
+      const int64 valueBytes = int64(3 * sizeof(int32_t));
+
+      trimModel(model, true);
+
+      const BufferView& bufferView = model.bufferViews[property.values];
+      TestEqual("length", bufferView.byteLength, valueBytes);
+      TestEqual("resident", computeCpuBytes(model), valueBytes);
+    });
+
+    It("packs the kept buffer views of a shared buffer", [this]() {
+      Model model;
+      MeshPrimitive& primitive =
+          model.meshes.emplace_back().primitives.emplace_back();
+      primitive.addExtension<ExtensionExtMeshFeatures>();
+
+      const std::vector<uint8_t> first{1, 2, 3};
+      const std::vector<uint8_t> dropped(100, 7);
+      const std::vector<uint8_t> last{4, 5, 6, 7, 8};
+
+      primitive.attributes["_FEATURE_ID_0"] =
+          addBytesToSharedBuffer(model, first);
+      const int32_t droppedAccessor = addBytesToSharedBuffer(model, dropped);
+      primitive.attributes["_FEATURE_ID_1"] =
+          addBytesToSharedBuffer(model, last);
+
+      TestEqual("released", trimModel(model, true), int64(100 - 5));
+      TestEqual("size", int32(model.buffers[0].cesium.data.size()), 13);
+      TestEqual("offset", int32(model.bufferViews[2].byteOffset), 8);
+      TestTrue(
+          "first",
+          readsBytes(model, primitive.attributes["_FEATURE_ID_0"], first));
+      TestTrue(
+          "last",
+          readsBytes(model, primitive.attributes["_FEATURE_ID_1"], last));
+      TestFalse("dropped", readsBytes(model, droppedAccessor, dropped));
+    });
+
+    It("releases images unless they are feature ID textures", [this]() {
+      Model model;
+      MeshPrimitive& primitive = addTriangle(model);
+      AddFeatureIDsAsTextureToModel(
+          model,
+          primitive,
+          {0, 1, 2, 3},
+          4,
+          2,
+          2,
+          {glm::vec2(0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f)},
+          0);
+
+      ImageCesium& baseColor = model.images.emplace_back().cesium;
+      baseColor.width = 2;
+      baseColor.height = 2;
+      baseColor.channels = 4;
+      baseColor.pixelData.resize(16);
+
+      Model keptImages = model;
+      trimModel(keptImages, false);
+      TestEqual(
+          "kept",
+          int32(keptImages.images.back().cesium.pixelData.size()),
+          16);
+
+      trimModel(model, true);
+      TestTrue("released", model.images.back().cesium.pixelData.empty());
+      TestFalse(
+          "feature IDs kept",
+          model.images.front().cesium.pixelData.empty());
+    });
+  });
+}
@@ -0,0 +1,158 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPrebakedTile.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+using namespace CesiumGltf;
+
+namespace {
+
+void addQuad(Model& model, Mesh& mesh, bool withNormals) {
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec3>{
+          glm::vec3(0.0f, 0.0f, 0.0f),
+          glm::vec3(1.0f, 0.0f, 0.0f),
+          glm::vec3(1.0f, 1.0f, 0.5f),
+          glm::vec3(0.0f, 1.0f, 0.0f)});
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TEXCOORD_0",
+      AccessorSpec::Type::VEC2,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec2>{
+          glm::vec2(0.0f, 0.0f),
+          glm::vec2(1.0f, 0.0f),
+          glm::vec2(1.0f, 1.0f),
+          glm::vec2(0.0f, 1.0f)});
+  if (withNormals) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "NORMAL",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        std::vector<glm::vec3>(4, glm::vec3(0.0f, 0.0f, 1.0f)));
+  }
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      std::vector<uint16_t>{0, 1, 2, 0, 2, 3});
+}
+
+bool areEqual(
+    const CesiumPrebakedPrimitive& a,
+    const CesiumPrebakedPrimitive& b) {
+  // Compare the vertices bitwise, because unused texture coordinates are
+  // left uninitialized.
+  return a.meshIndex == b.meshIndex && a.primitiveIndex == b.primitiveIndex &&
+         a.vertices.Num() == b.vertices.Num() &&
+         FMemory::Memcmp(
+             a.vertices.GetData(),
+             b.vertices.GetData(),
+             a.vertices.Num() * sizeof(FStaticMeshBuildVertex)) == 0 &&
+         a.indices == b.indices && a.hasVertexColors == b.hasVertexColors &&
+         a.textureCoordinateParameters == b.textureCoordinateParameters &&
+         a.overlayTextureCoordinateIDToUVIndex ==
+             b.overlayTextureCoordinateIDToUVIndex &&
+         a.gltfToUnrealTexCoordMap == b.gltfToUnrealTexCoordMap;
+}
+
+bool areEqual(const CesiumPrebakedTile& a, const CesiumPrebakedTile& b) {
+  if (a.primitives.size() != b.primitives.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.primitives.size(); ++i) {
+    if (!areEqual(a.primitives[i], b.primitives[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrebakedTileSpec,
+    "Cesium.Unit.PrebakedTile",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+CesiumPrebakeOptions options;
+END_DEFINE_SPEC(FCesiumPrebakedTileSpec)
+
+void FCesiumPrebakedTileSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    Mesh& mesh = model.meshes.emplace_back();
+    // Without normals, flat normals are generated for duplicated vertices.
+    addQuad(model, mesh, false);
+    addQuad(model, mesh, true);
+
+    options = CesiumPrebakeOptions();
+    options.alwaysIncludeTangents = true;
+  });
+
+  It("bakes every primitive", [this]() {
+    CesiumPrebakedTile baked = CesiumPrebakedTiles::bakeModel(model, options);
+    TestEqual("primitives", int32(baked.primitives.size()), 2);
+    TestEqual("vertices", baked.primitives[0].vertices.Num(), 6);
+    TestEqual("indices", baked.primitives[0].indices.Num(), 6);
+  });
+
+  It("loads the same primitives from a pre-baked tile", [this]() {
+    CesiumPrebakedTile baked = CesiumPrebakedTiles::bakeModel(model, options);
+    CesiumPrebakedTile loaded =
+        CesiumPrebakedTiles::bakeModel(model, options, &baked);
+    TestTrue("identical", areEqual(baked, loaded));
+  });
+
+  It("uses the pre-baked vertices instead of computing them", [this]() {
+    CesiumPrebakedTile baked = CesiumPrebakedTiles::bakeModel(model, options);
+    baked.primitives[0].vertices[0].TangentZ = FVector3f(1.0f, 0.0f, 0.0f);
+
+    CesiumPrebakedTile loaded =
+        CesiumPrebakedTiles::bakeModel(model, options, &baked);
+    TestTrue("identical", areEqual(baked, loaded));
+  });
+
+  It("reads the tiles it writes", [this]() {
+    const FString directory = FPaths::Combine(
+        FPaths::ProjectIntermediateDir(),
+        TEXT("CesiumPrebakedTileSpec"));
+
+    CesiumPrebakedTile baked = CesiumPrebakedTiles::bakeModel(model, options);
+    TestTrue("written", CesiumPrebakedTiles::writeTile(directory, 42, baked));
+
+    std::optional<CesiumPrebakedTile> read =
+        CesiumPrebakedTiles::readTile(directory, 42);
+    TestTrue("read", read.has_value());
+    TestTrue("identical", read && areEqual(baked, *read));
+    TestFalse(
+        "missing",
+        CesiumPrebakedTiles::readTile(directory, 43).has_value());
+
+    IFileManager::Get().DeleteDirectory(*directory, false, true);
+  });
+
+  It("uses different keys for different options", [this]() {
+    const TArray<uint8> content{1, 2, 3, 4};
+    CesiumPrebakeOptions otherOptions = options;
+    otherOptions.alwaysIncludeTangents = false;
+    TestTrue(
+        "different",
+        CesiumPrebakedTiles::computeKey(content, options) !=
+            CesiumPrebakedTiles::computeKey(content, otherOptions));
+  });
+}
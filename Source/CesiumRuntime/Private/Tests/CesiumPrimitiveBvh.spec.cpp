@@ -0,0 +1,218 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveBvh.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+namespace {
+
+FVector3f randomPoint(FRandomStream& random, float extent) {
+  return FVector3f(
+      random.FRandRange(-extent, extent),
+      random.FRandRange(-extent, extent),
+      random.FRandRange(-extent, extent));
+}
+
+// Finds the nearest triangle hit by a ray by testing every triangle.
+int32 raycastBruteForce(
+    const TArray<FVector3f>& vertices,
+    const FVector3f& origin,
+    const FVector3f& direction,
+    float& time) {
+  int32 nearest = INDEX_NONE;
+  time = 1.0f;
+  for (int32 i = 0; i < vertices.Num() / 3; ++i) {
+    const FVector3f edge1 = vertices[3 * i + 1] - vertices[3 * i];
+    const FVector3f edge2 = vertices[3 * i + 2] - vertices[3 * i];
+    const FVector3f normal = FVector3f::CrossProduct(edge1, edge2);
+    const float denominator = FVector3f::DotProduct(normal, direction);
+    if (denominator == 0.0f) {
+      continue;
+    }
+
+    const float t =
+        FVector3f::DotProduct(normal, vertices[3 * i] - origin) / denominator;
+    if (t < 0.0f || t > time) {
+      continue;
+    }
+
+    const FVector3f point = origin + direction * t;
+    bool inside = true;
+    for (int32 j = 0; j < 3; ++j) {
+      const FVector3f& a = vertices[3 * i + j];
+      const FVector3f& b = vertices[3 * i + (j + 1) % 3];
+      inside &= FVector3f::DotProduct(
+                    FVector3f::CrossProduct(b - a, point - a),
+                    normal) >= 0.0f;
+    }
+    if (inside) {
+      time = t;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitiveBvhSpec,
+    "Cesium.Unit.PrimitiveBvh",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumPrimitiveBvhSpec)
+
+void FCesiumPrimitiveBvhSpec::Define() {
+  It("hits a single triangle from both sides", [this]() {
+    CesiumPrimitiveBvh bvh(
+        {FVector3f(0.0f, 0.0f, 0.0f),
+         FVector3f(1.0f, 0.0f, 0.0f),
+         FVector3f(0.0f, 1.0f, 0.0f)},
+        {7});
+
+    CesiumPrimitiveBvh::RayHit hit;
+    TestTrue(
+        "hit from above",
+        bvh.raycast(
+            FVector3f(0.25f, 0.25f, 1.0f),
+            FVector3f(0.0f, 0.0f, -2.0f),
+            1.0f,
+            hit));
+    TestEqual("face index", hit.faceIndex, 7);
+    TestEqual("time", hit.time, 0.5f);
+    TestEqual("normal", hit.normal, FVector3f(0.0f, 0.0f, 1.0f));
+
+    TestTrue(
+        "hit from below",
+        bvh.raycast(
+            FVector3f(0.25f, 0.25f, -1.0f),
+            FVector3f(0.0f, 0.0f, 2.0f),
+            1.0f,
+            hit));
+    TestEqual("normal", hit.normal, FVector3f(0.0f, 0.0f, -1.0f));
+  });
+
+  It("misses triangles beyond the end of the ray", [this]() {
+    CesiumPrimitiveBvh bvh(
+        {FVector3f(0.0f, 0.0f, 0.0f),
+         FVector3f(1.0f, 0.0f, 0.0f),
+         FVector3f(0.0f, 1.0f, 0.0f)},
+        {0});
+
+    CesiumPrimitiveBvh::RayHit hit;
+    TestFalse(
+        "too short",
+        bvh.raycast(
+            FVector3f(0.25f, 0.25f, 1.0f),
+            FVector3f(0.0f, 0.0f, -0.5f),
+            1.0f,
+            hit));
+    TestFalse(
+        "outside",
+        bvh.raycast(
+            FVector3f(1.0f, 1.0f, 1.0f),
+            FVector3f(0.0f, 0.0f, -2.0f),
+            1.0f,
+            hit));
+  });
+
+  It("finds the same triangles as testing every triangle", [this]() {
+    FRandomStream random(42);
+
+    const int32 triangleCount = 1000;
+    TArray<FVector3f> vertices;
+    TArray<int32> faceIndices;
+    for (int32 i = 0; i < triangleCount; ++i) {
+      const FVector3f center = randomPoint(random, 100.0f);
+      for (int32 j = 0; j < 3; ++j) {
+        vertices.Add(center + randomPoint(random, 5.0f));
+      }
+      faceIndices.Add(i);
+    }
+
+    CesiumPrimitiveBvh bvh(TArray<FVector3f>(vertices), MoveTemp(faceIndices));
+    TestEqual("triangle count", bvh.getTriangleCount(), triangleCount);
+    TestTrue("node count", bvh.getNodeCount() > 1);
+    TestTrue("allocated size", bvh.getAllocatedSize() > 0);
+
+    int32 hitCount = 0;
+    for (int32 i = 0; i < 500; ++i) {
+      const FVector3f origin = randomPoint(random, 150.0f);
+      const FVector3f direction = randomPoint(random, 100.0f) - origin;
+
+      float expectedTime;
+      const int32 expected =
+          raycastBruteForce(vertices, origin, direction, expectedTime);
+
+      CesiumPrimitiveBvh::RayHit hit;
+      const bool result = bvh.raycast(origin, direction, 1.0f, hit);
+      if (!TestEqual("hit", result, expected != INDEX_NONE)) {
+        continue;
+      }
+
+      if (result) {
+        ++hitCount;
+        TestEqual("face index", hit.faceIndex, expected);
+        TestTrue(
+            "time",
+            FMath::IsNearlyEqual(hit.time, expectedTime, 1.0e-4f));
+      }
+    }
+
+    TestTrue("some rays hit", hitCount > 0);
+  });
+
+  Describe("create", [this]() {
+    It("inverts the Y axis and skips invalid faces", [this]() {
+      const std::vector<FVector3f> positions{
+          FVector3f(0.0f, 0.0f, 0.0f),
+          FVector3f(1.0f, 0.0f, 0.0f),
+          FVector3f(0.0f, 1.0f, 0.0f)};
+      const std::vector<uint16_t> indices{0, 1, 5, 0, 1, 2};
+
+      const CesiumGltf::AccessorView<FVector3f> positionView(
+          reinterpret_cast<const std::byte*>(positions.data()),
+          sizeof(FVector3f),
+          0,
+          int64_t(positions.size()));
+      const CesiumGltf::AccessorView<uint16_t> indexView(
+          reinterpret_cast<const std::byte*>(indices.data()),
+          sizeof(uint16_t),
+          0,
+          int64_t(indices.size()));
+
+      TUniquePtr<CesiumPrimitiveBvh> pBvh =
+          CesiumPrimitiveBvh::create(positionView, indexView);
+      if (!TestNotNull("bvh", pBvh.Get())) {
+        return;
+      }
+
+      TestEqual("triangle count", pBvh->getTriangleCount(), 1);
+
+      CesiumPrimitiveBvh::RayHit hit;
+      TestTrue(
+          "hit",
+          pBvh->raycast(
+              FVector3f(0.25f, -0.25f, 1.0f),
+              FVector3f(0.0f, 0.0f, -2.0f),
+              1.0f,
+              hit));
+      TestEqual("face index", hit.faceIndex, 1);
+      TestFalse(
+          "miss",
+          pBvh->raycast(
+              FVector3f(0.25f, 0.25f, 1.0f),
+              FVector3f(0.0f, 0.0f, -2.0f),
+              1.0f,
+              hit));
+    });
+
+    It("returns nullptr without triangles", [this]() {
+      const CesiumGltf::AccessorView<FVector3f> positionView;
+      TestNull(
+          "bvh",
+          CesiumPrimitiveBvh::create(positionView, std::monostate())
+              .Get());
+    });
+  });
+}
@@ -3,6 +3,7 @@
 #include "CesiumGltfSpecUtility.h"
 #include "CesiumPropertyTable.h"
 #include "Misc/AutomationTest.h"
+#include <cstring>
 #include <limits>
 
 using namespace CesiumGltf;
@@ -836,4 +837,144 @@ void FCesiumPropertyTableSpec::Define() {
       TestTrue("values map is empty", values.IsEmpty());
     });
   });
+
+  Describe("FCesiumPropertyTableQuery", [this]() {
+    BeforeEach([this]() {
+      pPropertyTable->classProperty = "testClass";
+      pPropertyTable->count = 6;
+
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          "height",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::FLOAT64,
+          std::vector<double>{50.0, 150.0, 120.0, 100.0, 300.0, 20.0});
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          "occupied",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::UINT8,
+          std::vector<uint8_t>{1, 0, 1, 1, 0, 1});
+      AddStringPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          "class",
+          {"residential",
+           "residential",
+           "commercial",
+           "residential",
+           "industrial",
+           "Residential"});
+    });
+
+    It("matches every feature without conditions", [this]() {
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      FCesiumPropertyTableQuery query(propertyTable);
+      TestEqual("count", query.countMatches(), int64(6));
+    });
+
+    It("combines conditions", [this]() {
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      FCesiumPropertyTableQuery query(propertyTable);
+      query
+          .whereFloat64(
+              "height",
+              ECesiumPropertyTableQueryOperator::GreaterOrEqual,
+              100.0)
+          .whereString(
+              "class",
+              ECesiumPropertyTableQueryOperator::Equal,
+              "residential");
+
+      TArray<int64> featureIDs;
+      query.getMatchingFeatureIDs(featureIDs);
+      TestTrue("feature IDs", featureIDs == TArray<int64>{1, 3});
+
+      query.whereBoolean("occupied", true);
+      query.getMatchingFeatureIDs(featureIDs);
+      TestTrue("occupied", featureIDs == TArray<int64>{3});
+
+      query.reset();
+      TestEqual("reset", query.countMatches(), int64(6));
+    });
+
+    It("returns the same results with indexes", [this]() {
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      FCesiumPropertyTableQuery scanned(propertyTable);
+      FCesiumPropertyTableQuery indexed(propertyTable);
+      indexed.buildIndex("height");
+      indexed.buildIndex("class");
+
+      const TArray<ECesiumPropertyTableQueryOperator> operators{
+          ECesiumPropertyTableQueryOperator::Equal,
+          ECesiumPropertyTableQueryOperator::NotEqual,
+          ECesiumPropertyTableQueryOperator::Less,
+          ECesiumPropertyTableQueryOperator::LessOrEqual,
+          ECesiumPropertyTableQueryOperator::Greater,
+          ECesiumPropertyTableQueryOperator::GreaterOrEqual};
+      for (ECesiumPropertyTableQueryOperator op : operators) {
+        for (double value : {20.0, 100.0, 110.0, 300.0}) {
+          scanned.reset();
+          indexed.reset();
+          scanned.whereFloat64("height", op, value);
+          indexed.whereFloat64("height", op, value);
+          TestTrue("height", scanned.getMatches() == indexed.getMatches());
+        }
+
+        // String comparisons are case-sensitive, with or without an index.
+        for (const FString& value :
+             {FString("commercial"),
+              FString("residential"),
+              FString("Residential"),
+              FString("x")}) {
+          scanned.reset();
+          indexed.reset();
+          scanned.whereString("class", op, value);
+          indexed.whereString("class", op, value);
+          TestTrue("class", scanned.getMatches() == indexed.getMatches());
+        }
+      }
+    });
+
+    It("matches nothing for missing or mismatched properties", [this]() {
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      FCesiumPropertyTableQuery query(propertyTable);
+      query.whereFloat64(
+          "nonexistent",
+          ECesiumPropertyTableQueryOperator::NotEqual,
+          0.0);
+      TestEqual("nonexistent", query.countMatches(), int64(0));
+
+      query.reset();
+      query.whereString(
+          "height",
+          ECesiumPropertyTableQueryOperator::NotEqual,
+          "");
+      TestEqual("not a string", query.countMatches(), int64(0));
+
+      FCesiumPropertyTable invalidPropertyTable;
+      FCesiumPropertyTableQuery invalidQuery(invalidPropertyTable);
+      TestEqual("invalid", invalidQuery.countMatches(), int64(0));
+    });
+
+    It("finds feature IDs from Blueprints", [this]() {
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+      TestTrue(
+          "Float64",
+          UCesiumPropertyTableBlueprintLibrary::FindFeatureIDsByFloat64(
+              propertyTable,
+              "height",
+              ECesiumPropertyTableQueryOperator::Less,
+              100.0) == TArray<int64>{0, 5});
+      TestTrue(
+          "String",
+          UCesiumPropertyTableBlueprintLibrary::FindFeatureIDsByString(
+              propertyTable,
+              "class",
+              ECesiumPropertyTableQueryOperator::NotEqual,
+              "residential") == TArray<int64>{2, 4, 5});
+    });
+  });
 }
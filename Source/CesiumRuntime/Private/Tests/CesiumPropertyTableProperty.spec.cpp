@@ -4272,4 +4272,116 @@ void FCesiumPropertyTablePropertySpec::Define() {
       }
     });
   });
+
+  Describe("FCesiumPropertyTablePropertyHandle", [this]() {
+    It("returns default values for invalid property", [this]() {
+      FCesiumPropertyTableProperty property;
+      FCesiumPropertyTablePropertyHandle handle(property);
+      TestFalse("isValid", handle.isValid());
+      TestEqual<int64>("size", handle.size(), 0);
+      TestEqual("value", handle.getFloat64(0, -1.0), -1.0);
+
+      const std::vector<int64> featureIDs{0, 1};
+      std::vector<double> values(featureIDs.size());
+      handle.getFloat64s(
+          TArrayView<const int64>(featureIDs.data(), int32(featureIDs.size())),
+          -1.0,
+          TArrayView<double>(values.data(), int32(values.size())));
+      TestEqual("first", values[0], -1.0);
+      TestEqual("second", values[1], -1.0);
+    });
+
+    It("gets the same values as the Blueprint functions", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::INT16;
+
+      std::vector<int16_t> values{-1, 0, 12, 300};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<int16_t> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+      FCesiumPropertyTablePropertyHandle handle(property);
+      TestTrue("isValid", handle.isValid());
+      TestEqual<int64>("size", handle.size(), int64(values.size()));
+
+      for (int64 i = -1; i <= int64(values.size()); ++i) {
+        TestEqual(
+            "boolean",
+            handle.getBoolean(i, true),
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetBoolean(
+                property,
+                i,
+                true));
+        TestEqual(
+            "integer64",
+            handle.getInteger64(i, 7),
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger64(
+                property,
+                i,
+                7));
+        TestEqual(
+            "float64",
+            handle.getFloat64(i, 7.5),
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
+                property,
+                i,
+                7.5));
+        TestEqual(
+            "vector",
+            handle.getVector(i, FVector(1.0)),
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetVector(
+                property,
+                i,
+                FVector(1.0)));
+      }
+    });
+
+    It("gets values for many features at once", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::FLOAT64;
+
+      std::vector<double> values{-1.1, 2.2, -3.3, 4.0};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<double> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+
+      const TArray<int64> featureIDs{3, 0, 10, 2, -1, 1};
+      TArray<double> result;
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64Values(
+          property,
+          featureIDs,
+          result,
+          0.5);
+
+      TestEqual("count", result.Num(), featureIDs.Num());
+      TestEqual("0", result[0], values[3]);
+      TestEqual("1", result[1], values[0]);
+      TestEqual("2", result[2], 0.5);
+      TestEqual("3", result[3], values[2]);
+      TestEqual("4", result[4], 0.5);
+      TestEqual("5", result[5], values[1]);
+
+      TArray<int64> integers;
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetInteger64Values(
+          property,
+          featureIDs,
+          integers,
+          -10);
+      TestEqual("integer", integers[0], int64(4));
+      TestEqual("integer default", integers[2], int64(-10));
+    });
+  });
 }
@@ -1,11 +1,36 @@
 #include "CesiumGltfSpecUtility.h"
 #include "CesiumPropertyArrayBlueprintLibrary.h"
 #include "CesiumPropertyTextureProperty.h"
+#include "Math/RandomStream.h"
 #include "Misc/AutomationTest.h"
 #include <limits>
 
 using namespace CesiumGltf;
 
+namespace {
+TArray<FVector2D> createUVs(int32 count) {
+  // Spans more than [0, 1] so that the sampler's wrapping is exercised too.
+  TArray<FVector2D> uvs;
+  uvs.Reserve(count);
+  FRandomStream random(42);
+  for (int32 i = 0; i < count; ++i) {
+    uvs.Emplace(random.FRandRange(-1.5, 1.5), random.FRandRange(-1.5, 1.5));
+  }
+  return uvs;
+}
+
+template <typename Func> double measureSeconds(Func&& func) {
+  const int32 repetitions = 3;
+  double best = std::numeric_limits<double>::max();
+  for (int32 i = 0; i < repetitions; ++i) {
+    const double start = FPlatformTime::Seconds();
+    func();
+    best = FMath::Min(best, FPlatformTime::Seconds() - start);
+  }
+  return best;
+}
+} // namespace
+
 BEGIN_DEFINE_SPEC(
     FCesiumPropertyTexturePropertySpec,
     "Cesium.Unit.PropertyTextureProperty",
@@ -2493,4 +2518,187 @@ void FCesiumPropertyTexturePropertySpec::Define() {
       }
     });
   });
+
+  Describe("Batched values", [this]() {
+    It("returns default values for invalid property", [this]() {
+      FCesiumPropertyTextureProperty property;
+      FCesiumPropertyTexturePropertyHandle handle(property);
+      TestFalse("isValid", handle.isValid());
+
+      TArray<double> values;
+      UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+          property,
+          createUVs(3),
+          values,
+          -1.0);
+      TestEqual("number of values", values.Num(), 3);
+      for (int32 i = 0; i < values.Num(); ++i) {
+        TestEqual(FString::Printf(TEXT("value%d"), i), values[i], -1.0);
+      }
+    });
+
+    It("matches GetFloat64 for scalar property", [this]() {
+      PropertyTextureProperty propertyTextureProperty;
+      propertyTextureProperty.channels = {0};
+
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+      classProperty.offset = 5.0;
+      classProperty.scale = 2.0;
+
+      Sampler sampler;
+      ImageCesium image;
+      image.width = 2;
+      image.height = 2;
+      image.channels = 1;
+      image.bytesPerChannel = 1;
+
+      std::vector<uint8_t> values{0, 128, 255, 0};
+      image.pixelData = GetValuesAsBytes(values);
+
+      PropertyTexturePropertyView<uint8_t, true> propertyView(
+          propertyTextureProperty,
+          classProperty,
+          sampler,
+          image);
+      FCesiumPropertyTextureProperty property(propertyView);
+
+      const TArray<FVector2D> uvs = createUVs(64);
+      TArray<double> batched;
+      UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+          property,
+          uvs,
+          batched,
+          -1.0);
+      TestEqual("number of values", batched.Num(), uvs.Num());
+
+      FCesiumPropertyTexturePropertyHandle handle(property);
+      TestTrue("isValid", handle.isValid());
+      for (int32 i = 0; i < uvs.Num(); ++i) {
+        const double expected =
+            UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64(
+                property,
+                uvs[i],
+                -1.0);
+        TestEqual(FString::Printf(TEXT("value%d"), i), batched[i], expected);
+        TestEqual(
+            FString::Printf(TEXT("float%d"), i),
+            handle.getFloat(uvs[i], -1.0f),
+            UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat(
+                property,
+                uvs[i],
+                -1.0f));
+      }
+    });
+
+    It("matches GetVector4 for vector property", [this]() {
+      PropertyTextureProperty propertyTextureProperty;
+      propertyTextureProperty.channels = {0, 1, 2, 3};
+
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::VEC4;
+      classProperty.componentType = ClassProperty::ComponentType::INT8;
+      classProperty.normalized = true;
+
+      Sampler sampler;
+      ImageCesium image;
+      image.width = 2;
+      image.height = 2;
+      image.channels = 4;
+      image.bytesPerChannel = 1;
+
+      std::vector<glm::i8vec4> values{
+          glm::i8vec4(1, 1, -1, 1),
+          glm::i8vec4(-1, -1, 2, 0),
+          glm::i8vec4(0, 4, 2, -8),
+          glm::i8vec4(10, 8, 5, 27)};
+      image.pixelData = GetValuesAsBytes(values);
+
+      PropertyTexturePropertyView<glm::i8vec4, true> propertyView(
+          propertyTextureProperty,
+          classProperty,
+          sampler,
+          image);
+      FCesiumPropertyTextureProperty property(propertyView);
+
+      const TArray<FVector2D> uvs = createUVs(64);
+      TArray<FVector4> batched;
+      UCesiumPropertyTexturePropertyBlueprintLibrary::GetVector4Values(
+          property,
+          uvs,
+          batched,
+          FVector4::Zero());
+      TestEqual("number of values", batched.Num(), uvs.Num());
+
+      for (int32 i = 0; i < uvs.Num(); ++i) {
+        TestEqual(
+            FString::Printf(TEXT("value%d"), i),
+            batched[i],
+            UCesiumPropertyTexturePropertyBlueprintLibrary::GetVector4(
+                property,
+                uvs[i],
+                FVector4::Zero()));
+      }
+    });
+
+    It("measures batched sampling against single samples", [this]() {
+      PropertyTextureProperty propertyTextureProperty;
+      propertyTextureProperty.channels = {0};
+
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+
+      const int32 size = 512;
+      Sampler sampler;
+      ImageCesium image;
+      image.width = size;
+      image.height = size;
+      image.channels = 1;
+      image.bytesPerChannel = 1;
+
+      std::vector<uint8_t> values(size_t(size * size));
+      for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = uint8_t(i % 251);
+      }
+      image.pixelData = GetValuesAsBytes(values);
+
+      PropertyTexturePropertyView<uint8_t, true> propertyView(
+          propertyTextureProperty,
+          classProperty,
+          sampler,
+          image);
+      FCesiumPropertyTextureProperty property(propertyView);
+
+      const TArray<FVector2D> uvs = createUVs(100000);
+      TArray<double> single;
+      TArray<double> batched;
+
+      const double singleSeconds = measureSeconds([&]() {
+        single.SetNum(uvs.Num());
+        for (int32 i = 0; i < uvs.Num(); ++i) {
+          single[i] =
+              UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64(
+                  property,
+                  uvs[i]);
+        }
+      });
+      const double batchedSeconds = measureSeconds([&]() {
+        UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+            property,
+            uvs,
+            batched);
+      });
+
+      TestTrue("same values", single == batched);
+      AddInfo(FString::Printf(
+          TEXT("Float64 values at %d UVs: %.3fms single, %.3fms batched"),
+          uvs.Num(),
+          singleSeconds * 1000.0,
+          batchedSeconds * 1000.0));
+    });
+  });
 }
@@ -0,0 +1,106 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureAtlasAllocator.h"
+#include "Misc/AutomationTest.h"
+
+using Slot = CesiumTextureAtlasAllocator::Slot;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureAtlasAllocatorSpec,
+    "Cesium.Unit.TextureAtlasAllocator",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTextureAtlasAllocatorSpec)
+
+void FCesiumTextureAtlasAllocatorSpec::Define() {
+  Describe("computeSlotSize", [this]() {
+    It("adds the gutter and rounds up to the alignment", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      TestEqual("square", allocator.computeSlotSize(256, 256), 272);
+      TestEqual("rectangle", allocator.computeSlotSize(100, 250), 272);
+      TestEqual("aligned", allocator.computeSlotSize(240, 240), 256);
+    });
+  });
+
+  Describe("allocate", [this]() {
+    It("fills a page from the top-left before adding another", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 0, 16);
+
+      TArray<Slot> slots;
+      for (int32 i = 0; i < 16; ++i) {
+        slots.Add(allocator.allocate(256, 256));
+      }
+      TestEqual("pages", allocator.getPageCount(), 1);
+      TestEqual("first x", slots[0].x, 0);
+      TestEqual("first y", slots[0].y, 0);
+      TestEqual("second x", slots[1].x, 256);
+      TestEqual("fifth y", slots[4].y, 256);
+      TestEqual("last x", slots[15].x, 768);
+      TestEqual("last y", slots[15].y, 768);
+
+      const Slot overflow = allocator.allocate(256, 256);
+      TestEqual("new page", overflow.page, 1);
+      TestEqual("pages", allocator.getPageCount(), 2);
+    });
+
+    It("reuses freed slots", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      const Slot first = allocator.allocate(256, 256);
+      const Slot second = allocator.allocate(256, 256);
+      allocator.free(first);
+
+      const Slot reused = allocator.allocate(256, 256);
+      TestEqual("page", reused.page, first.page);
+      TestEqual("x", reused.x, first.x);
+      TestEqual("y", reused.y, first.y);
+      TestEqual("pages", allocator.getPageCount(), 1);
+      TestTrue("other", second.x != reused.x || second.y != reused.y);
+    });
+
+    It("keeps different sizes on different pages", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      const Slot large = allocator.allocate(256, 256);
+      const Slot small = allocator.allocate(64, 64);
+      TestTrue("pages", large.page != small.page);
+      TestEqual("small size", small.size, 80);
+    });
+
+    It("divides empty pages again", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      const Slot large = allocator.allocate(256, 256);
+      allocator.free(large);
+
+      const Slot small = allocator.allocate(64, 64);
+      TestEqual("page", small.page, large.page);
+      TestEqual("size", small.size, 80);
+      TestEqual("pages", allocator.getPageCount(), 1);
+    });
+
+    It("rejects images too large for a page", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      TestFalse("too large", allocator.allocate(1020, 16).isValid());
+      TestFalse("empty", allocator.allocate(0, 16).isValid());
+      TestTrue("fits", allocator.allocate(1008, 16).isValid());
+      TestEqual("fallbacks", int32(allocator.getStatistics().fallbacks), 2);
+    });
+  });
+
+  Describe("getStatistics", [this]() {
+    It("counts pages, slots and pixels", [this]() {
+      CesiumTextureAtlasAllocator allocator(1024, 8, 16);
+      const Slot first = allocator.allocate(256, 128);
+      allocator.allocate(256, 256);
+      allocator.allocate(64, 64);
+      allocator.free(first);
+
+      const CesiumTextureAtlasAllocator::Statistics& statistics =
+          allocator.getStatistics();
+      TestEqual("pages", statistics.pages, 2);
+      TestEqual("slots", statistics.allocatedSlots, 2);
+      TestTrue("used", statistics.usedPixels == 256 * 256 + 64 * 64);
+      TestTrue("page pixels", statistics.pagePixels == 2 * 1024 * 1024);
+      TestEqual("allocations", int32(statistics.allocations), 3);
+      TestEqual("frees", int32(statistics.frees), 1);
+    });
+  });
+}
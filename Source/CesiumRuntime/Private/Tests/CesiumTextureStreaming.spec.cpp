@@ -0,0 +1,132 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureStreaming.h"
+#include "Misc/AutomationTest.h"
+
+namespace {
+
+CesiumStreamedTextureLevels
+createLevels(uint32 size, EPixelFormat format, double screenPixels) {
+  CesiumStreamedTextureLevels levels;
+  levels.width = size;
+  levels.height = size;
+  levels.format = format;
+  levels.mipCount = uint32(FMath::FloorLog2(size)) + 1;
+  levels.screenPixels = screenPixels;
+  return levels;
+}
+
+int64 computeTotalBytes(const TArray<CesiumStreamedTextureLevels>& textures) {
+  int64 bytes = 0;
+  for (const CesiumStreamedTextureLevels& texture : textures) {
+    bytes += CesiumTextureStreaming::computeBytes(texture, texture.firstMip);
+  }
+  return bytes;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureStreamingSpec,
+    "Cesium.Unit.TextureStreaming",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTextureStreamingSpec)
+
+void FCesiumTextureStreamingSpec::Define() {
+  Describe("computeBytes", [this]() {
+    It("includes every resident mip level", [this]() {
+      CesiumStreamedTextureLevels levels =
+          createLevels(4, PF_R8G8B8A8, 0.0);
+      TestTrue(
+          "full",
+          CesiumTextureStreaming::computeBytes(levels, 0) ==
+              (16 + 4 + 1) * 4);
+      TestTrue(
+          "dropped",
+          CesiumTextureStreaming::computeBytes(levels, 1) == (4 + 1) * 4);
+    });
+
+    It("counts whole blocks of compressed formats", [this]() {
+      CesiumStreamedTextureLevels levels = createLevels(8, PF_DXT1, 0.0);
+      // 8x8 is 4 blocks, and 4x4, 2x2 and 1x1 are one block each.
+      TestTrue(
+          "full",
+          CesiumTextureStreaming::computeBytes(levels, 0) ==
+              (4 + 1 + 1 + 1) * 8);
+    });
+  });
+
+  Describe("computeMaximumFirstMip", [this]() {
+    It("keeps the last mip level of uncompressed textures", [this]() {
+      CesiumStreamedTextureLevels levels =
+          createLevels(256, PF_R8G8B8A8, 0.0);
+      TestEqual(
+          "first mip",
+          int32(CesiumTextureStreaming::computeMaximumFirstMip(levels)),
+          8);
+    });
+
+    It("keeps whole blocks of compressed textures", [this]() {
+      CesiumStreamedTextureLevels levels = createLevels(256, PF_DXT1, 0.0);
+      TestEqual(
+          "first mip",
+          int32(CesiumTextureStreaming::computeMaximumFirstMip(levels)),
+          6);
+    });
+  });
+
+  Describe("chooseFirstMips", [this]() {
+    It("keeps every mip level when the textures fit", [this]() {
+      TArray<CesiumStreamedTextureLevels> textures{
+          createLevels(256, PF_R8G8B8A8, 0.0),
+          createLevels(256, PF_R8G8B8A8, 1000.0)};
+      CesiumTextureStreaming::chooseFirstMips(
+          textures,
+          computeTotalBytes(textures));
+      TestEqual("first", int32(textures[0].firstMip), 0);
+      TestEqual("second", int32(textures[1].firstMip), 0);
+    });
+
+    It("keeps every mip level without a budget", [this]() {
+      TArray<CesiumStreamedTextureLevels> textures{
+          createLevels(256, PF_R8G8B8A8, 0.0)};
+      CesiumTextureStreaming::chooseFirstMips(textures, 0);
+      TestEqual("first", int32(textures[0].firstMip), 0);
+    });
+
+    It("first drops detail the screen can't show", [this]() {
+      TArray<CesiumStreamedTextureLevels> textures{
+          createLevels(256, PF_R8G8B8A8, 64.0),
+          createLevels(256, PF_R8G8B8A8, 1000.0)};
+      const int64 budget =
+          CesiumTextureStreaming::computeBytes(textures[0], 2) +
+          CesiumTextureStreaming::computeBytes(textures[1], 0);
+      CesiumTextureStreaming::chooseFirstMips(textures, budget);
+      TestEqual("distant", int32(textures[0].firstMip), 2);
+      TestEqual("near", int32(textures[1].firstMip), 0);
+      TestTrue("fits", computeTotalBytes(textures) <= budget);
+    });
+
+    It("drops more detail from distant textures first", [this]() {
+      TArray<CesiumStreamedTextureLevels> textures{
+          createLevels(256, PF_R8G8B8A8, 500.0),
+          createLevels(256, PF_R8G8B8A8, 1000.0)};
+      const int64 budget =
+          CesiumTextureStreaming::computeBytes(textures[0], 1) +
+          CesiumTextureStreaming::computeBytes(textures[1], 0);
+      CesiumTextureStreaming::chooseFirstMips(textures, budget);
+      TestEqual("distant", int32(textures[0].firstMip), 1);
+      TestEqual("near", int32(textures[1].firstMip), 0);
+    });
+
+    It("keeps the least detailed mip levels", [this]() {
+      TArray<CesiumStreamedTextureLevels> textures{
+          createLevels(256, PF_DXT1, 1000.0),
+          createLevels(256, PF_R8G8B8A8, 1000.0)};
+      CesiumTextureStreaming::chooseFirstMips(textures, 1);
+      TestEqual("compressed", int32(textures[0].firstMip), 6);
+      TestEqual("uncompressed", int32(textures[1].firstMip), 8);
+    });
+  });
+}
@@ -0,0 +1,153 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTieredCacheDatabase.h"
+#include "Misc/AutomationTest.h"
+#include <map>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class FakeCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    ++this->reads;
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(HttpHeaders(requestHeaders), requestMethod, url),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> items;
+  mutable int32 reads = 0;
+};
+
+void store(ICacheDatabase& cache, const std::string& key, size_t size) {
+  std::vector<std::byte> data(size, std::byte(42));
+  cache.storeEntry(key, 0, key, "GET", {}, 200, {}, data);
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTieredCacheDatabaseSpec,
+    "Cesium.Unit.TieredCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+std::shared_ptr<FakeCacheDatabase> pDisk;
+END_DEFINE_SPEC(FCesiumTieredCacheDatabaseSpec)
+
+void FCesiumTieredCacheDatabaseSpec::Define() {
+  BeforeEach([this]() { pDisk = std::make_shared<FakeCacheDatabase>(); });
+
+  It("answers recently stored entries from memory", [this]() {
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024);
+    store(cache, "a", 1000);
+
+    std::optional<CacheItem> item = cache.getEntry("a");
+    TestTrue("found", item.has_value());
+    TestEqual("size", int64(item->cacheResponse.data.size()), int64(1000));
+    TestEqual("disk reads", pDisk->reads, 0);
+    TestTrue("stored on disk", pDisk->items.count("a") == 1);
+
+    CesiumCacheStatistics statistics = cache.getStatistics();
+    TestEqual("memory hits", statistics.memoryHits, int64(1));
+    TestEqual("disk bytes written", statistics.diskBytesWritten, int64(1000));
+  });
+
+  It("keeps entries read from disk in memory", [this]() {
+    store(*pDisk, "a", 1000);
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024);
+
+    TestTrue("first read", cache.getEntry("a").has_value());
+    TestTrue("second read", cache.getEntry("a").has_value());
+    TestEqual("disk reads", pDisk->reads, 1);
+
+    CesiumCacheStatistics statistics = cache.getStatistics();
+    TestEqual("memory hits", statistics.memoryHits, int64(1));
+    TestEqual("memory misses", statistics.memoryMisses, int64(1));
+    TestEqual("disk hits", statistics.diskHits, int64(1));
+    TestEqual("disk bytes read", statistics.diskBytesRead, int64(1000));
+  });
+
+  It("evicts the least recently used entries to stay in budget", [this]() {
+    CesiumTieredCacheDatabase cache(pDisk, 32 * 1024);
+    store(cache, "a", 3000);
+    store(cache, "b", 3000);
+    store(cache, "c", 3000);
+
+    // Use "a" so that "b" becomes the least recently used entry.
+    cache.getEntry("a");
+
+    for (int32 i = 0; i < 8; ++i) {
+      store(cache, "filler" + std::to_string(i), 3000);
+    }
+
+    CesiumCacheStatistics statistics = cache.getStatistics();
+    TestTrue("within budget", statistics.memoryBytes <= 32 * 1024);
+
+    pDisk->reads = 0;
+    cache.getEntry("b");
+    TestEqual("b was evicted", pDisk->reads, 1);
+  });
+
+  It("keeps large entries only on disk", [this]() {
+    CesiumTieredCacheDatabase cache(pDisk, 16 * 1024);
+    store(cache, "large", 8 * 1024);
+
+    TestEqual("memory entries", cache.getStatistics().memoryEntries, int64(0));
+    TestTrue("found", cache.getEntry("large").has_value());
+    TestEqual("disk reads", pDisk->reads, 1);
+  });
+
+  It("replaces entries that are stored again", [this]() {
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024);
+    store(cache, "a", 1000);
+    store(cache, "a", 2000);
+
+    std::optional<CacheItem> item = cache.getEntry("a");
+    TestEqual("size", int64(item->cacheResponse.data.size()), int64(2000));
+    TestEqual("memory entries", cache.getStatistics().memoryEntries, int64(1));
+  });
+
+  It("clears both tiers", [this]() {
+    CesiumTieredCacheDatabase cache(pDisk, 1024 * 1024);
+    store(cache, "a", 1000);
+    cache.clearAll();
+
+    TestFalse("found", cache.getEntry("a").has_value());
+    TestEqual("memory bytes", cache.getStatistics().memoryBytes, int64(0));
+  });
+}
@@ -0,0 +1,53 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileExclusionCache.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "Misc/AutomationTest.h"
+
+using namespace Cesium3DTilesSelection;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileExclusionCacheSpec,
+    "Cesium.Unit.TileExclusionCache",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTileExclusionCacheSpec)
+
+void FCesiumTileExclusionCacheSpec::Define() {
+  It("returns stored decisions", [this]() {
+    Tile tile(nullptr);
+    CesiumTileExclusionCache cache;
+    TestFalse("before store", cache.find(tile).has_value());
+
+    cache.store(tile, true);
+    TestTrue("after store", cache.find(tile) == std::optional<bool>(true));
+  });
+
+  It("ignores decisions for a different tile at the same address", [this]() {
+    Tile tile(nullptr);
+    CesiumTileExclusionCache cache;
+    cache.store(tile, true);
+
+    tile.setBoundingVolume(
+        CesiumGeometry::BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 4.0));
+    TestFalse("moved", cache.find(tile).has_value());
+  });
+
+  It("discards decisions that were not used in the last frame", [this]() {
+    Tile used(nullptr);
+    Tile unused(nullptr);
+    CesiumTileExclusionCache cache;
+    cache.store(used, false);
+    cache.store(unused, true);
+
+    cache.startNewFrame();
+    TestEqual("size after first frame", cache.size(), size_t(2));
+    TestTrue("used", cache.find(used).has_value());
+
+    cache.startNewFrame();
+    TestEqual("size after second frame", cache.size(), size_t(1));
+    TestTrue("still used", cache.find(used).has_value());
+    TestFalse("unused", cache.find(unused).has_value());
+  });
+}
@@ -0,0 +1,194 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumGeospatial/BoundingRegion.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumTileExclusionVolumes.h"
+#include "Misc/AutomationTest.h"
+#include <glm/trigonometric.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileExclusionVolumesSpec,
+    "Cesium.Unit.TileExclusionVolumes",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+CesiumTileExclusionIndex index;
+END_DEFINE_SPEC(FCesiumTileExclusionVolumesSpec)
+
+void FCesiumTileExclusionVolumesSpec::Define() {
+  BeforeEach([this]() { index = CesiumTileExclusionIndex(); });
+
+  Describe("Box", [this]() {
+    It("excludes tiles entirely inside the box", [this]() {
+      CesiumExclusionVolume volume;
+      volume.shape = CesiumExclusionBox{glm::dvec3(0.0), glm::dmat3(10.0)};
+      index.build({volume});
+
+      TestTrue(
+          "inside",
+          index.shouldExclude(BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 1.0)));
+      TestFalse(
+          "straddling",
+          index.shouldExclude(BoundingSphere(glm::dvec3(9.5, 0.0, 0.0), 1.0)));
+      TestFalse(
+          "outside",
+          index.shouldExclude(BoundingSphere(glm::dvec3(20.0, 0.0, 0.0), 1.0)));
+    });
+
+    It("respects rotated boxes", [this]() {
+      glm::dmat3 halfAxes(0.0);
+      halfAxes[0] = glm::dvec3(10.0, 10.0, 0.0);
+      halfAxes[1] = glm::dvec3(-1.0, 1.0, 0.0);
+      halfAxes[2] = glm::dvec3(0.0, 0.0, 1.0);
+
+      CesiumExclusionVolume volume;
+      volume.shape = CesiumExclusionBox{glm::dvec3(0.0), halfAxes};
+      index.build({volume});
+
+      TestTrue(
+          "along the diagonal",
+          index.shouldExclude(BoundingSphere(glm::dvec3(5.0, 5.0, 0.0), 0.5)));
+      TestFalse(
+          "across the diagonal",
+          index.shouldExclude(BoundingSphere(glm::dvec3(5.0, -5.0, 0.0), 0.5)));
+    });
+
+    It("excludes tiles entirely outside keep boxes", [this]() {
+      CesiumExclusionVolume volume;
+      volume.shape = CesiumExclusionBox{glm::dvec3(0.0), glm::dmat3(10.0)};
+      volume.excludeOutside = true;
+      index.build({volume});
+
+      TestFalse(
+          "inside",
+          index.shouldExclude(BoundingSphere(glm::dvec3(1.0, 2.0, 3.0), 1.0)));
+      TestFalse(
+          "straddling",
+          index.shouldExclude(BoundingSphere(glm::dvec3(9.5, 0.0, 0.0), 1.0)));
+      TestTrue(
+          "outside",
+          index.shouldExclude(BoundingSphere(glm::dvec3(20.0, 0.0, 0.0), 1.0)));
+    });
+  });
+
+  Describe("Sphere", [this]() {
+    It("excludes tiles inside or outside", [this]() {
+      CesiumExclusionVolume inside;
+      inside.shape = CesiumExclusionSphere{glm::dvec3(0.0), 10.0};
+      index.build({inside});
+
+      TestTrue(
+          "inside",
+          index.shouldExclude(
+              OrientedBoundingBox(glm::dvec3(1.0, 0.0, 0.0), glm::dmat3(1.0))));
+      TestFalse(
+          "corner outside",
+          index.shouldExclude(
+              OrientedBoundingBox(glm::dvec3(8.0, 0.0, 0.0), glm::dmat3(2.5))));
+
+      CesiumExclusionVolume outside;
+      outside.shape = CesiumExclusionSphere{glm::dvec3(0.0), 10.0};
+      outside.excludeOutside = true;
+      index.build({outside});
+
+      // The corner of this box is farther than 10 from the origin, but its
+      // closest point is not.
+      TestFalse(
+          "overlapping",
+          index.shouldExclude(
+              OrientedBoundingBox(glm::dvec3(8.0, 0.0, 0.0), glm::dmat3(2.5))));
+      TestTrue(
+          "disjoint",
+          index.shouldExclude(OrientedBoundingBox(
+              glm::dvec3(9.0, 9.0, 0.0),
+              glm::dmat3(1.0))));
+    });
+  });
+
+  Describe("Prism", [this]() {
+    It("excludes regions inside the polygon and height range", [this]() {
+      CesiumExclusionVolume volume;
+      volume.shape = CesiumExclusionPrism{
+          {glm::dvec2(glm::radians(-1.0), glm::radians(-1.0)),
+           glm::dvec2(glm::radians(1.0), glm::radians(-1.0)),
+           glm::dvec2(glm::radians(1.0), glm::radians(1.0)),
+           glm::dvec2(glm::radians(-1.0), glm::radians(1.0))},
+          -100.0,
+          100.0};
+      index.build({volume});
+
+      GlobeRectangle small = GlobeRectangle::fromDegrees(-0.5, -0.5, 0.5, 0.5);
+      TestTrue(
+          "inside",
+          index.shouldExclude(BoundingRegion(small, 0.0, 50.0)));
+      TestFalse(
+          "too high",
+          index.shouldExclude(BoundingRegion(small, 0.0, 500.0)));
+      TestFalse(
+          "partially outside",
+          index.shouldExclude(BoundingRegion(
+              GlobeRectangle::fromDegrees(0.5, 0.5, 1.5, 1.5),
+              0.0,
+              50.0)));
+    });
+
+    It("excludes regions outside keep polygons", [this]() {
+      CesiumExclusionVolume volume;
+      volume.shape = CesiumExclusionPrism{
+          {glm::dvec2(glm::radians(-1.0), glm::radians(-1.0)),
+           glm::dvec2(glm::radians(1.0), glm::radians(-1.0)),
+           glm::dvec2(glm::radians(0.0), glm::radians(1.0))},
+          -100.0,
+          100.0};
+      volume.excludeOutside = true;
+      index.build({volume});
+
+      TestFalse(
+          "overlapping",
+          index.shouldExclude(BoundingRegion(
+              GlobeRectangle::fromDegrees(-0.1, -0.1, 0.1, 0.1),
+              0.0,
+              50.0)));
+      TestTrue(
+          "beside the triangle",
+          index.shouldExclude(BoundingRegion(
+              GlobeRectangle::fromDegrees(0.8, 0.8, 0.9, 0.9),
+              0.0,
+              50.0)));
+      TestTrue(
+          "above the height range",
+          index.shouldExclude(BoundingRegion(
+              GlobeRectangle::fromDegrees(-0.1, -0.1, 0.1, 0.1),
+              200.0,
+              300.0)));
+    });
+  });
+
+  Describe("Index", [this]() {
+    It("finds the right volume among many", [this]() {
+      std::vector<CesiumExclusionVolume> volumes;
+      for (int i = 0; i < 100; ++i) {
+        CesiumExclusionVolume& volume = volumes.emplace_back();
+        volume.shape = CesiumExclusionSphere{
+            glm::dvec3(100.0 * i, 0.0, 0.0),
+            10.0};
+      }
+      index.build(std::move(volumes));
+
+      for (int i = 0; i < 100; ++i) {
+        TestTrue(
+            "inside",
+            index.shouldExclude(
+                BoundingSphere(glm::dvec3(100.0 * i + 1.0, 0.0, 0.0), 1.0)));
+        TestFalse(
+            "between",
+            index.shouldExclude(
+                BoundingSphere(glm::dvec3(100.0 * i + 50.0, 0.0, 0.0), 1.0)));
+      }
+    });
+  });
+}
@@ -0,0 +1,151 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexWelding.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumVertexWelding;
+
+namespace {
+
+FStaticMeshBuildVertex createVertex(
+    const FVector3f& position,
+    const FVector3f& normal,
+    const FVector2f& uv) {
+  FStaticMeshBuildVertex vertex;
+  FMemory::Memzero(vertex);
+  vertex.Position = position;
+  vertex.TangentZ = normal;
+  vertex.UVs[0] = uv;
+  vertex.Color = FColor::White;
+  return vertex;
+}
+
+// Creates the unindexed vertices of a quad split into two triangles, with a
+// flat normal for each triangle, like loadPrimitive does for primitives
+// without normals.
+TArray<FStaticMeshBuildVertex> createUnindexedQuad(float raisedCorner) {
+  const FVector3f corners[4] = {
+      FVector3f(0.0f, 0.0f, 0.0f),
+      FVector3f(1.0f, 0.0f, 0.0f),
+      FVector3f(1.0f, 1.0f, raisedCorner),
+      FVector3f(0.0f, 1.0f, 0.0f)};
+  const uint32 triangles[6] = {0, 1, 2, 0, 2, 3};
+
+  TArray<FStaticMeshBuildVertex> vertices;
+  for (int32 i = 0; i < 6; i += 3) {
+    const FVector3f& a = corners[triangles[i]];
+    const FVector3f& b = corners[triangles[i + 1]];
+    const FVector3f& c = corners[triangles[i + 2]];
+    const FVector3f normal =
+        FVector3f::CrossProduct(b - a, c - a).GetSafeNormal();
+    for (int32 j = 0; j < 3; ++j) {
+      const FVector3f& corner = corners[triangles[i + j]];
+      vertices.Add(
+          createVertex(corner, normal, FVector2f(corner.X, corner.Y)));
+    }
+  }
+  return vertices;
+}
+
+TArray<uint32> createIdentityIndices(int32 count) {
+  TArray<uint32> indices;
+  for (int32 i = 0; i < count; ++i) {
+    indices.Add(uint32(i));
+  }
+  return indices;
+}
+
+// Checks that every corner of the welded mesh is identical to the same corner
+// of the unindexed mesh.
+bool matchesUnindexed(
+    const TArray<FStaticMeshBuildVertex>& unindexed,
+    const TArray<FStaticMeshBuildVertex>& welded,
+    const TArray<uint32>& indices) {
+  if (indices.Num() != unindexed.Num()) {
+    return false;
+  }
+
+  for (int32 i = 0; i < indices.Num(); ++i) {
+    if (!welded.IsValidIndex(int32(indices[i]))) {
+      return false;
+    }
+    const FStaticMeshBuildVertex& a = unindexed[i];
+    const FStaticMeshBuildVertex& b = welded[int32(indices[i])];
+    if (a.Position != b.Position || a.TangentX != b.TangentX ||
+        a.TangentY != b.TangentY || a.TangentZ != b.TangentZ ||
+        a.UVs[0] != b.UVs[0] || a.Color != b.Color) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVertexWeldingSpec,
+    "Cesium.Unit.VertexWelding",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumVertexWeldingSpec)
+
+void FCesiumVertexWeldingSpec::Define() {
+  Describe("weldVertices", [this]() {
+    It("merges the shared corners of a flat quad", [this]() {
+      const TArray<FStaticMeshBuildVertex> unindexed = createUnindexedQuad(0);
+      TArray<FStaticMeshBuildVertex> vertices = unindexed;
+      TArray<uint32> indices = createIdentityIndices(vertices.Num());
+
+      weldVertices(vertices, indices, 1, true);
+
+      TestEqual("vertices", vertices.Num(), 4);
+      TestTrue("matches", matchesUnindexed(unindexed, vertices, indices));
+    });
+
+    It("keeps corners whose flat normals differ", [this]() {
+      const TArray<FStaticMeshBuildVertex> unindexed =
+          createUnindexedQuad(0.5f);
+      TArray<FStaticMeshBuildVertex> vertices = unindexed;
+      TArray<uint32> indices = createIdentityIndices(vertices.Num());
+
+      weldVertices(vertices, indices, 1, true);
+
+      TestEqual("vertices", vertices.Num(), 6);
+      TestTrue("matches", matchesUnindexed(unindexed, vertices, indices));
+    });
+
+    It("compares only the attributes that are used", [this]() {
+      const TArray<FStaticMeshBuildVertex> unindexed = createUnindexedQuad(0);
+
+      TArray<FStaticMeshBuildVertex> vertices = unindexed;
+      for (int32 i = 0; i < vertices.Num(); ++i) {
+        vertices[i].UVs[1] = FVector2f(float(i), 0.0f);
+        vertices[i].Color = FColor(uint8(i), 0, 0, 255);
+      }
+      const TArray<FStaticMeshBuildVertex> withUnusedAttributes = vertices;
+
+      TArray<uint32> indices = createIdentityIndices(vertices.Num());
+      weldVertices(vertices, indices, 1, false);
+      TestEqual("ignored", vertices.Num(), 4);
+
+      vertices = withUnusedAttributes;
+      indices = createIdentityIndices(vertices.Num());
+      weldVertices(vertices, indices, 2, true);
+      TestEqual("compared", vertices.Num(), 6);
+      TestTrue(
+          "matches",
+          matchesUnindexed(withUnusedAttributes, vertices, indices));
+    });
+
+    It("keeps vertices in the order they are first used", [this]() {
+      TArray<FStaticMeshBuildVertex> vertices = createUnindexedQuad(0);
+      const FVector3f firstPosition = vertices[0].Position;
+      TArray<uint32> indices = createIdentityIndices(vertices.Num());
+
+      weldVertices(vertices, indices, 1, true);
+
+      TestTrue("first", vertices[0].Position == firstPosition);
+      TestTrue("indices", indices == TArray<uint32>({0, 1, 2, 0, 2, 3}));
+    });
+  });
+}
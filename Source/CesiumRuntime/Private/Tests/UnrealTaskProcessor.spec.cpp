@@ -0,0 +1,186 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include "UnrealTaskProcessor.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FUnrealTaskProcessorSpec,
+    "Cesium.Unit.UnrealTaskProcessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+std::unique_ptr<UnrealTaskProcessor> pProcessor;
+std::atomic<bool> gateOpen;
+std::atomic<bool> gateReached;
+std::mutex orderMutex;
+std::vector<int32> order;
+
+// Occupies the processor's only worker thread until the gate is opened, so
+// that the tasks queued in the meantime are all waiting at the same time.
+void closeGate() {
+  gateOpen = false;
+  gateReached = false;
+  pProcessor->startTask([this]() {
+    gateReached = true;
+    while (!gateOpen) {
+      FPlatformProcess::Sleep(0.001f);
+    }
+  });
+  while (!gateReached) {
+    FPlatformProcess::Sleep(0.001f);
+  }
+}
+
+void record(uint32 owner, int32 value) {
+  CesiumTaskScope scope(owner);
+  pProcessor->startTask([this, value]() {
+    std::scoped_lock<std::mutex> lock(orderMutex);
+    order.push_back(value);
+  });
+}
+
+void openGateAndWait(size_t expectedCount) {
+  gateOpen = true;
+  for (;;) {
+    {
+      std::scoped_lock<std::mutex> lock(orderMutex);
+      if (order.size() >= expectedCount) {
+        break;
+      }
+    }
+    FPlatformProcess::Sleep(0.001f);
+  }
+}
+
+END_DEFINE_SPEC(FUnrealTaskProcessorSpec)
+
+void FUnrealTaskProcessorSpec::Define() {
+  BeforeEach([this]() {
+    pProcessor = std::make_unique<UnrealTaskProcessor>(1);
+    order.clear();
+  });
+
+  AfterEach([this]() {
+    gateOpen = true;
+    pProcessor.reset();
+  });
+
+  It("starts tasks in higher-priority lanes first", [this]() {
+    uint32 preload = pProcessor->createOwner(ECesiumTaskLane::Preload);
+    uint32 inView = pProcessor->createOwner(ECesiumTaskLane::InView);
+
+    closeGate();
+    record(UnrealTaskProcessor::UnownedTasks, 5);
+    record(preload, 3);
+    record(inView, 1);
+    record(preload, 4);
+    record(inView, 2);
+    openGateAndWait(5);
+
+    TestTrue("order", order == std::vector<int32>{1, 2, 3, 4, 5});
+  });
+
+  It("alternates between owners in the same lane", [this]() {
+    uint32 first = pProcessor->createOwner(ECesiumTaskLane::InView);
+    uint32 second = pProcessor->createOwner(ECesiumTaskLane::InView);
+
+    closeGate();
+    record(first, 1);
+    record(first, 3);
+    record(first, 4);
+    record(second, 2);
+    openGateAndWait(4);
+
+    TestTrue("order", order == std::vector<int32>{1, 2, 3, 4});
+  });
+
+  It("moves queued tasks when an owner changes lanes", [this]() {
+    uint32 moved = pProcessor->createOwner(ECesiumTaskLane::Preload);
+    uint32 stays = pProcessor->createOwner(ECesiumTaskLane::Preload);
+
+    closeGate();
+    record(stays, 3);
+    record(moved, 1);
+    record(moved, 2);
+    pProcessor->setOwnerLane(moved, ECesiumTaskLane::InView);
+    openGateAndWait(3);
+
+    TestTrue("order", order == std::vector<int32>{1, 2, 3});
+  });
+
+  It("demotes the queued tasks of released owners", [this]() {
+    uint32 released = pProcessor->createOwner(ECesiumTaskLane::InView);
+    uint32 preload = pProcessor->createOwner(ECesiumTaskLane::Preload);
+
+    closeGate();
+    record(released, 2);
+    record(preload, 1);
+    pProcessor->releaseOwner(released);
+    openGateAndWait(2);
+
+    TestTrue("order", order == std::vector<int32>{1, 2});
+  });
+
+  It("runs tasks in the scope of their owner", [this]() {
+    uint32 owner = pProcessor->createOwner(ECesiumTaskLane::InView);
+    std::atomic<uint32> observedOwner{UnrealTaskProcessor::UnownedTasks};
+    std::atomic<bool> done{false};
+
+    {
+      CesiumTaskScope scope(owner);
+      pProcessor->startTask([&observedOwner, &done]() {
+        observedOwner = CesiumTaskScope::current();
+        done = true;
+      });
+    }
+
+    TestTrue(
+        "scope restored",
+        CesiumTaskScope::current() == UnrealTaskProcessor::UnownedTasks);
+
+    while (!done) {
+      FPlatformProcess::Sleep(0.001f);
+    }
+    TestTrue("observed owner", observedOwner == owner);
+  });
+
+  It("reports statistics for each lane", [this]() {
+    uint32 preload = pProcessor->createOwner(ECesiumTaskLane::Preload);
+
+    closeGate();
+    record(preload, 1);
+    record(preload, 2);
+
+    auto queued = pProcessor->getStatistics();
+    TestEqual(
+        "queued preload tasks",
+        queued[size_t(ECesiumTaskLane::Preload)].queuedTasks,
+        2);
+
+    openGateAndWait(2);
+    pProcessor->shutdown();
+
+    auto finished = pProcessor->getStatistics();
+    TestEqual(
+        "started preload tasks",
+        finished[size_t(ECesiumTaskLane::Preload)].startedTasks,
+        int64(2));
+    TestEqual(
+        "remaining preload tasks",
+        finished[size_t(ECesiumTaskLane::Preload)].queuedTasks,
+        0);
+  });
+
+  It("runs tasks immediately after shutdown", [this]() {
+    pProcessor->shutdown();
+
+    bool ran = false;
+    pProcessor->startTask([&ran]() { ran = true; });
+    TestTrue("ran", ran);
+  });
+}
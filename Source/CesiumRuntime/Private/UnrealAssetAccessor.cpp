@@ -16,6 +16,7 @@
 #include "Misc/App.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/FileHelper.h"
+#include "UnrealTaskProcessor.h"
 #include <cstddef>
 #include <cstring>
 #include <optional>
@@ -167,6 +168,9 @@ UnrealAssetAccessor::get(
 
   return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
       [&url, &headers, &userAgent, &cesiumRequestHeaders](const auto& promise) {
+        // Continuations of this request are queued for whoever requested it.
+        const uint32 taskOwner = CesiumTaskScope::current();
+
         FHttpModule& httpModule = FHttpModule::Get();
         TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
             httpModule.CreateRequest();
@@ -185,13 +189,15 @@ UnrealAssetAccessor::get(
         pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
 
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
+            [promise, taskOwner, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) mutable {
               CESIUM_TRACE_USE_CAPTURED_TRACK();
               CESIUM_TRACE_END_IN_TRACK("requestAsset");
 
+              CesiumTaskScope scope(taskOwner);
+
               if (connectedSuccessfully) {
                 promise.resolve(
                     std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
@@ -228,6 +234,8 @@ UnrealAssetAccessor::request(
        &userAgent,
        &cesiumRequestHeaders,
        &contentPayload](const auto& promise) {
+        const uint32 taskOwner = CesiumTaskScope::current();
+
         FHttpModule& httpModule = FHttpModule::Get();
         TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
             httpModule.CreateRequest();
@@ -251,10 +259,11 @@ UnrealAssetAccessor::request(
             contentPayload.size()));
 
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise](
+            [promise, taskOwner](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) {
+              CesiumTaskScope scope(taskOwner);
               if (connectedSuccessfully) {
                 promise.resolve(
                     std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
@@ -357,6 +366,7 @@ public:
       const std::string& url,
       const CesiumAsync::AsyncSystem& asyncSystem)
       : _url(url),
+        _taskOwner(CesiumTaskScope::current()),
         _promise(
             asyncSystem
                 .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()) {
@@ -373,6 +383,7 @@ public:
   }
 
   void DoWork() {
+    CesiumTaskScope scope(this->_taskOwner);
     FString filename =
         UTF8_TO_TCHAR(convertFileUriToFilename(this->_url).c_str());
     TArray64<uint8> data;
@@ -391,6 +402,7 @@ public:
 
 private:
   std::string _url;
+  uint32 _taskOwner;
   CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> _promise;
 };
 
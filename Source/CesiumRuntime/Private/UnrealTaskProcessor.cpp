@@ -1,12 +1,404 @@
 // Copyright 2020-2021 CesiumGS, Inc. and Contributors
 
 #include "UnrealTaskProcessor.h"
-#include "Async/Async.h"
-#include "Misc/QueuedThreadPool.h"
+#include "CesiumRuntime.h"
+#include "CesiumStats.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Queued In-View Tasks"),
+    STAT_CesiumQueuedInViewTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Queued Preload Tasks"),
+    STAT_CesiumQueuedPreloadTasks,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Queued Background Tasks"),
+    STAT_CesiumQueuedBackgroundTasks,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("In-View Task Latency (ms)"),
+    STAT_CesiumInViewTaskLatency,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Preload Task Latency (ms)"),
+    STAT_CesiumPreloadTaskLatency,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Background Task Latency (ms)"),
+    STAT_CesiumBackgroundTaskLatency,
+    STATGROUP_Cesium);
+
+namespace {
+
+constexpr size_t LaneCount = size_t(ECesiumTaskLane::Count);
+
+// How much each started task contributes to a lane's recent average latency.
+constexpr double LatencySmoothing = 0.05;
+
+thread_local uint32 currentTaskOwner = UnrealTaskProcessor::UnownedTasks;
+
+void publishQueueDepth(ECesiumTaskLane lane, int32 queuedTasks) {
+  switch (lane) {
+  case ECesiumTaskLane::InView:
+    SET_DWORD_STAT(STAT_CesiumQueuedInViewTasks, queuedTasks);
+    break;
+  case ECesiumTaskLane::Preload:
+    SET_DWORD_STAT(STAT_CesiumQueuedPreloadTasks, queuedTasks);
+    break;
+  default:
+    SET_DWORD_STAT(STAT_CesiumQueuedBackgroundTasks, queuedTasks);
+    break;
+  }
+}
+
+void publishLatency(ECesiumTaskLane lane, double latencySeconds) {
+  const float latencyMilliseconds = float(latencySeconds * 1000.0);
+  switch (lane) {
+  case ECesiumTaskLane::InView:
+    SET_FLOAT_STAT(STAT_CesiumInViewTaskLatency, latencyMilliseconds);
+    break;
+  case ECesiumTaskLane::Preload:
+    SET_FLOAT_STAT(STAT_CesiumPreloadTaskLatency, latencyMilliseconds);
+    break;
+  default:
+    SET_FLOAT_STAT(STAT_CesiumBackgroundTaskLatency, latencyMilliseconds);
+    break;
+  }
+}
+
+} // namespace
+
+class UnrealTaskProcessor::Scheduler {
+public:
+  explicit Scheduler(int32 threadCount) {
+    this->_owners[UnrealTaskProcessor::UnownedTasks].lane =
+        ECesiumTaskLane::Background;
+
+    if (!FPlatformProcess::SupportsMultithreading()) {
+      // Every task runs on the thread that starts it.
+      this->_acceptingTasks = false;
+      return;
+    }
+
+    if (threadCount <= 0) {
+      threadCount =
+          FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+    }
+
+    for (int32 i = 0; i < threadCount; ++i) {
+      std::unique_ptr<Worker> pWorker = std::make_unique<Worker>(*this);
+      FRunnableThread* pThread = FRunnableThread::Create(
+          pWorker.get(),
+          *FString::Printf(TEXT("CesiumTaskWorker%d"), i),
+          0,
+          TPri_BelowNormal);
+      if (pThread) {
+        this->_workers.push_back(std::move(pWorker));
+        this->_threads.push_back(pThread);
+      }
+    }
+
+    if (this->_threads.empty()) {
+      this->_acceptingTasks = false;
+    }
+  }
+
+  ~Scheduler() { this->shutdown(); }
+
+  /**
+   * Queues a task, or returns false if the task must be run by the caller
+   * because the scheduler has no worker threads.
+   */
+  bool enqueue(uint32 owner, std::function<void()>&& f) {
+    ECesiumTaskLane lane = ECesiumTaskLane::Background;
+    int32 queuedTasks = 0;
+
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      if (!this->_acceptingTasks) {
+        return false;
+      }
+
+      auto it = this->_owners.find(owner);
+      if (it == this->_owners.end()) {
+        // The owner has been released and all of its earlier tasks have
+        // started, so this is follow-up work that nobody is waiting for.
+        owner = UnrealTaskProcessor::UnownedTasks;
+        it = this->_owners.find(owner);
+      }
+
+      it->second.tasks.push_back(
+          QueuedTask{std::move(f), owner, FPlatformTime::Seconds()});
+
+      lane = it->second.lane;
+      queuedTasks = ++this->_statistics[size_t(lane)].queuedTasks;
+      ++this->_totalQueuedTasks;
+    }
+
+    this->_taskAvailable.notify_one();
+    publishQueueDepth(lane, queuedTasks);
+    return true;
+  }
+
+  uint32 createOwner(ECesiumTaskLane lane) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    const uint32 owner = this->_nextOwner++;
+    this->_owners[owner].lane = lane;
+    return owner;
+  }
+
+  void setOwnerLane(uint32 owner, ECesiumTaskLane lane) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto it = this->_owners.find(owner);
+    if (it == this->_owners.end() || it->second.released ||
+        owner == UnrealTaskProcessor::UnownedTasks) {
+      return;
+    }
+
+    this->moveOwner(it->second, lane);
+  }
+
+  void releaseOwner(uint32 owner) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto it = this->_owners.find(owner);
+    if (it == this->_owners.end() ||
+        owner == UnrealTaskProcessor::UnownedTasks) {
+      return;
+    }
+
+    if (it->second.tasks.empty()) {
+      this->_owners.erase(it);
+      return;
+    }
+
+    it->second.released = true;
+    this->moveOwner(it->second, ECesiumTaskLane::Background);
+  }
+
+  std::array<CesiumTaskLaneStatistics, LaneCount> getStatistics() const {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    return this->_statistics;
+  }
+
+  void shutdown() {
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      if (this->_stopping) {
+        return;
+      }
+      this->_stopping = true;
+    }
+
+    // The workers run every queued task before they exit, including tasks
+    // that are started while they do so. Once a worker finds the queue empty,
+    // new tasks run on the thread that starts them.
+    this->_taskAvailable.notify_all();
+    for (FRunnableThread* pThread : this->_threads) {
+      pThread->WaitForCompletion();
+      delete pThread;
+    }
+
+    this->_threads.clear();
+    this->_workers.clear();
+  }
+
+private:
+  struct QueuedTask {
+    std::function<void()> f;
+    uint32 owner;
+    double queuedTime;
+  };
+
+  struct Owner {
+    ECesiumTaskLane lane = ECesiumTaskLane::Background;
+    bool released = false;
+    std::deque<QueuedTask> tasks;
+  };
+
+  class Worker : public FRunnable {
+  public:
+    explicit Worker(Scheduler& scheduler) : _scheduler(scheduler) {}
+
+    virtual uint32 Run() override {
+      this->_scheduler.runWorker();
+      return 0;
+    }
+
+  private:
+    Scheduler& _scheduler;
+  };
+
+  void runWorker() {
+    QueuedTask task;
+    while (this->waitForTask(task)) {
+      CesiumTaskScope scope(task.owner);
+      {
+        TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
+        task.f();
+      }
+      task.f = nullptr;
+    }
+  }
+
+  bool waitForTask(QueuedTask& task) {
+    ECesiumTaskLane lane = ECesiumTaskLane::Background;
+    int32 queuedTasks = 0;
+    double latency = 0.0;
+
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_taskAvailable.wait(lock, [this]() {
+        return this->_totalQueuedTasks > 0 || this->_stopping;
+      });
+
+      if (this->_totalQueuedTasks == 0) {
+        // Stopping and nothing left to do. From now on, tasks run on the
+        // thread that starts them.
+        this->_acceptingTasks = false;
+        return false;
+      }
+
+      auto it = this->findNextOwner(lane);
+      Owner& owner = it->second;
+
+      task = std::move(owner.tasks.front());
+      owner.tasks.pop_front();
+      --this->_totalQueuedTasks;
+      this->_lastServedOwner[size_t(lane)] = it->first;
+
+      CesiumTaskLaneStatistics& statistics = this->_statistics[size_t(lane)];
+      queuedTasks = --statistics.queuedTasks;
+
+      latency = FPlatformTime::Seconds() - task.queuedTime;
+      statistics.recentAverageLatencySeconds =
+          statistics.startedTasks == 0
+              ? latency
+              : statistics.recentAverageLatencySeconds +
+                    (latency - statistics.recentAverageLatencySeconds) *
+                        LatencySmoothing;
+      statistics.maximumLatencySeconds =
+          FMath::Max(statistics.maximumLatencySeconds, latency);
+      ++statistics.startedTasks;
+
+      if (owner.released && owner.tasks.empty()) {
+        this->_owners.erase(it);
+      }
+    }
+
+    publishQueueDepth(lane, queuedTasks);
+    publishLatency(lane, latency);
+    return true;
+  }
+
+  /**
+   * Finds the owner whose task should start next: the first owner in the
+   * highest-priority lane with queued tasks that comes after the owner that
+   * was served last in that lane. Must only be called with the mutex locked
+   * and at least one task queued.
+   */
+  std::map<uint32, Owner>::iterator findNextOwner(ECesiumTaskLane& lane) {
+    for (size_t laneIndex = 0; laneIndex < LaneCount; ++laneIndex) {
+      if (this->_statistics[laneIndex].queuedTasks == 0) {
+        continue;
+      }
+
+      lane = ECesiumTaskLane(laneIndex);
+      auto isCandidate = [lane](const std::pair<const uint32, Owner>& owner) {
+        return owner.second.lane == lane && !owner.second.tasks.empty();
+      };
+
+      auto start =
+          this->_owners.upper_bound(this->_lastServedOwner[laneIndex]);
+      for (auto it = start; it != this->_owners.end(); ++it) {
+        if (isCandidate(*it)) {
+          return it;
+        }
+      }
+      for (auto it = this->_owners.begin(); it != start; ++it) {
+        if (isCandidate(*it)) {
+          return it;
+        }
+      }
+    }
+
+    check(false);
+    return this->_owners.begin();
+  }
+
+  void moveOwner(Owner& owner, ECesiumTaskLane lane) {
+    if (owner.lane == lane) {
+      return;
+    }
+
+    const int32 count = int32(owner.tasks.size());
+    this->_statistics[size_t(owner.lane)].queuedTasks -= count;
+    this->_statistics[size_t(lane)].queuedTasks += count;
+    owner.lane = lane;
+  }
+
+  mutable std::mutex _mutex;
+  std::condition_variable _taskAvailable;
+
+  std::map<uint32, Owner> _owners;
+  uint32 _nextOwner = UnrealTaskProcessor::UnownedTasks + 1;
+  std::array<uint32, LaneCount> _lastServedOwner{};
+  std::array<CesiumTaskLaneStatistics, LaneCount> _statistics{};
+  int32 _totalQueuedTasks = 0;
+  bool _acceptingTasks = true;
+  bool _stopping = false;
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<FRunnableThread*> _threads;
+};
+
+UnrealTaskProcessor::UnrealTaskProcessor(int32 threadCount)
+    : _pScheduler(std::make_unique<Scheduler>(threadCount)) {}
+
+UnrealTaskProcessor::~UnrealTaskProcessor() = default;
 
 void UnrealTaskProcessor::startTask(std::function<void()> f) {
-  AsyncTask(ENamedThreads::Type::AnyBackgroundThreadNormalTask, [f]() {
+  // The scheduler only takes the task if it accepts it.
+  const uint32 owner = CesiumTaskScope::current();
+  if (!this->_pScheduler->enqueue(owner, std::move(f))) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
     f();
-  });
+  }
 }
+
+uint32 UnrealTaskProcessor::createOwner(ECesiumTaskLane lane) {
+  return this->_pScheduler->createOwner(lane);
+}
+
+void UnrealTaskProcessor::setOwnerLane(uint32 owner, ECesiumTaskLane lane) {
+  this->_pScheduler->setOwnerLane(owner, lane);
+}
+
+void UnrealTaskProcessor::releaseOwner(uint32 owner) {
+  this->_pScheduler->releaseOwner(owner);
+}
+
+std::array<CesiumTaskLaneStatistics, size_t(ECesiumTaskLane::Count)>
+UnrealTaskProcessor::getStatistics() const {
+  return this->_pScheduler->getStatistics();
+}
+
+void UnrealTaskProcessor::shutdown() { this->_pScheduler->shutdown(); }
+
+CesiumTaskScope::CesiumTaskScope(uint32 owner) : _previous(currentTaskOwner) {
+  currentTaskOwner = owner;
+}
+
+CesiumTaskScope::~CesiumTaskScope() { currentTaskOwner = this->_previous; }
+
+uint32 CesiumTaskScope::current() { return currentTaskOwner; }
@@ -6,12 +6,16 @@
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "Cesium3DTilesSelection/ViewUpdateResult.h"
 #include "Cesium3DTilesetLoadFailureDetails.h"
+#include "CesiumComponentPoolStatistics.h"
 #include "CesiumCreditSystem.h"
 #include "CesiumEncodedMetadataComponent.h"
 #include "CesiumFeaturesMetadataComponent.h"
 #include "CesiumGeoreference.h"
+#include "CesiumGltfMemoryStatistics.h"
 #include "CesiumIonServer.h"
+#include "CesiumPickingStatistics.h"
 #include "CesiumPointCloudShading.h"
+#include "CesiumTextureCompression.h"
 #include "CoreMinimal.h"
 #include "CustomDepthParameters.h"
 #include "Engine/EngineTypes.h"
@@ -30,7 +34,10 @@ class UMaterialInterface;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
 class UCesiumBoundingVolumePoolComponent;
+class UCesiumGltfComponentPool;
+class UCesiumMaterialInstanceCache;
 class CesiumViewExtension;
+class CesiumGeometricTileExcluderAdapter;
 struct FCesiumCamera;
 
 namespace Cesium3DTilesSelection {
@@ -238,6 +245,18 @@ private:
       Meta = (AllowPrivateAccess))
   UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
 
+  /**
+   * The pool that recycles the components of unloaded tiles.
+   */
+  UPROPERTY(Transient)
+  UCesiumGltfComponentPool* GltfComponentPool = nullptr;
+
+  /**
+   * The material instances shared by this tileset's primitives.
+   */
+  UPROPERTY(Transient)
+  UCesiumMaterialInstanceCache* MaterialInstanceCache = nullptr;
+
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -396,6 +415,86 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
   int64 MaximumCachedBytes = 256 * 1024 * 1024;
 
+  /**
+   * The maximum number of unloaded tile components that are kept so that they
+   * can be reused by later tile loads.
+   *
+   * Recycling components, rather than destroying them and creating new ones,
+   * reduces object churn and garbage collection hitches when the camera moves
+   * back and forth over the same area. Set this to 0 to disable pooling.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumPooledTileComponents = 64;
+
+  /**
+   * The maximum number of unloaded primitive components, each with its static
+   * mesh and material instance, that are kept so that they can be reused by
+   * later tile loads. Set this to 0 to disable pooling of primitives.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0))
+  int32 MaximumPooledPrimitiveComponents = 256;
+
+  /**
+   * Gets statistics about how often tile loads were able to reuse pooled
+   * components. See MaximumPooledTileComponents.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  FCesiumComponentPoolStatistics GetComponentPoolStatistics() const;
+
+  /**
+   * Whether the CPU copies of each tile's glTF vertices, indices, and images
+   * are released once the tile has been uploaded to the GPU. Only the data
+   * that metadata queries and picking read is kept: property tables, feature
+   * ID and property textures, and the geometry of primitives that have
+   * features or metadata. Geometry that raster overlays are draped on is also
+   * kept, because it is subdivided to create more detailed tiles for the
+   * overlays. Images are kept if TextureMemoryBudgetInMegabytes is set in the
+   * Cesium project settings, because dropped mip levels are restored from
+   * them.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetReleaseGltfDataAfterUpload,
+      BlueprintSetter = SetReleaseGltfDataAfterUpload,
+      Category = "Cesium|Tile Loading")
+  bool ReleaseGltfDataAfterUpload = false;
+
+  /**
+   * Gets the CPU memory used by the glTF data of this tileset's loaded tiles.
+   * See ReleaseGltfDataAfterUpload.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  FCesiumGltfMemoryStatistics GetGltfMemoryStatistics() const;
+
+  /**
+   * Gets statistics about the bounding volume hierarchies that the loaded
+   * tiles of this tileset have built to be picked without physics meshes.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  FCesiumPickingStatistics GetPickingStatistics() const;
+
+  /**
+   * A directory of tiles that were pre-baked for this tileset with the
+   * CesiumPrebakeTileset commandlet. Tiles found in it are loaded without
+   * computing their vertices, normals, and tangents again. Pre-baked tiles are
+   * not used when the tileset generates smooth normals, and not used for
+   * primitives that have raster overlays or encoded metadata.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (RelativeToGameDir))
+  FDirectoryPath PrebakedTilesDirectory;
+
   /**
    * The number of loading descendents a tile should allow before deciding to
    * render itself instead of waiting.
@@ -628,6 +727,21 @@ public:
       Category = "Cesium|Rendering")
   bool UseLodTransitions = false;
 
+  /**
+   * Whether primitives that have no textures of their own, and that would get
+   * identical material parameters, share a single material instance.
+   *
+   * Sharing material instances allows Unreal to batch the draw calls of these
+   * primitives and avoids creating and updating a material instance for each
+   * of them, which helps with tilesets made of many small untextured parts.
+   * Primitives stop sharing their material instance as soon as a raster
+   * overlay is attached to them. With LOD transitions enabled, only materials
+   * that read the DitherFade layer's FadePercentage and FadingType parameters
+   * from custom primitive data can be shared.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Rendering")
+  bool ShareMaterialInstances = false;
+
   /**
    * How long dithered LOD transitions between different tiles should take, in
    * seconds.
@@ -728,6 +842,9 @@ private:
    * meshes will not be created.
    *
    * Physics meshes cannot be generated for primitives containing points.
+   *
+   * Tilesets that only need to be picked don't need physics meshes, see
+   * UCesiumMetadataPickingBlueprintLibrary's LineTraceTileset.
    */
   UPROPERTY(
       EditAnywhere,
@@ -821,6 +938,21 @@ private:
       meta = (DisplayName = "Ignore KHR_materials_unlit"))
   bool IgnoreKhrMaterialsUnlit = false;
 
+  /**
+   * How the uncompressed images of this tileset's glTF tiles, such as JPEGs
+   * and PNGs, are compressed before they are uploaded to the GPU. Images that
+   * are already compressed, normal maps, and images whose size isn't a
+   * multiple of four are never compressed. This has no effect on platforms
+   * that don't support BC texture formats.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTextureCompression,
+      BlueprintSetter = SetTextureCompression,
+      Category = "Cesium|Rendering")
+  ECesiumTextureCompression TextureCompression =
+      ECesiumTextureCompression::None;
+
   /**
    * A custom Material to use to render opaque elements in this tileset, in
    * order to implement custom visual effects.
@@ -1000,6 +1132,22 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetIgnoreKhrMaterialsUnlit(bool bIgnoreKhrMaterialsUnlit);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Loading")
+  bool GetReleaseGltfDataAfterUpload() const {
+    return ReleaseGltfDataAfterUpload;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Loading")
+  void SetReleaseGltfDataAfterUpload(bool bReleaseGltfDataAfterUpload);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  ECesiumTextureCompression GetTextureCompression() const {
+    return TextureCompression;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetTextureCompression(ECesiumTextureCompression NewTextureCompression);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   UMaterialInterface* GetMaterial() const { return Material; }
 
@@ -1225,8 +1373,17 @@ private:
   // tilesToHideThisFrame may be hidden immediately.
   std::vector<Cesium3DTilesSelection::Tile*> _tilesToHideNextFrame;
 
+  // The single native excluder shared by all UCesiumGeometricTileExcluder
+  // components of this tileset, or nullptr if there are none.
+  std::shared_ptr<CesiumGeometricTileExcluderAdapter> _pGeometricTileExcluder;
+
   int32 _tilesetsBeingDestroyed;
 
+  // The owner of this tileset's background work in the task processor, so
+  // that it can be prioritized and shared fairly with other tilesets.
+  uint32 _taskOwner = 0;
+
   friend class UnrealResourcePreparer;
   friend class UCesiumGltfPointsComponent;
+  friend class UCesiumGeometricTileExcluder;
 };
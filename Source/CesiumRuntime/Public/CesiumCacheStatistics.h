@@ -0,0 +1,72 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+/**
+ * Statistics about the cache of Cesium network responses, which has an
+ * in-memory tier in front of the SQLite database on disk.
+ */
+struct CesiumCacheStatistics {
+  /**
+   * The number of lookups that were answered from memory.
+   */
+  int64 memoryHits = 0;
+
+  /**
+   * The number of lookups that were not in memory and went to disk.
+   */
+  int64 memoryMisses = 0;
+
+  /**
+   * The number of responses currently held in memory.
+   */
+  int64 memoryEntries = 0;
+
+  /**
+   * The number of bytes of responses currently held in memory.
+   */
+  int64 memoryBytes = 0;
+
+  /**
+   * The number of lookups that were answered from the database on disk.
+   */
+  int64 diskHits = 0;
+
+  /**
+   * The number of lookups that were not found on disk either.
+   */
+  int64 diskMisses = 0;
+
+  /**
+   * The number of bytes of responses that were read from disk.
+   */
+  int64 diskBytesRead = 0;
+
+  /**
+   * The number of bytes of responses that were written to disk.
+   */
+  int64 diskBytesWritten = 0;
+
+  /**
+   * The number of responses waiting to be written to disk.
+   */
+  int64 pendingWrites = 0;
+
+  /**
+   * The number of bytes of responses waiting to be written to disk.
+   */
+  int64 pendingWriteBytes = 0;
+
+  /**
+   * The number of batches of responses that have been written to disk.
+   */
+  int64 writeBatches = 0;
+
+  /**
+   * The number of responses that were not cached because too many were
+   * already waiting to be written to disk.
+   */
+  int64 droppedWrites = 0;
+};
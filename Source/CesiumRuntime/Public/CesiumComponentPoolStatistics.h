@@ -0,0 +1,56 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumComponentPoolStatistics.generated.h"
+
+/**
+ * Statistics about the pool that a Cesium 3D Tileset uses to recycle the
+ * components of unloaded tiles.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumComponentPoolStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of tile components that are currently waiting in the pool to be
+   * reused.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 PooledTileComponents = 0;
+
+  /**
+   * The number of primitive components, each with its own static mesh and
+   * material instance, that are currently waiting in the pool to be reused.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 PooledPrimitiveComponents = 0;
+
+  /**
+   * The number of times a loaded tile reused a tile component from the pool.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TileComponentHits = 0;
+
+  /**
+   * The number of times a loaded tile had to create a new tile component
+   * because the pool did not have one.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TileComponentMisses = 0;
+
+  /**
+   * The number of times a glTF primitive reused a primitive component from the
+   * pool.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 PrimitiveComponentHits = 0;
+
+  /**
+   * The number of times a glTF primitive had to create a new primitive
+   * component because the pool did not have a compatible one.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 PrimitiveComponentMisses = 0;
+};
@@ -10,6 +10,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if WITH_EDITOR
 #include "IAssetViewport.h"
@@ -88,8 +90,27 @@ private:
 
   size_t _lastCreditsCount;
 
-  FString ConvertHtmlToRtf(std::string html);
-  std::unordered_map<std::string, FString> _htmlToRtf;
+  /**
+   * A credit's HTML converted to the RTF shown by the credits widget, and the
+   * URLs of the images that the RTF references.
+   */
+  struct ConvertedCredit {
+    FString rtf;
+    std::vector<std::string> imageUrls;
+  };
+
+  static ConvertedCredit ConvertHtmlToRtf(std::string html);
+  void ConvertHtmlToRtfInBackground(const std::string& html);
+  void UpdateCredits();
+
+  // Credits whose HTML has been converted, and credits whose HTML is being
+  // converted in a worker thread.
+  std::unordered_map<std::string, ConvertedCredit> _htmlToRtf;
+  std::unordered_set<std::string> _htmlBeingConverted;
+
+  // Whether the credits shown by the widget need to be updated, because the
+  // credits have changed or a conversion has finished.
+  bool _creditsChanged = false;
 
 #if WITH_EDITOR
   TWeakPtr<IAssetViewport> _pLastEditorViewport;
@@ -0,0 +1,164 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "Containers/Map.h"
+#include "Containers/UnrealString.h"
+#include "Math/Color.h"
+#include "Templates/SharedPointer.h"
+#include "CesiumFeatureStylingComponent.generated.h"
+
+class CesiumFeatureStyleBuffer;
+class UCesiumGltfPrimitiveComponent;
+class UMaterialInstanceDynamic;
+class UTexture2D;
+
+/**
+ * Shows, hides, and recolors individual features of a Cesium3DTileset at
+ * runtime, without reloading tiles or encoding any metadata.
+ *
+ * The styles of the features of each property table are kept in two textures
+ * indexed by feature ID, which are bound to the materials of every tile whose
+ * feature ID sets refer to the property table. Styling features only updates
+ * the rows of the textures that changed, once per frame. A material layer
+ * samples them with the following parameters, where <table> is the HLSL-safe
+ * name of the property table (or of its class, if it has no name), as in
+ * UCesiumFeaturesMetadataComponent:
+ *
+ * - FSTYLE_<table>_COLOR: The texture of the feature colors. The texel of
+ * feature ID N is at (N % Width, N / Width). Its RGB is the color that the
+ * feature is tinted with, and its alpha is 1 if the feature is visible and 0
+ * if it's hidden.
+ * - FSTYLE_<table>_EMISSIVE: The texture of the emissive colors that are added
+ * to the features, laid out in the same way.
+ * - FSTYLE_<table>_WIDTH and FSTYLE_<table>_HEIGHT: The size of both textures,
+ * in texels.
+ *
+ * The parameters are set both as global parameters and as parameters of the
+ * "FeaturesMetadata" material layer, if the tileset's material has one.
+ *
+ * Feature IDs are used as they are, so a style applies to the same feature ID
+ * in every tile that uses a property table of that name. This is most useful
+ * when the feature IDs of a tileset are unique across its tiles.
+ */
+UCLASS(ClassGroup = (Cesium), Meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumFeatureStylingComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumFeatureStylingComponent();
+
+  /**
+   * Shows or hides a feature of the given property table.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeatureVisibility(
+      const FString& PropertyTableName,
+      int64 FeatureID,
+      bool Visible);
+
+  /**
+   * Shows or hides many features of the given property table at once.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeaturesVisibility(
+      const FString& PropertyTableName,
+      const TArray<int64>& FeatureIDs,
+      bool Visible);
+
+  /**
+   * Sets the color that a feature of the given property table is tinted with.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeatureColor(
+      const FString& PropertyTableName,
+      int64 FeatureID,
+      const FLinearColor& Color);
+
+  /**
+   * Sets the color that many features of the given property table are tinted
+   * with.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeaturesColor(
+      const FString& PropertyTableName,
+      const TArray<int64>& FeatureIDs,
+      const FLinearColor& Color);
+
+  /**
+   * Sets the emissive color that is added to a feature of the given property
+   * table.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeatureEmissive(
+      const FString& PropertyTableName,
+      int64 FeatureID,
+      const FLinearColor& Emissive);
+
+  /**
+   * Sets the emissive color that is added to many features of the given
+   * property table.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void SetFeaturesEmissive(
+      const FString& PropertyTableName,
+      const TArray<int64>& FeatureIDs,
+      const FLinearColor& Emissive);
+
+  /**
+   * Makes a feature of the given property table visible, with no tint and no
+   * emissive color.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void ResetFeatureStyle(const FString& PropertyTableName, int64 FeatureID);
+
+  /**
+   * Makes every feature of the given property table visible, with no tint and
+   * no emissive color.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void ResetAllFeatureStyles(const FString& PropertyTableName);
+
+  /**
+   * Uploads the styles that changed since the last update to their textures.
+   * This is called every frame, but can be called earlier to apply the
+   * styles immediately.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|Styling")
+  void UpdateStyleTextures();
+
+  /**
+   * Binds the style textures of the property tables that a glTF primitive
+   * refers to to its material.
+   */
+  void BindStyleTextures(UCesiumGltfPrimitiveComponent& Primitive);
+
+  virtual void TickComponent(
+      float DeltaTime,
+      ELevelTick TickType,
+      FActorComponentTickFunction* ThisTickFunction) override;
+
+  virtual void OnUnregister() override;
+
+private:
+  CesiumFeatureStyleBuffer& _getBuffer(const FString& propertyTableName);
+
+  void _bindStyleTextures(
+      UCesiumGltfPrimitiveComponent& primitive,
+      const FString* pOnlyPropertyTableName);
+
+  void _setStyleParameters(
+      UMaterialInstanceDynamic& material,
+      int32 featuresMetadataLayerIndex,
+      const FString& propertyTableName);
+
+  TMap<FString, TSharedPtr<CesiumFeatureStyleBuffer>> _buffers;
+
+  UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+  TMap<FString, UTexture2D*> _colorTextures;
+
+  UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+  TMap<FString, UTexture2D*> _emissiveTextures;
+};
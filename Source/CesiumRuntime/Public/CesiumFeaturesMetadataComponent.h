@@ -165,8 +165,8 @@ struct CESIUMRUNTIME_API FCesiumPropertyTableDescription {
 /**
  * @brief Description of a property texture property that should be made
  * accessible to Unreal materials. A property texture property's data is
- * already available through a texture, so no additional encoding details need
- * to be specified.
+ * already available through a texture, which can optionally be uploaded at a
+ * reduced resolution.
  */
 USTRUCT()
 struct CESIUMRUNTIME_API FCesiumPropertyTexturePropertyDescription {
@@ -185,6 +185,25 @@ struct CESIUMRUNTIME_API FCesiumPropertyTexturePropertyDescription {
    */
   UPROPERTY(EditAnywhere, Category = "Cesium")
   FCesiumMetadataPropertyDetails PropertyDetails;
+
+  /**
+   * The factor that the width and height of the property's texture are
+   * divided by before it is uploaded to the GPU. For example, a factor of 2
+   * uses a quarter of the memory of the full-resolution texture. Properties
+   * that share an image, downsample factor, and filter also share a texture.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", Meta = (ClampMin = 1))
+  int32 DownsampleFactor = 1;
+
+  /**
+   * The filter used to downsample the property's texture.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      Category = "Cesium",
+      Meta = (EditCondition = "DownsampleFactor > 1"))
+  ECesiumEncodedMetadataDownsampleFilter DownsampleFilter =
+      ECesiumEncodedMetadataDownsampleFilter::Nearest;
 };
 
 /**
@@ -347,6 +366,20 @@ public:
   UMaterialFunctionMaterialLayer* TargetMaterialLayer = nullptr;
 #endif
 
+  /**
+   * Whether to encode only the feature ID sets and properties whose generated
+   * parameters are referenced by the tileset's materials, including their
+   * material layers. This avoids encoding properties that no material reads,
+   * and the tileset is reloaded with a new selection whenever one of its
+   * materials is changed.
+   *
+   * Don't enable this if materials that sample the encoded parameters are
+   * applied to the tiles in some other way, such as by setting them on the
+   * tile components at runtime.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool EncodeOnlyReferencedProperties = false;
+
   // Using the FCesiumPrimitiveFeaturesDescription and
   // FCesiumModelMetadataDescription structs makes the UI less readable, so the
   // component uses arrays directly to help flatten the UI.
@@ -0,0 +1,282 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/SceneComponent.h"
+#include "CoreMinimal.h"
+#include <glm/mat4x4.hpp>
+#include <vector>
+#include "CesiumGeometricTileExcluder.generated.h"
+
+class ACesium3DTileset;
+class ACesiumCartographicPolygon;
+struct CesiumExclusionVolume;
+
+/**
+ * Determines which tiles a geometric tile excluder removes from its tileset.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTileExclusionMode : uint8 {
+  /**
+   * Tiles that are entirely inside the excluder's volume are excluded. This is
+   * useful for cutting holes into a tileset.
+   */
+  ExcludeTilesInside,
+
+  /**
+   * Tiles that are entirely outside the excluder's volume are excluded. If a
+   * tileset has several excluders with this mode, only tiles outside of all of
+   * them are excluded.
+   */
+  ExcludeTilesOutside
+};
+
+/**
+ * A tile excluder that tests tile bounding volumes directly against a simple
+ * geometric volume, without calling into Blueprints for every tile.
+ *
+ * All geometric tile excluders attached to a Cesium 3D Tileset are combined
+ * into a single native excluder with a spatial index, so that each tile is only
+ * tested in detail against the volumes it could touch. Tests are conservative:
+ * a tile is only excluded if its bounding volume is known to be completely
+ * inside (or completely outside) the excluder's volume.
+ */
+UCLASS(ClassGroup = (Cesium), Abstract)
+class CESIUMRUNTIME_API UCesiumGeometricTileExcluder : public USceneComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumGeometricTileExcluder();
+
+  /**
+   * Whether this excluder removes the tiles inside or outside of its volume.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ECesiumTileExclusionMode ExclusionMode =
+      ECesiumTileExclusionMode::ExcludeTilesInside;
+
+  /**
+   * Adds this tile excluder to its owning Cesium 3D Tileset Actor. If the
+   * excluder is already added or if this component's Owner is not a Cesium 3D
+   * Tileset, this method does nothing.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void AddToTileset();
+
+  /**
+   * Removes this tile excluder from its owning Cesium 3D Tileset Actor. If the
+   * excluder is not yet added or if this component's Owner is not a Cesium 3D
+   * Tileset, this method does nothing.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void RemoveFromTileset();
+
+  /**
+   * Refreshes this tile excluder by removing it from its owning Cesium 3D
+   * Tileset Actor and re-adding it.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void Refresh();
+
+  /**
+   * Appends the volumes of this excluder, expressed in the coordinate system
+   * of the Cesium tileset (usually ECEF), to the given list.
+   *
+   * @param Tileset The tileset this excluder applies to.
+   * @param UnrealWorldToCesiumTileset The transformation from Unreal world
+   * coordinates to Cesium tileset coordinates.
+   * @param Volumes The list to append to.
+   */
+  virtual void AppendExclusionVolumes(
+      const ACesium3DTileset& Tileset,
+      const glm::dmat4& UnrealWorldToCesiumTileset,
+      std::vector<CesiumExclusionVolume>& Volumes) const {}
+
+  /**
+   * Computes a stamp that changes whenever the volumes appended by
+   * AppendExclusionVolumes change, for example because this component moved
+   * or one of its properties was modified. Exclusion decisions are cached per
+   * tile for as long as the stamps of all of a tileset's excluders, and the
+   * tileset's own transform, stay the same.
+   */
+  virtual uint32 ComputeExclusionStamp() const;
+
+  virtual void Activate(bool bReset) override;
+  virtual void Deactivate() override;
+  virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+#if WITH_EDITOR
+  // Called when properties are changed in the editor
+  virtual void
+  PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+  bool _isAdded;
+};
+
+/**
+ * Excludes tiles inside or outside of a box. The box is centered on this
+ * component and spans BoxExtent in each direction of its local axes, so it
+ * follows the component's location, rotation, and scale.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumBoxTileExcluder
+    : public UCesiumGeometricTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The half-size of the box along each of this component's local axes, in
+   * Unreal units.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  FVector BoxExtent = FVector(5000.0, 5000.0, 5000.0);
+
+  virtual void AppendExclusionVolumes(
+      const ACesium3DTileset& Tileset,
+      const glm::dmat4& UnrealWorldToCesiumTileset,
+      std::vector<CesiumExclusionVolume>& Volumes) const override;
+
+  virtual uint32 ComputeExclusionStamp() const override;
+};
+
+/**
+ * Excludes tiles inside or outside of a sphere centered on this component.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumSphereTileExcluder
+    : public UCesiumGeometricTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The radius of the sphere in Unreal units. It is scaled by the largest
+   * component of this component's world scale.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double SphereRadius = 5000.0;
+
+  virtual void AppendExclusionVolumes(
+      const ACesium3DTileset& Tileset,
+      const glm::dmat4& UnrealWorldToCesiumTileset,
+      std::vector<CesiumExclusionVolume>& Volumes) const override;
+
+  virtual uint32 ComputeExclusionStamp() const override;
+};
+
+/**
+ * Excludes tiles inside or outside of cartographic polygons extruded between a
+ * minimum and maximum height above the WGS84 ellipsoid.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumPolygonTileExcluder
+    : public UCesiumGeometricTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The polygons that define the excluded areas.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<ACesiumCartographicPolygon*> Polygons;
+
+  /**
+   * The lowest height above the ellipsoid covered by the polygons, in meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MinimumHeight = -1000.0;
+
+  /**
+   * The highest height above the ellipsoid covered by the polygons, in meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MaximumHeight = 10000.0;
+
+  virtual void AppendExclusionVolumes(
+      const ACesium3DTileset& Tileset,
+      const glm::dmat4& UnrealWorldToCesiumTileset,
+      std::vector<CesiumExclusionVolume>& Volumes) const override;
+
+  virtual uint32 ComputeExclusionStamp() const override;
+};
+
+/**
+ * Excludes tiles inside or outside of a longitude / latitude rectangle
+ * extruded between a minimum and maximum height above the WGS84 ellipsoid.
+ * Rectangles whose West is greater than their East cross the anti-meridian.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumRectangleTileExcluder
+    : public UCesiumGeometricTileExcluder {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The western longitude of the rectangle, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -180.0, ClampMax = 180.0))
+  double West = -1.0;
+
+  /**
+   * The southern latitude of the rectangle, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -90.0, ClampMax = 90.0))
+  double South = -1.0;
+
+  /**
+   * The eastern longitude of the rectangle, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -180.0, ClampMax = 180.0))
+  double East = 1.0;
+
+  /**
+   * The northern latitude of the rectangle, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -90.0, ClampMax = 90.0))
+  double North = 1.0;
+
+  /**
+   * The lowest height above the ellipsoid covered by the rectangle, in meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MinimumHeight = -1000.0;
+
+  /**
+   * The highest height above the ellipsoid covered by the rectangle, in
+   * meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MaximumHeight = 10000.0;
+
+  virtual void AppendExclusionVolumes(
+      const ACesium3DTileset& Tileset,
+      const glm::dmat4& UnrealWorldToCesiumTileset,
+      std::vector<CesiumExclusionVolume>& Volumes) const override;
+
+  virtual uint32 ComputeExclusionStamp() const override;
+};
@@ -0,0 +1,42 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumGltfMemoryStatistics.generated.h"
+
+/**
+ * Statistics about the CPU memory used by the glTF buffers and decoded images
+ * of the loaded tiles of a Cesium 3D Tileset.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumGltfMemoryStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of loaded tiles that have glTF content.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 Tiles = 0;
+
+  /**
+   * The number of bytes of glTF data that remain in CPU memory for all loaded
+   * tiles.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ResidentBytes = 0;
+
+  /**
+   * The largest number of bytes of glTF data that remain in CPU memory for a
+   * single loaded tile.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 LargestTileResidentBytes = 0;
+
+  /**
+   * The number of bytes of glTF data that were released after the loaded
+   * tiles were uploaded to the GPU.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ReleasedBytes = 0;
+};
@@ -54,6 +54,24 @@ enum class ECesiumEncodedMetadataConversion : uint8 {
   ParseColorFromString
 };
 
+/**
+ * @brief The filter used to downsample the image of a property texture.
+ */
+UENUM()
+enum class ECesiumEncodedMetadataDownsampleFilter : uint8 {
+  /**
+   * Keep the texel at the center of each block of texels. This preserves the
+   * exact values of every kind of property.
+   */
+  Nearest,
+  /**
+   * Average the texels in each block of texels. This is only applied to
+   * properties with uint8 components, since the channels of other properties
+   * can't be averaged separately. Nearest is used for other properties.
+   */
+  Average
+};
+
 /**
  * Describes how a property from EXT_structural_metadata will be encoded for
  * access in Unreal materials.
@@ -65,7 +83,9 @@ struct FCesiumMetadataEncodingDetails {
   FCesiumMetadataEncodingDetails()
       : Type(ECesiumEncodedMetadataType::None),
         ComponentType(ECesiumEncodedMetadataComponentType::None),
-        Conversion(ECesiumEncodedMetadataConversion::None) {}
+        Conversion(ECesiumEncodedMetadataConversion::None),
+        bQuantize(false),
+        bPack(false) {}
 
   FCesiumMetadataEncodingDetails(
       ECesiumEncodedMetadataType InType,
@@ -73,7 +93,9 @@ struct FCesiumMetadataEncodingDetails {
       ECesiumEncodedMetadataConversion InConversion)
       : Type(InType),
         ComponentType(InComponentType),
-        Conversion(InConversion) {}
+        Conversion(InConversion),
+        bQuantize(false),
+        bPack(false) {}
 
   /**
    * The GPU-compatible type that this property's values will be encoded as.
@@ -97,18 +119,66 @@ struct FCesiumMetadataEncodingDetails {
   UPROPERTY(EditAnywhere, Category = "Cesium")
   ECesiumEncodedMetadataConversion Conversion;
 
+  /**
+   * Whether to quantize Float values to 16-bit integers, which halves the
+   * memory used by the property's texture. The integers are spread evenly
+   * between the smallest and largest value of the property in each tile, and
+   * the material converts them back to floats. The error of a value is at most
+   * 1/131070 of the range of the property's values in the tile. Only values
+   * that are coerced can be quantized.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      Category = "Cesium",
+      Meta =
+          (EditCondition =
+               "ComponentType == ECesiumEncodedMetadataComponentType::Float && Conversion == ECesiumEncodedMetadataConversion::Coerce"))
+  bool bQuantize;
+
+  /**
+   * Whether to pack this property into a channel of a texture that is shared
+   * with up to three other packed properties of the same property table,
+   * instead of giving it a texture of its own. Only Uint8 Scalar properties
+   * can be packed.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      Category = "Cesium",
+      Meta =
+          (EditCondition =
+               "Type == ECesiumEncodedMetadataType::Scalar && ComponentType == ECesiumEncodedMetadataComponentType::Uint8"))
+  bool bPack;
+
   inline bool operator==(const FCesiumMetadataEncodingDetails& Info) const {
     return Type == Info.Type && ComponentType == Info.ComponentType &&
-           Conversion == Info.Conversion;
+           Conversion == Info.Conversion && bQuantize == Info.bQuantize &&
+           bPack == Info.bPack;
   }
 
   inline bool operator!=(const FCesiumMetadataEncodingDetails& Info) const {
-    return Type != Info.Type || ComponentType != Info.ComponentType ||
-           Conversion != Info.Conversion;
+    return !(*this == Info);
   }
 
   bool HasValidType() const {
     return Type != ECesiumEncodedMetadataType::None &&
            ComponentType != ECesiumEncodedMetadataComponentType::None;
   }
+
+  /**
+   * Whether the property's values will be quantized to 16-bit integers.
+   */
+  bool IsQuantized() const {
+    return bQuantize &&
+           ComponentType == ECesiumEncodedMetadataComponentType::Float &&
+           Conversion == ECesiumEncodedMetadataConversion::Coerce;
+  }
+
+  /**
+   * Whether the property will be packed into a texture shared with other
+   * properties.
+   */
+  bool IsPacked() const {
+    return bPack && Type == ECesiumEncodedMetadataType::Scalar &&
+           ComponentType == ECesiumEncodedMetadataComponentType::Uint8;
+  }
 };
@@ -8,7 +8,10 @@
 #include "UObject/ObjectMacros.h"
 #include "CesiumMetadataPickingBlueprintLibrary.generated.h"
 
+class ACesium3DTileset;
+class UPrimitiveComponent;
 struct FHitResult;
+struct FCesiumPropertyTable;
 
 UCLASS()
 class CESIUMRUNTIME_API UCesiumMetadataPickingBlueprintLibrary
@@ -73,6 +76,149 @@ public:
       const FHitResult& Hit,
       int64 FeatureIDSetIndex = 0);
 
+  /**
+   * Finds the property table and the feature ID for a given line trace hit,
+   * under the same conditions as GetPropertyTableValuesFromHit, but without
+   * copying any of the property table's values.
+   *
+   * This is meant for C++ code that reads a few properties of many hits. Use
+   * FCesiumPropertyTablePropertyHandle to read the values of the returned
+   * property table's properties without allocating memory.
+   *
+   * @param Hit The line trace hit.
+   * @param FeatureIDSetIndex The index of the feature ID set in the
+   * component's CesiumPrimitiveFeatures.
+   * @param FeatureID Receives the ID of the hit feature, or -1 if there is
+   * none.
+   * @return The property table of the hit feature, or nullptr if there is
+   * none. It is owned by the hit's glTF component.
+   */
+  static const FCesiumPropertyTable* FindPropertyTableFromHit(
+      const FHitResult& Hit,
+      int64 FeatureIDSetIndex,
+      int64& FeatureID);
+
+  /**
+   * Computes the UV coordinates of many line trace hits at once, in the same
+   * way as FindUVFromHit.
+   *
+   * Hits on the same glTF primitive component are processed together, so the
+   * primitive's accessors are only looked up once for all of its hits. This
+   * is much faster than calling FindUVFromHit for each hit when there are
+   * many of them.
+   *
+   * @param Hits The line trace hits.
+   * @param GltfTexCoordSetIndex The index of the glTF texture coordinate set,
+   * i.e. N in "TEXCOORD_N".
+   * @param UVs Receives the UV coordinates of each hit, in the same order as
+   * the hits.
+   * @param Found Receives whether the UV coordinates of each hit could be
+   * computed. If not, the hit's UV coordinates are zero.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static void FindUVsFromHits(
+      const TArray<FHitResult>& Hits,
+      int64 GltfTexCoordSetIndex,
+      TArray<FVector2D>& UVs,
+      TArray<bool>& Found);
+
+  /**
+   * Gets the feature IDs of many line trace hits at once, in the same way as
+   * UCesiumPrimitiveFeaturesBlueprintLibrary's GetFeatureIDFromHit.
+   *
+   * Hits on the same glTF primitive component are processed together, so the
+   * primitive's accessors and feature ID set are only looked up once for all
+   * of its hits.
+   *
+   * @param Hits The line trace hits.
+   * @param FeatureIDs Receives the feature ID of each hit, in the same order
+   * as the hits, or -1 if a hit has no feature in the specified feature ID
+   * set.
+   * @param FeatureIDSetIndex The index of the feature ID set in the hit
+   * components' CesiumPrimitiveFeatures.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static void GetFeatureIDsFromHits(
+      const TArray<FHitResult>& Hits,
+      TArray<int64>& FeatureIDs,
+      int64 FeatureIDSetIndex = 0);
+
+  /**
+   * Gets the value of one property table property for many line trace hits
+   * at once, as double-precision floating-point numbers.
+   *
+   * The feature ID of each hit is found as in GetFeatureIDsFromHits. Its value
+   * is then read from the property table associated with the feature ID set,
+   * converted as described for UCesiumPropertyTablePropertyBlueprintLibrary's
+   * GetFloat64. The property is only looked up once for each of the hit
+   * primitives.
+   *
+   * @param Hits The line trace hits.
+   * @param PropertyName The name of the property table property.
+   * @param FeatureIDs Receives the feature ID of each hit, or -1 if a hit has
+   * no feature.
+   * @param Values Receives the property value of each hit, or DefaultValue if
+   * it has none.
+   * @param FeatureIDSetIndex The index of the feature ID set in the hit
+   * components' CesiumPrimitiveFeatures.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static void GetFloat64PropertyValuesFromHits(
+      const TArray<FHitResult>& Hits,
+      const FString& PropertyName,
+      TArray<int64>& FeatureIDs,
+      TArray<double>& Values,
+      int64 FeatureIDSetIndex = 0,
+      double DefaultValue = 0.0);
+
+  /**
+   * Traces a line against the triangles of a glTF primitive component without
+   * using its physics mesh, so it works for tilesets whose
+   * CreatePhysicsMeshes is disabled.
+   *
+   * The primitive's triangles are kept in a bounding volume hierarchy that is
+   * built the first time the primitive is traced, so later traces only test
+   * the few triangles near the line. The returned hit has the same component,
+   * face index, and location that a physics line trace would, so it can be
+   * passed to GetFeatureIDFromHit, FindUVFromHit,
+   * GetPropertyTableValuesFromHit, and the other functions that take hits.
+   *
+   * Only primitives made of a list of triangles whose positions are still in
+   * CPU memory can be traced. See the tileset's ReleaseGltfDataAfterUpload.
+   *
+   * @param Component The glTF primitive component.
+   * @param Start The start of the line, in world coordinates.
+   * @param End The end of the line, in world coordinates.
+   * @param Hit Receives the nearest hit along the line, if any.
+   * @return Whether the line hit the primitive.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static bool LineTraceGltfPrimitive(
+      UPrimitiveComponent* Component,
+      const FVector& Start,
+      const FVector& End,
+      FHitResult& Hit);
+
+  /**
+   * Traces a line against the triangles of the visible tiles of a tileset
+   * without using physics meshes, in the same way as LineTraceGltfPrimitive.
+   * Primitives whose bounds the line doesn't cross are skipped without
+   * building their bounding volume hierarchies.
+   *
+   * @param Tileset The tileset.
+   * @param Start The start of the line, in world coordinates.
+   * @param End The end of the line, in world coordinates.
+   * @param Hit Receives the nearest hit along the line, if any.
+   * @return Whether the line hit a tile.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static bool LineTraceTileset(
+      const ACesium3DTileset* Tileset,
+      const FVector& Start,
+      const FVector& End,
+      FHitResult& Hit);
+
   /**
    * Gets the property texture values from a given line trace hit, assuming it
    * has hit a glTF primitive component.
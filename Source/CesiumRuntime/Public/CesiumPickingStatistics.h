@@ -0,0 +1,54 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumPickingStatistics.generated.h"
+
+/**
+ * Statistics about the bounding volume hierarchies that the loaded tiles of a
+ * Cesium 3D Tileset have built to be picked without physics meshes. See
+ * UCesiumMetadataPickingBlueprintLibrary's LineTraceTileset.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumPickingStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of glTF primitives that have built a hierarchy.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 Primitives = 0;
+
+  /**
+   * The number of triangles in the hierarchies of all primitives.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Triangles = 0;
+
+  /**
+   * The number of bytes of CPU memory used by the hierarchies of all
+   * primitives.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 Bytes = 0;
+
+  /**
+   * The largest number of bytes used by the hierarchy of a single primitive.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 LargestPrimitiveBytes = 0;
+
+  /**
+   * The time it took to build the hierarchies of all primitives, in seconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double BuildSeconds = 0.0;
+
+  /**
+   * The longest time it took to build the hierarchy of a single primitive, in
+   * seconds.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double LongestPrimitiveBuildSeconds = 0.0;
+};
@@ -0,0 +1,65 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/UnrealString.h"
+#include "HAL/Platform.h"
+
+/**
+ * The options that affect the vertices and indices of pre-baked tiles. A
+ * pre-baked tile is only used by tilesets whose options match the options it
+ * was baked with.
+ */
+struct CesiumPrebakeOptions {
+  /**
+   * Whether tangents are computed for every primitive, rather than only for
+   * primitives with a normal map. See
+   * ACesium3DTileset::AlwaysIncludeTangents.
+   */
+  bool alwaysIncludeTangents = false;
+
+  /**
+   * Whether the KHR_materials_unlit extension is ignored. See
+   * ACesium3DTileset::IgnoreKhrMaterialsUnlit.
+   */
+  bool ignoreKhrMaterialsUnlit = false;
+};
+
+/**
+ * Functions for baking the render data of tiles ahead of time. Baking a tile
+ * stores the vertices and indices that Cesium for Unreal computes for its
+ * primitives, including generated normals and tangents, in a directory. A
+ * tileset that is pointed at that directory loads those primitives from it
+ * instead of computing them again.
+ */
+namespace CesiumPrebakedTiles {
+/**
+ * Computes the key of a pre-baked tile from the content of the tile, as it
+ * was downloaded, and the options it was baked with.
+ */
+CESIUMRUNTIME_API uint64 computeKey(
+    const TArrayView<const uint8>& content,
+    const CesiumPrebakeOptions& options);
+
+/**
+ * Gets the path of the file that holds the pre-baked tile with the given key.
+ */
+CESIUMRUNTIME_API FString getPath(const FString& directory, uint64 key);
+
+/**
+ * Bakes the given binary glTF tile content and writes the result to the given
+ * directory.
+ *
+ * @param directory The directory to write the pre-baked tile to.
+ * @param content The content of the tile, as it would be downloaded.
+ * @param options The options to bake the tile with.
+ * @param error Receives a description of the problem if baking fails.
+ * @return Whether the tile was baked and written successfully.
+ */
+CESIUMRUNTIME_API bool bakeTileContent(
+    const FString& directory,
+    const TArrayView<const uint8>& content,
+    const CesiumPrebakeOptions& options,
+    FString& error);
+} // namespace CesiumPrebakedTiles
@@ -5,8 +5,11 @@
 #include "CesiumGltf/Class.h"
 #include "CesiumMetadataValue.h"
 #include "CesiumPropertyTableProperty.h"
+#include "Containers/BitArray.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ObjectMacros.h"
+#include <string>
+#include <unordered_map>
 #include "CesiumPropertyTable.generated.h"
 
 namespace CesiumGltf {
@@ -30,6 +33,20 @@ enum class ECesiumPropertyTableStatus : uint8 {
   ErrorInvalidPropertyTableClass
 };
 
+/**
+ * @brief The comparison that a property table query applies between the value
+ * of a property and a given value.
+ */
+UENUM(BlueprintType)
+enum class ECesiumPropertyTableQueryOperator : uint8 {
+  Equal = 0,
+  NotEqual,
+  Less,
+  LessOrEqual,
+  Greater,
+  GreaterOrEqual
+};
+
 /**
  * A Blueprint-accessible wrapper for a glTF property table. A property table is
  * a collection of properties for the features in a mesh. It knows how to
@@ -70,6 +87,106 @@ private:
   TMap<FString, FCesiumPropertyTableProperty> _properties;
 
   friend class UCesiumPropertyTableBlueprintLibrary;
+  friend class FCesiumPropertyTableQuery;
+};
+
+/**
+ * Finds the features of a property table whose values match a set of
+ * conditions. This is only accessible from C++.
+ *
+ * Each condition compares the values of one property to a given value and
+ * removes the features that don't satisfy it, so chained conditions are
+ * combined with a logical AND. Conditions read the values of a whole property
+ * column at a time, without converting them to FCesiumMetadataValue, and only
+ * for the features that are still matching.
+ *
+ * Repeated queries on the same properties can be made faster with
+ * buildIndex. Indexes are kept until the query is destroyed, so a query should
+ * be reused with reset instead of being created again.
+ *
+ * The query refers to the property table, which must outlive it.
+ */
+class CESIUMRUNTIME_API FCesiumPropertyTableQuery {
+public:
+  /**
+   * Constructs a query where every feature of the property table matches. If
+   * the property table is invalid, no feature matches.
+   */
+  explicit FCesiumPropertyTableQuery(const FCesiumPropertyTable& PropertyTable);
+
+  /**
+   * Makes every feature of the property table match again. Indexes are kept.
+   */
+  void reset();
+
+  /**
+   * Removes the features whose value of the given property, converted to a
+   * double, doesn't compare to the given value with the given operator.
+   * Features without a value, and all features if the property doesn't exist,
+   * are removed.
+   */
+  FCesiumPropertyTableQuery& whereFloat64(
+      const FString& PropertyName,
+      ECesiumPropertyTableQueryOperator Operator,
+      double Value);
+
+  /**
+   * Removes the features whose value of the given string property doesn't
+   * compare to the given value with the given operator. Strings are ordered
+   * by their UTF-8 bytes. Features without a value, and all features if the
+   * property isn't a string property, are removed.
+   */
+  FCesiumPropertyTableQuery& whereString(
+      const FString& PropertyName,
+      ECesiumPropertyTableQueryOperator Operator,
+      const FString& Value);
+
+  /**
+   * Removes the features whose value of the given property, converted to a
+   * boolean, isn't the given value. Features without a value are treated as
+   * false.
+   */
+  FCesiumPropertyTableQuery&
+  whereBoolean(const FString& PropertyName, bool Value);
+
+  /**
+   * Builds an index of the values of the given property, which later
+   * conditions on the property use instead of reading the whole column.
+   *
+   * String properties get a hashed index, which serves Equal conditions.
+   * Other properties get an index sorted by their values as doubles, which
+   * serves every operator of whereFloat64.
+   */
+  void buildIndex(const FString& PropertyName);
+
+  /**
+   * Gets the matching features as a bit array indexed by feature ID.
+   */
+  const TBitArray<>& getMatches() const { return this->_matches; }
+
+  /**
+   * Gets the number of matching features.
+   */
+  int64 countMatches() const;
+
+  /**
+   * Gets the IDs of the matching features in ascending order.
+   */
+  void getMatchingFeatureIDs(TArray<int64>& FeatureIDs) const;
+
+private:
+  struct PropertyIndex {
+    // The features with a numeric value, sorted by value.
+    TArray<TPair<double, int32>> numbers;
+    // The features with a string value, by value. The values are kept in
+    // UTF-8 so that they're compared exactly like the column scan does, rather
+    // than case-insensitively like FString keys.
+    std::unordered_map<std::string, TArray<int32>> strings;
+  };
+
+  const FCesiumPropertyTable* _pPropertyTable;
+  TBitArray<> _matches;
+  TMap<FString, PropertyIndex> _indexes;
 };
 
 UCLASS()
@@ -161,6 +278,49 @@ public:
       UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
       int64 FeatureID);
 
+  /**
+   * Finds the features whose value of the given property, converted to a
+   * Float64, compares to the given value with the given operator. Features
+   * without a value are never included.
+   *
+   * This reads the values of the whole property at once, which is much faster
+   * than getting the value of each feature.
+   *
+   * @param PropertyName The name of the property.
+   * @param Operator The comparison between the property values and Value.
+   * @param Value The value to compare to.
+   * @return The IDs of the matching features in ascending order.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTable")
+  static TArray<int64> FindFeatureIDsByFloat64(
+      UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+      const FString& PropertyName,
+      ECesiumPropertyTableQueryOperator Operator,
+      double Value);
+
+  /**
+   * Finds the features whose value of the given string property compares to
+   * the given value with the given operator. Strings are ordered by their
+   * UTF-8 bytes. Features without a value are never included.
+   *
+   * @param PropertyName The name of the string property.
+   * @param Operator The comparison between the property values and Value.
+   * @param Value The value to compare to.
+   * @return The IDs of the matching features in ascending order.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTable")
+  static TArray<int64> FindFeatureIDsByString(
+      UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+      const FString& PropertyName,
+      ECesiumPropertyTableQueryOperator Operator,
+      const FString& Value);
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Gets all of the property values for a given feature as strings, mapped by
@@ -7,6 +7,7 @@
 #include "CesiumMetadataValue.h"
 #include "CesiumMetadataValueType.h"
 #include "CesiumPropertyArray.h"
+#include "Containers/ArrayView.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ObjectMacros.h"
 #include <any>
@@ -108,6 +109,98 @@ private:
   bool _normalized;
 
   friend class UCesiumPropertyTablePropertyBlueprintLibrary;
+  friend class FCesiumPropertyTablePropertyHandle;
+  friend class FCesiumPropertyTableQuery;
+};
+
+/**
+ * A handle for reading the values of a property table property from C++.
+ *
+ * The type of the property is resolved once, when the handle is created.
+ * Reading values through the handle then skips the per-call type dispatch of
+ * UCesiumPropertyTablePropertyBlueprintLibrary and does not allocate memory,
+ * unless string values have to be parsed. Values are transformed and
+ * converted in the same way as the corresponding Blueprint functions, e.g.
+ * getFloat64 behaves like UCesiumPropertyTablePropertyBlueprintLibrary's
+ * GetFloat64.
+ *
+ * The handle refers to the property it was created from, so that property
+ * must not be destroyed or moved while the handle is in use.
+ */
+class CESIUMRUNTIME_API FCesiumPropertyTablePropertyHandle {
+public:
+  /**
+   * Constructs an invalid handle that returns default values.
+   */
+  FCesiumPropertyTablePropertyHandle() = default;
+
+  /**
+   * Constructs a handle for the given property. If the property is invalid,
+   * the handle is invalid too.
+   */
+  explicit FCesiumPropertyTablePropertyHandle(
+      const FCesiumPropertyTableProperty& Property);
+
+  /**
+   * Whether this handle refers to a property that values can be read from.
+   */
+  bool isValid() const { return this->_pView != nullptr; }
+
+  /**
+   * Gets the number of values in the property, or zero if the handle is
+   * invalid.
+   */
+  int64 size() const { return this->_size; }
+
+  bool getBoolean(int64 featureID, bool defaultValue = false) const;
+  int64 getInteger64(int64 featureID, int64 defaultValue = 0) const;
+  double getFloat64(int64 featureID, double defaultValue = 0.0) const;
+  FVector getVector(int64 featureID, const FVector& defaultValue) const;
+  FVector4 getVector4(int64 featureID, const FVector4& defaultValue) const;
+
+  /**
+   * Reads the values of many features at once. The value of featureIDs[i] is
+   * written to values[i], so both views must have the same number of
+   * elements.
+   */
+  void getBooleans(
+      TArrayView<const int64> featureIDs,
+      bool defaultValue,
+      TArrayView<bool> values) const;
+  void getInteger64s(
+      TArrayView<const int64> featureIDs,
+      int64 defaultValue,
+      TArrayView<int64> values) const;
+  void getFloat64s(
+      TArrayView<const int64> featureIDs,
+      double defaultValue,
+      TArrayView<double> values) const;
+  void getVectors(
+      TArrayView<const int64> featureIDs,
+      const FVector& defaultValue,
+      TArrayView<FVector> values) const;
+  void getVector4s(
+      TArrayView<const int64> featureIDs,
+      const FVector4& defaultValue,
+      TArrayView<FVector4> values) const;
+
+private:
+  template <typename T>
+  using GetValuesFunction = void (*)(
+      const void* pView,
+      TArrayView<const int64> featureIDs,
+      const T& defaultValue,
+      TArrayView<T> values);
+
+  // The PropertyTablePropertyView inside the property's std::any.
+  const void* _pView = nullptr;
+  int64 _size = 0;
+
+  GetValuesFunction<bool> _getBooleans = nullptr;
+  GetValuesFunction<int64> _getInteger64s = nullptr;
+  GetValuesFunction<double> _getFloat64s = nullptr;
+  GetValuesFunction<FVector> _getVectors = nullptr;
+  GetValuesFunction<FVector4> _getVector4s = nullptr;
 };
 
 UCLASS()
@@ -945,6 +1038,71 @@ public:
       UPARAM(ref) const FCesiumPropertyTableProperty& Property,
       int64 FeatureID);
 
+  /**
+   * Attempts to retrieve the values for many features at once as booleans.
+   * Each value is converted as described for GetBoolean, and Values receives
+   * one value for each of the feature IDs, in the same order.
+   *
+   * This resolves the type of the property once for all of the features, so
+   * it is much faster than calling GetBoolean for each of them.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param Values The property values, one for each feature.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static void GetBooleanValues(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      const TArray<int64>& FeatureIDs,
+      TArray<bool>& Values,
+      bool DefaultValue = false);
+
+  /**
+   * Attempts to retrieve the values for many features at once as signed
+   * 64-bit integers. Each value is converted as described for GetInteger64,
+   * and Values receives one value for each of the feature IDs, in the same
+   * order.
+   *
+   * This resolves the type of the property once for all of the features, so
+   * it is much faster than calling GetInteger64 for each of them.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param Values The property values, one for each feature.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static void GetInteger64Values(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      const TArray<int64>& FeatureIDs,
+      TArray<int64>& Values,
+      int64 DefaultValue = 0);
+
+  /**
+   * Attempts to retrieve the values for many features at once as
+   * double-precision floating-point numbers. Each value is converted as
+   * described for GetFloat64, and Values receives one value for each of the
+   * feature IDs, in the same order.
+   *
+   * This resolves the type of the property once for all of the features, so
+   * it is much faster than calling GetFloat64 for each of them.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param Values The property values, one for each feature.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static void GetFloat64Values(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      const TArray<int64>& FeatureIDs,
+      TArray<double>& Values,
+      double DefaultValue = 0.0);
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Retrieves the value of the property for the given feature. This allows the
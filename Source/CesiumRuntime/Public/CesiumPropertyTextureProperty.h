@@ -4,6 +4,7 @@
 
 #include "CesiumGltf/PropertyTexturePropertyView.h"
 #include "CesiumMetadataValue.h"
+#include "Containers/ArrayView.h"
 #include "GenericPlatform/GenericPlatform.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include <any>
@@ -107,6 +108,89 @@ private:
   bool _normalized;
 
   friend class UCesiumPropertyTexturePropertyBlueprintLibrary;
+  friend class FCesiumPropertyTexturePropertyHandle;
+};
+
+/**
+ * A handle for sampling a property texture property many times from C++.
+ *
+ * The type of the property is resolved once, when the handle is created, and
+ * samples are read straight from the property's image. Nothing is decoded or
+ * allocated up front, so only the texels at the sampled coordinates are ever
+ * read. Values are transformed and converted in the same way as the
+ * corresponding Blueprint functions, e.g. getFloat64 behaves like
+ * UCesiumPropertyTexturePropertyBlueprintLibrary's GetFloat64.
+ *
+ * The handle refers to the property it was created from, so that property
+ * must not be destroyed or moved while the handle is in use.
+ */
+class CESIUMRUNTIME_API FCesiumPropertyTexturePropertyHandle {
+public:
+  /**
+   * Constructs an invalid handle that returns default values.
+   */
+  FCesiumPropertyTexturePropertyHandle() = default;
+
+  /**
+   * Constructs a handle for the given property. If the property is invalid,
+   * or if it is empty, the handle is invalid too.
+   */
+  explicit FCesiumPropertyTexturePropertyHandle(
+      const FCesiumPropertyTextureProperty& Property);
+
+  /**
+   * Whether this handle refers to a property that values can be sampled from.
+   */
+  bool isValid() const { return this->_pView != nullptr; }
+
+  int32 getInteger(const FVector2D& uv, int32 defaultValue = 0) const;
+  float getFloat(const FVector2D& uv, float defaultValue = 0.0f) const;
+  double getFloat64(const FVector2D& uv, double defaultValue = 0.0) const;
+  FVector getVector(const FVector2D& uv, const FVector& defaultValue) const;
+  FVector4 getVector4(const FVector2D& uv, const FVector4& defaultValue) const;
+
+  /**
+   * Samples the property at many texture coordinates at once. The value at
+   * uvs[i] is written to values[i], so both views must have the same number
+   * of elements.
+   */
+  void getIntegers(
+      TArrayView<const FVector2D> uvs,
+      int32 defaultValue,
+      TArrayView<int32> values) const;
+  void getFloats(
+      TArrayView<const FVector2D> uvs,
+      float defaultValue,
+      TArrayView<float> values) const;
+  void getFloat64s(
+      TArrayView<const FVector2D> uvs,
+      double defaultValue,
+      TArrayView<double> values) const;
+  void getVectors(
+      TArrayView<const FVector2D> uvs,
+      const FVector& defaultValue,
+      TArrayView<FVector> values) const;
+  void getVector4s(
+      TArrayView<const FVector2D> uvs,
+      const FVector4& defaultValue,
+      TArrayView<FVector4> values) const;
+
+private:
+  template <typename T>
+  using GetValuesFunction = void (*)(
+      const void* pView,
+      TArrayView<const FVector2D> uvs,
+      const T& defaultValue,
+      TArrayView<T> values);
+
+  // The PropertyTexturePropertyView inside the property's std::any.
+  const void* _pView = nullptr;
+
+  GetValuesFunction<int32> _getIntegers = nullptr;
+  GetValuesFunction<float> _getFloats = nullptr;
+  GetValuesFunction<double> _getFloat64s = nullptr;
+  GetValuesFunction<FVector> _getVectors = nullptr;
+  GetValuesFunction<FVector4> _getVector4s = nullptr;
 };
 
 UCLASS()
@@ -366,6 +450,28 @@ public:
       const FVector2D& UV,
       double DefaultValue = 0.0);
 
+  /**
+   * Attempts to retrieve the values at many texture coordinates at once as
+   * double-precision floating-point numbers. Each value is converted as
+   * described for GetFloat64, and Values receives one value for each of the
+   * texture coordinates, in the same order.
+   *
+   * This resolves the type of the property once for all of the samples, so it
+   * is much faster than calling GetFloat64 for each of them.
+   *
+   * @param UVs The texture coordinates.
+   * @param Values The property values, one for each texture coordinate.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Metadata|PropertyTextureProperty")
+  static void GetFloat64Values(
+      UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+      const TArray<FVector2D>& UVs,
+      TArray<double>& Values,
+      double DefaultValue = 0.0);
+
   /**
    * Attempts to retrieve the value at the given texture coordinates as a
    * FIntPoint.
@@ -587,6 +693,27 @@ public:
 
       const FVector4& DefaultValue);
 
+  /**
+   * Attempts to retrieve the values at many texture coordinates at once as
+   * FVector4s. Each value is converted as described for GetVector4, and Values
+   * receives one value for each of the texture coordinates, in the same order.
+   *
+   * This resolves the type of the property once for all of the samples, so it
+   * is much faster than calling GetVector4 for each of them.
+   *
+   * @param UVs The texture coordinates.
+   * @param Values The property values, one for each texture coordinate.
+   * @param DefaultValue The default value to fall back on.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Metadata|PropertyTextureProperty")
+  static void GetVector4Values(
+      UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+      const TArray<FVector2D>& UVs,
+      TArray<FVector4>& Values,
+      const FVector4& DefaultValue);
+
   /**
    * Attempts to retrieve the value for the given texture coordinates as a
    * FCesiumPropertyArray. If the property is not an array type, this returns an
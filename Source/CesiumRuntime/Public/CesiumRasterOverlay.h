@@ -15,6 +15,8 @@ namespace Cesium3DTilesSelection {
 class Tileset;
 }
 
+class CesiumRasterOverlayTexturePool;
+
 /**
  * The delegate for OnCesiumRasterOverlayLoadFailure, which is triggered when
  * the raster overlay encounters a load error.
@@ -42,6 +44,23 @@ struct FRasterOverlayRendererOptions {
 
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   bool useMipmaps = true;
+
+  /**
+   * Whether to copy the images of raster tiles into a few large textures that
+   * are shared by all tiles of this overlay, instead of creating a texture for
+   * each tile. This avoids creating and destroying a texture whenever a tile
+   * is loaded or unloaded, but mips of the shared textures that are smaller
+   * than 1/16th of their size aren't available, so distant tiles may shimmer
+   * more. Images too large to share are still given textures of their own.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool useTexturePool = false;
+
+  /**
+   * The texture pool of the overlay while it is added to a tileset and
+   * useTexturePool is true.
+   */
+  TSharedPtr<CesiumRasterOverlayTexturePool> pTexturePool;
 };
 
 /**
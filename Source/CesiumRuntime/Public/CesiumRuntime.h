@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include "CesiumCacheStatistics.h"
+#include "CesiumTextureMemoryStatistics.h"
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 #include <memory>
 
 class ACesium3DTileset;
 class UCesiumRasterOverlay;
+class UnrealTaskProcessor;
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -46,9 +49,22 @@ DECLARE_MULTICAST_DELEGATE_OneParam(
 CESIUMRUNTIME_API extern FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting;
 
+CESIUMRUNTIME_API UnrealTaskProcessor& getTaskProcessor();
 CESIUMRUNTIME_API CesiumAsync::AsyncSystem& getAsyncSystem() noexcept;
 CESIUMRUNTIME_API const std::shared_ptr<CesiumAsync::IAssetAccessor>&
 getAssetAccessor();
 
 CESIUMRUNTIME_API std::shared_ptr<CesiumAsync::ICacheDatabase>&
 getCacheDatabase();
+
+/**
+ * Gets statistics about the hits, misses, and size of each tier of the cache
+ * returned by getCacheDatabase.
+ */
+CESIUMRUNTIME_API CesiumCacheStatistics getCacheStatistics();
+
+/**
+ * Gets statistics about the GPU memory used by the textures of tiles, and the
+ * budget they are streamed to fit in. Must be called from the game thread.
+ */
+CESIUMRUNTIME_API CesiumTextureMemoryStatistics getTextureMemoryStatistics();
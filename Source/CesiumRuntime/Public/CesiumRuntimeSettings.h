@@ -66,4 +66,63 @@ public:
       Category = "Cache",
       meta = (ConfigRestartRequired = true))
   int MaxCacheItems = 4096;
+
+  /**
+   * The maximum size of the in-memory cache of recently used responses, in
+   * megabytes. Responses in this cache are loaded without reading the Sqlite
+   * database. Set this to zero to always read cached responses from disk.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int MemoryCacheSizeInMegabytes = 128;
+
+  /**
+   * The maximum size of the responses waiting to be written to the Sqlite
+   * database, in megabytes. Responses are written in batches on a background
+   * thread, so that the threads loading tiles don't wait for the disk. If the
+   * buffer is full, new responses are not cached until it has been written.
+   * Set this to zero to write every response immediately.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int CacheWriteBufferSizeInMegabytes = 64;
+
+  /**
+   * The number of threads that load tiles and do other background work for
+   * Cesium. If this is zero, a number suitable for this machine is used.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ConfigRestartRequired = true, ClampMin = 0))
+  int TaskProcessorThreadCount = 0;
+
+  /**
+   * The maximum amount of GPU memory used by the textures of tiles, in
+   * megabytes. When the textures would use more than this, the most detailed
+   * mip levels of the textures that are smallest on screen are dropped until
+   * they fit, and restored when there is room for them again. Set this to zero
+   * to always keep every mip level of every texture.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0))
+  int TextureMemoryBudgetInMegabytes = 0;
+
+  /**
+   * Whether the positions and indices of large glTF primitives are copied and
+   * bounded on several worker threads at once when tiles are loaded. The
+   * resulting meshes are identical either way.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool ParallelMeshBuilding = true;
 };
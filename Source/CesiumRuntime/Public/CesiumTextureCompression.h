@@ -0,0 +1,34 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumTextureCompression.generated.h"
+
+/**
+ * How the uncompressed images of a tileset's glTF tiles, such as JPEGs and
+ * PNGs, are compressed before they are uploaded to the GPU. Compressed
+ * textures use a quarter to an eighth of the GPU memory, at the cost of some
+ * image quality and extra work on the threads that load tiles.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTextureCompression : uint8 {
+  /**
+   * Images are uploaded without compression.
+   */
+  None,
+
+  /**
+   * Images are compressed as quickly as possible. Opaque images are
+   * compressed to BC1 and translucent images to BC3.
+   */
+  Fast,
+
+  /**
+   * Images are compressed to the same formats as Fast, but the colors of each
+   * block are chosen more carefully, which takes several times longer and
+   * gives fewer artifacts in blocks with gradients.
+   */
+  HighQuality
+};
@@ -0,0 +1,40 @@
+// Copyright 2020-2023 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+/**
+ * Statistics about the GPU memory used by the textures of tiles, and the
+ * budget that mip levels are streamed in and out to stay within.
+ */
+struct CesiumTextureMemoryStatistics {
+  /**
+   * The number of textures whose memory is managed.
+   */
+  int64 textures = 0;
+
+  /**
+   * The number of bytes of GPU memory used by the mip levels that are
+   * currently resident.
+   */
+  int64 residentBytes = 0;
+
+  /**
+   * The number of bytes of GPU memory the textures would use if all of their
+   * mip levels were resident.
+   */
+  int64 fullResolutionBytes = 0;
+
+  /**
+   * The maximum number of bytes of GPU memory the textures should use, or zero
+   * if there is no budget.
+   */
+  int64 budgetBytes = 0;
+
+  /**
+   * The number of textures that currently have one or more of their most
+   * detailed mip levels dropped.
+   */
+  int64 reducedTextures = 0;
+};
@@ -26,9 +26,33 @@ private:
   UPROPERTY()
   UCesiumTile* CesiumTile;
 
+  int64 _exclusionVersion = 0;
+
+  void _onOwnerTransformUpdated(
+      USceneComponent* UpdatedComponent,
+      EUpdateTransformFlags UpdateTransformFlags,
+      ETeleportType Teleport);
+
 public:
+  /**
+   * Whether the result of ShouldExclude may be cached per tile.
+   *
+   * When this is enabled, ShouldExclude is called at most once for each tile
+   * and the result is reused in later frames, until this excluder is
+   * refreshed, its properties are edited, its owner moves,
+   * MarkExclusionChanged is called, or the tileset moves relative to the globe.
+   * Enable this only if ShouldExclude depends on nothing but the tile, this
+   * component's properties, and its owner's transform, or if
+   * MarkExclusionChanged is called whenever anything else it depends on
+   * changes.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool CacheExclusionResults = false;
+
   UCesiumTileExcluder(const FObjectInitializer& ObjectInitializer);
 
+  virtual void OnRegister() override;
+  virtual void OnUnregister() override;
   virtual void Activate(bool bReset) override;
   virtual void Deactivate() override;
   virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
@@ -63,6 +87,20 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   void Refresh();
 
+  /**
+   * Notifies this tile excluder that the result of ShouldExclude may have
+   * changed for some tiles, discarding all cached results. This is only
+   * necessary when CacheExclusionResults is enabled.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void MarkExclusionChanged();
+
+  /**
+   * Gets a version stamp that changes whenever MarkExclusionChanged is called,
+   * the owner of this component moves, or its properties are edited.
+   */
+  int64 GetExclusionVersion() const { return this->_exclusionVersion; }
+
   /**
    * Determines whether a tile should be excluded.
    * This function is called to determine whether a tile should be excluded from
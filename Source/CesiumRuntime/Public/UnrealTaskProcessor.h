@@ -4,9 +4,147 @@
 
 #include "CesiumAsync/ITaskProcessor.h"
 #include "HAL/Platform.h"
+#include <array>
+#include <cstdint>
+#include <memory>
 
+/**
+ * The priority lanes of the {@link UnrealTaskProcessor}. Queued tasks in a
+ * lane are only started when all lanes before it are empty.
+ */
+enum class ECesiumTaskLane : uint8 {
+  /**
+   * Work for a tileset that is currently being rendered, such as loading the
+   * tiles the camera is looking at.
+   */
+  InView,
+
+  /**
+   * Work for a tileset that is loaded but not currently rendered, for example
+   * because it is hidden or has no camera to render to.
+   */
+  Preload,
+
+  /**
+   * Work that is not associated with a tileset, or that belongs to a tileset
+   * that has been destroyed.
+   */
+  Background,
+
+  Count
+};
+
+/**
+ * Statistics about one {@link ECesiumTaskLane} of the task processor.
+ */
+struct CesiumTaskLaneStatistics {
+  /**
+   * The number of tasks that are waiting to be started.
+   */
+  int32 queuedTasks = 0;
+
+  /**
+   * The total number of tasks that have been started.
+   */
+  int64 startedTasks = 0;
+
+  /**
+   * The average time that recently started tasks waited in the queue.
+   */
+  double recentAverageLatencySeconds = 0.0;
+
+  /**
+   * The longest time that any task has waited in the queue.
+   */
+  double maximumLatencySeconds = 0.0;
+};
+
+/**
+ * Runs cesium-native's background work on a dedicated set of worker threads.
+ *
+ * Each task belongs to an owner, usually a tileset, and is queued in the lane
+ * of its owner. Lanes are served in priority order, and within a lane the
+ * owners take turns so that one tileset with a deep queue can't starve the
+ * others. Tasks of the same owner start in the order they were queued.
+ *
+ * Tasks are associated with the owner of the {@link CesiumTaskScope} that is
+ * active on the thread that starts them, and tasks that are running are in
+ * their owner's scope, so continuations inherit the owner of the task that
+ * started them. Continuations in the main thread are shared by all owners, so
+ * they run outside of any scope, and the tasks they start are unowned.
+ */
 class CESIUMRUNTIME_API UnrealTaskProcessor
     : public CesiumAsync::ITaskProcessor {
 public:
+  /**
+   * The owner of tasks that are not started in any {@link CesiumTaskScope}.
+   * These tasks are always in the background lane.
+   */
+  static constexpr uint32 UnownedTasks = 0;
+
+  /**
+   * Creates a task processor with the given number of worker threads. If the
+   * count is zero or less, a count suitable for the current machine is used.
+   */
+  explicit UnrealTaskProcessor(int32 threadCount = 0);
+  virtual ~UnrealTaskProcessor();
+
   virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * Creates a new task owner whose tasks are queued in the given lane.
+   */
+  uint32 createOwner(ECesiumTaskLane lane);
+
+  /**
+   * Moves an owner, including all of its queued tasks, to a different lane.
+   */
+  void setOwnerLane(uint32 owner, ECesiumTaskLane lane);
+
+  /**
+   * Releases an owner that no longer needs its work done quickly, such as a
+   * destroyed tileset. Its queued tasks, and any tasks started by them, move
+   * to the background lane. They can't be dropped, because each of them
+   * resolves a future that cesium-native waits on before it finishes
+   * destroying the tileset.
+   */
+  void releaseOwner(uint32 owner);
+
+  /**
+   * Gets statistics about each lane, indexed by {@link ECesiumTaskLane}.
+   */
+  std::array<CesiumTaskLaneStatistics, size_t(ECesiumTaskLane::Count)>
+  getStatistics() const;
+
+  /**
+   * Runs all queued tasks to completion and stops the worker threads. Tasks
+   * started after this run immediately on the calling thread.
+   */
+  void shutdown();
+
+private:
+  class Scheduler;
+  std::unique_ptr<Scheduler> _pScheduler;
+};
+
+/**
+ * Associates the tasks that are started on this thread with an owner of the
+ * {@link UnrealTaskProcessor} for as long as this object is in scope.
+ */
+class CESIUMRUNTIME_API CesiumTaskScope {
+public:
+  explicit CesiumTaskScope(uint32 owner);
+  ~CesiumTaskScope();
+
+  CesiumTaskScope(const CesiumTaskScope&) = delete;
+  CesiumTaskScope& operator=(const CesiumTaskScope&) = delete;
+
+  /**
+   * Gets the owner of the innermost scope on this thread, or
+   * {@link UnrealTaskProcessor::UnownedTasks} if there is none.
+   */
+  static uint32 current();
+
+private:
+  uint32 _previous;
 };